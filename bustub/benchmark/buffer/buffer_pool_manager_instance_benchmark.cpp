@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_pool_manager_instance_benchmark.cpp
+//
+// Identification: benchmark/buffer/buffer_pool_manager_instance_benchmark.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/** A buffer pool of `pool_size` frames over a database file holding `num_pages` pages */
+class BufferPoolFixture {
+ public:
+  BufferPoolFixture(size_t pool_size, size_t num_pages) {
+    std::remove("bpm_benchmark.db");
+    disk_manager_ = std::make_unique<DiskManager>("bpm_benchmark.db");
+    bpm_ = std::make_unique<BufferPoolManagerInstance>(pool_size, disk_manager_.get());
+    for (size_t i = 0; i < num_pages; i++) {
+      page_id_t page_id;
+      bpm_->NewPage(&page_id);
+      bpm_->UnpinPage(page_id, true);
+      page_ids_.push_back(page_id);
+    }
+  }
+
+  ~BufferPoolFixture() {
+    bpm_.reset();
+    disk_manager_->ShutDown();
+    std::remove("bpm_benchmark.db");
+    std::remove("bpm_benchmark.log");
+  }
+
+  std::unique_ptr<DiskManager> disk_manager_;
+  std::unique_ptr<BufferPoolManagerInstance> bpm_;
+  std::vector<page_id_t> page_ids_;
+};
+
+/** Every page fits in the pool: FetchPage never goes to disk */
+static void BM_FetchUnpinHit(benchmark::State &state) {
+  BufferPoolFixture fixture(1024, 512);
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<size_t> pick(0, fixture.page_ids_.size() - 1);
+  for (auto _ : state) {
+    auto page_id = fixture.page_ids_[pick(rng)];
+    benchmark::DoNotOptimize(fixture.bpm_->FetchPage(page_id));
+    fixture.bpm_->UnpinPage(page_id, false);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FetchUnpinHit);
+
+/** The pages are four times the pool: most FetchPage calls evict a frame and read the page back */
+static void BM_FetchUnpinMiss(benchmark::State &state) {
+  BufferPoolFixture fixture(64, 256);
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<size_t> pick(0, fixture.page_ids_.size() - 1);
+  bool dirty = state.range(0) != 0;
+  for (auto _ : state) {
+    auto page_id = fixture.page_ids_[pick(rng)];
+    benchmark::DoNotOptimize(fixture.bpm_->FetchPage(page_id));
+    fixture.bpm_->UnpinPage(page_id, dirty);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FetchUnpinMiss)->ArgName("dirty")->Arg(0)->Arg(1);
+
+/** Concurrent hits on a shared pool, contending on the buffer pool latch */
+static void BM_FetchUnpinHitConcurrent(benchmark::State &state) {
+  static std::unique_ptr<BufferPoolFixture> fixture;
+  if (state.thread_index() == 0) {
+    fixture = std::make_unique<BufferPoolFixture>(1024, 512);
+  }
+  // The other threads wait for the fixture at the start of the loop.
+  std::mt19937 rng(state.thread_index());
+  std::uniform_int_distribution<size_t> pick(0, 511);
+  for (auto _ : state) {
+    auto page_id = fixture->page_ids_[pick(rng)];
+    benchmark::DoNotOptimize(fixture->bpm_->FetchPage(page_id));
+    fixture->bpm_->UnpinPage(page_id, false);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    fixture.reset();
+  }
+}
+BENCHMARK(BM_FetchUnpinHitConcurrent)->Threads(1)->Threads(4)->UseRealTime();
+
+/** NewPage on a full pool evicts a frame and writes it back */
+static void BM_NewPage(benchmark::State &state) {
+  BufferPoolFixture fixture(64, 0);
+  for (auto _ : state) {
+    page_id_t page_id;
+    benchmark::DoNotOptimize(fixture.bpm_->NewPage(&page_id));
+    fixture.bpm_->UnpinPage(page_id, true);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NewPage);
+
+}  // namespace bustub
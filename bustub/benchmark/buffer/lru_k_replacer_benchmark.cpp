@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// lru_k_replacer_benchmark.cpp
+//
+// Identification: benchmark/buffer/lru_k_replacer_benchmark.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <random>
+
+#include "benchmark/benchmark.h"
+#include "buffer/lru_k_replacer.h"
+
+namespace bustub {
+
+/** Accesses to frames that are already tracked, moving them inside the history and cache lists */
+static void BM_RecordAccess(benchmark::State &state) {
+  auto num_frames = static_cast<size_t>(state.range(0));
+  LRUKReplacer replacer(num_frames, 2);
+  for (size_t i = 0; i < num_frames; i++) {
+    replacer.RecordAccess(static_cast<frame_id_t>(i));
+    replacer.SetEvictable(static_cast<frame_id_t>(i), true);
+  }
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<frame_id_t> pick(0, static_cast<frame_id_t>(num_frames) - 1);
+  for (auto _ : state) {
+    replacer.RecordAccess(pick(rng));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordAccess)->ArgName("frames")->Arg(64)->Arg(1024);
+
+/**
+ * The replacement done by a buffer pool miss: evict a victim, then track the frame again for the new page. `pinned`
+ * is the share (in percent) of frames that are not evictable and have to be skipped by Evict.
+ */
+static void BM_EvictRecordAccess(benchmark::State &state) {
+  auto num_frames = static_cast<size_t>(state.range(0));
+  auto pinned = num_frames * static_cast<size_t>(state.range(1)) / 100;
+  LRUKReplacer replacer(num_frames, 2);
+  for (size_t i = 0; i < num_frames; i++) {
+    replacer.RecordAccess(static_cast<frame_id_t>(i));
+    replacer.SetEvictable(static_cast<frame_id_t>(i), i >= pinned);
+  }
+  for (auto _ : state) {
+    frame_id_t frame_id;
+    if (!replacer.Evict(&frame_id)) {
+      state.SkipWithError("no evictable frame");
+      break;
+    }
+    replacer.RecordAccess(frame_id);
+    replacer.SetEvictable(frame_id, true);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EvictRecordAccess)->ArgNames({"frames", "pinned_pct"})->Args({1024, 0})->Args({1024, 90});
+
+/** Pin and unpin, as every FetchPage and UnpinPage of a buffer pool hit does */
+static void BM_SetEvictable(benchmark::State &state) {
+  LRUKReplacer replacer(1024, 2);
+  for (frame_id_t i = 0; i < 1024; i++) {
+    replacer.RecordAccess(i);
+  }
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<frame_id_t> pick(0, 1023);
+  for (auto _ : state) {
+    auto frame_id = pick(rng);
+    replacer.SetEvictable(frame_id, false);
+    replacer.SetEvictable(frame_id, true);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SetEvictable);
+
+}  // namespace bustub
@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// extendible_hash_table_benchmark.cpp
+//
+// Identification: benchmark/container/extendible_hash_table_benchmark.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <random>
+
+#include "benchmark/benchmark.h"
+#include "container/hash/extendible_hash_table.h"
+
+namespace bustub {
+
+/** Insert `keys` distinct keys into an empty table, splitting buckets and doubling the directory on the way */
+static void BM_ExtendibleHashTableInsert(benchmark::State &state) {
+  auto num_keys = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    ExtendibleHashTable<int, int> table(4);
+    for (int i = 0; i < num_keys; i++) {
+      table.Insert(i, i);
+    }
+    benchmark::DoNotOptimize(table.GetNumBuckets());
+  }
+  state.SetItemsProcessed(state.iterations() * num_keys);
+}
+BENCHMARK(BM_ExtendibleHashTableInsert)->ArgName("keys")->Arg(1 << 10)->Arg(1 << 14);
+
+/** Lookups in a table of `keys` keys, half of them hits */
+static void BM_ExtendibleHashTableFind(benchmark::State &state) {
+  auto num_keys = static_cast<int>(state.range(0));
+  ExtendibleHashTable<int, int> table(4);
+  for (int i = 0; i < num_keys; i++) {
+    table.Insert(i, i);
+  }
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> pick(0, 2 * num_keys - 1);
+  for (auto _ : state) {
+    int value;
+    benchmark::DoNotOptimize(table.Find(pick(rng), value));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExtendibleHashTableFind)->ArgName("keys")->Arg(1 << 10)->Arg(1 << 14);
+
+/** Remove then insert back a key, the churn of the page table of a buffer pool */
+static void BM_ExtendibleHashTableRemoveInsert(benchmark::State &state) {
+  ExtendibleHashTable<int, int> table(4);
+  for (int i = 0; i < 1024; i++) {
+    table.Insert(i, i);
+  }
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> pick(0, 1023);
+  for (auto _ : state) {
+    auto key = pick(rng);
+    table.Remove(key);
+    table.Insert(key, key);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExtendibleHashTableRemoveInsert);
+
+}  // namespace bustub
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// executor_benchmark.cpp
+//
+// Identification: benchmark/execution/executor_benchmark.cpp
+//
+//===----------------------------------------------------------------------===//
+
+// Each benchmark runs one query through BustubInstance, on the tables filled by TableGenerator, so it measures the
+// executor together with the planner and the optimizer, as a user sees it. The lock manager logs every lock to
+// stdout: compare the --benchmark_out JSON files, not the console output.
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+
+namespace bustub {
+
+/** A BusTub instance with the test tables of TableGenerator, an index on test_1.colA and an empty scratch table */
+class ExecutorFixture {
+ public:
+  ExecutorFixture() {
+    std::remove("executor_benchmark.db");
+    bustub_ = std::make_unique<BustubInstance>("executor_benchmark.db");
+    bustub_->GenerateTestTable();
+    NoopWriter writer;
+    bustub_->ExecuteSql("CREATE INDEX test_1_colA ON test_1 (colA);", writer);
+    bustub_->ExecuteSql("CREATE TABLE scratch (a INT, b INT);", writer);
+  }
+
+  ~ExecutorFixture() {
+    bustub_.reset();
+    std::remove("executor_benchmark.db");
+    std::remove("executor_benchmark.log");
+  }
+
+  std::unique_ptr<BustubInstance> bustub_;
+};
+
+/** test_1 has 1000 rows, test_2 has 100 */
+static void RunQuery(benchmark::State &state, const std::string &sql) {
+  ExecutorFixture fixture;
+  NoopWriter writer;
+  for (auto _ : state) {
+    try {
+      fixture.bustub_->ExecuteSql(sql, writer);
+    } catch (const Exception &e) {
+      state.SkipWithError(e.what());
+      break;
+    }
+  }
+}
+
+BENCHMARK_CAPTURE(RunQuery, seq_scan, std::string("SELECT * FROM test_1;"));
+BENCHMARK_CAPTURE(RunQuery, filter, std::string("SELECT colA FROM test_1 WHERE colB = 3;"));
+BENCHMARK_CAPTURE(RunQuery, projection, std::string("SELECT colA + colB, colC - colD FROM test_1;"));
+BENCHMARK_CAPTURE(RunQuery, index_scan, std::string("SELECT * FROM test_1 WHERE colA = 500;"));
+BENCHMARK_CAPTURE(RunQuery, simple_aggregation,
+                  std::string("SELECT COUNT(*), SUM(colC), MIN(colD), MAX(colD) FROM test_1;"));
+BENCHMARK_CAPTURE(RunQuery, group_aggregation,
+                  std::string("SELECT colB, COUNT(*), SUM(colC) FROM test_1 GROUP BY colB;"));
+BENCHMARK_CAPTURE(RunQuery, distinct, std::string("SELECT DISTINCT colB FROM test_1;"));
+BENCHMARK_CAPTURE(RunQuery, nested_loop_join,
+                  std::string("SELECT * FROM test_2 t1, test_2 t2 WHERE t1.colA < t2.colB;"));
+BENCHMARK_CAPTURE(RunQuery, hash_join,
+                  std::string("SELECT * FROM test_1 t1 INNER JOIN test_2 t2 ON t1.colB = t2.colC;"));
+BENCHMARK_CAPTURE(RunQuery, nested_index_join,
+                  std::string("SELECT * FROM test_2 t2 INNER JOIN test_1 t1 ON t2.colA = t1.colA;"));
+BENCHMARK_CAPTURE(RunQuery, sort, std::string("SELECT * FROM test_1 ORDER BY colD, colC;"));
+BENCHMARK_CAPTURE(RunQuery, top_n, std::string("SELECT * FROM test_1 ORDER BY colD LIMIT 10;"));
+BENCHMARK_CAPTURE(RunQuery, limit, std::string("SELECT * FROM test_1 LIMIT 10;"));
+BENCHMARK_CAPTURE(RunQuery, insert, std::string("INSERT INTO scratch VALUES (1, 2), (3, 4), (5, 6), (7, 8);"));
+BENCHMARK_CAPTURE(RunQuery, update, std::string("UPDATE test_2 SET colB = 1 WHERE colA < 10;"));
+
+}  // namespace bustub
@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_benchmark.cpp
+//
+// Identification: benchmark/storage/b_plus_tree_benchmark.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "concurrency/transaction.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using BenchmarkTree = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+/** A B+ tree over a fresh database file, with its header page */
+class BPlusTreeFixture {
+ public:
+  explicit BPlusTreeFixture(size_t pool_size) {
+    std::remove("b_plus_tree_benchmark.db");
+    key_schema_ = ParseCreateStatement("a bigint");
+    comparator_ = std::make_unique<GenericComparator<8>>(key_schema_.get());
+    disk_manager_ = std::make_unique<DiskManager>("b_plus_tree_benchmark.db");
+    bpm_ = std::make_unique<BufferPoolManagerInstance>(pool_size, disk_manager_.get());
+    page_id_t page_id;
+    bpm_->NewPage(&page_id);
+    bpm_->UnpinPage(page_id, true);
+    tree_ = std::make_unique<BenchmarkTree>("benchmark_pk", bpm_.get(), *comparator_);
+  }
+
+  ~BPlusTreeFixture() {
+    tree_.reset();
+    bpm_.reset();
+    disk_manager_->ShutDown();
+    std::remove("b_plus_tree_benchmark.db");
+    std::remove("b_plus_tree_benchmark.log");
+  }
+
+  void Insert(int64_t key) {
+    GenericKey<8> index_key;
+    index_key.SetFromInteger(key);
+    tree_->Insert(index_key, RID(static_cast<page_id_t>(key >> 32), static_cast<uint32_t>(key)), &txn_);
+  }
+
+  std::unique_ptr<Schema> key_schema_;
+  std::unique_ptr<GenericComparator<8>> comparator_;
+  std::unique_ptr<DiskManager> disk_manager_;
+  std::unique_ptr<BufferPoolManagerInstance> bpm_;
+  std::unique_ptr<BenchmarkTree> tree_;
+  Transaction txn_{0};
+};
+
+/** @return the keys 0 .. n - 1, in order or shuffled */
+static auto MakeKeys(size_t n, bool shuffled) -> std::vector<int64_t> {
+  std::vector<int64_t> keys(n);
+  std::iota(keys.begin(), keys.end(), 0);
+  if (shuffled) {
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+  }
+  return keys;
+}
+
+/** Build a tree of `keys` keys, inserted in order or at random */
+static void BM_BPlusTreeInsert(benchmark::State &state) {
+  auto keys = MakeKeys(state.range(0), state.range(1) != 0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto fixture = std::make_unique<BPlusTreeFixture>(256);
+    state.ResumeTiming();
+    for (auto key : keys) {
+      fixture->Insert(key);
+    }
+    state.PauseTiming();
+    fixture.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_BPlusTreeInsert)->ArgNames({"keys", "random"})->Args({10000, 0})->Args({10000, 1});
+
+/** Point lookups in a tree of `keys` keys */
+static void BM_BPlusTreeGetValue(benchmark::State &state) {
+  BPlusTreeFixture fixture(256);
+  auto num_keys = state.range(0);
+  for (auto key : MakeKeys(num_keys, true)) {
+    fixture.Insert(key);
+  }
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> pick(0, num_keys - 1);
+  std::vector<RID> result;
+  GenericKey<8> index_key;
+  for (auto _ : state) {
+    result.clear();
+    index_key.SetFromInteger(pick(rng));
+    benchmark::DoNotOptimize(fixture.tree_->GetValue(index_key, &result, &fixture.txn_));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BPlusTreeGetValue)->ArgName("keys")->Arg(10000)->Arg(100000);
+
+/** Range scans of `length` keys from a random start, through the leaf iterator */
+static void BM_BPlusTreeScan(benchmark::State &state) {
+  BPlusTreeFixture fixture(256);
+  constexpr int64_t num_keys = 100000;
+  for (auto key : MakeKeys(num_keys, true)) {
+    fixture.Insert(key);
+  }
+  auto length = state.range(0);
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> pick(0, num_keys - length);
+  GenericKey<8> index_key;
+  for (auto _ : state) {
+    index_key.SetFromInteger(pick(rng));
+    int64_t count = 0;
+    for (auto iter = fixture.tree_->Begin(index_key); !iter.IsEnd() && count < length; ++iter) {
+      benchmark::DoNotOptimize((*iter).second);
+      count++;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK(BM_BPlusTreeScan)->ArgName("length")->Arg(10)->Arg(1000);
+
+}  // namespace bustub
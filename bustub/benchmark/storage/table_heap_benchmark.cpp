@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_heap_benchmark.cpp
+//
+// Identification: benchmark/storage/table_heap_benchmark.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "concurrency/transaction.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** An empty table heap over a fresh database file */
+class TableHeapFixture {
+ public:
+  TableHeapFixture() {
+    std::remove("table_heap_benchmark.db");
+    schema_ = ParseCreateStatement("a integer,b varchar(64)");
+    disk_manager_ = std::make_unique<DiskManager>("table_heap_benchmark.db");
+    bpm_ = std::make_unique<BufferPoolManagerInstance>(256, disk_manager_.get());
+    table_ = std::make_unique<TableHeap>(bpm_.get(), nullptr, nullptr, &txn_);
+  }
+
+  ~TableHeapFixture() {
+    table_.reset();
+    bpm_.reset();
+    disk_manager_->ShutDown();
+    std::remove("table_heap_benchmark.db");
+    std::remove("table_heap_benchmark.log");
+  }
+
+  auto MakeTuple(int32_t a) -> Tuple {
+    return Tuple({ValueFactory::GetIntegerValue(a), ValueFactory::GetVarcharValue(std::string(48, 'x'))},
+                 schema_.get());
+  }
+
+  void Insert(const Tuple &tuple) {
+    RID rid;
+    table_->InsertTuple(tuple, &rid, &txn_);
+    // The write set only matters to abort a transaction, don't let it grow with the benchmark.
+    txn_.GetWriteSet()->clear();
+  }
+
+  std::unique_ptr<Schema> schema_;
+  std::unique_ptr<DiskManager> disk_manager_;
+  std::unique_ptr<BufferPoolManagerInstance> bpm_;
+  Transaction txn_{0};
+  std::unique_ptr<TableHeap> table_;
+};
+
+/** Fill an empty heap with `rows` rows. InsertTuple walks the pages from the first one, so this grows with `rows`. */
+static void BM_TableHeapInsert(benchmark::State &state) {
+  auto rows = static_cast<int32_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto fixture = std::make_unique<TableHeapFixture>();
+    auto tuple = fixture->MakeTuple(0);
+    state.ResumeTiming();
+    for (int32_t i = 0; i < rows; i++) {
+      fixture->Insert(tuple);
+    }
+    state.PauseTiming();
+    fixture.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_TableHeapInsert)->ArgName("rows")->Arg(1000)->Arg(10000);
+
+/** A full scan of a heap of `rows` rows through the table iterator */
+static void BM_TableHeapScan(benchmark::State &state) {
+  TableHeapFixture fixture;
+  auto rows = static_cast<int32_t>(state.range(0));
+  for (int32_t i = 0; i < rows; i++) {
+    fixture.Insert(fixture.MakeTuple(i));
+  }
+  for (auto _ : state) {
+    for (auto iter = fixture.table_->Begin(&fixture.txn_); iter != fixture.table_->End(); ++iter) {
+      benchmark::DoNotOptimize(iter->GetData());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_TableHeapScan)->ArgName("rows")->Arg(1000)->Arg(10000);
+
+}  // namespace bustub
@@ -0,0 +1,34 @@
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "binder/binder.h"
+#include "binder/statement/analyze_statement.h"
+#include "common/exception.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+auto Binder::BindAnalyze(duckdb_libpgquery::PGVacuumStmt *stmt) -> std::unique_ptr<AnalyzeStatement> {
+  if ((stmt->options & duckdb_libpgquery::PG_VACOPT_VACUUM) != 0) {
+    // The free pages belong to the whole database file, not to a table.
+    if ((stmt->options & duckdb_libpgquery::PG_VACOPT_ANALYZE) != 0 || stmt->relation != nullptr) {
+      throw NotImplementedException("only a plain VACUUM of the whole database is supported");
+    }
+    return std::make_unique<AnalyzeStatement>(std::nullopt, true);
+  }
+  if (stmt->va_cols != nullptr) {
+    throw NotImplementedException("analyze on a column list is not supported");
+  }
+  if (stmt->relation == nullptr) {
+    return std::make_unique<AnalyzeStatement>(std::nullopt);
+  }
+
+  std::string table_name = stmt->relation->relname;
+  if (catalog_.GetTable(table_name) == nullptr) {
+    throw bustub::Exception(fmt::format("invalid table {}", table_name));
+  }
+  return std::make_unique<AnalyzeStatement>(std::move(table_name));
+}
+
+}  // namespace bustub
@@ -78,6 +78,23 @@ auto Binder::BindColumnDefinition(duckdb_libpgquery::PGColumnDef *cdef) -> Colum
     return {colname, TypeId::VARCHAR, varchar_max_length};
   }
 
+  // DECIMAL(p, s) is parsed as numeric
+  if (name == "numeric") {
+    if (cdef->typeName->typmods == nullptr) {
+      return {colname, TypeId::FIXED_DECIMAL};
+    }
+    auto exprs = BindExpressionList(cdef->typeName->typmods);
+    if (exprs.size() > 2) {
+      throw bustub::Exception("should specify at most a precision and a scale for decimal field");
+    }
+    auto precision = std::stoi(dynamic_cast<const BoundConstant &>(*exprs[0]).ToString());
+    auto scale = exprs.size() == 2 ? std::stoi(dynamic_cast<const BoundConstant &>(*exprs[1]).ToString()) : 0;
+    if (precision < 1 || precision > BUSTUB_FIXED_DECIMAL_MAX_PRECISION || scale < 0 || scale > precision) {
+      throw bustub::Exception(fmt::format("invalid precision and scale for decimal field: ({}, {})", precision, scale));
+    }
+    return {colname, TypeId::FIXED_DECIMAL, static_cast<uint8_t>(precision), static_cast<uint8_t>(scale)};
+  }
+
   throw NotImplementedException(fmt::format("unsupported type: {}", name));
 }
 
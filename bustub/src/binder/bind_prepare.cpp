@@ -0,0 +1,109 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/binder.h"
+#include "binder/expressions/bound_constant.h"
+#include "binder/expressions/bound_parameter.h"
+#include "binder/statement/prepare_statement.h"
+#include "common/exception.h"
+#include "fmt/format.h"
+#include "nodes/parsenodes.hpp"
+#include "type/type_id.h"
+
+namespace bustub {
+
+namespace {
+
+auto BindParamType(duckdb_libpgquery::PGTypeName *type_name) -> TypeId {
+  auto name = std::string(
+      (reinterpret_cast<duckdb_libpgquery::PGValue *>(type_name->names->tail->data.ptr_value)->val.str));
+  if (name == "int4") {
+    return TypeId::INTEGER;
+  }
+  if (name == "varchar") {
+    return TypeId::VARCHAR;
+  }
+  if (name == "bool") {
+    return TypeId::BOOLEAN;
+  }
+  if (name == "numeric") {
+    return TypeId::FIXED_DECIMAL;
+  }
+  throw NotImplementedException(fmt::format("unsupported parameter type {}", name));
+}
+
+}  // namespace
+
+auto Binder::BindPrepare(duckdb_libpgquery::PGPrepareStmt *stmt) -> std::unique_ptr<PrepareStatement> {
+  if (param_types_.has_value()) {
+    throw bustub::Exception("PREPARE can not be nested");
+  }
+  std::vector<TypeId> param_types;
+  if (stmt->argtypes != nullptr) {
+    for (auto node = stmt->argtypes->head; node != nullptr; node = node->next) {
+      param_types.push_back(BindParamType(reinterpret_cast<duckdb_libpgquery::PGTypeName *>(node->data.ptr_value)));
+    }
+  }
+
+  // Parameters without a declared type are bound as integers, see `BindParamRef`.
+  param_types_ = std::move(param_types);
+  std::unique_ptr<BoundStatement> statement;
+  try {
+    statement = BindStatement(stmt->query);
+  } catch (...) {
+    param_types_ = std::nullopt;
+    throw;
+  }
+  param_types = std::move(*param_types_);
+  param_types_ = std::nullopt;
+
+  switch (statement->type_) {
+    case StatementType::SELECT_STATEMENT:
+    case StatementType::INSERT_STATEMENT:
+    case StatementType::DELETE_STATEMENT:
+    case StatementType::UPDATE_STATEMENT:
+      break;
+    default:
+      throw NotImplementedException(fmt::format("{} statement can not be prepared", statement->type_));
+  }
+  return std::make_unique<PrepareStatement>(stmt->name, std::move(param_types), std::move(statement));
+}
+
+auto Binder::BindExecute(duckdb_libpgquery::PGExecuteStmt *stmt) -> std::unique_ptr<ExecuteStatement> {
+  std::vector<Value> params;
+  if (stmt->params != nullptr) {
+    for (const auto &expr : BindExpressionList(stmt->params)) {
+      if (expr->type_ != ExpressionType::CONSTANT) {
+        throw NotImplementedException("only constants are supported as parameters");
+      }
+      params.push_back(dynamic_cast<const BoundConstant &>(*expr).val_);
+    }
+  }
+  return std::make_unique<ExecuteStatement>(stmt->name, std::move(params));
+}
+
+auto Binder::BindDeallocate(duckdb_libpgquery::PGDeallocateStmt *stmt) -> std::unique_ptr<DeallocateStatement> {
+  if (stmt->name == nullptr) {
+    return std::make_unique<DeallocateStatement>(std::nullopt);
+  }
+  return std::make_unique<DeallocateStatement>(stmt->name);
+}
+
+auto Binder::BindParamRef(duckdb_libpgquery::PGParamRef *node) -> std::unique_ptr<BoundExpression> {
+  if (!param_types_.has_value()) {
+    throw bustub::Exception("parameters can only be used in PREPARE");
+  }
+  if (node->number <= 0) {
+    throw NotImplementedException("only numbered parameters ($1, $2, ...) are supported");
+  }
+  auto param_idx = static_cast<size_t>(node->number - 1);
+  if (param_idx >= param_types_->size()) {
+    param_types_->resize(param_idx + 1, TypeId::INTEGER);
+  }
+  return std::make_unique<BoundParameter>(param_idx, (*param_types_)[param_idx]);
+}
+
+}  // namespace bustub
@@ -14,7 +14,9 @@
 #include "binder/expressions/bound_column_ref.h"
 #include "binder/expressions/bound_constant.h"
 #include "binder/expressions/bound_star.h"
+#include "binder/expressions/bound_subquery.h"
 #include "binder/expressions/bound_unary_op.h"
+#include "binder/expressions/bound_window.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/table_ref/bound_base_table_ref.h"
@@ -456,6 +458,10 @@ auto Binder::BindConstant(duckdb_libpgquery::PGAConst *node) -> std::unique_ptr<
     case duckdb_libpgquery::T_PGString: {
       return std::make_unique<BoundConstant>(ValueFactory::GetVarcharValue(val.val.str));
     }
+    case duckdb_libpgquery::T_PGFloat: {
+      // a number with a decimal point or too large for an integer, kept exact
+      return std::make_unique<BoundConstant>(ValueFactory::GetFixedDecimalValue(std::string(val.val.str)));
+    }
     case duckdb_libpgquery::T_PGNull: {
       // TODO(chi): cast integer null to other types
       return std::make_unique<BoundConstant>(ValueFactory::GetNullValueByType(TypeId::INTEGER));
@@ -521,8 +527,15 @@ auto Binder::BindFuncCall(duckdb_libpgquery::PGFuncCall *root) -> std::unique_pt
     }
   }
 
+  if (root->over != nullptr) {
+    if (root->agg_distinct) {
+      throw NotImplementedException("DISTINCT is not supported in window functions");
+    }
+    return BindWindow(root->over, std::move(function_name), std::move(children));
+  }
+
   if (function_name == "min" || function_name == "max" || function_name == "first" || function_name == "last" ||
-      function_name == "sum" || function_name == "count") {
+      function_name == "sum" || function_name == "count" || function_name == "approx_count_distinct") {
     // Rewrite count(*) to count_star().
     if (function_name == "count" && children.empty()) {
       function_name = "count_star";
@@ -534,6 +547,56 @@ auto Binder::BindFuncCall(duckdb_libpgquery::PGFuncCall *root) -> std::unique_pt
   throw bustub::Exception(fmt::format("unsupported func call {}", function_name));
 }
 
+auto Binder::BindWindow(duckdb_libpgquery::PGWindowDef *over, std::string function_name,
+                        std::vector<std::unique_ptr<BoundExpression>> args) -> std::unique_ptr<BoundExpression> {
+  if (function_name == "count" && args.empty()) {
+    function_name = "count_star";
+  }
+  if (function_name == "row_number" || function_name == "rank" || function_name == "dense_rank" ||
+      function_name == "count_star") {
+    if (!args.empty()) {
+      throw bustub::Exception(fmt::format("{} takes no argument", function_name));
+    }
+  } else if (function_name == "min" || function_name == "max" || function_name == "sum" || function_name == "count") {
+    if (args.size() != 1) {
+      throw bustub::Exception(fmt::format("{} takes exactly one argument", function_name));
+    }
+  } else {
+    throw bustub::Exception(fmt::format("unsupported window function {}", function_name));
+  }
+  if (over->name != nullptr || over->refname != nullptr) {
+    throw NotImplementedException("named windows are not supported");
+  }
+
+  auto partition_by = std::vector<std::unique_ptr<BoundExpression>>{};
+  if (over->partitionClause != nullptr) {
+    partition_by = BindExpressionList(over->partitionClause);
+  }
+  auto order_bys = std::vector<std::unique_ptr<BoundOrderBy>>{};
+  if (over->orderClause != nullptr) {
+    order_bys = BindSort(over->orderClause);
+  }
+
+  // Only the frames starting at the beginning of the partition, which can be computed incrementally, are supported.
+  auto frame = order_bys.empty() ? WindowFrameType::PARTITION : WindowFrameType::RANGE_TO_CURRENT;
+  if ((over->frameOptions & FRAMEOPTION_NONDEFAULT) != 0) {
+    if ((over->frameOptions & FRAMEOPTION_START_UNBOUNDED_PRECEDING) == 0) {
+      throw NotImplementedException("window frames must start at UNBOUNDED PRECEDING");
+    }
+    if ((over->frameOptions & FRAMEOPTION_END_UNBOUNDED_FOLLOWING) != 0) {
+      frame = WindowFrameType::PARTITION;
+    } else if ((over->frameOptions & FRAMEOPTION_END_CURRENT_ROW) != 0) {
+      frame = (over->frameOptions & FRAMEOPTION_ROWS) != 0 ? WindowFrameType::ROWS_TO_CURRENT
+                                                           : WindowFrameType::RANGE_TO_CURRENT;
+    } else {
+      throw NotImplementedException("window frames must end at CURRENT ROW or UNBOUNDED FOLLOWING");
+    }
+  }
+
+  return std::make_unique<BoundWindow>(std::move(function_name), std::move(args), std::move(partition_by),
+                                       std::move(order_bys), frame);
+}
+
 /**
  * @brief Get `BoundColumnRef` from the schema.
  */
@@ -697,6 +760,12 @@ auto Binder::ResolveColumn(const BoundTableRef &scope, const std::vector<std::st
     -> std::unique_ptr<BoundExpression> {
   BUSTUB_ASSERT(!scope.IsInvalid(), "invalid scope");
   auto expr = ResolveColumnInternal(scope, col_name);
+  // A column not found in a subquery may reference the enclosing queries (correlated subquery).
+  for (auto iter = outer_scopes_.rbegin(); !expr && iter != outer_scopes_.rend(); iter++) {
+    if (*iter != nullptr && !(*iter)->IsInvalid()) {
+      expr = ResolveColumnInternal(**iter, col_name);
+    }
+  }
   if (!expr) {
     throw bustub::Exception(fmt::format("column {} not found", fmt::join(col_name, ".")));
   }
@@ -719,6 +788,17 @@ auto Binder::BindAExpr(duckdb_libpgquery::PGAExpr *root) -> std::unique_ptr<Boun
   BUSTUB_ASSERT(root, "nullptr");
   auto name = std::string((reinterpret_cast<duckdb_libpgquery::PGValue *>(root->name->head->data.ptr_value))->val.str);
 
+  if (root->kind == duckdb_libpgquery::PG_AEXPR_BETWEEN) {
+    // `x BETWEEN a AND b` is bound as `x >= a AND x <= b`.
+    auto bounds = BindExpressionList(reinterpret_cast<duckdb_libpgquery::PGList *>(root->rexpr));
+    if (bounds.size() != 2) {
+      throw bustub::Exception("BETWEEN should have 2 bounds");
+    }
+    auto lower = std::make_unique<BoundBinaryOp>(">=", BindExpression(root->lexpr), std::move(bounds[0]));
+    auto upper = std::make_unique<BoundBinaryOp>("<=", BindExpression(root->lexpr), std::move(bounds[1]));
+    return std::make_unique<BoundBinaryOp>("and", std::move(lower), std::move(upper));
+  }
+
   if (root->kind != duckdb_libpgquery::PG_AEXPR_OP) {
     throw bustub::Exception("unsupported op in AExpr");
   }
@@ -777,6 +857,47 @@ auto Binder::BindBoolExpr(duckdb_libpgquery::PGBoolExpr *root) -> std::unique_pt
   UNREACHABLE("We should have handled all cases!");
 }
 
+auto Binder::BindSubLink(duckdb_libpgquery::PGSubLink *root) -> std::unique_ptr<BoundExpression> {
+  BUSTUB_ASSERT(root, "nullptr");
+  SubqueryType subquery_type;
+  std::unique_ptr<BoundExpression> child = nullptr;
+  switch (root->subLinkType) {
+    case duckdb_libpgquery::PG_EXISTS_SUBLINK:
+      subquery_type = SubqueryType::EXISTS;
+      break;
+    case duckdb_libpgquery::PG_ANY_SUBLINK:
+      // `x IN (SELECT ...)` has no operator name, `x = ANY (SELECT ...)` is the same thing.
+      if (root->operName != nullptr) {
+        auto op_name = std::string(
+            reinterpret_cast<duckdb_libpgquery::PGValue *>(root->operName->head->data.ptr_value)->val.str);
+        if (op_name != "=") {
+          throw NotImplementedException(fmt::format("{} ANY subquery is not supported", op_name));
+        }
+      }
+      subquery_type = SubqueryType::IN;
+      child = BindExpression(root->testexpr);
+      break;
+    default:
+      throw NotImplementedException("only IN and EXISTS subqueries are supported");
+  }
+
+  // The columns of the enclosing query are visible inside the subquery.
+  outer_scopes_.push_back(scope_);
+  std::unique_ptr<SelectStatement> subquery;
+  try {
+    subquery = BindSelect(reinterpret_cast<duckdb_libpgquery::PGSelectStmt *>(root->subselect));
+  } catch (...) {
+    outer_scopes_.pop_back();
+    throw;
+  }
+  outer_scopes_.pop_back();
+
+  if (subquery_type == SubqueryType::IN && subquery->select_list_.size() != 1) {
+    throw bustub::Exception("subquery of IN should return exactly one column");
+  }
+  return std::make_unique<BoundSubqueryExpr>(subquery_type, std::move(child), std::move(subquery));
+}
+
 auto Binder::BindExpression(duckdb_libpgquery::PGNode *node) -> std::unique_ptr<BoundExpression> {
   BUSTUB_ASSERT(node, "nullptr");
   switch (node->type) {
@@ -794,6 +915,10 @@ auto Binder::BindExpression(duckdb_libpgquery::PGNode *node) -> std::unique_ptr<
       return BindAExpr(reinterpret_cast<duckdb_libpgquery::PGAExpr *>(node));
     case duckdb_libpgquery::T_PGBoolExpr:
       return BindBoolExpr(reinterpret_cast<duckdb_libpgquery::PGBoolExpr *>(node));
+    case duckdb_libpgquery::T_PGParamRef:
+      return BindParamRef(reinterpret_cast<duckdb_libpgquery::PGParamRef *>(node));
+    case duckdb_libpgquery::T_PGSubLink:
+      return BindSubLink(reinterpret_cast<duckdb_libpgquery::PGSubLink *>(node));
     default:
       break;
   }
@@ -827,6 +952,9 @@ auto Binder::BindExplain(duckdb_libpgquery::PGExplainStmt *stmt) -> std::unique_
       if (strcmp(temp->defname, "schema") == 0 || strcmp(temp->defname, "s") == 0) {
         explain_options |= ExplainOptions::SCHEMA;
       }
+      if (strcmp(temp->defname, "analyze") == 0 || strcmp(temp->defname, "a") == 0) {
+        explain_options |= ExplainOptions::ANALYZE;
+      }
     }
   }
   return std::make_unique<ExplainStatement>(BindStatement(stmt->query), explain_options);
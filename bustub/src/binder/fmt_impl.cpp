@@ -1,5 +1,6 @@
 #include "binder/bound_order_by.h"
 #include "binder/expressions/bound_agg_call.h"
+#include "binder/expressions/bound_window.h"
 #include "binder/statement/select_statement.h"
 #include "binder/table_ref/bound_cte_ref.h"
 #include "binder/table_ref/bound_expression_list_ref.h"
@@ -17,6 +18,11 @@ auto BoundAggCall::ToString() const -> std::string {
   return fmt::format("{}({})", func_name_, args_);
 }
 
+auto BoundWindow::ToString() const -> std::string {
+  return fmt::format("{}({}) over (partition_by={}, order_by={}, frame={})", func_name_, args_, partition_by_,
+                     order_bys_, frame_);
+}
+
 auto BoundExpressionListRef::ToString() const -> std::string {
   return fmt::format("BoundExpressionListRef {{ identifier={}, values={} }}", identifier_, values_);
 }
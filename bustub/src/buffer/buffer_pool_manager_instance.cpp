@@ -24,6 +24,15 @@ namespace bustub {
 BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager, size_t replacer_k,
                                                      LogManager *log_manager)
     : pool_size_(pool_size), disk_manager_(disk_manager), log_manager_(log_manager) {
+  auto &metrics = MetricsRegistry::Instance();
+  metric_fetches_ = metrics.GetCounter("buffer_pool.fetches");
+  metric_misses_ = metrics.GetCounter("buffer_pool.misses");
+  metric_new_pages_ = metrics.GetCounter("buffer_pool.new_pages");
+  metric_evictions_ = metrics.GetCounter("buffer_pool.evictions");
+  metric_dirty_writebacks_ = metrics.GetCounter("buffer_pool.dirty_writebacks");
+  metric_no_free_frame_ = metrics.GetCounter("buffer_pool.no_free_frame");
+  metric_miss_latency_ = metrics.GetHistogram("buffer_pool.miss_latency");
+
   // we allocate a consecutive memory space for the buffer pool
   pages_ = new Page[pool_size_];
   page_table_ = new ExtendibleHashTable<page_id_t, frame_id_t>(bucket_size_);
@@ -60,8 +69,10 @@ auto BufferPoolManagerInstance::GetAvailableFrame(frame_id_t *out_frame_id)->boo
   // 但是如果所有页都不能剔除的话，那么只能返回false
   if(replacer_->Evict(out_frame_id)){
     // 2.1.如果剔除成功了，需要判断是否是脏页，脏页需要刷到磁盘中去
+    metric_evictions_->Add();
     if(pages_[*out_frame_id].is_dirty_){
       disk_manager_->WritePage(pages_[*out_frame_id].page_id_, pages_[*out_frame_id].GetData());
+      metric_dirty_writebacks_->Add();
     }
 
     // 2.2.需要将page_id_：frame_id_键值对从page_table_中删除
@@ -71,6 +82,7 @@ auto BufferPoolManagerInstance::GetAvailableFrame(frame_id_t *out_frame_id)->boo
 
 
   // 3.如果没有可以剔除的页，则直接返回false
+  metric_no_free_frame_->Add();
   return false;
 }
 
@@ -84,11 +96,12 @@ auto BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) -> Page * {
   if(GetAvailableFrame(&frame_id)){
     // 2.1.获取下一个要分配的页的页号
     *page_id = AllocatePage();
+    metric_new_pages_->Add();
 
     // 2.2.因为页的空间在一开始创建缓存池的时候就分配好了，因此只需要修改相关的信息就可以了，但是一定要将data进行清空
     pages_[frame_id].page_id_ = *page_id;
     pages_[frame_id].pin_count_ = 1;
-    pages_[frame_id].is_dirty_ = false;
+    pages_[frame_id].is_dirty_ = true; // 复用的页在磁盘上还是被释放之前的内容，标记为脏页，剔除的时候用清空后的内容覆盖掉
     pages_[frame_id].ResetMemory();
 
     // 2.3.需要将页的信息添加到映射表中，并添加访问记录和设置不可以被剔除掉
@@ -106,6 +119,8 @@ auto BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) -> Page * {
 auto BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) -> Page * {
   // 1.先加锁，注意直接加的锁是互斥锁，在调用GetAvailableFrame时不能够在这里函数里面继续加锁，不然会导致死锁
   std::scoped_lock<std::mutex> lock(latch_);
+  fetch_count_++;
+  metric_fetches_->Add();
 
   // 2.在缓存池中找到需要获取的页，如果则直接获取
   frame_id_t frame_id;
@@ -120,6 +135,9 @@ auto BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) -> Page * {
   }
 
   // 3.缓存池中没有，需要从磁盘中读，先要判断是否有可以替换的页，如果有可以替换的页
+  miss_count_++;
+  metric_misses_->Add();
+  ScopedMetricTimer miss_timer(metric_miss_latency_); // 记录未命中时换页和读盘的时间
   if(GetAvailableFrame(&frame_id)){
     // 3.1.重新设置页的信息，然后将data清空并从磁盘中读取页的信息
     pages_[frame_id].page_id_ = page_id;
@@ -219,7 +237,8 @@ auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
 
   // 2.找到这个页，如果没有这个页，则直接返回
   frame_id_t frame_id;
-  if(!page_table_->Find(page_id, frame_id)){ // 如果没有找到，则直接返回
+  if(!page_table_->Find(page_id, frame_id)){ // 如果没有找到，页只在磁盘上，直接释放
+    DeallocatePage(page_id);
     return true;
   }
 
@@ -243,9 +262,12 @@ auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
   return true; 
 }
 
-// 返回下一个即将被分配的页号，页号是持续不断增长的
+// 返回下一个即将被分配的页号，磁盘管理器优先复用被释放的页，没有的话在文件末尾分配新的页
 auto BufferPoolManagerInstance::AllocatePage() -> page_id_t {
   // 这里不能够加锁，因为这个函数一般都是被那些已经加锁了的函数调用，如果这里加锁，就直接导致死锁了
+  if(disk_manager_ != nullptr){
+    return disk_manager_->AllocatePage();
+  }
   return next_page_id_++; 
 }
 
@@ -61,10 +61,14 @@ void OutPutFile(){
     output_file.close();
 }
 
-LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k) : replacer_size_(num_frames), k_(k) {}
+LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k) : replacer_size_(num_frames), k_(k) {
+    metric_evict_failures_ = MetricsRegistry::Instance().GetCounter("replacer.evict_failures");
+    metric_evict_latency_ = MetricsRegistry::Instance().GetHistogram("replacer.evict_latency");
+}
 
 auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool { 
     std::scoped_lock<std::mutex> lock(latch_);
+    ScopedMetricTimer timer(metric_evict_latency_);
     bool is_find = false;
 
     // 先从hist_list_中查找，如果可以剔除的，需要再从cache_list_中寻找
@@ -96,6 +100,7 @@ auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
         return true;
     }
 
+    metric_evict_failures_->Add();
     return false; 
 }
 
@@ -0,0 +1,397 @@
+#include "catalog/catalog.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "storage/page/header_page.h"
+#include "storage/table/table_iterator.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * The system tables. Their first page ids are recorded in the header page under their names.
+ *
+ * __tables(oid, name, first_page_id, row_count): one row per table.
+ * __columns(table_oid, col_idx, name, type, length, scale): one row per column of each table, `length` is the precision
+ *   of a FIXED_DECIMAL column.
+ * __indexes(oid, name, table_oid, key_attrs, key_size): one row per index, `key_attrs` is like "0,2".
+ * __statistics(table_oid, col_idx, kind, seq, number, value): the column statistics of the analyzed tables, `kind`
+ *   is one of `StatisticsKind`. `value` is a value of the column serialized with `Value::SerializeTo`.
+ */
+const char *const SYS_TABLES = "__tables";
+const char *const SYS_COLUMNS = "__columns";
+const char *const SYS_INDEXES = "__indexes";
+const char *const SYS_STATISTICS = "__statistics";
+
+/** The maximum length of the names in the system tables */
+constexpr uint32_t SYS_NAME_LENGTH = 128;
+
+enum class StatisticsKind : int32_t {
+  NULL_FRAC = 0, /**< number = the fraction of NULLs */
+  NDV = 1,       /**< number = the number of distinct values */
+  MCV = 2,       /**< the seq-th most common value, number = its frequency */
+  BOUND = 3,     /**< the seq-th bound of the histogram */
+};
+
+auto TablesSchema() -> const Schema & {
+  static const Schema SCHEMA{std::vector<Column>{{"oid", TypeId::INTEGER},
+                                                 {"name", TypeId::VARCHAR, SYS_NAME_LENGTH},
+                                                 {"first_page_id", TypeId::INTEGER},
+                                                 {"row_count", TypeId::BIGINT}}};
+  return SCHEMA;
+}
+
+auto ColumnsSchema() -> const Schema & {
+  static const Schema SCHEMA{std::vector<Column>{{"table_oid", TypeId::INTEGER},
+                                                 {"col_idx", TypeId::INTEGER},
+                                                 {"name", TypeId::VARCHAR, SYS_NAME_LENGTH},
+                                                 {"type", TypeId::INTEGER},
+                                                 {"length", TypeId::INTEGER},
+                                                 {"scale", TypeId::INTEGER}}};
+  return SCHEMA;
+}
+
+auto IndexesSchema() -> const Schema & {
+  static const Schema SCHEMA{std::vector<Column>{{"oid", TypeId::INTEGER},
+                                                 {"name", TypeId::VARCHAR, SYS_NAME_LENGTH},
+                                                 {"table_oid", TypeId::INTEGER},
+                                                 {"key_attrs", TypeId::VARCHAR, SYS_NAME_LENGTH},
+                                                 {"key_size", TypeId::INTEGER}}};
+  return SCHEMA;
+}
+
+auto StatisticsSchema() -> const Schema & {
+  static const Schema SCHEMA{std::vector<Column>{{"table_oid", TypeId::INTEGER},
+                                                 {"col_idx", TypeId::INTEGER},
+                                                 {"kind", TypeId::INTEGER},
+                                                 {"seq", TypeId::INTEGER},
+                                                 {"number", TypeId::DECIMAL},
+                                                 {"value", TypeId::VARCHAR, BUSTUB_PAGE_SIZE}}};
+  return SCHEMA;
+}
+
+auto TableRow(const TableInfo &table_info) -> Tuple {
+  std::vector<Value> values{ValueFactory::GetIntegerValue(static_cast<int32_t>(table_info.oid_)),
+                            ValueFactory::GetVarcharValue(table_info.name_),
+                            ValueFactory::GetIntegerValue(table_info.table_->GetFirstPageId()),
+                            ValueFactory::GetBigIntValue(static_cast<int64_t>(table_info.stats_->GetRowCount()))};
+  return {values, &TablesSchema()};
+}
+
+auto StatisticsRow(table_oid_t table_oid, uint32_t col_idx, StatisticsKind kind, size_t seq, double number,
+                   const Value *value) -> Tuple {
+  std::vector<char> data;
+  if (value != nullptr) {
+    data.resize(value->GetTypeId() == TypeId::VARCHAR ? sizeof(uint32_t) + value->GetLength()
+                                                      : Type::GetTypeSize(value->GetTypeId()));
+    value->SerializeTo(data.data());
+  }
+  std::vector<Value> values{ValueFactory::GetIntegerValue(static_cast<int32_t>(table_oid)),
+                            ValueFactory::GetIntegerValue(static_cast<int32_t>(col_idx)),
+                            ValueFactory::GetIntegerValue(static_cast<int32_t>(kind)),
+                            ValueFactory::GetIntegerValue(static_cast<int32_t>(seq)),
+                            ValueFactory::GetDecimalValue(number),
+                            ValueFactory::GetVarcharValue(data.data(), data.size(), true)};
+  return {values, &StatisticsSchema()};
+}
+
+/** Create the B+ tree index of the key size, and reopen it from its root page id recorded in the header page */
+template <size_t KeySize>
+auto ReopenIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *bpm) -> std::unique_ptr<Index> {
+  auto index =
+      std::make_unique<BPlusTreeIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>>>(std::move(metadata), bpm);
+  index->Reopen();
+  return index;
+}
+
+}  // namespace
+
+auto Catalog::OpenSystemTable(Transaction *txn, const std::string &name, bool create) -> std::unique_ptr<TableHeap> {
+  auto *header_page = static_cast<HeaderPage *>(bpm_->FetchPage(HEADER_PAGE_ID));
+  if (header_page == nullptr) {
+    throw Exception("failed to fetch the header page");
+  }
+  std::unique_ptr<TableHeap> heap;
+  if (create) {
+    heap = std::make_unique<TableHeap>(bpm_, lock_manager_, log_manager_, txn);
+    header_page->InsertRecord(name, heap->GetFirstPageId());
+  } else {
+    page_id_t first_page_id;
+    if (header_page->GetRootId(name, &first_page_id)) {
+      heap = std::make_unique<TableHeap>(bpm_, lock_manager_, log_manager_, first_page_id);
+    }
+  }
+  bpm_->UnpinPage(HEADER_PAGE_ID, create);
+  if (heap == nullptr) {
+    throw Exception(fmt::format("system table {} not found in the header page", name));
+  }
+  return heap;
+}
+
+void Catalog::Bootstrap(Transaction *txn) {
+  page_id_t header_page_id;
+  auto *header_page = static_cast<HeaderPage *>(bpm_->NewPage(&header_page_id));
+  if (header_page == nullptr || header_page_id != HEADER_PAGE_ID) {
+    throw Exception("the header page must be the first page of a new database file");
+  }
+  header_page->Init();
+  bpm_->UnpinPage(HEADER_PAGE_ID, true);
+
+  sys_tables_ = OpenSystemTable(txn, SYS_TABLES, true);
+  sys_columns_ = OpenSystemTable(txn, SYS_COLUMNS, true);
+  sys_indexes_ = OpenSystemTable(txn, SYS_INDEXES, true);
+  sys_statistics_ = OpenSystemTable(txn, SYS_STATISTICS, true);
+}
+
+void Catalog::Load(Transaction *txn) {
+  sys_tables_ = OpenSystemTable(txn, SYS_TABLES, false);
+  sys_columns_ = OpenSystemTable(txn, SYS_COLUMNS, false);
+  sys_indexes_ = OpenSystemTable(txn, SYS_INDEXES, false);
+  sys_statistics_ = OpenSystemTable(txn, SYS_STATISTICS, false);
+
+  // 1. The columns of every table, ordered by their index in the table.
+  std::unordered_map<table_oid_t, std::map<uint32_t, Column>> columns;
+  const auto &columns_schema = ColumnsSchema();
+  for (auto iter = sys_columns_->Begin(txn); iter != sys_columns_->End(); ++iter) {
+    auto table_oid = static_cast<table_oid_t>(iter->GetValue(&columns_schema, 0).GetAs<int32_t>());
+    auto col_idx = static_cast<uint32_t>(iter->GetValue(&columns_schema, 1).GetAs<int32_t>());
+    auto name = iter->GetValue(&columns_schema, 2).ToString();
+    auto type = static_cast<TypeId>(iter->GetValue(&columns_schema, 3).GetAs<int32_t>());
+    auto length = static_cast<uint32_t>(iter->GetValue(&columns_schema, 4).GetAs<int32_t>());
+    auto scale = static_cast<uint8_t>(iter->GetValue(&columns_schema, 5).GetAs<int32_t>());
+    if (type == TypeId::VARCHAR) {
+      columns[table_oid].emplace(col_idx, Column(name, type, length));
+    } else if (type == TypeId::FIXED_DECIMAL && length != 0) {
+      columns[table_oid].emplace(col_idx, Column(name, type, static_cast<uint8_t>(length), scale));
+    } else {
+      columns[table_oid].emplace(col_idx, Column(name, type));
+    }
+  }
+
+  // 2. The tables, with their heaps opened from the first page id.
+  const auto &tables_schema = TablesSchema();
+  for (auto iter = sys_tables_->Begin(txn); iter != sys_tables_->End(); ++iter) {
+    auto table_oid = static_cast<table_oid_t>(iter->GetValue(&tables_schema, 0).GetAs<int32_t>());
+    auto name = iter->GetValue(&tables_schema, 1).ToString();
+    auto first_page_id = iter->GetValue(&tables_schema, 2).GetAs<int32_t>();
+    auto row_count = iter->GetValue(&tables_schema, 3).GetAs<int64_t>();
+
+    std::vector<Column> table_columns;
+    for (auto &[_, column] : columns[table_oid]) {
+      table_columns.push_back(std::move(column));
+    }
+    auto heap = std::make_unique<TableHeap>(bpm_, lock_manager_, log_manager_, first_page_id);
+    auto meta = std::make_unique<TableInfo>(Schema(table_columns), name, std::move(heap), table_oid);
+    meta->stats_->Restore(static_cast<size_t>(std::max<int64_t>(row_count, 0)), {});
+
+    tables_.emplace(table_oid, std::move(meta));
+    table_names_.emplace(name, table_oid);
+    index_names_.emplace(name, std::unordered_map<std::string, index_oid_t>{});
+    table_rids_.emplace(table_oid, iter->GetRid());
+    next_table_oid_ = std::max(next_table_oid_.load(), table_oid + 1);
+  }
+
+  // 3. The column statistics of the analyzed tables.
+  struct ColumnStatisticsRows {
+    double null_frac_{0};
+    double ndv_{0};
+    std::map<size_t, std::pair<Value, double>> mcv_;
+    std::map<size_t, Value> bounds_;
+  };
+  std::unordered_map<table_oid_t, std::map<uint32_t, ColumnStatisticsRows>> statistics;
+  const auto &statistics_schema = StatisticsSchema();
+  for (auto iter = sys_statistics_->Begin(txn); iter != sys_statistics_->End(); ++iter) {
+    auto table_oid = static_cast<table_oid_t>(iter->GetValue(&statistics_schema, 0).GetAs<int32_t>());
+    auto col_idx = static_cast<uint32_t>(iter->GetValue(&statistics_schema, 1).GetAs<int32_t>());
+    auto kind = static_cast<StatisticsKind>(iter->GetValue(&statistics_schema, 2).GetAs<int32_t>());
+    auto seq = static_cast<size_t>(iter->GetValue(&statistics_schema, 3).GetAs<int32_t>());
+    auto number = iter->GetValue(&statistics_schema, 4).GetAs<double>();
+    auto *table_info = GetTable(table_oid);
+    if (table_info == NULL_TABLE_INFO || col_idx >= table_info->schema_.GetColumnCount()) {
+      continue;
+    }
+    auto &rows = statistics[table_oid][col_idx];
+    switch (kind) {
+      case StatisticsKind::NULL_FRAC:
+        rows.null_frac_ = number;
+        break;
+      case StatisticsKind::NDV:
+        rows.ndv_ = number;
+        break;
+      case StatisticsKind::MCV:
+      case StatisticsKind::BOUND: {
+        auto data = iter->GetValue(&statistics_schema, 5);
+        auto value = Value::DeserializeFrom(data.GetData(), table_info->schema_.GetColumn(col_idx).GetType());
+        if (kind == StatisticsKind::MCV) {
+          rows.mcv_.emplace(seq, std::make_pair(std::move(value), number));
+        } else {
+          rows.bounds_.emplace(seq, std::move(value));
+        }
+        break;
+      }
+    }
+  }
+  for (auto &[table_oid, table_rows] : statistics) {
+    auto *table_info = GetTable(table_oid);
+    if (table_rows.size() != table_info->schema_.GetColumnCount()) {
+      continue;
+    }
+    std::vector<ColumnStatistics> column_statistics;
+    for (auto &[_, rows] : table_rows) {
+      std::vector<std::pair<Value, double>> mcv;
+      for (auto &[_, value] : rows.mcv_) {
+        mcv.push_back(std::move(value));
+      }
+      std::vector<Value> bounds;
+      for (auto &[_, value] : rows.bounds_) {
+        bounds.push_back(std::move(value));
+      }
+      column_statistics.emplace_back(rows.null_frac_, rows.ndv_, std::move(mcv), std::move(bounds));
+    }
+    table_info->stats_->Restore(table_info->stats_->GetRowCount(), std::move(column_statistics));
+  }
+
+  // 4. The indexes, with their B+ trees opened from the root page id recorded in the header page.
+  const auto &indexes_schema = IndexesSchema();
+  for (auto iter = sys_indexes_->Begin(txn); iter != sys_indexes_->End(); ++iter) {
+    auto index_oid = static_cast<index_oid_t>(iter->GetValue(&indexes_schema, 0).GetAs<int32_t>());
+    auto name = iter->GetValue(&indexes_schema, 1).ToString();
+    auto table_oid = static_cast<table_oid_t>(iter->GetValue(&indexes_schema, 2).GetAs<int32_t>());
+    auto key_attrs_str = iter->GetValue(&indexes_schema, 3).ToString();
+    auto key_size = static_cast<size_t>(iter->GetValue(&indexes_schema, 4).GetAs<int32_t>());
+    auto *table_info = GetTable(table_oid);
+    BUSTUB_ASSERT(table_info != NULL_TABLE_INFO, "Broken Invariant");
+
+    std::vector<uint32_t> key_attrs;
+    for (const auto &attr : StringUtil::Split(key_attrs_str, ',')) {
+      key_attrs.push_back(static_cast<uint32_t>(std::stoul(attr)));
+    }
+    auto key_schema = Schema::CopySchema(&table_info->schema_, key_attrs);
+    auto meta = std::make_unique<IndexMetadata>(name, table_info->name_, &table_info->schema_, key_attrs);
+    std::unique_ptr<Index> index;
+    switch (key_size) {
+      case 4:
+        index = ReopenIndex<4>(std::move(meta), bpm_);
+        break;
+      case 8:
+        index = ReopenIndex<8>(std::move(meta), bpm_);
+        break;
+      case 16:
+        index = ReopenIndex<16>(std::move(meta), bpm_);
+        break;
+      case 32:
+        index = ReopenIndex<32>(std::move(meta), bpm_);
+        break;
+      case 64:
+        index = ReopenIndex<64>(std::move(meta), bpm_);
+        break;
+      default:
+        throw Exception(fmt::format("index {} has an unsupported key size {}", name, key_size));
+    }
+
+    indexes_.emplace(index_oid, std::make_unique<IndexInfo>(key_schema, name, std::move(index), index_oid,
+                                                            table_info->name_, key_size));
+    index_names_[table_info->name_].emplace(name, index_oid);
+    next_index_oid_ = std::max(next_index_oid_.load(), index_oid + 1);
+  }
+
+  version_.fetch_add(1);
+}
+
+void Catalog::PersistTable(Transaction *txn, const TableInfo &table_info) {
+  RID rid;
+  if (!sys_tables_->InsertTuple(TableRow(table_info), &rid, txn)) {
+    throw Exception(fmt::format("failed to persist table {}", table_info.name_));
+  }
+  table_rids_.emplace(table_info.oid_, rid);
+
+  const auto &columns_schema = ColumnsSchema();
+  for (uint32_t i = 0; i < table_info.schema_.GetColumnCount(); i++) {
+    const auto &column = table_info.schema_.GetColumn(i);
+    std::vector<Value> values{ValueFactory::GetIntegerValue(static_cast<int32_t>(table_info.oid_)),
+                              ValueFactory::GetIntegerValue(static_cast<int32_t>(i)),
+                              ValueFactory::GetVarcharValue(column.GetName()),
+                              ValueFactory::GetIntegerValue(static_cast<int32_t>(column.GetType())),
+                              ValueFactory::GetIntegerValue(static_cast<int32_t>(
+                                  column.GetType() == TypeId::FIXED_DECIMAL ? column.GetPrecision()
+                                                                            : column.GetVariableLength())),
+                              ValueFactory::GetIntegerValue(static_cast<int32_t>(column.GetScale()))};
+    RID column_rid;
+    if (!sys_columns_->InsertTuple(Tuple(values, &columns_schema), &column_rid, txn)) {
+      throw Exception(fmt::format("failed to persist table {}", table_info.name_));
+    }
+  }
+}
+
+void Catalog::PersistIndex(Transaction *txn, const IndexInfo &index_info, table_oid_t table_oid,
+                           const std::vector<uint32_t> &key_attrs) {
+  std::vector<std::string> attrs;
+  attrs.reserve(key_attrs.size());
+  for (auto attr : key_attrs) {
+    attrs.push_back(std::to_string(attr));
+  }
+  std::vector<Value> values{ValueFactory::GetIntegerValue(static_cast<int32_t>(index_info.index_oid_)),
+                            ValueFactory::GetVarcharValue(index_info.name_),
+                            ValueFactory::GetIntegerValue(static_cast<int32_t>(table_oid)),
+                            ValueFactory::GetVarcharValue(StringUtil::Join(attrs, ",")),
+                            ValueFactory::GetIntegerValue(static_cast<int32_t>(index_info.key_size_))};
+  RID rid;
+  if (!sys_indexes_->InsertTuple(Tuple(values, &IndexesSchema()), &rid, txn)) {
+    throw Exception(fmt::format("failed to persist index {}", index_info.name_));
+  }
+}
+
+void Catalog::PersistStatistics(Transaction *txn, const TableInfo &table_info) {
+  // The rows of the previous ANALYZE are deleted when the transaction commits.
+  const auto &statistics_schema = StatisticsSchema();
+  std::vector<RID> old_rids;
+  for (auto iter = sys_statistics_->Begin(txn); iter != sys_statistics_->End(); ++iter) {
+    if (static_cast<table_oid_t>(iter->GetValue(&statistics_schema, 0).GetAs<int32_t>()) == table_info.oid_) {
+      old_rids.push_back(iter->GetRid());
+    }
+  }
+  for (const auto &rid : old_rids) {
+    sys_statistics_->MarkDelete(rid, txn);
+  }
+
+  std::vector<Tuple> rows;
+  for (uint32_t i = 0; i < table_info.schema_.GetColumnCount(); i++) {
+    const auto *column_statistics = table_info.stats_->GetColumnStatistics(i);
+    if (column_statistics == nullptr) {
+      return;
+    }
+    rows.push_back(
+        StatisticsRow(table_info.oid_, i, StatisticsKind::NULL_FRAC, 0, column_statistics->NullFraction(), nullptr));
+    rows.push_back(StatisticsRow(table_info.oid_, i, StatisticsKind::NDV, 0, column_statistics->DistinctCount(), nullptr));
+    const auto &mcv = column_statistics->MostCommonValues();
+    for (size_t j = 0; j < mcv.size(); j++) {
+      rows.push_back(StatisticsRow(table_info.oid_, i, StatisticsKind::MCV, j, mcv[j].second, &mcv[j].first));
+    }
+    const auto &bounds = column_statistics->HistogramBounds();
+    for (size_t j = 0; j < bounds.size(); j++) {
+      rows.push_back(StatisticsRow(table_info.oid_, i, StatisticsKind::BOUND, j, 0, &bounds[j]));
+    }
+  }
+  for (const auto &row : rows) {
+    RID rid;
+    if (!sys_statistics_->InsertTuple(row, &rid, txn)) {
+      throw Exception(fmt::format("failed to persist the statistics of table {}", table_info.name_));
+    }
+  }
+}
+
+void Catalog::SaveRowCounts(Transaction *txn) {
+  for (const auto &[table_oid, rid] : table_rids_) {
+    sys_tables_->UpdateTuple(TableRow(*GetTable(table_oid)), rid, txn);
+  }
+}
+
+}  // namespace bustub
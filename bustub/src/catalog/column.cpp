@@ -21,6 +21,9 @@ auto Column::ToString(bool simplified) const -> std::string {
   if (simplified) {
     std::ostringstream os;
     os << column_name_ << ":" << Type::TypeIdToString(column_type_);
+    if (precision_ != 0) {
+      os << "(" << static_cast<int>(precision_) << "," << static_cast<int>(scale_) << ")";
+    }
     return (os.str());
   }
 
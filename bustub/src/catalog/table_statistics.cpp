@@ -0,0 +1,192 @@
+#include "catalog/table_statistics.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "storage/table/table_heap.h"
+#include "type/type_id.h"
+
+namespace bustub {
+
+namespace {
+
+auto ValueLess(const Value &a, const Value &b) -> bool { return a.CompareLessThan(b) == CmpBool::CmpTrue; }
+
+auto ValueEqual(const Value &a, const Value &b) -> bool { return a.CompareEquals(b) == CmpBool::CmpTrue; }
+
+/** @return the value as a double if it has a numeric type, used to interpolate within a histogram bucket */
+auto NumericValue(const Value &val) -> std::optional<double> {
+  switch (val.GetTypeId()) {
+    case TypeId::TINYINT:
+      return val.GetAs<int8_t>();
+    case TypeId::SMALLINT:
+      return val.GetAs<int16_t>();
+    case TypeId::INTEGER:
+      return val.GetAs<int32_t>();
+    case TypeId::BIGINT:
+      return static_cast<double>(val.GetAs<int64_t>());
+    case TypeId::DECIMAL:
+      return val.GetAs<double>();
+    case TypeId::FIXED_DECIMAL:
+      return val.CastAs(TypeId::DECIMAL).GetAs<double>();
+    case TypeId::TIMESTAMP:
+      return static_cast<double>(val.GetAs<uint64_t>());
+    default:
+      return std::nullopt;
+  }
+}
+
+auto Clamp(double selectivity) -> double { return std::min(1.0, std::max(0.0, selectivity)); }
+
+}  // namespace
+
+auto ColumnStatistics::EstimateEqualSelectivity(const Value &val) const -> double {
+  if (val.IsNull()) {
+    return 0;
+  }
+  double mcv_total = 0;
+  for (const auto &[mcv, freq] : mcv_) {
+    if (mcv.CheckComparable(val) && ValueEqual(mcv, val)) {
+      return freq;
+    }
+    mcv_total += freq;
+  }
+  // Not a common value: spread the remaining rows evenly over the remaining distinct values.
+  double remaining_ndv = ndv_ - static_cast<double>(mcv_.size());
+  if (remaining_ndv < 1) {
+    return mcv_.empty() ? DEFAULT_EQ_SELECTIVITY : 0;
+  }
+  return Clamp((1.0 - null_frac_ - mcv_total) / remaining_ndv);
+}
+
+auto ColumnStatistics::HistogramFraction(const Value &val) const -> double {
+  if (bounds_.size() < 2) {
+    return 0.5;
+  }
+  if (!ValueLess(bounds_.front(), val)) {
+    return 0;
+  }
+  if (!ValueLess(val, bounds_.back())) {
+    return 1;
+  }
+  // bounds_[bucket] < val <= bounds_[bucket + 1]
+  auto it = std::lower_bound(bounds_.begin(), bounds_.end(), val, ValueLess);
+  auto bucket = static_cast<size_t>(it - bounds_.begin()) - 1;
+  double within = 0.5;
+  auto lo = NumericValue(bounds_[bucket]);
+  auto hi = NumericValue(bounds_[bucket + 1]);
+  auto v = NumericValue(val);
+  if (lo.has_value() && hi.has_value() && v.has_value() && *hi > *lo) {
+    within = (*v - *lo) / (*hi - *lo);
+  }
+  auto buckets = static_cast<double>(bounds_.size() - 1);
+  return Clamp((static_cast<double>(bucket) + within) / buckets);
+}
+
+auto ColumnStatistics::EstimateLessThanSelectivity(const Value &val, bool or_equal) const -> double {
+  if (val.IsNull() || (!bounds_.empty() && !bounds_.front().CheckComparable(val))) {
+    return DEFAULT_RANGE_SELECTIVITY;
+  }
+  double selectivity = HistogramFraction(val) * (1.0 - null_frac_);
+  if (or_equal) {
+    selectivity += EstimateEqualSelectivity(val);
+  }
+  return Clamp(selectivity);
+}
+
+auto ColumnStatistics::EstimateRangeSelectivity(const std::optional<Value> &lower, bool lower_inclusive,
+                                                const std::optional<Value> &upper, bool upper_inclusive) const
+    -> double {
+  double hi = upper.has_value() ? EstimateLessThanSelectivity(*upper, upper_inclusive) : 1.0 - null_frac_;
+  double lo = lower.has_value() ? EstimateLessThanSelectivity(*lower, !lower_inclusive) : 0.0;
+  return Clamp(hi - lo);
+}
+
+void TableStatistics::Analyze(TableHeap *heap, const Schema &schema, Transaction *txn, size_t sample_size) {
+  const auto column_count = schema.GetColumnCount();
+  std::vector<HyperLogLog> sketches(column_count);
+  std::vector<size_t> null_counts(column_count, 0);
+  std::vector<std::vector<Value>> samples(column_count);
+
+  // 1.全表扫描：精确统计行数，用HyperLogLog估计每一列的NDV，同时做蓄水池采样
+  std::mt19937_64 rng(15445);
+  size_t rows = 0;
+  for (auto iter = heap->Begin(txn); iter != heap->End(); ++iter) {
+    const auto &tuple = *iter;
+    size_t slot = rows;
+    if (rows >= sample_size) {
+      slot = std::uniform_int_distribution<size_t>(0, rows)(rng);
+    }
+    for (uint32_t i = 0; i < column_count; i++) {
+      auto val = tuple.GetValue(&schema, i);
+      if (val.IsNull()) {
+        null_counts[i]++;
+      } else {
+        sketches[i].AddValue(val);
+      }
+      if (slot < sample_size) {
+        if (rows < sample_size) {
+          samples[i].emplace_back(std::move(val));
+        } else {
+          samples[i][slot] = std::move(val);
+        }
+      }
+    }
+    rows++;
+  }
+
+  // 2.根据采样结果为每一列构建等深直方图和MCV
+  std::vector<ColumnStatistics> columns(column_count);
+  for (uint32_t i = 0; i < column_count; i++) {
+    auto &col = columns[i];
+    if (rows == 0) {
+      continue;
+    }
+    col.null_frac_ = static_cast<double>(null_counts[i]) / static_cast<double>(rows);
+    col.ndv_ = std::min(sketches[i].Estimate(), static_cast<double>(rows - null_counts[i]));
+
+    auto &sample = samples[i];
+    sample.erase(std::remove_if(sample.begin(), sample.end(), [](const Value &v) { return v.IsNull(); }),
+                 sample.end());
+    if (sample.empty()) {
+      continue;
+    }
+    std::sort(sample.begin(), sample.end(), ValueLess);
+    const auto non_null_frac = 1.0 - col.null_frac_;
+    const auto sample_cnt = static_cast<double>(sample.size());
+
+    // 2.1.MCV：只保留出现次数明显高于平均值的那些值，如果不同值的个数很少则全部保留
+    std::vector<std::pair<size_t, size_t>> runs;  // (run length, run start)
+    for (size_t start = 0; start < sample.size();) {
+      size_t end = start + 1;
+      while (end < sample.size() && ValueEqual(sample[start], sample[end])) {
+        end++;
+      }
+      runs.emplace_back(end - start, start);
+      start = end;
+    }
+    std::sort(runs.begin(), runs.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+    const double avg_run = sample_cnt / static_cast<double>(runs.size());
+    const bool keep_all = runs.size() <= STATISTICS_MCV_COUNT;
+    for (const auto &[len, start] : runs) {
+      if (col.mcv_.size() >= STATISTICS_MCV_COUNT || len < 2 ||
+          (!keep_all && static_cast<double>(len) <= 1.25 * avg_run)) {
+        break;
+      }
+      col.mcv_.emplace_back(sample[start], static_cast<double>(len) / sample_cnt * non_null_frac);
+    }
+
+    // 2.2.等深直方图：每个桶包含相同数量的采样值
+    const auto buckets = std::min(STATISTICS_HISTOGRAM_BUCKETS, sample.size());
+    for (size_t b = 0; b <= buckets; b++) {
+      col.bounds_.push_back(sample[b * (sample.size() - 1) / buckets]);
+    }
+  }
+
+  columns_ = std::move(columns);
+  row_count_.store(static_cast<int64_t>(rows));
+  analyzed_ = true;
+}
+
+}  // namespace bustub
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <chrono>  // NOLINT
 #include <optional>
 #include <shared_mutex>
 #include <string>
@@ -6,9 +8,11 @@
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
+#include "binder/statement/analyze_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/index_statement.h"
+#include "binder/statement/prepare_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
 #include "buffer/buffer_pool_manager_instance.h"
@@ -17,6 +21,7 @@
 #include "common/bustub_instance.h"
 #include "common/enums/statement_type.h"
 #include "common/exception.h"
+#include "common/metrics.h"
 #include "common/util/string_util.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
@@ -41,7 +46,7 @@ auto BustubInstance::MakeExecutorContext(Transaction *txn) -> std::unique_ptr<Ex
   return std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_);
 }
 
-BustubInstance::BustubInstance(const std::string &db_file_name) {
+BustubInstance::BustubInstance(const std::string &db_file_name, size_t bpm_size) {
   // TODO(chi): revisit this when designing the recovery project.
 
   enable_logging = false;
@@ -52,10 +57,10 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
   // Log related.
   log_manager_ = new LogManager(disk_manager_);
 
-  // We need more frames for GenerateTestTable to work. Therefore, we use 128 instead of the default
+  // We need more frames for GenerateTestTable to work. Therefore, we use 128 by default instead of the default
   // buffer pool size specified in `config.h`.
   try {
-    buffer_pool_manager_ = new BufferPoolManagerInstance(128, disk_manager_, LRUK_REPLACER_K, log_manager_);
+    buffer_pool_manager_ = new BufferPoolManagerInstance(bpm_size, disk_manager_, LRUK_REPLACER_K, log_manager_);
   } catch (NotImplementedException &e) {
     std::cerr << "BufferPoolManager is not implemented, only mock tables are supported." << std::endl;
     buffer_pool_manager_ = nullptr;
@@ -70,6 +75,17 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
 
   // Catalog.
   catalog_ = new Catalog(buffer_pool_manager_, lock_manager_, log_manager_);
+  if (buffer_pool_manager_ != nullptr) {
+    // A new database file gets the header page and the system tables, an existing one has its catalog loaded.
+    auto txn = txn_manager_->Begin();
+    if (disk_manager_->GetNumPages() == 0) {
+      catalog_->Bootstrap(txn);
+    } else {
+      catalog_->Load(txn);
+    }
+    txn_manager_->Commit(txn);
+    delete txn;
+  }
 
   // Execution engine.
   execution_engine_ = new ExecutionEngine(buffer_pool_manager_, txn_manager_, catalog_);
@@ -116,6 +132,37 @@ void BustubInstance::CmdDisplayIndices(ResultWriter &writer) {
   writer.EndTable();
 }
 
+void BustubInstance::CmdDisplayMetrics(ResultWriter &writer) {
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("metric");
+  writer.WriteHeaderCell("value");
+  writer.EndHeader();
+  for (const auto &[name, value] : MetricsRegistry::Instance().Snapshot()) {
+    writer.BeginRow();
+    writer.WriteCell(name);
+    writer.WriteCell(value);
+    writer.EndRow();
+  }
+  writer.EndTable();
+}
+
+void BustubInstance::CmdVacuum(ResultWriter &writer) {
+  auto released_pages = disk_manager_->ShrinkFile();
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("released_pages");
+  writer.WriteHeaderCell("file_pages");
+  writer.WriteHeaderCell("free_pages");
+  writer.EndHeader();
+  writer.BeginRow();
+  writer.WriteCell(fmt::format("{}", released_pages));
+  writer.WriteCell(fmt::format("{}", disk_manager_->GetNumPages()));
+  writer.WriteCell(fmt::format("{}", disk_manager_->GetNumFreePages()));
+  writer.EndRow();
+  writer.EndTable();
+}
+
 void BustubInstance::WriteOneCell(const std::string &cell, ResultWriter &writer) {
   writer.BeginTable(true);
   writer.BeginRow();
@@ -129,6 +176,8 @@ void BustubInstance::CmdDisplayHelp(ResultWriter &writer) {
 
 \dt: show all tables
 \di: show all indices
+SHOW METRICS: show the buffer pool, lock, log, transaction and executor metrics
+VACUUM: give the free pages at the end of the database file back to the OS
 \help: show this message again
 
 BusTub shell currently only supports a small set of Postgres queries. We'll set
@@ -167,6 +216,16 @@ void BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
     throw Exception(fmt::format("unsupported internal command: {}", sql));
   }
 
+  // Statements seen before skip parsing, binding, planning and optimizing.
+  std::string cache_key;
+  if (IsPlanCacheEnabled()) {
+    cache_key = fmt::format("{}|{}", IsForceStarterRule(), PlanCache::NormalizeSql(sql));
+    if (auto plan = plan_cache_.Get(cache_key, catalog_->GetVersion()); plan != nullptr) {
+      ExecutePlan(*plan, {}, writer, txn);
+      return;
+    }
+  }
+
   std::shared_lock<std::shared_mutex> l(catalog_lock_);
   bustub::Binder binder(*catalog_);
   binder.ParseAndSave(sql);
@@ -199,15 +258,22 @@ void BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
             throw NotImplementedException("only support creating index on integer column");
           }
         }
-        if (col_ids.size() != 1) {
-          throw NotImplementedException("only support creating index with exactly one column");
+        if (col_ids.empty() || col_ids.size() > 2) {
+          throw NotImplementedException("only support creating index with one or two columns");
         }
         auto key_schema = Schema::CopySchema(&index_stmt.table_->schema_, col_ids);
 
         std::unique_lock<std::shared_mutex> l(catalog_lock_);
-        auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
-            txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
-            INTEGER_SIZE, IntegerHashFunctionType{});
+        IndexInfo *info;
+        if (col_ids.size() == 1) {
+          info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              INTEGER_SIZE, IntegerHashFunctionType{});
+        } else {
+          info = catalog_->CreateIndex<TwoIntegerKeyType, IntegerValueType, TwoIntegerComparatorType>(
+              txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
+              TWO_INTEGER_SIZE, TwoIntegerHashFunctionType{});
+        }
         l.unlock();
 
         if (info == nullptr) {
@@ -216,8 +282,48 @@ void BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         WriteOneCell(fmt::format("Index created with id = {}", info->index_oid_), writer);
         continue;
       }
+      case StatementType::ANALYZE_STATEMENT: {
+        const auto &analyze_stmt = dynamic_cast<const AnalyzeStatement &>(*statement);
+        if (analyze_stmt.vacuum_) {
+          CmdVacuum(writer);
+          continue;
+        }
+
+        std::unique_lock<std::shared_mutex> l(catalog_lock_);
+        std::vector<std::string> table_names;
+        if (analyze_stmt.table_.has_value()) {
+          table_names.push_back(*analyze_stmt.table_);
+        } else {
+          table_names = catalog_->GetTableNames();
+          std::sort(table_names.begin(), table_names.end());
+        }
+
+        writer.BeginTable(false);
+        writer.BeginHeader();
+        writer.WriteHeaderCell("table_name");
+        writer.WriteHeaderCell("row_count");
+        writer.EndHeader();
+        for (const auto &table_name : table_names) {
+          // Mock tables don't have a table heap, skip them.
+          const auto *stats = catalog_->AnalyzeTable(txn, table_name);
+          if (stats == nullptr) {
+            continue;
+          }
+          writer.BeginRow();
+          writer.WriteCell(table_name);
+          writer.WriteCell(fmt::format("{}", stats->GetRowCount()));
+          writer.EndRow();
+        }
+        writer.EndTable();
+        l.unlock();
+        continue;
+      }
       case StatementType::VARIABLE_SHOW_STATEMENT: {
         const auto &show_stmt = dynamic_cast<const VariableShowStatement &>(*statement);
+        if (StringUtil::Lower(show_stmt.variable_) == "metrics") {
+          CmdDisplayMetrics(writer);
+          continue;
+        }
         auto content = GetSessionVariable(show_stmt.variable_);
         WriteOneCell(fmt::format("{}={}", show_stmt.variable_, content), writer);
         continue;
@@ -239,13 +345,33 @@ void BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
           output += "\n";
         }
 
+        bool show_schema = (explain_stmt.options_ & ExplainOptions::SCHEMA) != 0;
+
+        // A prepared statement is already planned, print the plan that is going to be executed.
+        if (explain_stmt.statement_->type_ == StatementType::EXECUTE_STATEMENT) {
+          const auto &execute_stmt = dynamic_cast<const ExecuteStatement &>(*explain_stmt.statement_);
+          const auto &prepared = GetPreparedStatement(execute_stmt.name_);
+          if ((explain_stmt.options_ & ExplainOptions::OPTIMIZER) != 0) {
+            output += "=== OPTIMIZER ===";
+            output += "\n";
+            output += prepared.plan_->plan_->ToString(show_schema);
+            output += "\n";
+          }
+          if ((explain_stmt.options_ & ExplainOptions::ANALYZE) != 0) {
+            output += "=== ANALYZE ===";
+            output += "\n";
+            output += AnalyzePlan(*prepared.plan_, CastParameters(execute_stmt, prepared), txn, show_schema);
+            output += "\n";
+          }
+          WriteOneCell(output, writer);
+          continue;
+        }
+
         std::shared_lock<std::shared_mutex> l(catalog_lock_);
 
         bustub::Planner planner(*catalog_);
         planner.PlanQuery(*explain_stmt.statement_);
 
-        bool show_schema = (explain_stmt.options_ & ExplainOptions::SCHEMA) != 0;
-
         // Print planner result.
         if ((explain_stmt.options_ & ExplainOptions::PLANNER) != 0) {
           output += "=== PLANNER ===";
@@ -267,52 +393,160 @@ void BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
           output += "\n";
         }
 
+        // Run the query and print the optimized plan with the runtime statistics.
+        if ((explain_stmt.options_ & ExplainOptions::ANALYZE) != 0) {
+          CachedPlan plan;
+          plan.plan_ = optimized_plan;
+          plan.output_schema_ = planner.plan_->output_schema_;
+          output += "=== ANALYZE ===";
+          output += "\n";
+          output += AnalyzePlan(plan, {}, txn, show_schema);
+          output += "\n";
+        }
+
         WriteOneCell(output, writer);
 
         continue;
       }
+      case StatementType::PREPARE_STATEMENT: {
+        const auto &prepare_stmt = dynamic_cast<const PrepareStatement &>(*statement);
+        if (prepared_statements_.count(prepare_stmt.name_) != 0) {
+          throw Exception(fmt::format("prepared statement {} already exists", prepare_stmt.name_));
+        }
+        auto plan = PlanStatement(*prepare_stmt.statement_);
+        prepared_statements_.emplace(prepare_stmt.name_,
+                                     PreparedStatement{prepare_stmt.statement_, prepare_stmt.param_types_, plan});
+        continue;
+      }
+      case StatementType::EXECUTE_STATEMENT: {
+        const auto &execute_stmt = dynamic_cast<const ExecuteStatement &>(*statement);
+        const auto &prepared = GetPreparedStatement(execute_stmt.name_);
+        ExecutePlan(*prepared.plan_, CastParameters(execute_stmt, prepared), writer, txn);
+        continue;
+      }
+      case StatementType::DEALLOCATE_STATEMENT: {
+        const auto &deallocate_stmt = dynamic_cast<const DeallocateStatement &>(*statement);
+        if (!deallocate_stmt.name_.has_value()) {
+          prepared_statements_.clear();
+        } else if (prepared_statements_.erase(*deallocate_stmt.name_) == 0) {
+          throw Exception(fmt::format("prepared statement {} does not exist", *deallocate_stmt.name_));
+        }
+        continue;
+      }
       default:
         break;
     }
 
-    std::shared_lock<std::shared_mutex> l(catalog_lock_);
-
-    // Plan the query.
-    bustub::Planner planner(*catalog_);
-    planner.PlanQuery(*statement);
+    auto plan = PlanStatement(*statement);
+    if (!cache_key.empty() && binder.statement_nodes_.size() == 1) {
+      plan_cache_.Put(cache_key, plan);
+    }
+    ExecutePlan(*plan, {}, writer, txn);
+  }
+}
 
-    // Optimize the query.
-    bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
-    auto optimized_plan = optimizer.Optimize(planner.plan_);
+auto BustubInstance::GetPreparedStatement(const std::string &name) -> const PreparedStatement & {
+  auto iter = prepared_statements_.find(name);
+  if (iter == prepared_statements_.end()) {
+    throw Exception(fmt::format("prepared statement {} does not exist", name));
+  }
+  // The plan is only built again when the catalog has changed since it was prepared.
+  auto &prepared = iter->second;
+  if (prepared.plan_->catalog_version_ != catalog_->GetVersion()) {
+    prepared.plan_ = PlanStatement(*prepared.statement_);
+  }
+  return prepared;
+}
 
-    l.unlock();
+auto BustubInstance::PlanStatement(const BoundStatement &statement) -> std::shared_ptr<CachedPlan> {
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  auto plan = std::make_shared<CachedPlan>();
+  plan->catalog_version_ = catalog_->GetVersion();
+
+  // Plan the query.
+  bustub::Planner planner(*catalog_);
+  planner.PlanQuery(statement);
+
+  // Optimize the query.
+  bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
+  plan->plan_ = optimizer.Optimize(planner.plan_);
+  plan->output_schema_ = planner.plan_->output_schema_;
+  plan->parameters_ = std::move(planner.parameters_);
+  return plan;
+}
 
-    // Execute the query.
-    auto exec_ctx = MakeExecutorContext(txn);
-    std::vector<Tuple> result_set{};
-    execution_engine_->Execute(optimized_plan, &result_set, txn, exec_ctx.get());
+auto BustubInstance::CastParameters(const ExecuteStatement &execute_stmt, const PreparedStatement &prepared)
+    -> std::vector<Value> {
+  if (execute_stmt.params_.size() != prepared.param_types_.size()) {
+    throw Exception(fmt::format("prepared statement {} expects {} parameters, got {}", execute_stmt.name_,
+                                prepared.param_types_.size(), execute_stmt.params_.size()));
+  }
 
-    // Return the result set as a vector of string.
-    auto schema = planner.plan_->OutputSchema();
+  std::vector<Value> params;
+  for (size_t i = 0; i < execute_stmt.params_.size(); i++) {
+    const auto &param = execute_stmt.params_[i];
+    auto type = prepared.param_types_[i];
+    params.push_back(param.IsNull() ? ValueFactory::GetNullValueByType(type) : param.CastAs(type));
+  }
+  return params;
+}
 
-    // Generate header for the result set.
-    writer.BeginTable(false);
-    writer.BeginHeader();
-    for (const auto &column : schema.GetColumns()) {
-      writer.WriteHeaderCell(column.GetName());
+auto BustubInstance::RunPlan(CachedPlan &plan, const std::vector<Value> &params, Transaction *txn,
+                             ExecutionProfile *profile) -> std::vector<Tuple> {
+  std::vector<Tuple> result_set{};
+  std::scoped_lock<std::mutex> plan_lock(plan.latch_);
+  for (size_t i = 0; i < params.size() && i < plan.parameters_.size(); i++) {
+    if (plan.parameters_[i] != nullptr) {
+      *plan.parameters_[i] = params[i];
     }
-    writer.EndHeader();
+  }
 
-    // Transforming result set into strings.
-    for (const auto &tuple : result_set) {
-      writer.BeginRow();
-      for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
-        writer.WriteCell(tuple.GetValue(&schema, i).ToString());
-      }
-      writer.EndRow();
+  // Execute the query.
+  auto exec_ctx = MakeExecutorContext(txn);
+  exec_ctx->SetProfile(profile);
+  execution_engine_->Execute(plan.plan_, &result_set, txn, exec_ctx.get());
+  return result_set;
+}
+
+auto BustubInstance::AnalyzePlan(CachedPlan &plan, const std::vector<Value> &params, Transaction *txn,
+                                 bool with_schema) -> std::string {
+  ExecutionProfile profile;
+  auto start = std::chrono::steady_clock::now();
+  auto result_set = RunPlan(plan, params, txn, &profile);
+  auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+  // Plan nodes that never ran (e.g. the inner side of a join whose outer side is empty) have no statistics.
+  auto output = plan.plan_->ToString(with_schema, [&](const AbstractPlanNode &node) -> std::string {
+    auto iter = profile.find(&node);
+    return iter == profile.end() ? "(never executed)" : iter->second.ToString();
+  });
+  return fmt::format("{}\nExecution Time: {:.3f}ms, {} rows", output, elapsed.count(), result_set.size());
+}
+
+void BustubInstance::ExecutePlan(CachedPlan &plan, const std::vector<Value> &params, ResultWriter &writer,
+                                 Transaction *txn) {
+  auto result_set = RunPlan(plan, params, txn);
+
+  // Return the result set as a vector of string.
+  const auto &schema = *plan.output_schema_;
+
+  // Generate header for the result set.
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  for (const auto &column : schema.GetColumns()) {
+    writer.WriteHeaderCell(column.GetName());
+  }
+  writer.EndHeader();
+
+  // Transforming result set into strings.
+  for (const auto &tuple : result_set) {
+    writer.BeginRow();
+    for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+      writer.WriteCell(tuple.GetValue(&schema, i).ToString());
     }
-    writer.EndTable();
+    writer.EndRow();
   }
+  writer.EndTable();
 }
 
 /**
@@ -356,6 +590,13 @@ BustubInstance::~BustubInstance() {
   if (enable_logging) {
     log_manager_->StopFlushThread();
   }
+  if (catalog_->IsPersistent()) {
+    auto txn = txn_manager_->Begin();
+    catalog_->SaveRowCounts(txn);
+    txn_manager_->Commit(txn);
+    delete txn;
+    buffer_pool_manager_->FlushAllPages();
+  }
   delete execution_engine_;
   delete catalog_;
   delete checkpoint_manager_;
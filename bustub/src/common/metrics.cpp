@@ -0,0 +1,194 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// metrics.cpp
+//
+// Identification: src/common/metrics.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/metrics.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "fmt/format.h"
+
+namespace bustub {
+
+auto MetricCounter::Get() const -> uint64_t {
+  uint64_t sum = 0;
+  for (const auto &shard : shards_) {
+    sum += shard.value_.load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+void MetricCounter::Reset() {
+  for (auto &shard : shards_) {
+    shard.value_.store(0, std::memory_order_relaxed);
+  }
+}
+
+auto MetricCounter::ThreadShard() -> size_t {
+  static std::atomic<size_t> next_shard{0};
+  thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+  return shard;
+}
+
+void MetricHistogram::Record(uint64_t value) {
+  buckets_[BucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.Add();
+  sum_.Add(value);
+  auto max = max_.load(std::memory_order_relaxed);
+  while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+auto MetricHistogram::Percentile(double q) const -> uint64_t {
+  // Count from the buckets rather than count_, which may be ahead of them while values are being recorded.
+  std::array<uint64_t, NUM_BUCKETS> counts;
+  uint64_t total = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; i++) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+  auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(total) + 0.5));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; i++) {
+    seen += counts[i];
+    if (seen >= rank) {
+      return std::min(BucketUpperBound(i), Max());
+    }
+  }
+  return Max();
+}
+
+void MetricHistogram::Reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.Reset();
+  sum_.Reset();
+  max_.store(0, std::memory_order_relaxed);
+}
+
+auto MetricHistogram::BucketOf(uint64_t value) -> size_t {
+  if (value < SUB_BUCKETS) {
+    return value;
+  }
+  // The highest bit picks the power of two, the SUB_BUCKET_BITS bits below it the linear bucket inside it.
+  size_t exponent = 63 - __builtin_clzll(value);
+  size_t shift = exponent - SUB_BUCKET_BITS;
+  return SUB_BUCKETS + shift * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+}
+
+auto MetricHistogram::BucketUpperBound(size_t bucket) -> uint64_t {
+  if (bucket < SUB_BUCKETS) {
+    return bucket;
+  }
+  size_t shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+  uint64_t sub_bucket = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+  return ((SUB_BUCKETS + sub_bucket) << shift) + ((uint64_t{1} << shift) - 1);
+}
+
+auto MetricsRegistry::Instance() -> MetricsRegistry & {
+  static MetricsRegistry registry;
+  return registry;
+}
+
+MetricsRegistry::~MetricsRegistry() { StopSnapshotThread(); }
+
+auto MetricsRegistry::GetCounter(const std::string &name) -> MetricCounter * {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto &counter = counters_[name];
+  if (counter == nullptr) {
+    counter = std::make_unique<MetricCounter>();
+  }
+  return counter.get();
+}
+
+auto MetricsRegistry::GetHistogram(const std::string &name) -> MetricHistogram * {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto &histogram = histograms_[name];
+  if (histogram == nullptr) {
+    histogram = std::make_unique<MetricHistogram>();
+  }
+  return histogram.get();
+}
+
+auto MetricsRegistry::Snapshot() const -> std::vector<std::pair<std::string, std::string>> {
+  std::vector<std::pair<std::string, std::string>> rows;
+  std::scoped_lock<std::mutex> lock(latch_);
+  for (const auto &[name, counter] : counters_) {
+    rows.emplace_back(name, fmt::format("{}", counter->Get()));
+  }
+  auto to_us = [](uint64_t ns) { return fmt::format("{:.3f}", static_cast<double>(ns) / 1000.0); };
+  for (const auto &[name, histogram] : histograms_) {
+    auto count = histogram->Count();
+    rows.emplace_back(name + ".count", fmt::format("{}", count));
+    rows.emplace_back(name + ".avg_us", to_us(count == 0 ? 0 : histogram->Sum() / count));
+    rows.emplace_back(name + ".p50_us", to_us(histogram->Percentile(0.5)));
+    rows.emplace_back(name + ".p99_us", to_us(histogram->Percentile(0.99)));
+    rows.emplace_back(name + ".p999_us", to_us(histogram->Percentile(0.999)));
+    rows.emplace_back(name + ".max_us", to_us(histogram->Max()));
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+auto MetricsRegistry::SnapshotJson() const -> std::string {
+  auto timestamp =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+  std::vector<std::string> fields{fmt::format("\"timestamp_ms\": {}", timestamp.count())};
+  for (const auto &[name, value] : Snapshot()) {
+    fields.push_back(fmt::format("\"{}\": {}", name, value));
+  }
+  return fmt::format("{{{}}}", fmt::join(fields, ", "));
+}
+
+void MetricsRegistry::Reset() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  for (auto &[name, counter] : counters_) {
+    counter->Reset();
+  }
+  for (auto &[name, histogram] : histograms_) {
+    histogram->Reset();
+  }
+}
+
+void MetricsRegistry::StartSnapshotThread(const std::string &path, std::chrono::milliseconds interval) {
+  StopSnapshotThread();
+  stop_snapshot_ = false;
+  snapshot_thread_ = std::thread([this, path, interval] { RunSnapshotThread(path, interval); });
+}
+
+void MetricsRegistry::StopSnapshotThread() {
+  if (!snapshot_thread_.joinable()) {
+    return;
+  }
+  {
+    std::scoped_lock<std::mutex> lock(snapshot_latch_);
+    stop_snapshot_ = true;
+  }
+  snapshot_cv_.notify_all();
+  snapshot_thread_.join();
+}
+
+void MetricsRegistry::RunSnapshotThread(const std::string &path, std::chrono::milliseconds interval) {
+  std::ofstream file(path, std::ios::app);
+  std::unique_lock<std::mutex> lock(snapshot_latch_);
+  while (true) {
+    bool stopping = snapshot_cv_.wait_for(lock, interval, [this] { return stop_snapshot_; });
+    file << SnapshotJson() << std::endl;
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+}  // namespace bustub
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "concurrency/lock_manager.h"
+#include <chrono>  // NOLINT
 #include <climits>
 #include <mutex>
 #include <utility>
@@ -22,10 +23,25 @@
 
 namespace bustub {
 
+namespace {
+
+// 阻塞等待锁的授予，同时记录事务等待锁的次数和时间（EXPLAIN ANALYZE和SHOW METRICS中会输出）
+void WaitForGrant(Transaction *txn, std::condition_variable &cv, std::unique_lock<std::mutex> &latch) {
+  static auto *wait_latency = MetricsRegistry::Instance().GetHistogram("lock_manager.wait_latency");
+  auto start = std::chrono::steady_clock::now();
+  cv.wait(latch);
+  auto wait_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+  txn->AddLockWait(wait_ns.count());
+  wait_latency->Record(wait_ns.count());
+}
+
+}  // namespace
+
 auto LockManager::LockTable(Transaction *txn, LockMode lock_mode, const table_oid_t &oid) -> bool {
   // 1.输出加锁的日志信息
   LOG_INFO("lock table");
   Log(txn,lock_mode,oid);
+  metric_table_lock_requests_->Add();
 
   // 2.根据事务的状态，判断是否符合加锁的条件
   if(txn->GetState() == TransactionState::COMMITTED || txn->GetState() == TransactionState::ABORTED){
@@ -65,7 +81,7 @@ auto LockManager::LockTable(Transaction *txn, LockMode lock_mode, const table_oi
     // 4.4.根据等待队列判断锁是否能够被授予，如果不能被授予，则阻塞当前事务的锁请求，直到锁被授予为止
     while(!GrantLock(txn, lock_mode, oid)){
       // 4.4.1.当前事务的锁申请被阻塞了
-      table_lock_queue_ptr->cv_.wait(latch);
+      WaitForGrant(txn, table_lock_queue_ptr->cv_, latch);
       Log(txn,lock_mode,oid);
 
       // 4.4.2.如果当前事务在等待锁的授予过程中被中止了（即阻塞之后被唤醒发现事务被中止了，发生了死锁）
@@ -135,7 +151,7 @@ auto LockManager::LockTable(Transaction *txn, LockMode lock_mode, const table_oi
         // 4.3.3.根据等待队列判断锁是否能够被授予，如果不能被授予，则阻塞当前事务的锁请求，直到锁被授予为止
         while(!GrantLock(txn,lock_mode,oid)){
           // 4.3.1.当前事务的锁申请被阻塞了
-          table_lock_queue_ptr->cv_.wait(latch);
+          WaitForGrant(txn, table_lock_queue_ptr->cv_, latch);
           Log(txn,lock_mode,oid);
 
           // 4.3.2.如果当前事务在等待锁的授予过程中被中止了（即阻塞之后被唤醒发现事务被中止了，发生了死锁）
@@ -216,6 +232,7 @@ auto LockManager::LockRow(Transaction *txn, LockMode lock_mode, const table_oid_
   // 1.输出日志信息
   LOG_INFO("lock row");
   Log(txn,lock_mode,oid);
+  metric_row_lock_requests_->Add();
 
   // 2.因为在加行锁之前，先要加表锁，那么需要检查对应的表是否加锁，并且表锁与行锁之间的逻辑是否相符，如果不符合直接抛出异常
   IsTableFit(txn, lock_mode, oid);
@@ -260,7 +277,7 @@ auto LockManager::LockRow(Transaction *txn, LockMode lock_mode, const table_oid_
     // 4.4.授予锁
     while(!GrantLock(txn,lock_mode,rid)){
       // 4.4.1.当前事务的锁申请被阻塞了
-      row_lock_queue_ptr->cv_.wait(latch);
+      WaitForGrant(txn, row_lock_queue_ptr->cv_, latch);
       Log(txn,lock_mode,rid);
 
       // 4.4.2.如果当前事务在等待锁的授予过程中被中止了（即阻塞之后被唤醒发现事务被中止了，发生了死锁）
@@ -330,7 +347,7 @@ auto LockManager::LockRow(Transaction *txn, LockMode lock_mode, const table_oid_
         // 5.3.3.根据等待队列判断锁是否能够被授予，如果不能被授予，则阻塞当前事务的锁请求，直到锁被授予为止
         while(!GrantLock(txn,lock_mode,oid)){
           // 5.3.1.当前事务的锁申请被阻塞了
-          row_lock_queue_ptr->cv_.wait(latch);
+          WaitForGrant(txn, row_lock_queue_ptr->cv_, latch);
           Log(txn,lock_mode,oid);
 
           // 5.3.2.如果当前事务在等待锁的授予过程中被中止了（即阻塞之后被唤醒发现事务被中止了，发生了死锁）
@@ -584,6 +601,7 @@ void LockManager::RunCycleDetection() {
         txn->LockTxn();
         txn->SetState(TransactionState::ABORTED);
         txn->UnlockTxn();
+        metric_deadlock_aborts_->Add();
 
         // 3.2.将被中止的事务从等待图中剔除
         waits_for_.erase(txn_id);
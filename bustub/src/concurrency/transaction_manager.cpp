@@ -33,11 +33,13 @@ auto TransactionManager::Begin(Transaction *txn, IsolationLevel isolation_level)
   txn_map_mutex.lock();
   txn_map[txn->GetTransactionId()] = txn;
   txn_map_mutex.unlock();
+  metric_begins_->Add();
   return txn;
 }
 
 void TransactionManager::Commit(Transaction *txn) {
   txn->SetState(TransactionState::COMMITTED);
+  metric_commits_->Add();
 
   // Perform all deletes before we commit.
   auto write_set = txn->GetWriteSet();
@@ -60,6 +62,7 @@ void TransactionManager::Commit(Transaction *txn) {
 
 void TransactionManager::Abort(Transaction *txn) {
   txn->SetState(TransactionState::ABORTED);
+  metric_aborts_->Add();
   // Rollback before releasing the lock.
   auto table_write_set = txn->GetWriteSet();
   while (!table_write_set->empty()) {
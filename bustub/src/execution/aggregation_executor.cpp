@@ -9,11 +9,15 @@
 // Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "common/rid.h"
 #include "execution/executors/aggregation_executor.h"
+#include "execution/expressions/column_value_expression.h"
 
 namespace bustub {
 
@@ -30,16 +34,33 @@ void AggregationExecutor::Init() { // 初始化的时候将所有tuple按照聚
     aht_.Clear();
     child_->Init();
 
+    // 子执行器已经按group by的列排好序了，一个分组的tuple是连续的，在Next里一组一组地聚合，先读出第一个tuple
+    if(plan_->sorted_input_){
+        RID rid;
+        has_next_tuple_ = child_->Next(&next_tuple_, &rid);
+        return;
+    }
+
+    if(AggregateInBatches()){
+        aht_iterator_ = aht_.Begin();
+        return;
+    }
+
     Tuple tuple;
     RID rid;
     while(child_->Next(&tuple, &rid)){
         aht_.InsertCombine(MakeAggregateKey(&tuple), MakeAggregateValue(&tuple));
     }
+    aht_.Finalize();
 
     aht_iterator_ = aht_.Begin();
 }
 
 auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+    if(plan_->sorted_input_){
+        return NextSorted(tuple, rid);
+    }
+
     // 1.如果已经遍历完了
     if(aht_iterator_ == aht_.End()){ // 说明hash表是空的
         if(has_no_tuple_ && plan_->GetGroupBys().empty()){ // 没有元组且plan_中的group by也是空的，需要返回对应空的情况 todo ? 
@@ -54,20 +75,166 @@ auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
     }
 
     // 2.如果还没有遍历完
-    auto key = aht_iterator_.Key().group_bys_;    // aggregateKey
-    auto value = aht_iterator_.Val().aggregates_; // aggregateValue
-    auto result = key;
-    for(const auto &item : value){
-        result.push_back(item);
-    }
+    const auto &key = aht_iterator_.Key().group_bys_;    // aggregateKey
+    const auto &value = aht_iterator_.Val().aggregates_; // aggregateValue
+    std::vector<Value> result;
+    result.reserve(key.size() + value.size());
+    result.insert(result.end(), key.begin(), key.end());
+    result.insert(result.end(), value.begin(), value.end());
 
-    *tuple = Tuple(result,&plan_->OutputSchema());
+    *tuple = Tuple(std::move(result),&plan_->OutputSchema());
     *rid = tuple->GetRid();
     has_no_tuple_ = false;
     ++aht_iterator_;
     return true;
 }
 
+auto AggregationExecutor::NextSorted(Tuple *tuple, RID *rid) -> bool {
+    // 1.没有下一组了（有group by，没有输入的时候不需要输出初始值）
+    if(!has_next_tuple_){
+        return false;
+    }
+
+    // 2.一直聚合到group by的值变化为止，多读出来的那个tuple是下一组的第一个
+    auto key = MakeAggregateKey(&next_tuple_);
+    auto value = aht_.GenerateInitialAggregateValue();
+    RID child_rid;
+    do{
+        aht_.CombineAggregateValues(&value, MakeAggregateValue(&next_tuple_));
+        has_next_tuple_ = child_->Next(&next_tuple_, &child_rid);
+    }while(has_next_tuple_ && MakeAggregateKey(&next_tuple_) == key);
+    aht_.FinalizeAggregateValue(&value);
+
+    // 3.输出这一组
+    std::vector<Value> result;
+    result.reserve(key.group_bys_.size() + value.aggregates_.size());
+    result.insert(result.end(), key.group_bys_.begin(), key.group_bys_.end());
+    result.insert(result.end(), value.aggregates_.begin(), value.aggregates_.end());
+    *tuple = Tuple(std::move(result),&plan_->OutputSchema());
+    *rid = tuple->GetRid();
+    return true;
+}
+
+auto AggregationExecutor::AggregateInBatches() -> bool {
+    const auto &aggregates = plan_->GetAggregates();
+    const auto &agg_types = plan_->GetAggregateTypes();
+    const auto &schema = child_->GetOutputSchema();
+    if(!plan_->GetGroupBys().empty()){
+        return false;
+    }
+
+    // 1.检查每个聚集函数：要么是count(*)，要么直接作用在声明了精度(<=18)的FIXED_DECIMAL列上，这样每个值在tuple里都是一个int64
+    std::vector<uint32_t> offsets(aggregates.size(), 0);
+    std::vector<const Column *> columns(aggregates.size(), nullptr);
+    bool has_decimal = false;
+    for(uint32_t i = 0; i < aggregates.size(); i++){
+        if(agg_types[i] == AggregationType::CountStarAggregate){
+            continue;
+        }
+        if(agg_types[i] == AggregationType::CountDistinctAggregate ||
+           agg_types[i] == AggregationType::ApproxCountDistinctAggregate){ // 去重的计数没有对应的kernel
+            return false;
+        }
+        const auto *expr = dynamic_cast<const ColumnValueExpression *>(aggregates[i].get());
+        if(expr == nullptr || expr->GetTupleIdx() != 0){
+            return false;
+        }
+        const auto &col = schema.GetColumn(expr->GetColIdx());
+        if(col.GetType() != TypeId::FIXED_DECIMAL || col.GetPrecision() == 0 ||
+           col.GetPrecision() > BUSTUB_FIXED_DECIMAL_MAX_NARROW_PRECISION){
+            return false;
+        }
+        offsets[i] = col.GetOffset() + 1; // 跳过头部存scale的那个字节
+        columns[i] = &col;
+        has_decimal = true;
+    }
+    if(!has_decimal){
+        return false;
+    }
+
+    // 2.每个聚集函数攒一批原始的int64值，攒满BATCH_SIZE个就交给kernel，kernel里没有分支可以被编译成SIMD
+    std::vector<std::vector<int64_t>> batches(aggregates.size());
+    std::vector<int128_t> sums(aggregates.size(), 0);
+    std::vector<int64_t> mins(aggregates.size(), BUSTUB_INT64_MAX);
+    std::vector<int64_t> maxs(aggregates.size(), BUSTUB_INT64_NULL);
+    std::vector<size_t> counts(aggregates.size(), 0);
+    size_t rows = 0;
+    auto flush = [&](){
+        for(uint32_t i = 0; i < aggregates.size(); i++){
+            if(columns[i] == nullptr){
+                continue;
+            }
+            const int64_t *values = batches[i].data();
+            size_t n = batches[i].size();
+            counts[i] += TypeKernels::CountFixedDecimals(values, n);
+            switch(agg_types[i]){
+                case AggregationType::SumAggregate:
+                    sums[i] += TypeKernels::SumFixedDecimals(values, n);
+                    break;
+                case AggregationType::MinAggregate:
+                    mins[i] = std::min(mins[i], TypeKernels::MinFixedDecimals(values, n));
+                    break;
+                case AggregationType::MaxAggregate:
+                    maxs[i] = std::max(maxs[i], TypeKernels::MaxFixedDecimals(values, n));
+                    break;
+                default:
+                    break;
+            }
+            batches[i].clear();
+        }
+    };
+
+    Tuple tuple;
+    RID rid;
+    while(child_->Next(&tuple, &rid)){
+        for(uint32_t i = 0; i < aggregates.size(); i++){
+            if(columns[i] != nullptr){
+                int64_t value;
+                memcpy(&value, tuple.GetData() + offsets[i], sizeof(int64_t));
+                batches[i].push_back(value);
+            }
+        }
+        if(++rows % BATCH_SIZE == 0){
+            flush();
+        }
+    }
+    flush();
+
+    // 3.没有任何输入的时候哈希表保持为空，由Next返回初始值
+    if(rows == 0){
+        return true;
+    }
+    std::vector<Value> results;
+    for(uint32_t i = 0; i < aggregates.size(); i++){
+        if(agg_types[i] == AggregationType::CountStarAggregate){
+            results.emplace_back(ValueFactory::GetIntegerValue(static_cast<int32_t>(rows)));
+            continue;
+        }
+        if(counts[i] == 0){ // 全是NULL的时候和逐行聚集一样，结果是NULL
+            results.emplace_back(ValueFactory::GetNullValueByType(TypeId::INTEGER));
+            continue;
+        }
+        uint8_t precision = columns[i]->GetPrecision();
+        uint8_t scale = columns[i]->GetScale();
+        switch(agg_types[i]){
+            case AggregationType::CountAggregate:
+                results.emplace_back(ValueFactory::GetIntegerValue(static_cast<int32_t>(counts[i])));
+                break;
+            case AggregationType::SumAggregate:
+                results.emplace_back(ValueFactory::GetFixedDecimalValue(sums[i], BUSTUB_FIXED_DECIMAL_MAX_PRECISION, scale));
+                break;
+            case AggregationType::MinAggregate:
+                results.emplace_back(ValueFactory::GetFixedDecimalValue(mins[i], precision, scale));
+                break;
+            default:
+                results.emplace_back(ValueFactory::GetFixedDecimalValue(maxs[i], precision, scale));
+                break;
+        }
+    }
+    aht_.Insert({}, {std::move(results)});
+    return true;
+}
+
 auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
 
 }  // namespace bustub
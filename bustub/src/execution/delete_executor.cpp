@@ -85,6 +85,9 @@ auto DeleteExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
         }
     }
 
+    // 3.更新表的统计信息（行数）
+    table_info_->stats_->UpdateRowCount(-delete_count);
+
     Tuple temp_tuple(std::vector<Value>(1,Value(TypeId::INTEGER,delete_count)),&GetOutputSchema());
     *tuple = temp_tuple;
     has_no_tuple_ = true;
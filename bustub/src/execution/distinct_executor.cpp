@@ -0,0 +1,187 @@
+#include "execution/executors/distinct_executor.h"
+#include <cstring>
+#include <utility>
+#include "buffer/buffer_pool_manager.h"
+#include "common/exception.h"
+
+namespace bustub {
+
+DistinctExecutor::DistinctExecutor(ExecutorContext *exec_ctx, const DistinctPlanNode *plan,
+                                   std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+DistinctExecutor::~DistinctExecutor() { DropPartitions(); }
+
+void DistinctExecutor::Init() {
+    // 1.初始化子执行器
+    child_executor_->Init();
+
+    // 2.清空上一次执行留下的状态（包括还没读完的溢出分区）
+    DropPartitions();
+    seen_.Clear();
+    reading_child_ = true;
+    level_ = 0;
+    reading_page_idx_ = 0;
+    read_buffer_.clear();
+    read_offset_ = 0;
+}
+
+auto DistinctExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+    Tuple input;
+    while(NextInput(&input)){
+        // 1.按整行序列化之后的字节去重，已经输出过的行直接跳过
+        const char *data = input.GetData();
+        uint32_t size = input.GetLength();
+        auto hash = DistinctHashSet::Hash(data, size);
+        if(seen_.Contains(data, size, hash)){
+            continue;
+        }
+
+        // 2.内存用完了，没见过的行写到溢出分区里之后再单独去重，相同的行一定会进同一个分区
+        if(seen_.MemoryUsage() >= DISTINCT_MEMORY_BUDGET && level_ < MAX_SPILL_LEVEL &&
+           size + 2 * sizeof(uint32_t) <= BUSTUB_PAGE_SIZE){
+            Spill(input, hash);
+            continue;
+        }
+
+        // 3.第一次见到的行马上输出，不用等子执行器读完
+        seen_.Insert(data, size, hash);
+        *rid = input.GetRid();
+        *tuple = std::move(input);
+        return true;
+    }
+    return false;
+}
+
+auto DistinctExecutor::NextInput(Tuple *tuple) -> bool {
+    auto *bpm = exec_ctx_->GetBufferPoolManager();
+    while(true){
+        if(reading_child_){
+            RID rid;
+            if(child_executor_->Next(tuple, &rid)){
+                return true;
+            }
+            reading_child_ = false;
+        }else if(ReadSpilled(tuple)){
+            return true;
+        }
+
+        // 当前输入读完了：把它溢出的分区排进队列，读过的分区的页可以删掉了
+        FinishSpilling();
+        for(auto page_id : reading_.pages_){
+            bpm->DeletePage(page_id);
+        }
+        reading_ = SpillPartition{};
+        if(pending_.empty()){
+            return false;
+        }
+
+        // 换下一个分区，用一个空的set去重，它和之前输出过的行不会有重复
+        reading_ = std::move(pending_.front());
+        pending_.pop_front();
+        level_ = reading_.level_;
+        reading_page_idx_ = 0;
+        read_buffer_.clear();
+        read_offset_ = 0;
+        seen_.Clear();
+    }
+}
+
+void DistinctExecutor::Spill(const Tuple &tuple, uint64_t hash) {
+    // 每一层用hash的不同位选分区，这样同一个分区再溢出的时候还能继续分开
+    auto shift = 64 - SPILL_PARTITION_BITS * (level_ + 1);
+    if(spilling_.size() != NUM_SPILL_PARTITIONS){
+        spilling_.resize(NUM_SPILL_PARTITIONS);
+    }
+    auto &partition = spilling_[(hash >> shift) & (NUM_SPILL_PARTITIONS - 1)];
+    partition.level_ = level_ + 1;
+
+    uint32_t record_size = sizeof(uint32_t) + tuple.GetLength();
+    if(partition.write_buffer_.size() + record_size > BUSTUB_PAGE_SIZE){
+        FlushPartition(&partition);
+    }
+    auto offset = partition.write_buffer_.size();
+    partition.write_buffer_.resize(offset + record_size);
+    tuple.SerializeTo(partition.write_buffer_.data() + offset);
+}
+
+void DistinctExecutor::FlushPartition(SpillPartition *partition) {
+    if(partition->write_buffer_.empty()){
+        return;
+    }
+    auto *bpm = exec_ctx_->GetBufferPoolManager();
+    page_id_t page_id;
+    auto *page = bpm->NewPage(&page_id);
+    if(page == nullptr){
+        throw ExecutionException("distinct: no free frame in the buffer pool to spill rows");
+    }
+    page->WLatch();
+    memset(page->GetData(), 0, BUSTUB_PAGE_SIZE); // 剩下的部分全是0，读到长度为0就说明这一页结束了
+    memcpy(page->GetData(), partition->write_buffer_.data(), partition->write_buffer_.size());
+    page->WUnlatch();
+    bpm->UnpinPage(page_id, true);
+    partition->pages_.push_back(page_id);
+    partition->write_buffer_.clear();
+}
+
+void DistinctExecutor::FinishSpilling() {
+    for(auto &partition : spilling_){
+        if(partition.pages_.empty() && partition.write_buffer_.empty()){
+            continue;
+        }
+        FlushPartition(&partition);
+        pending_.push_back(std::move(partition));
+        partition = SpillPartition{};
+    }
+}
+
+auto DistinctExecutor::ReadSpilled(Tuple *tuple) -> bool {
+    auto *bpm = exec_ctx_->GetBufferPoolManager();
+    while(true){
+        // 1.当前页里还有行
+        if(read_offset_ + sizeof(uint32_t) <= read_buffer_.size()){
+            uint32_t size;
+            memcpy(&size, read_buffer_.data() + read_offset_, sizeof(uint32_t));
+            if(size != 0){
+                tuple->DeserializeFrom(read_buffer_.data() + read_offset_);
+                read_offset_ += sizeof(uint32_t) + size;
+                return true;
+            }
+        }
+
+        // 2.当前页读完了，把下一页拷出来，不用一直pin着
+        if(reading_page_idx_ >= reading_.pages_.size()){
+            return false;
+        }
+        auto page_id = reading_.pages_[reading_page_idx_++];
+        auto *page = bpm->FetchPage(page_id);
+        if(page == nullptr){
+            throw ExecutionException("distinct: no free frame in the buffer pool to read spilled rows");
+        }
+        page->RLatch();
+        read_buffer_.assign(page->GetData(), page->GetData() + BUSTUB_PAGE_SIZE);
+        page->RUnlatch();
+        bpm->UnpinPage(page_id, false);
+        read_offset_ = 0;
+    }
+}
+
+void DistinctExecutor::DropPartitions() {
+    auto *bpm = exec_ctx_->GetBufferPoolManager();
+    auto drop = [bpm](SpillPartition *partition){
+        for(auto page_id : partition->pages_){
+            bpm->DeletePage(page_id);
+        }
+        *partition = SpillPartition{};
+    };
+    for(auto &partition : spilling_){
+        drop(&partition);
+    }
+    for(auto &partition : pending_){
+        drop(&partition);
+    }
+    drop(&reading_);
+    pending_.clear();
+}
+
+}  // namespace bustub
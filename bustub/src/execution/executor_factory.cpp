@@ -18,20 +18,24 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/delete_executor.h"
+#include "execution/executors/distinct_executor.h"
 #include "execution/executors/filter_executor.h"
 #include "execution/executors/hash_join_executor.h"
 #include "execution/executors/index_scan_executor.h"
 #include "execution/executors/insert_executor.h"
 #include "execution/executors/limit_executor.h"
+#include "execution/executors/merge_join_executor.h"
 #include "execution/executors/mock_scan_executor.h"
 #include "execution/executors/nested_index_join_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
+#include "execution/executors/profiling_executor.h"
 #include "execution/executors/projection_executor.h"
 #include "execution/executors/seq_scan_executor.h"
 #include "execution/executors/sort_executor.h"
 #include "execution/executors/topn_executor.h"
 #include "execution/executors/update_executor.h"
 #include "execution/executors/values_executor.h"
+#include "execution/executors/window_function_executor.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/mock_scan_plan.h"
 #include "execution/plans/projection_plan.h"
@@ -44,6 +48,15 @@ namespace bustub {
 
 auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
     -> std::unique_ptr<AbstractExecutor> {
+  auto executor = CreatePlanExecutor(exec_ctx, plan);
+  if (exec_ctx->GetProfile() != nullptr) {
+    return std::make_unique<ProfilingExecutor>(exec_ctx, plan.get(), std::move(executor));
+  }
+  return executor;
+}
+
+auto ExecutorFactory::CreatePlanExecutor(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
+    -> std::unique_ptr<AbstractExecutor> {
   switch (plan->GetType()) {
     // Create a new sequential scan executor
     case PlanType::SeqScan: {
@@ -114,6 +127,14 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<HashJoinExecutor>(exec_ctx, hash_join_plan, std::move(left), std::move(right));
     }
 
+    // Create a new merge join executor
+    case PlanType::MergeJoin: {
+      auto merge_join_plan = dynamic_cast<const MergeJoinPlanNode *>(plan.get());
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetLeftPlan());
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetRightPlan());
+      return std::make_unique<MergeJoinExecutor>(exec_ctx, merge_join_plan, std::move(left), std::move(right));
+    }
+
     // Create a new mock scan executor
     case PlanType::MockScan: {
       const auto *mock_scan_plan = dynamic_cast<const MockScanPlanNode *>(plan.get());
@@ -154,6 +175,20 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<TopNExecutor>(exec_ctx, topn_plan, std::move(child));
     }
 
+      // Create a new distinct executor
+    case PlanType::Distinct: {
+      const auto *distinct_plan = dynamic_cast<const DistinctPlanNode *>(plan.get());
+      auto child = ExecutorFactory::CreateExecutor(exec_ctx, distinct_plan->GetChildPlan());
+      return std::make_unique<DistinctExecutor>(exec_ctx, distinct_plan, std::move(child));
+    }
+
+      // Create a new window function executor
+    case PlanType::Window: {
+      const auto *window_plan = dynamic_cast<const WindowFunctionPlanNode *>(plan.get());
+      auto child = ExecutorFactory::CreateExecutor(exec_ctx, window_plan->GetChildPlan());
+      return std::make_unique<WindowFunctionExecutor>(exec_ctx, window_plan, std::move(child));
+    }
+
     default:
       UNREACHABLE("Unsupported plan type.");
   }
@@ -7,14 +7,29 @@
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "execution/plans/aggregation_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/sort_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/plans/window_plan.h"
 
 namespace bustub {
 
-auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema) const -> std::string {
+auto AbstractPlanNode::ToString(bool with_schema,
+                                const std::function<std::string(const AbstractPlanNode &)> &annotate) const
+    -> std::string {
+  if (with_schema) {
+    return fmt::format("{} {} | {}{}", PlanNodeToString(), annotate(*this), output_schema_,
+                       ChildrenToString(2, with_schema, annotate));
+  }
+  return fmt::format("{} {}{}", PlanNodeToString(), annotate(*this), ChildrenToString(2, with_schema, annotate));
+}
+
+auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema,
+                                        const std::function<std::string(const AbstractPlanNode &)> &annotate) const
+    -> std::string {
   if (children_.empty()) {
     return "";
   }
@@ -22,7 +37,7 @@ auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema) const -> s
   children_str.reserve(children_.size());
   auto indent_str = StringUtil::Indent(indent);
   for (const auto &child : children_) {
-    auto child_str = child->ToString(with_schema);
+    auto child_str = annotate == nullptr ? child->ToString(with_schema) : child->ToString(with_schema, annotate);
     auto lines = StringUtil::Split(child_str, '\n');
     for (auto &line : lines) {
       children_str.push_back(fmt::format("{}{}", indent_str, line));
@@ -32,9 +47,37 @@ auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema) const -> s
 }
 
 auto AggregationPlanNode::PlanNodeToString() const -> std::string {
+  if (sorted_input_) {
+    return fmt::format("Agg {{ types={}, aggregates={}, group_by={}, sorted_input=true }}", agg_types_, aggregates_,
+                       group_bys_);
+  }
   return fmt::format("Agg {{ types={}, aggregates={}, group_by={} }}", agg_types_, aggregates_, group_bys_);
 }
 
+auto WindowFunctionPlanNode::PlanNodeToString() const -> std::string {
+  std::vector<std::string> columns;
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    auto iter = window_functions_.find(i);
+    if (iter == window_functions_.end()) {
+      columns.push_back(columns_[i]->ToString());
+    } else {
+      const auto &function = iter->second;
+      columns.push_back(fmt::format("{}({}) frame={}", function.type_, function.function_, function.frame_));
+    }
+  }
+  return fmt::format("WindowFunc {{ columns=[{}], partition_by={}, order_by={} }}", fmt::join(columns, ", "),
+                     partition_by_, order_by_);
+}
+
+auto HashJoinPlanNode::PlanNodeToString() const -> std::string {
+  if (runtime_filter_id_.has_value()) {
+    return fmt::format("HashJoin {{ type={}, left_key={}, right_key={}, runtime_filter=rf{} }}", join_type_,
+                       left_key_expressions_, right_key_expressions_, *runtime_filter_id_);
+  }
+  return fmt::format("HashJoin {{ type={}, left_key={}, right_key={} }}", join_type_, left_key_expressions_,
+                     right_key_expressions_);
+}
+
 auto ProjectionPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Projection {{ exprs={} }}", expressions_);
 }
@@ -47,9 +90,39 @@ auto SortPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Sort {{ order_bys={} }}", order_bys_);
 }
 
-auto LimitPlanNode::PlanNodeToString() const -> std::string { return fmt::format("Limit {{ limit={} }}", limit_); }
+auto IndexScanPlanNode::PlanNodeToString() const -> std::string {
+  auto key_to_string = [](const std::vector<AbstractExpressionRef> &key) {
+    std::vector<std::string> values;
+    for (const auto &expr : key) {
+      values.push_back(expr->ToString());
+    }
+    return fmt::format("({})", fmt::join(values, ", "));
+  };
+  std::string range;
+  if (!lower_bound_.empty() || !upper_bound_.empty()) {
+    range = fmt::format(", range=[{}, {}]", lower_bound_.empty() ? "-inf" : key_to_string(lower_bound_),
+                        upper_bound_.empty() ? "+inf" : key_to_string(upper_bound_));
+  }
+  if (limit_.has_value()) {
+    range += fmt::format(", limit={}", *limit_);
+  }
+  if (filter_predicate_) {
+    return fmt::format("IndexScan {{ index_oid={}{}, filter={} }}", index_oid_, range, filter_predicate_);
+  }
+  return fmt::format("IndexScan {{ index_oid={}{} }}", index_oid_, range);
+}
+
+auto LimitPlanNode::PlanNodeToString() const -> std::string {
+  if (offset_ != 0) {
+    return fmt::format("Limit {{ limit={}, offset={} }}", limit_, offset_);
+  }
+  return fmt::format("Limit {{ limit={} }}", limit_);
+}
 
 auto TopNPlanNode::PlanNodeToString() const -> std::string {
+  if (offset_ != 0) {
+    return fmt::format("TopN {{ n={}, offset={}, order_bys={}}}", n_, offset_, order_bys_);
+  }
   return fmt::format("TopN {{ n={}, order_bys={}}}", n_, order_bys_);
 }
 
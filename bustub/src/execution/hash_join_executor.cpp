@@ -18,6 +18,7 @@
 #include "binder/table_ref/bound_join_ref.h"
 #include "common/rid.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/runtime_filter.h"
 #include "type/value_factory.h"
 
 // Note for 2022 Fall: You don't need to implement HashJoinExecutor to pass all tests. You ONLY need to implement it
@@ -32,87 +33,109 @@ HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlan
       plan_(plan),
       left_child_executor_(std::forward<std::unique_ptr<AbstractExecutor>>(left_child)),
       right_child_executor_(std::forward<std::unique_ptr<AbstractExecutor>>(right_child)){
-  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
+  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER ||
+        plan->GetJoinType() == JoinType::SEMI || plan->GetJoinType() == JoinType::ANTI)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
 void HashJoinExecutor::Init() {
-  // 1.初始化两个子查询
-  left_child_executor_->Init();
+  // 1.初始化右表的子查询，左表要等runtime filter建好之后再初始化
   right_child_executor_->Init();
   current_index_ = -1;
+  matched_tuples_ = nullptr;
   is_matched_ = false;
+  right_hash_map_.clear();
 
-  // 2.获取左表的tuple并hash
+  // 2.获取右表的tuple并hash
   Tuple right_tuple;
   RID right_rid;
   while(right_child_executor_->Next(&right_tuple, &right_rid)){
-    // 2.1.获取join_key并hash
-    JoinKey right_join_key{plan_->RightJoinKeyExpression().Evaluate(&right_tuple, right_child_executor_->GetOutputSchema())};
-    
+    // 2.1.获取join_key并hash，key中有NULL的tuple不会和任何左表tuple匹配，不用放进hash表
+    auto right_join_key = MakeJoinKey(plan_->RightJoinKeyExpressions(), right_tuple, right_child_executor_->GetOutputSchema());
+    if(right_join_key.HasNull()){
+      continue;
+    }
+
     // 2.2.先判断对应的hash_key是否已经存在了，如果不存在，则初始化vector,存在的话就直接emplace_back
-    if(right_hash_map_.find(right_join_key) == right_hash_map_.end()){
-      right_hash_map_.insert({right_join_key,{right_tuple}});
-    }else{
-      right_hash_map_[right_join_key].emplace_back(right_tuple);
+    // 半连接和反连接只关心key是否存在，每个key保存一个tuple就够了
+    // key和tuple都直接move进hash表，避免拷贝
+    auto iter = right_hash_map_.find(right_join_key);
+    if(iter == right_hash_map_.end()){
+      right_hash_map_[std::move(right_join_key)].emplace_back(std::move(right_tuple));
+    }else if(!IsSemiOrAnti()){
+      iter->second.emplace_back(std::move(right_tuple));
+    }
+  }
+
+  // 3.用右表的第一个key建立runtime filter，交给左表的scan提前过滤掉不可能连接成功的tuple
+  if(plan_->runtime_filter_id_.has_value()){
+    RuntimeFilter filter(right_hash_map_.size());
+    for(const auto &[join_key, _] : right_hash_map_){
+      filter.Insert(join_key.values_[0]);
     }
+    exec_ctx_->SetRuntimeFilter(*plan_->runtime_filter_id_, std::move(filter));
   }
+
+  // 4.初始化左表的子查询
+  left_child_executor_->Init();
 }
 
 auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   RID left_rid;
 
+  if(IsSemiOrAnti()){
+    return NextSemiOrAnti(tuple);
+  }
+
   while(true){
-    // 1.判断是否需要获取下一个tuple（last_index_ == -1：初始化/当前的左表某个tuple完成了连接）
-    if(static_cast<int>(current_index_) == -1 || right_hash_map_[left_join_key_].size() <= current_index_){
+    // 1.判断是否需要获取下一个tuple（current_index_ == -1：初始化/当前的左表某个tuple完成了连接）
+    size_t matched_cnt = matched_tuples_ == nullptr ? 0 : matched_tuples_->size();
+    if(static_cast<int>(current_index_) == -1 || matched_cnt <= current_index_){
       // 1.1.获取左表的下一个tuple,如果获取失败，直接返回false
       if(!left_child_executor_->Next(&left_tuple_, &left_rid)){
         return false;
       }
 
-      // 1.2.更新last_index_、is_matched_、left_join_key_
+      // 1.2.更新current_index_、is_matched_，并在hash表中查找key相同的右表tuple
       current_index_ = 0;
       is_matched_ = false;
-      left_join_key_ = (JoinKey){plan_->LeftJoinKeyExpression().Evaluate(&left_tuple_,left_child_executor_->GetOutputSchema())};
+      auto left_join_key = MakeJoinKey(plan_->LeftJoinKeyExpressions(), left_tuple_, left_child_executor_->GetOutputSchema());
+      auto iter = left_join_key.HasNull() ? right_hash_map_.end() : right_hash_map_.find(left_join_key);
+      matched_tuples_ = iter == right_hash_map_.end() ? nullptr : &iter->second;
     }
 
-    // 2.右表中可能存在可以与左表中匹配的tuple
-    if(right_hash_map_.find(left_join_key_) != right_hash_map_.end()){
-      for(;current_index_ < right_hash_map_[left_join_key_].size();){
-        auto right_tuple = right_hash_map_[left_join_key_][current_index_]; 
-        auto right_join_key = (JoinKey){plan_->RightJoinKeyExpression().Evaluate(&right_tuple, right_child_executor_->GetOutputSchema())};
-        if(left_join_key_ == right_join_key){
-          is_matched_ = true; // 更改标记，已经找到了连接匹配的tuple
-
-          std::vector<Value> value;
-          auto left_schema = left_child_executor_->GetOutputSchema();
-          auto right_schema = right_child_executor_->GetOutputSchema();
-          // 2.1.获取左表中对应的数据列
-          for(uint32_t i = 0;i < left_schema.GetColumnCount();i++){
-            value.push_back(left_tuple_.GetValue(&left_schema, i));
-          }
-          // 2.2.获取右表中对应的数据列
-          for(uint32_t j = 0;j < right_schema.GetColumnCount();j++){
-            value.push_back(right_tuple.GetValue(&right_schema, j));
-          }
-          // 2.3.创建新的tuple，并返回true
-          *tuple = Tuple(value,&plan_->OutputSchema());
-
-          // 2.4.更新current_index_
-          current_index_++;
-
-          return true;
-        }
+    // 2.hash表中key相同的右表tuple都可以连接（hash表按JoinKey的operator==分组，所以所有key都相等）
+    if(matched_tuples_ != nullptr && current_index_ < matched_tuples_->size()){
+      is_matched_ = true; // 更改标记，已经找到了连接匹配的tuple
+      const auto &right_tuple = (*matched_tuples_)[current_index_];
+
+      std::vector<Value> value;
+      const auto &left_schema = left_child_executor_->GetOutputSchema();
+      const auto &right_schema = right_child_executor_->GetOutputSchema();
+      // 2.1.获取左表中对应的数据列
+      for(uint32_t i = 0;i < left_schema.GetColumnCount();i++){
+        value.push_back(left_tuple_.GetValue(&left_schema, i));
+      }
+      // 2.2.获取右表中对应的数据列
+      for(uint32_t j = 0;j < right_schema.GetColumnCount();j++){
+        value.push_back(right_tuple.GetValue(&right_schema, j));
       }
+      // 2.3.创建新的tuple，并返回true
+      *tuple = Tuple(value,&plan_->OutputSchema());
+
+      // 2.4.更新current_index_
+      current_index_++;
+
+      return true;
     }
 
     // 3.右表中没有可以匹配的tuple且是左连接
     if(plan_->GetJoinType() == JoinType::LEFT && !is_matched_){
       std::vector<Value> value;
-      auto left_schema = left_child_executor_->GetOutputSchema();
-      auto right_schema = right_child_executor_->GetOutputSchema();
+      const auto &left_schema = left_child_executor_->GetOutputSchema();
+      const auto &right_schema = right_child_executor_->GetOutputSchema();
       // 3.1.获取左表中对应的数据列
       for(uint32_t i = 0;i < left_schema.GetColumnCount();i++){
         value.push_back(left_tuple_.GetValue(&left_schema, i));
@@ -121,11 +144,39 @@ auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
       for(uint32_t j = 0;j < right_schema.GetColumnCount();j++){
         value.push_back(ValueFactory::GetNullValueByType(right_schema.GetColumn(j).GetType()));
       }
-      // 3.3.创建新的tuple，并返回true
+      // 3.3.创建新的tuple，并返回true（is_matched_置为true，下一次调用时获取下一个左表tuple）
       *tuple = Tuple(value,&plan_->OutputSchema());
+      is_matched_ = true;
       return true;
     }
   }
 }
 
+auto HashJoinExecutor::NextSemiOrAnti(Tuple *tuple) -> bool {
+  RID left_rid;
+
+  while(left_child_executor_->Next(&left_tuple_, &left_rid)){
+    // 1.在hash表中查找左表tuple的key，NULL不和任何值相等
+    auto left_join_key = MakeJoinKey(plan_->LeftJoinKeyExpressions(), left_tuple_, left_child_executor_->GetOutputSchema());
+    bool matched = !left_join_key.HasNull() && right_hash_map_.find(left_join_key) != right_hash_map_.end();
+
+    // 2.半连接输出找到匹配的左表tuple，反连接输出没有找到匹配的左表tuple，输出的只有左表的列
+    if(matched == (plan_->GetJoinType() == JoinType::SEMI)){
+      *tuple = left_tuple_;
+      return true;
+    }
+  }
+  return false;
+}
+
+auto HashJoinExecutor::MakeJoinKey(const std::vector<AbstractExpressionRef> &exprs, const Tuple &tuple,
+                                   const Schema &schema) -> JoinKey {
+  JoinKey key;
+  key.values_.reserve(exprs.size());
+  for(const auto &expr : exprs){
+    key.values_.push_back(expr->Evaluate(&tuple, schema));
+  }
+  return key;
+}
+
 }  // namespace bustub
@@ -11,37 +11,103 @@
 //===----------------------------------------------------------------------===//
 #include "execution/executors/index_scan_executor.h"
 #include <memory>
+#include <optional>
+#include "common/exception.h"
 #include "storage/index/b_plus_tree_index.h"
 
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
     : AbstractExecutor(exec_ctx),
       plan_(plan),
-      tree_(dynamic_cast<BPlusTreeIndexForOneIntegerColumn*>(
-        exec_ctx_->GetCatalog()->GetIndex(plan_->index_oid_)->index_.get())),
-      begin_(tree_->GetBeginIterator()),
-      end_(tree_->GetEndIterator()){}
+      index_info_(exec_ctx_->GetCatalog()->GetIndex(plan_->index_oid_)),
+      table_info_(exec_ctx_->GetCatalog()->GetTable(index_info_->table_name_)) {}  // 索引中存放了其对应的表名
 
 void IndexScanExecutor::Init() {
-  begin_ = tree_->GetBeginIterator();
+    emitted_ = 0;
+
+    // 单列和两列的整数索引使用不同宽度的key
+    auto *index = index_info_->index_.get();
+    if (auto *tree = dynamic_cast<BPlusTreeIndexForOneIntegerColumn *>(index); tree != nullptr) {
+        InitCursor(tree);
+    } else if (auto *tree = dynamic_cast<BPlusTreeIndexForTwoIntegerColumn *>(index); tree != nullptr) {
+        InitCursor(tree);
+    } else {
+        throw NotImplementedException("index scan only supports b+ tree index on integer columns");
+    }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void IndexScanExecutor::InitCursor(BPlusTreeIndex<KeyType, ValueType, KeyComparator> *tree) {
+    // 1.计算key范围的上下界（预编译语句的参数在每次执行时才确定），参数为NULL时不可能有满足条件的元组
+    bool is_empty = false;
+    auto make_key = [&](const std::vector<AbstractExpressionRef> &exprs) {
+        std::vector<Value> values;
+        for (const auto &expr : exprs) {
+            values.push_back(expr->Evaluate(nullptr, index_info_->key_schema_));
+            is_empty = is_empty || values.back().IsNull();
+        }
+        KeyType key;
+        key.SetFromKey(Tuple(values, index_info_->index_->GetKeySchema()));
+        return key;
+    };
+    std::optional<KeyType> lower_key;
+    if (!plan_->lower_bound_.empty()) {
+        lower_key = make_key(plan_->lower_bound_);
+    }
+    std::optional<KeyType> upper_key;
+    if (!plan_->upper_bound_.empty()) {
+        upper_key = make_key(plan_->upper_bound_);
+    }
+    if (is_empty) {
+        next_rid_ = [](RID *rid) { return false; };
+        return;
+    }
+
+    // 2.有下界时从第一个不小于下界的key开始遍历，否则从头开始
+    auto iter = std::make_shared<IndexIterator<KeyType, ValueType, KeyComparator>>(
+        lower_key.has_value() ? tree->GetBeginIterator(*lower_key) : tree->GetBeginIterator());
+
+    // 3.遍历到叶子页的末尾或者key超过了上界就结束
+    next_rid_ = [tree, iter, upper_key](RID *rid) {
+        if (iter->IsEnd()) {
+            return false;
+        }
+        const auto &[key, value] = **iter;
+        if (upper_key.has_value() && tree->GetComparator()(key, *upper_key) > 0) {
+            return false;
+        }
+        *rid = value;
+        ++(*iter);
+        return true;
+    };
 }
 
 auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-    // 1.判断是否遍历完了
-    if(begin_ == end_){
+    // 下推下来的limit已经满足了，不再遍历索引
+    if (plan_->limit_.has_value() && emitted_ >= *plan_->limit_) {
         return false;
     }
 
-    // 2.没有遍历完
-    *rid = (*begin_).second;
-    std::string name = exec_ctx_->GetCatalog()->GetIndex(plan_->index_oid_)->table_name_;  // 获取索引对应的表名（索引中存放了其对应的表名）
-    const TableInfo *table_info = exec_ctx_->GetCatalog()->GetTable(name);      // 根据表名获取对应的表信息
-    table_info->table_->GetTuple(*rid, tuple, exec_ctx_->GetTransaction());     // 根据rid从表中获取对应的元组
+    while (true) {
+        // 1.获取key范围内的下一个rid，范围遍历完了就结束
+        if (!next_rid_(rid)) {
+            return false;
+        }
 
-    // 3.迭代器加1(只有前置的++)
-    ++begin_;
+        // 2.根据rid从表中获取对应的元组
+        table_info_->table_->GetTuple(*rid, tuple, exec_ctx_->GetTransaction());
 
-    return true;
+        // 3.跳过不满足过滤条件（没有被key范围覆盖的条件）的元组
+        if (plan_->filter_predicate_ != nullptr) {
+            auto value = plan_->filter_predicate_->Evaluate(tuple, GetOutputSchema());
+            if (value.IsNull() || !value.GetAs<bool>()) {
+                continue;
+            }
+        }
+
+        emitted_++;
+        return true;
+    }
 }
 
 }  // namespace bustub
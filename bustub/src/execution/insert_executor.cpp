@@ -88,6 +88,9 @@ auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
         }
     }
 
+    // 3.更新表的统计信息（行数）
+    table_info_->stats_->UpdateRowCount(insert_count);
+
     Tuple temp_tuple(std::vector<Value>(1,Value(TypeId::INTEGER,insert_count)),&GetOutputSchema());
     *tuple = temp_tuple;
     has_no_tuple_ = true; // 插入完了更新为true
@@ -23,17 +23,25 @@ LimitExecutor::LimitExecutor(ExecutorContext *exec_ctx, const LimitPlanNode *pla
 
 void LimitExecutor::Init() {
     limit_count_ = plan_->GetLimit();
+    offset_count_ = plan_->GetOffset();
     child_executor_->Init();
 }
 
 auto LimitExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+    // 1.已经输出了limit个，不再向子执行器要tuple，子执行器不会多做一次Next
+    if(limit_count_ == 0){
+        return false;
+    }
+
+    // 2.跳过前offset个tuple
     while (child_executor_->Next(tuple, rid)){
-        if(limit_count_ > 0){
-            limit_count_--;
-            return true;
+        if(offset_count_ > 0){
+            offset_count_--;
+            continue;
         }
 
-        return false;
+        limit_count_--;
+        return true;
     }    
 
     return false;
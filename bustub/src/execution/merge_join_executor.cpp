@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.cpp
+//
+// Identification: src/execution/merge_join_executor.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/merge_join_executor.h"
+#include "binder/table_ref/bound_join_ref.h"
+#include "common/exception.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+MergeJoinExecutor::MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_child,
+                                     std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_child_executor_(std::move(left_child)),
+      right_child_executor_(std::move(right_child)) {
+  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
+    throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
+  }
+}
+
+void MergeJoinExecutor::Init() {
+  // 1.初始化两个子查询，预读右表的第一个tuple
+  left_child_executor_->Init();
+  right_child_executor_->Init();
+  has_left_ = false;
+  left_matched_ = false;
+  right_run_.clear();
+  run_index_ = 0;
+  FetchRight();
+}
+
+void MergeJoinExecutor::FetchRight() {
+  RID right_rid;
+  has_right_ = right_child_executor_->Next(&right_tuple_, &right_rid);
+  if (has_right_) {
+    right_key_ = plan_->RightJoinKeyExpression().Evaluate(&right_tuple_, right_child_executor_->GetOutputSchema());
+  }
+}
+
+auto MergeJoinExecutor::SeekRightRun(const Value &key) -> bool {
+  // 1.左表是按key升序的，右表中key比它小的（以及NULL）不会再和后面的左表tuple匹配，直接跳过
+  while (has_right_ && (right_key_.IsNull() || right_key_.CompareLessThan(key) == CmpBool::CmpTrue)) {
+    FetchRight();
+  }
+  if (!has_right_ || right_key_.CompareEquals(key) != CmpBool::CmpTrue) {
+    return false;
+  }
+
+  // 2.把右表中key相同的tuple都读进right_run_
+  right_run_.clear();
+  run_key_ = key;
+  while (has_right_ && right_key_.CompareEquals(key) == CmpBool::CmpTrue) {
+    right_run_.push_back(right_tuple_);
+    FetchRight();
+  }
+  return true;
+}
+
+auto MergeJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  const auto &left_schema = left_child_executor_->GetOutputSchema();
+  const auto &right_schema = right_child_executor_->GetOutputSchema();
+
+  while (true) {
+    // 1.当前的左表tuple依次和right_run_中的tuple连接
+    if (has_left_) {
+      if (left_matched_ && run_index_ < right_run_.size()) {
+        const auto &right_tuple = right_run_[run_index_++];
+        std::vector<Value> values;
+        for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+          values.push_back(left_tuple_.GetValue(&left_schema, i));
+        }
+        for (uint32_t j = 0; j < right_schema.GetColumnCount(); j++) {
+          values.push_back(right_tuple.GetValue(&right_schema, j));
+        }
+        *tuple = Tuple(values, &plan_->OutputSchema());
+        return true;
+      }
+      has_left_ = false;
+
+      // 1.1.没有找到匹配的tuple且是左连接，右表的列补NULL
+      if (!left_matched_ && plan_->GetJoinType() == JoinType::LEFT) {
+        std::vector<Value> values;
+        for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+          values.push_back(left_tuple_.GetValue(&left_schema, i));
+        }
+        for (uint32_t j = 0; j < right_schema.GetColumnCount(); j++) {
+          values.push_back(ValueFactory::GetNullValueByType(right_schema.GetColumn(j).GetType()));
+        }
+        *tuple = Tuple(values, &plan_->OutputSchema());
+        return true;
+      }
+    }
+
+    // 2.获取左表的下一个tuple
+    RID left_rid;
+    if (!left_child_executor_->Next(&left_tuple_, &left_rid)) {
+      return false;
+    }
+    has_left_ = true;
+    run_index_ = 0;
+
+    // 3.key和上一个左表tuple相同时复用right_run_，否则在右表中向后查找，NULL不和任何值相等
+    auto left_key = plan_->LeftJoinKeyExpression().Evaluate(&left_tuple_, left_schema);
+    if (left_key.IsNull()) {
+      left_matched_ = false;
+    } else if (!right_run_.empty() && run_key_.CompareEquals(left_key) == CmpBool::CmpTrue) {
+      left_matched_ = true;
+    } else {
+      left_matched_ = SeekRightRun(left_key);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -21,7 +21,8 @@ NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const Ne
     : AbstractExecutor(exec_ctx),
       plan_(plan),
       child_executor_(std::forward<std::unique_ptr<AbstractExecutor>>(child_executor)){
-  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
+  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER ||
+        plan->GetJoinType() == JoinType::SEMI || plan->GetJoinType() == JoinType::ANTI)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
@@ -50,12 +51,23 @@ auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
     auto left_schema = child_executor_->GetOutputSchema();
     auto right_schema = inner_table_info_->schema_;
     auto key_schema = inner_table_index_info_->index_->GetKeySchema();
-    auto key = plan_->KeyPredicate()->Evaluate(&left_tuple_,right_schema);
+    auto key = plan_->KeyPredicate()->Evaluate(&left_tuple_,left_schema);
     key_value.push_back(key);
     Tuple key_tuple(key_value,key_schema);
 
-    // 3.获取rid
-    inner_table_index_info_->index_->ScanKey(key_tuple, &result_rid, exec_ctx_->GetTransaction());
+    // 3.获取rid（NULL不和任何值相等，不需要查索引）
+    if(!key.IsNull()){
+      inner_table_index_info_->index_->ScanKey(key_tuple, &result_rid, exec_ctx_->GetTransaction());
+    }
+
+    // 3.1.半连接输出找到匹配的左表tuple，反连接输出没有找到匹配的左表tuple，输出的只有左表的列
+    if(plan_->GetJoinType() == JoinType::SEMI || plan_->GetJoinType() == JoinType::ANTI){
+      if(result_rid.empty() == (plan_->GetJoinType() == JoinType::ANTI)){
+        *tuple = left_tuple_;
+        return true;
+      }
+      continue;
+    }
 
     // 4.获取对应的tuple
     std::vector<Value> value;
@@ -11,6 +11,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "execution/executors/nested_loop_join_executor.h"
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "buffer/buffer_pool_manager.h"
 #include "binder/table_ref/bound_join_ref.h"
 #include "common/exception.h"
 #include "common/rid.h"
@@ -27,105 +31,232 @@ NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext *exec_ctx, const
       left_executor_(std::forward<std::unique_ptr<AbstractExecutor>>(left_executor)),
       right_executor_(std::forward<std::unique_ptr<AbstractExecutor>>(right_executor)),
       has_no_tuple_(false){
-  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
+  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER ||
+        plan->GetJoinType() == JoinType::SEMI || plan->GetJoinType() == JoinType::ANTI)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestedLoopJoinExecutor::Init() { 
+NestedLoopJoinExecutor::~NestedLoopJoinExecutor() { DropSpilledChunks(); }
+
+void NestedLoopJoinExecutor::Init() {
+  // 1.初始化左右子执行器，清空上一次执行留下的状态
   left_executor_->Init();
   right_executor_->Init();
-  is_matched_ = false;
-  left_is_initialized_ = false;
-  right_is_need_initialized_ = false;
+  left_block_.clear();
+  left_matched_.clear();
+  loaded_chunk_.clear();
+  has_no_tuple_ = false;
+
+  // 2.右表只执行一次，把结果物化下来，之后每个左表的块都和物化的结果连接
+  MaterializeInner();
+  chunk_idx_ = 0;
+  left_idx_ = 0;
+  inner_idx_ = 0;
+  chunk_ = &resident_chunk_;
 }
 
 auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  RID left_rid;
-  Tuple right_tuple;
-  RID right_rid;
-
   if(has_no_tuple_){
     return false;
   }
-  // 1.判断left_tuple_是否是初始化的
-  // 如果left_tuple_为空，需要从获取一个，如果不为空，则不需要获取，同时如果获取不到说明已经连接结束了
-  // if(left_tuple_.GetLength() == 0){ // 说明是未初始化的
-  //   if(!left_executor_->Next(&left_tuple_, &left_rid)){
-  //     return false; // 获取失败了说明是已经连接结束了
-  //   }
-  // }
-  if(!left_is_initialized_){
-    if(!left_executor_->Next(&left_tuple_, &left_rid)){
-      return false; // 获取失败了说明是已经连接结束了
-    }
-    left_is_initialized_ = true;
-  }
+  bool semi_or_anti = plan_->join_type_ == JoinType::SEMI || plan_->join_type_ == JoinType::ANTI;
 
-  // 2.不断获取右表的tuple，判断是否匹配，匹配不成功，获取下一个tuple
   while(true){
-    // 2.1.获取右表的tuple
-    if(right_is_need_initialized_ || !right_executor_->Next(&right_tuple, &right_rid)){ // 右表遍历完了
-      // 更改右表的标记位，表示已经遍历到了右表的尾部
-      right_is_need_initialized_ = true;
-
-      // 右表遍历完了之后需要判断是否找到了可以匹配的连接对象，这里针对左连接特殊处理
-      if(!is_matched_ && plan_->join_type_ == JoinType::LEFT){ // 没有找到且是左连接
-        is_matched_ = true; // 更改标记位
-
-        std::vector<Value> value;
-        auto left_schema = left_executor_->GetOutputSchema();
-        auto right_schema = right_executor_->GetOutputSchema();
-        // 2.1.1.获取左表中对应的数据列
-        for(uint32_t i = 0;i < left_schema.GetColumnCount();i++){
-          value.push_back(left_tuple_.GetValue(&left_schema, i));
-        }
-        // 2.1.2.获取右表中对应的数据列
-        for(uint32_t j = 0;j < right_schema.GetColumnCount();j++){
-          value.push_back(ValueFactory::GetNullValueByType(right_schema.GetColumn(j).GetType())); //GetNullValueByType(TypeId::INTEGER)
+    // 1.当前chunk和块中所有的左表tuple都连接完了，换下一个chunk；所有chunk都连接完了，换下一个块
+    if(left_idx_ >= left_block_.size()){
+      if(!left_block_.empty() && chunk_idx_ + 1 < 1 + spilled_chunks_.size()){
+        chunk_idx_++;
+      }else if(NextLeftBlock()){
+        chunk_idx_ = 0;
+      }else{
+        has_no_tuple_ = true;
+        return false;
+      }
+      LoadChunk();
+      left_idx_ = 0;
+      inner_idx_ = 0;
+      continue;
+    }
+
+    const auto &left_tuple = left_block_[left_idx_];
+    bool last_chunk = chunk_idx_ == spilled_chunks_.size();
+
+    // 2.半连接和反连接只需要知道左表tuple有没有匹配，找到第一个就可以停止
+    if(semi_or_anti){
+      if(!left_matched_[left_idx_]){
+        for(const auto &right_tuple : *chunk_){
+          if(Matches(left_tuple, right_tuple)){
+            left_matched_[left_idx_] = true;
+            break;
+          }
         }
-        // 2.1.3.创建新的tuple，并返回true
-        *tuple = Tuple(value,&plan_->OutputSchema());
+      }
+      left_idx_++;
+      // 最后一个chunk连接完才能确定有没有匹配，输出的只有左表的列
+      if(last_chunk && left_matched_[left_idx_ - 1] == (plan_->join_type_ == JoinType::SEMI)){
+        *tuple = left_tuple;
         return true;
       }
+      continue;
+    }
 
-      if(left_executor_->Next(&left_tuple_, &left_rid)){ // 左表获取到了下一个
-        is_matched_ = false; // 初始化为false
-      }else{  // 左表遍历完了
-        has_no_tuple_ = true;
-        return false; // 连接结束，右表不需要回溯
+    // 3.内连接和左连接：在chunk中继续查找和当前左表tuple匹配的右表tuple
+    while(inner_idx_ < chunk_->size()){
+      const auto &right_tuple = (*chunk_)[inner_idx_++];
+      if(Matches(left_tuple, right_tuple)){
+        left_matched_[left_idx_] = true;
+        *tuple = MakeOutput(left_tuple, &right_tuple);
+        return true;
       }
+    }
+
+    // 4.当前左表tuple和这个chunk连接完了；左连接在最后一个chunk之后输出没有匹配的左表tuple
+    left_idx_++;
+    inner_idx_ = 0;
+    if(last_chunk && !left_matched_[left_idx_ - 1] && plan_->join_type_ == JoinType::LEFT){
+      *tuple = MakeOutput(left_block_[left_idx_ - 1], nullptr);
+      return true;
+    }
+  }
+}
+
+void NestedLoopJoinExecutor::MaterializeInner() {
+  DropSpilledChunks();
+  resident_chunk_.clear();
+  spill_buffer_.clear();
 
-      // 右表需要回溯，并更新right_tuple
-      right_executor_->Init();
-      right_executor_->Next(&right_tuple, &right_rid);
-      right_is_need_initialized_ = false;
+  Tuple right_tuple;
+  RID right_rid;
+  size_t resident_bytes = 0;
+  size_t chunk_bytes = 0;
+  while(right_executor_->Next(&right_tuple, &right_rid)){
+    // 1.内存预算之内的tuple常驻内存
+    size_t size = sizeof(Tuple) + right_tuple.GetLength();
+    if(resident_bytes + size <= NLJ_INNER_MEMORY_BUDGET){
+      resident_bytes += size;
+      resident_chunk_.push_back(std::move(right_tuple));
+      continue;
     }
 
-    // 2.2.判断是否匹配，如果匹配成功
-    if(right_tuple.GetLength() != 0 && 
-          plan_->Predicate().EvaluateJoin(&left_tuple_, left_executor_->GetOutputSchema(), 
-          &right_tuple, right_executor_->GetOutputSchema()).CompareEquals(Value(TypeId::BOOLEAN,
-          static_cast<int8_t>(1))) == CmpBool::CmpTrue){
-      is_matched_ = true; // 标记当前左表的tuple在右表中找到了可以连接的对象
-      
-      std::vector<Value> value;
-      auto left_schema = left_executor_->GetOutputSchema();
-      auto right_schema = right_executor_->GetOutputSchema();
-      // 2.2.1.获取左表中对应的数据列
-      for(uint32_t i = 0;i < left_schema.GetColumnCount();i++){
-        value.push_back(left_tuple_.GetValue(&left_schema, i));
-      }
-      // 2.2.2.获取右表中对应的数据列
-      for(uint32_t j = 0;j < right_schema.GetColumnCount();j++){
-        value.push_back(right_tuple.GetValue(&right_schema, j));
+    // 2.超出预算的tuple写到溢出页中，每个chunk的大小也不超过预算，这样一次可以把一个chunk读到内存里
+    uint32_t record_size = sizeof(uint32_t) + right_tuple.GetLength();
+    if(record_size > BUSTUB_PAGE_SIZE){
+      throw ExecutionException("nested loop join: inner tuple larger than a page");
+    }
+    if(spilled_chunks_.empty() || chunk_bytes + size > NLJ_INNER_MEMORY_BUDGET){
+      FlushSpillPage();
+      spilled_chunks_.emplace_back();
+      chunk_bytes = 0;
+    }
+    if(spill_buffer_.size() + record_size > BUSTUB_PAGE_SIZE){
+      FlushSpillPage();
+    }
+    chunk_bytes += size;
+    auto offset = spill_buffer_.size();
+    spill_buffer_.resize(offset + record_size);
+    right_tuple.SerializeTo(spill_buffer_.data() + offset);
+  }
+  FlushSpillPage();
+}
+
+auto NestedLoopJoinExecutor::NextLeftBlock() -> bool {
+  left_block_.clear();
+  Tuple left_tuple;
+  RID left_rid;
+  size_t block_bytes = 0;
+  while(block_bytes < NLJ_BLOCK_MEMORY_BUDGET && left_executor_->Next(&left_tuple, &left_rid)){
+    block_bytes += sizeof(Tuple) + left_tuple.GetLength();
+    left_block_.push_back(std::move(left_tuple));
+  }
+  left_matched_.assign(left_block_.size(), false);
+  return !left_block_.empty();
+}
+
+void NestedLoopJoinExecutor::LoadChunk() {
+  if(chunk_idx_ == 0){
+    chunk_ = &resident_chunk_;
+    return;
+  }
+
+  // 把一个chunk的溢出页都读到内存里，读的时候不用一直pin着页
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  loaded_chunk_.clear();
+  for(auto page_id : spilled_chunks_[chunk_idx_ - 1]){
+    auto *page = bpm->FetchPage(page_id);
+    if(page == nullptr){
+      throw ExecutionException("nested loop join: no free frame in the buffer pool to read the inner side");
+    }
+    page->RLatch();
+    size_t offset = 0;
+    while(offset + sizeof(uint32_t) <= BUSTUB_PAGE_SIZE){
+      uint32_t size;
+      memcpy(&size, page->GetData() + offset, sizeof(uint32_t));
+      if(size == 0){
+        break;
       }
-      // 2.2.3.创建新的tuple，并返回true
-      *tuple = Tuple(value,&plan_->OutputSchema());
-      return true;
+      Tuple tuple;
+      tuple.DeserializeFrom(page->GetData() + offset);
+      loaded_chunk_.push_back(std::move(tuple));
+      offset += sizeof(uint32_t) + size;
     }
+    page->RUnlatch();
+    bpm->UnpinPage(page_id, false);
+  }
+  chunk_ = &loaded_chunk_;
+}
+
+void NestedLoopJoinExecutor::FlushSpillPage() {
+  if(spill_buffer_.empty()){
+    return;
+  }
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  page_id_t page_id;
+  auto *page = bpm->NewPage(&page_id);
+  if(page == nullptr){
+    throw ExecutionException("nested loop join: no free frame in the buffer pool to materialize the inner side");
+  }
+  page->WLatch();
+  memset(page->GetData(), 0, BUSTUB_PAGE_SIZE); // 剩下的部分全是0，读到长度为0就说明这一页结束了
+  memcpy(page->GetData(), spill_buffer_.data(), spill_buffer_.size());
+  page->WUnlatch();
+  bpm->UnpinPage(page_id, true);
+  spilled_chunks_.back().push_back(page_id);
+  spill_buffer_.clear();
+}
+
+void NestedLoopJoinExecutor::DropSpilledChunks() {
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  for(const auto &chunk : spilled_chunks_){
+    for(auto page_id : chunk){
+      bpm->DeletePage(page_id);
+    }
+  }
+  spilled_chunks_.clear();
+}
+
+auto NestedLoopJoinExecutor::Matches(const Tuple &left, const Tuple &right) const -> bool {
+  auto value = plan_->Predicate().EvaluateJoin(&left, left_executor_->GetOutputSchema(), &right,
+                                               right_executor_->GetOutputSchema());
+  return !value.IsNull() && value.GetAs<bool>();
+}
+
+auto NestedLoopJoinExecutor::MakeOutput(const Tuple &left, const Tuple *right) const -> Tuple {
+  std::vector<Value> values;
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  values.reserve(left_schema.GetColumnCount() + right_schema.GetColumnCount());
+  // 1.左表的列
+  for(uint32_t i = 0; i < left_schema.GetColumnCount(); i++){
+    values.push_back(left.GetValue(&left_schema, i));
+  }
+  // 2.右表的列，左连接没有匹配的时候全是NULL
+  for(uint32_t j = 0; j < right_schema.GetColumnCount(); j++){
+    values.push_back(right != nullptr ? right->GetValue(&right_schema, j)
+                                      : ValueFactory::GetNullValueByType(right_schema.GetColumn(j).GetType()));
   }
+  return Tuple(values, &plan_->OutputSchema());
 }
 
 }  // namespace bustub
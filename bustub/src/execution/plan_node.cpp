@@ -10,6 +10,7 @@
 #include "execution/plans/nested_loop_join_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/window_plan.h"
 
 namespace bustub {
 
@@ -73,10 +74,39 @@ auto AggregationPlanNode::InferAggSchema(const std::vector<AbstractExpressionRef
     }
   }
   for (size_t idx = 0; idx < aggregates.size(); idx++) {
-    // TODO(chi): correctly infer agg call return type
-    output.emplace_back(Column("<unnamed>", TypeId::INTEGER));
+    output.emplace_back(Column("<unnamed>", InferAggReturnType(aggregates[idx], agg_types[idx])));
   }
   return Schema(output);
 }
 
+auto AggregationPlanNode::InferAggReturnType(const AbstractExpressionRef &aggregate, AggregationType agg_type)
+    -> TypeId {
+  switch (agg_type) {
+    case AggregationType::SumAggregate:
+    case AggregationType::MinAggregate:
+    case AggregationType::MaxAggregate:
+      if (aggregate->GetReturnType() == TypeId::FIXED_DECIMAL) {
+        return TypeId::FIXED_DECIMAL;
+      }
+      break;
+    default:
+      break;
+  }
+  // TODO(chi): correctly infer agg call return type
+  return TypeId::INTEGER;
+}
+
+auto WindowFunctionPlanNode::InferWindowReturnType(const WindowFunction &window_function) -> TypeId {
+  switch (window_function.type_) {
+    case WindowFunctionType::SumAggregate:
+      return AggregationPlanNode::InferAggReturnType(window_function.function_, AggregationType::SumAggregate);
+    case WindowFunctionType::MinAggregate:
+      return AggregationPlanNode::InferAggReturnType(window_function.function_, AggregationType::MinAggregate);
+    case WindowFunctionType::MaxAggregate:
+      return AggregationPlanNode::InferAggReturnType(window_function.function_, AggregationType::MaxAggregate);
+    default:
+      return TypeId::INTEGER;
+  }
+}
+
 }  // namespace bustub
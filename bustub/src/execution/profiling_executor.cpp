@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// profiling_executor.cpp
+//
+// Identification: src/execution/profiling_executor.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/profiling_executor.h"
+
+#include <chrono>  // NOLINT
+
+#include "fmt/format.h"
+
+namespace bustub {
+
+auto ExecutorStats::ToString() const -> std::string {
+  auto to_ms = [](uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+  auto lock_waits = lock_wait_cnt_ == 0 ? "0" : fmt::format("{} ({:.3f}ms)", lock_wait_cnt_, to_ms(lock_wait_ns_));
+  return fmt::format("(actual init={:.3f}ms next={:.3f}ms rows={} loops={} pages={} misses={} lock_waits={})",
+                     to_ms(init_ns_), to_ms(next_ns_), row_cnt_, init_cnt_, page_fetch_cnt_, page_miss_cnt_,
+                     lock_waits);
+}
+
+ProfilingExecutor::ProfilingExecutor(ExecutorContext *exec_ctx, const AbstractPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx),
+      child_executor_(std::move(child_executor)),
+      stats_(&(*exec_ctx->GetProfile())[plan]) {}
+
+template <typename Func>
+auto ProfilingExecutor::Measure(uint64_t *elapsed_ns, Func &&func) {
+    // 1.记录执行前的时间、缓冲池和锁等待的计数
+    auto *bpm = exec_ctx_->GetBufferPoolManager();
+    auto *txn = exec_ctx_->GetTransaction();
+    auto fetch_cnt = bpm->GetFetchCount();
+    auto miss_cnt = bpm->GetMissCount();
+    auto lock_wait_cnt = txn->GetLockWaitCount();
+    auto lock_wait_ns = txn->GetLockWaitTime();
+    auto start = std::chrono::steady_clock::now();
+
+    // 2.执行被包装的算子
+    auto result = func();
+
+    // 3.把这段时间内的增量累加到统计信息中（包含了子算子的开销，执行是单线程的所以计数的增量都属于这个查询）
+    *elapsed_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    stats_->page_fetch_cnt_ += bpm->GetFetchCount() - fetch_cnt;
+    stats_->page_miss_cnt_ += bpm->GetMissCount() - miss_cnt;
+    stats_->lock_wait_cnt_ += txn->GetLockWaitCount() - lock_wait_cnt;
+    stats_->lock_wait_ns_ += txn->GetLockWaitTime() - lock_wait_ns;
+    return result;
+}
+
+void ProfilingExecutor::Init() {
+    stats_->init_cnt_++;
+    Measure(&stats_->init_ns_, [&] {
+        child_executor_->Init();
+        return true;
+    });
+}
+
+auto ProfilingExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+    auto has_next = Measure(&stats_->next_ns_, [&] { return child_executor_->Next(tuple, rid); });
+    if (has_next) {
+        stats_->row_cnt_++;
+    }
+    return has_next;
+}
+
+}  // namespace bustub
@@ -34,54 +34,85 @@ void SeqScanExecutor::Init() {
     
     // 2.获取表的迭代器
     table_iter_ = std::make_unique<TableIterator>(table_info_->table_->Begin(exec_ctx_->GetTransaction()));
+
+    // 3.获取hash join下推下来的runtime filter（hash join在初始化左表之前就已经建好了）
+    runtime_filters_.clear();
+    for(const auto &[filter_id, col_idx] : plan_->runtime_filters_){
+        if(const auto *filter = exec_ctx_->GetRuntimeFilter(filter_id); filter != nullptr){
+            runtime_filters_.emplace_back(filter, col_idx);
+        }
+    }
 }
 
 auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { 
-    // 1.判断是否已经迭代完了
-    if(*table_iter_ == table_info_->table_->End()){
-        // // 1.1.如果事务的隔离级别是读已提交，需要释放之前获取的IS
-        // try {
-        //     if(exec_ctx_->GetTransaction()->GetIsolationLevel() == IsolationLevel::READ_COMMITTED){
-        //         if(!exec_ctx_->GetLockManager()->UnlockTable(exec_ctx_->GetTransaction(), table_info_->oid_)){
-        //             throw ExecutionException(std::string("executor fail"));
-        //         }
-        //     }
-        // } catch (TransactionAbortException e) {
-        //     throw ExecutionException(e.GetInfo() + std::string(" executor fail"));
-        // }
+    while(true){
+        // 1.判断是否已经迭代完了
+        if(*table_iter_ == table_info_->table_->End()){
+            // // 1.1.如果事务的隔离级别是读已提交，需要释放之前获取的IS
+            // try {
+            //     if(exec_ctx_->GetTransaction()->GetIsolationLevel() == IsolationLevel::READ_COMMITTED){
+            //         if(!exec_ctx_->GetLockManager()->UnlockTable(exec_ctx_->GetTransaction(), table_info_->oid_)){
+            //             throw ExecutionException(std::string("executor fail"));
+            //         }
+            //     }
+            // } catch (TransactionAbortException e) {
+            //     throw ExecutionException(e.GetInfo() + std::string(" executor fail"));
+            // }
 
-        return false;
-    }
+            return false;
+        }
 
-    // 如果是读已提交或者可重复读，需要提前加S锁
-    try {
-        if(exec_ctx_->GetTransaction()->GetIsolationLevel() != IsolationLevel::READ_UNCOMMITTED){
-            if(!exec_ctx_->GetLockManager()->LockRow(exec_ctx_->GetTransaction(), 
-                LockManager::LockMode::SHARED,table_info_->oid_,(*table_iter_)->GetRid())){
-                throw ExecutionException(std::string("executor fail"));
+        // 在加锁和拷贝之前，跳过runtime filter中一定找不到的tuple，它们不可能和hash join右表中的tuple连接成功
+        bool may_match = true;
+        for(const auto &[filter, col_idx] : runtime_filters_){
+            if(!filter->MayContain((*table_iter_)->GetValue(&GetOutputSchema(), col_idx))){
+                may_match = false;
+                break;
             }
         }
-    } catch (TransactionAbortException e) {
-        throw ExecutionException(e.GetInfo() + std::string(" executor fail"));
-    }
+        if(!may_match){
+            ++(*table_iter_);
+            continue;
+        }
 
-    // 2.获取下一个tuple
-    *tuple = *(*table_iter_);   // 深拷贝
-    *rid = tuple->GetRid();
-    ++(*table_iter_);
+        // 如果是读已提交或者可重复读，需要提前加S锁
+        try {
+            if(exec_ctx_->GetTransaction()->GetIsolationLevel() != IsolationLevel::READ_UNCOMMITTED){
+                if(!exec_ctx_->GetLockManager()->LockRow(exec_ctx_->GetTransaction(), 
+                    LockManager::LockMode::SHARED,table_info_->oid_,(*table_iter_)->GetRid())){
+                    throw ExecutionException(std::string("executor fail"));
+                }
+            }
+        } catch (TransactionAbortException e) {
+            throw ExecutionException(e.GetInfo() + std::string(" executor fail"));
+        }
 
-    // 如果是读已提交或者可重复读，需要释放S锁
-    try {
-        if(exec_ctx_->GetTransaction()->GetIsolationLevel() != IsolationLevel::READ_UNCOMMITTED){
-            if(!exec_ctx_->GetLockManager()->UnlockRow(exec_ctx_->GetTransaction(),table_info_->oid_,(*table_iter_)->GetRid())){
-                throw ExecutionException(std::string("executor fail"));
+        // 2.获取下一个tuple
+        *tuple = *(*table_iter_);   // 深拷贝
+        *rid = tuple->GetRid();
+        ++(*table_iter_);
+
+        // 如果是读已提交或者可重复读，需要释放S锁
+        try {
+            if(exec_ctx_->GetTransaction()->GetIsolationLevel() == IsolationLevel::READ_COMMITTED){
+                if(!exec_ctx_->GetLockManager()->UnlockRow(exec_ctx_->GetTransaction(),table_info_->oid_,*rid)){
+                    throw ExecutionException(std::string("executor fail"));
+                }
+            }
+        } catch (TransactionAbortException e) {
+            throw ExecutionException(e.GetInfo() + std::string(" executor fail"));
+        }
+
+        // 3.如果scan上有下推下来的过滤条件，跳过不满足条件的tuple
+        if(plan_->filter_predicate_ != nullptr){
+            auto value = plan_->filter_predicate_->Evaluate(tuple, GetOutputSchema());
+            if(value.IsNull() || !value.GetAs<bool>()){
+                continue;
             }
         }
-    } catch (TransactionAbortException e) {
-        throw ExecutionException(e.GetInfo() + std::string(" executor fail"));
-    }
 
-    return true; 
+        return true;
+    }
 }
 
 }  // namespace bustub
@@ -1,5 +1,8 @@
 #include "execution/executors/sort_executor.h"
+#include <algorithm>
 #include <iterator>
+#include <numeric>
+#include <utility>
 #include "binder/bound_order_by.h"
 #include "common/rid.h"
 #include "storage/table/tuple.h"
@@ -22,7 +25,7 @@ void SortExecutor::Init() {
     Tuple tuple;
     RID rid;
     while(child_executor_->Next(&tuple, &rid)){
-        tuples_.push_back(tuple);
+        tuples_.push_back(std::move(tuple));
     }
 
     // for(const auto& t : tuples_){
@@ -79,59 +82,63 @@ auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
     }
 
     // 2.不为空(从尾部取出来)
-    *tuple = tuples_.back();
+    *tuple = std::move(tuples_.back());
     *rid = tuple->GetRid();
     tuples_.pop_back();
 
     return true;
 }
 
-// 对 vector 中的元素使用冒泡排序升序排序
+// 先把每个tuple的排序key算出来，再对下标做稳定排序，key相同的tuple保持原来的顺序（窗口函数的分区里一定有相同的key）
 void SortExecutor::SortTuples(std::vector<Tuple> &tuples) {
-  int n = tuples.size();
-  bool swapped = true;
-  while (swapped) {
-    swapped = false;
-    for (int i = 1; i < n; i++) {
-      if (!CompareTuples(tuples[i - 1], tuples[i])) {
-        std::swap(tuples[i - 1], tuples[i]);
-        swapped = true;
-      }
-    }
-    n--;
+  const auto &order_bys = plan_->GetOrderBy();
+  std::vector<std::vector<Value>> keys;
+  keys.reserve(tuples.size());
+  for (const auto &tuple : tuples) {
+    keys.emplace_back(MakeSortKey(tuple, order_bys, child_executor_->GetOutputSchema()));
+  }
+
+  std::vector<size_t> order(tuples.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return CompareSortKeys(keys[a], keys[b], order_bys) < 0;
+  });
+
+  std::vector<Tuple> sorted;
+  sorted.reserve(tuples.size());
+  for (auto idx : order) {
+    sorted.push_back(std::move(tuples[idx]));
   }
+  tuples = std::move(sorted);
 }
 
-// 比较两个 tuple 的大小关系
-auto SortExecutor::CompareTuples(Tuple &a, Tuple &b) -> bool{
-  for (auto [order_by_type, expression] : plan_->GetOrderBy()) {
-    auto value_a = expression->Evaluate(&a, child_executor_->GetOutputSchema());
-    auto value_b = expression->Evaluate(&b, child_executor_->GetOutputSchema());
+auto SortExecutor::MakeSortKey(const Tuple &tuple, const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys,
+                               const Schema &schema) -> std::vector<Value> {
+  std::vector<Value> key;
+  key.reserve(order_bys.size());
+  for (const auto &[order_by_type, expression] : order_bys) {
+    key.emplace_back(expression->Evaluate(&tuple, schema));
+  }
+  return key;
+}
 
-    if(value_a.CompareEquals(value_b) == CmpBool::CmpTrue){
-        continue;
+// 依次比较每一列，NULL比其他值都小；降序的列把结果反过来
+auto SortExecutor::CompareSortKeys(const std::vector<Value> &a, const std::vector<Value> &b,
+                                   const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys) -> int {
+  for (size_t i = 0; i < order_bys.size(); i++) {
+    int cmp = 0;
+    if (a[i].IsNull() || b[i].IsNull()) {
+      cmp = static_cast<int>(!a[i].IsNull()) - static_cast<int>(!b[i].IsNull());
+    } else if (a[i].CompareLessThan(b[i]) == CmpBool::CmpTrue) {
+      cmp = -1;
+    } else if (a[i].CompareGreaterThan(b[i]) == CmpBool::CmpTrue) {
+      cmp = 1;
     }
-
-    if(order_by_type == OrderByType::DEFAULT || order_by_type == OrderByType::ASC){
-        if(value_a.CompareLessThan(value_b) == CmpBool::CmpTrue){
-            return true;
-        }
-
-        if(value_a.CompareGreaterThan(value_b) == CmpBool::CmpTrue){
-            return false;
-        }
-    }else if(order_by_type == OrderByType::DESC){
-        if(value_a.CompareGreaterThan(value_b) == CmpBool::CmpTrue){
-            return true;
-        }
-
-        if(value_a.CompareLessThan(value_b) == CmpBool::CmpTrue){
-            return false;
-        }
+    if (cmp != 0) {
+      return order_bys[i].first == OrderByType::DESC ? -cmp : cmp;
     }
   }
-
-  UNREACHABLE("doesn't support duplicate key");
+  return 0;
 }
 
 }  // namespace bustub
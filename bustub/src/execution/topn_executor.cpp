@@ -1,10 +1,11 @@
 #include "execution/executors/topn_executor.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
 #include <vector>
-#include "binder/bound_order_by.h"
 #include "common/rid.h"
 #include "execution/executors/abstract_executor.h"
-#include "execution/expressions/comparison_expression.h"
-#include "type/type.h"
+#include "execution/executors/sort_executor.h"
 
 namespace bustub {
 
@@ -12,126 +13,68 @@ TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx),
       plan_(plan),
-      child_executor_(std::forward<std::unique_ptr<AbstractExecutor>>(child_executor)) {
-    // priority_queue_ = std::priority_queue<Tuple,std::vector<Tuple>,decltype(&TopNExecutor::Compare)>(&TopNExecutor::Compare);
-}
+      child_executor_(std::forward<std::unique_ptr<AbstractExecutor>>(child_executor)) {}
 
 void TopNExecutor::Init() {
-    // 定义比较函数，并初始化一个优先队列
-    // auto compare = [this](const Tuple &a,const Tuple &b) -> bool{
-    //     for (auto [order_by_type, expression] : plan_->GetOrderBy()) {
-    //         auto value_a = expression->Evaluate(&a, child_executor_->GetOutputSchema());
-    //         auto value_b = expression->Evaluate(&b, child_executor_->GetOutputSchema());
-
-    //         if(value_a.CompareEquals(value_b) == CmpBool::CmpTrue){
-    //             continue;
-    //         }
-
-    //         if(order_by_type == OrderByType::DEFAULT || order_by_type == OrderByType::ASC){
-    //             if(value_a.CompareLessThan(value_b) == CmpBool::CmpTrue){
-    //                 return true;
-    //             }
-
-    //             if(value_a.CompareGreaterThan(value_b) == CmpBool::CmpTrue){
-    //                 return false;
-    //             }
-    //         }else if(order_by_type == OrderByType::DESC){
-    //             if(value_a.CompareGreaterThan(value_b) == CmpBool::CmpTrue){
-    //                 return true;
-    //             }
-
-    //             if(value_a.CompareLessThan(value_b) == CmpBool::CmpTrue){
-    //                 return false;
-    //             }
-    //         }
-    //     }
-
-    //     UNREACHABLE("doesn't support duplicate key");
-    // };
-    // std::priority_queue<Tuple,std::vector<Tuple>,decltype(compare)> priority_queue(compare);
-
-    // 1.获取限制的数量和初始化
-    limit_count_ = plan_->GetN();
+    // 1.初始化子执行器，清空上一次执行留下的状态
     child_executor_->Init();
+    heap_.clear();
+    output_.clear();
+    cursor_ = 0;
+
+    // 2.要保留前n+offset个，跳过的那offset个也要先排出来
+    size_t keep = plan_->GetN() > std::numeric_limits<size_t>::max() - plan_->GetOffset()
+                      ? std::numeric_limits<size_t>::max()
+                      : plan_->GetN() + plan_->GetOffset();
+    if(keep == 0){
+        return;
+    }
 
-    // 2.获取并添加到优先队列中
+    // 3.每个tuple的排序key只算一次；堆满了之后，只有排在堆顶前面的tuple才替换掉堆顶
+    auto cmp = [this](const HeapEntry &a, const HeapEntry &b){ return SortsBefore(a, b); };
+    const auto &schema = child_executor_->GetOutputSchema();
     Tuple tuple;
     RID rid;
-    std::vector<Tuple> tuples;
+    size_t seq = 0;
     while(child_executor_->Next(&tuple, &rid)){
-        tuples.push_back(tuple);
+        HeapEntry entry{SortExecutor::MakeSortKey(tuple, plan_->GetOrderBy(), schema), seq++, Tuple{}};
+        if(heap_.size() < keep){
+            entry.tuple_ = std::move(tuple);
+            heap_.push_back(std::move(entry));
+            std::push_heap(heap_.begin(), heap_.end(), cmp);
+            continue;
+        }
+        if(!SortsBefore(entry, heap_.front())){
+            continue;
+        }
+        entry.tuple_ = std::move(tuple);
+        std::pop_heap(heap_.begin(), heap_.end(), cmp);
+        heap_.back() = std::move(entry);
+        std::push_heap(heap_.begin(), heap_.end(), cmp);
     }
 
-
-    // 3.保存前limit_count_个tuple
-    SortTuples(tuples);
-    std::reverse(tuples.begin(),tuples.end());
-    while(!tuples.empty() && limit_count_ > 0){
-        queue_.push(tuples.back());
-        tuples.pop_back();
-        limit_count_--;
+    // 4.堆排序成升序，跳过前offset个
+    std::sort_heap(heap_.begin(), heap_.end(), cmp);
+    for(size_t i = plan_->GetOffset(); i < heap_.size(); i++){
+        output_.push_back(std::move(heap_[i].tuple_));
     }
+    heap_.clear();
 }
 
 auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-    // 1.判断队列是否为空
-    if(queue_.empty()){
+    // 1.判断是否已经全部输出
+    if(cursor_ >= output_.size()){
         return false;
     }
 
-    *tuple = queue_.front();
+    *tuple = std::move(output_[cursor_++]);
     *rid = tuple->GetRid();
-    queue_.pop();
-
     return true;
 }
 
-// 对 vector 中的元素使用冒泡排序升序排序
-void TopNExecutor::SortTuples(std::vector<Tuple> &tuples) {
-  int n = tuples.size();
-  bool swapped = true;
-  while (swapped) {
-    swapped = false;
-    for (int i = 1; i < n; i++) {
-      if (!CompareTuples(tuples[i - 1], tuples[i])) {
-        std::swap(tuples[i - 1], tuples[i]);
-        swapped = true;
-      }
-    }
-    n--;
-  }
-}
-
-// 比较两个 tuple 的大小关系
-auto TopNExecutor::CompareTuples(Tuple &a, Tuple &b) -> bool{
-  for (auto [order_by_type, expression] : plan_->GetOrderBy()) {
-    auto value_a = expression->Evaluate(&a, child_executor_->GetOutputSchema());
-    auto value_b = expression->Evaluate(&b, child_executor_->GetOutputSchema());
-
-    if(value_a.CompareEquals(value_b) == CmpBool::CmpTrue){
-        continue;
-    }
-
-    if(order_by_type == OrderByType::DEFAULT || order_by_type == OrderByType::ASC){
-        if(value_a.CompareLessThan(value_b) == CmpBool::CmpTrue){
-            return true;
-        }
-
-        if(value_a.CompareGreaterThan(value_b) == CmpBool::CmpTrue){
-            return false;
-        }
-    }else if(order_by_type == OrderByType::DESC){
-        if(value_a.CompareGreaterThan(value_b) == CmpBool::CmpTrue){
-            return true;
-        }
-
-        if(value_a.CompareLessThan(value_b) == CmpBool::CmpTrue){
-            return false;
-        }
-    }
-  }
-
-  UNREACHABLE("doesn't support duplicate key");
+auto TopNExecutor::SortsBefore(const HeapEntry &a, const HeapEntry &b) const -> bool {
+    int cmp = SortExecutor::CompareSortKeys(a.key_, b.key_, plan_->GetOrderBy());
+    return cmp < 0 || (cmp == 0 && a.seq_ < b.seq_);
 }
 
 }  // namespace bustub
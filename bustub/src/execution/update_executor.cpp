@@ -9,11 +9,13 @@
 // Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <cstring>
 #include <memory>
 #include <vector>
 
 #include "common/rid.h"
 #include "execution/executors/update_executor.h"
+#include "execution/expressions/column_value_expression.h"
 #include "type/type_id.h"
 #include "type/value.h"
 
@@ -26,7 +28,17 @@ UpdateExecutor::UpdateExecutor(ExecutorContext *exec_ctx, const UpdatePlanNode *
       child_executor_(std::forward<std::unique_ptr<AbstractExecutor>>(child_executor)),
       has_no_tuple_(false){
     table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->TableOid()); // 获取需要被更新的表的信息
-    table_indexes_info_ = exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->name_); // 获取被更新的表的所有索引的信息
+    // 获取被更新的表的所有索引的信息，只保留key中有列可能被修改的索引
+    // SET没有修改的列的表达式就是这一列本身，key全由这样的列组成的索引不需要维护
+    for(auto table_index_info : exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->name_)){
+        for(auto key_attr : table_index_info->index_->GetKeyAttrs()){
+            const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(plan_->target_expressions_[key_attr].get());
+            if(column_value_expr == nullptr || column_value_expr->GetColIdx() != key_attr){
+                table_indexes_info_.push_back(table_index_info);
+                break;
+            }
+        }
+    }
 }
 
 void UpdateExecutor::Init() {
@@ -61,14 +73,17 @@ auto UpdateExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
             return false;
         }
 
-        // 1.3.更新所有的索引（先删除在添加）
+        // 1.3.更新key可能变化的索引（先删除在添加），tuple变大时会被移到其他页，但rid不变，key没变的索引不需要维护
         for(auto table_index_info : table_indexes_info_){
-            // 1.3.1.获取更新之前索引table_index_info对应的before_update_tuple的key
+            // 1.3.1.获取更新前后索引table_index_info对应的key，key没有变化则跳过
             auto old_key = old_tuple.KeyFromTuple(table_info_->schema_, table_index_info->key_schema_, table_index_info->index_->GetKeyAttrs());
-            table_index_info->index_->DeleteEntry(old_key, old_rid, exec_ctx_->GetTransaction());
-            
-            // 1.3.2.获取更新之后索引table_index_info对应的update_tuple的key
             auto new_key = new_tuple.KeyFromTuple(table_info_->schema_, table_index_info->key_schema_, table_index_info->index_->GetKeyAttrs());
+            if(old_key.GetLength() == new_key.GetLength() && memcmp(old_key.GetData(), new_key.GetData(), old_key.GetLength()) == 0){
+                continue;
+            }
+
+            // 1.3.2.删除旧的key，插入新的key
+            table_index_info->index_->DeleteEntry(old_key, old_rid, exec_ctx_->GetTransaction());
             table_index_info->index_->InsertEntry(new_key, old_rid, exec_ctx_->GetTransaction());
         }
 
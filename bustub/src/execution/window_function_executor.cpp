@@ -0,0 +1,192 @@
+#include "execution/executors/window_function_executor.h"
+#include <unordered_map>
+#include <utility>
+#include "execution/executors/sort_executor.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+WindowFunctionExecutor::WindowFunctionExecutor(ExecutorContext *exec_ctx, const WindowFunctionPlanNode *plan,
+                                               std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
+    for(const auto &expr : plan_->partition_by_){
+        partition_keys_.emplace_back(OrderByType::ASC, expr);
+    }
+}
+
+void WindowFunctionExecutor::Init() {
+    // 1.初始化子执行器
+    child_executor_->Init();
+
+    // 2.清空上一次执行留下的状态
+    partition_.clear();
+    order_keys_.clear();
+    output_.clear();
+    cursor_ = 0;
+    has_lookahead_ = false;
+    child_done_ = false;
+}
+
+auto WindowFunctionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+    // 1.当前分区的输出已经取完了，就去计算下一个分区
+    while(cursor_ >= output_.size()){
+        if(!NextPartition()){
+            return false;
+        }
+    }
+
+    // 2.输出当前分区的下一个tuple
+    *tuple = std::move(output_[cursor_++]);
+    *rid = tuple->GetRid();
+    return true;
+}
+
+auto WindowFunctionExecutor::NextPartition() -> bool {
+    const auto &child_schema = child_executor_->GetOutputSchema();
+    partition_.clear();
+    order_keys_.clear();
+    output_.clear();
+    cursor_ = 0;
+
+    // 1.拿到新分区的第一个tuple：上一次多读出来的那个，或者从子执行器读一个
+    RID rid;
+    if(!has_lookahead_){
+        if(child_done_ || !child_executor_->Next(&lookahead_, &rid)){
+            child_done_ = true;
+            return false;
+        }
+        lookahead_partition_key_ = SortExecutor::MakeSortKey(lookahead_, partition_keys_, child_schema);
+        has_lookahead_ = true;
+    }
+
+    // 2.一直读到分区key变化为止，子执行器已经按分区key排好序了
+    auto partition_key = std::move(lookahead_partition_key_);
+    while(has_lookahead_){
+        order_keys_.emplace_back(SortExecutor::MakeSortKey(lookahead_, plan_->order_by_, child_schema));
+        partition_.push_back(std::move(lookahead_));
+        if(!child_executor_->Next(&lookahead_, &rid)){
+            has_lookahead_ = false;
+            child_done_ = true;
+            break;
+        }
+        lookahead_partition_key_ = SortExecutor::MakeSortKey(lookahead_, partition_keys_, child_schema);
+        if(SortExecutor::CompareSortKeys(lookahead_partition_key_, partition_key, partition_keys_) != 0){
+            break;
+        }
+    }
+
+    // 3.计算每个窗口函数在这个分区上的结果
+    std::unordered_map<uint32_t, std::vector<Value>> results;
+    for(const auto &[col_idx, window_function] : plan_->window_functions_){
+        results.emplace(col_idx, ComputeWindowFunction(window_function));
+    }
+
+    // 4.拼出输出的tuple，普通的列直接在子执行器的tuple上求值
+    output_.reserve(partition_.size());
+    for(size_t i = 0; i < partition_.size(); i++){
+        std::vector<Value> values;
+        values.reserve(plan_->columns_.size());
+        for(uint32_t col_idx = 0; col_idx < plan_->columns_.size(); col_idx++){
+            auto it = results.find(col_idx);
+            if(it != results.end()){
+                values.push_back(std::move(it->second[i]));
+            }else{
+                values.push_back(plan_->columns_[col_idx]->Evaluate(&partition_[i], child_schema));
+            }
+        }
+        output_.emplace_back(std::move(values), &GetOutputSchema());
+    }
+    return true;
+}
+
+auto WindowFunctionExecutor::ComputeWindowFunction(const WindowFunctionPlanNode::WindowFunction &window_function)
+    -> std::vector<Value> {
+    std::vector<Value> results;
+    results.reserve(partition_.size());
+    auto type = window_function.type_;
+
+    // 1.排名类的函数只看peer组（ORDER BY相同的连续几行），和帧无关
+    if(type == WindowFunctionType::RowNumber || type == WindowFunctionType::Rank || type == WindowFunctionType::DenseRank){
+        size_t group_start = 0;
+        int32_t dense_rank = 0;
+        for(size_t i = 0; i < partition_.size(); i++){
+            if(i == 0 || !IsPeer(i - 1, i)){
+                group_start = i;
+                dense_rank++;
+            }
+            if(type == WindowFunctionType::RowNumber){
+                results.push_back(ValueFactory::GetIntegerValue(static_cast<int32_t>(i + 1)));
+            }else if(type == WindowFunctionType::Rank){
+                results.push_back(ValueFactory::GetIntegerValue(static_cast<int32_t>(group_start + 1)));
+            }else{
+                results.push_back(ValueFactory::GetIntegerValue(dense_rank));
+            }
+        }
+        return results;
+    }
+
+    // 2.聚合类的函数：count从0开始，其他的从NULL开始
+    const auto &child_schema = child_executor_->GetOutputSchema();
+    auto result_type = WindowFunctionPlanNode::InferWindowReturnType(window_function);
+    Value result = (type == WindowFunctionType::CountStarAggregate || type == WindowFunctionType::CountAggregate)
+                       ? ValueFactory::GetIntegerValue(0)
+                       : ValueFactory::GetNullValueByType(result_type);
+
+    // 3.每次把一段行加进聚合值，再把聚合值赋给这一段的每一行：
+    //   整个分区的帧就是一整段；ROWS帧每行一段（累计值）；RANGE帧一个peer组一段（peer的值相同）
+    size_t begin = 0;
+    while(begin < partition_.size()){
+        size_t end = begin + 1;
+        if(window_function.frame_ == WindowFrameType::PARTITION){
+            end = partition_.size();
+        }else if(window_function.frame_ == WindowFrameType::RANGE_TO_CURRENT){
+            while(end < partition_.size() && IsPeer(begin, end)){
+                end++;
+            }
+        }
+        for(size_t i = begin; i < end; i++){
+            Accumulate(type, window_function.function_->Evaluate(&partition_[i], child_schema), &result);
+        }
+        for(size_t i = begin; i < end; i++){
+            results.push_back(result);
+        }
+        begin = end;
+    }
+    return results;
+}
+
+auto WindowFunctionExecutor::IsPeer(size_t i, size_t j) const -> bool {
+    return SortExecutor::CompareSortKeys(order_keys_[i], order_keys_[j], plan_->order_by_) == 0;
+}
+
+void WindowFunctionExecutor::Accumulate(WindowFunctionType type, const Value &input, Value *result) {
+    switch(type){
+        case WindowFunctionType::CountStarAggregate:
+            *result = result->Add(ValueFactory::GetIntegerValue(1));
+            break;
+        case WindowFunctionType::CountAggregate:
+            if(!input.IsNull()){
+                *result = result->Add(ValueFactory::GetIntegerValue(1));
+            }
+            break;
+        case WindowFunctionType::SumAggregate:
+            if(!input.IsNull()){
+                *result = result->IsNull() ? input : result->Add(input);
+            }
+            break;
+        case WindowFunctionType::MinAggregate:
+            if(!input.IsNull()){
+                *result = result->IsNull() ? input : result->Min(input);
+            }
+            break;
+        case WindowFunctionType::MaxAggregate:
+            if(!input.IsNull()){
+                *result = result->IsNull() ? input : result->Max(input);
+            }
+            break;
+        default:
+            UNREACHABLE("not an aggregate window function");
+    }
+}
+
+}  // namespace bustub
@@ -21,6 +21,9 @@ enum class ExpressionType : uint8_t {
   UNARY_OP = 8,   /**< Unary expression type. */
   BINARY_OP = 9,  /**< Binary expression type. */
   ALIAS = 10,     /**< Alias expression type. */
+  PARAMETER = 11, /**< Parameter of a prepared statement. */
+  SUBQUERY = 12,  /**< IN / EXISTS subquery. */
+  WINDOW = 13,    /**< Window function call. */
 };
 
 /**
@@ -98,6 +101,15 @@ struct fmt::formatter<bustub::ExpressionType> : formatter<string_view> {
       case bustub::ExpressionType::ALIAS:
         name = "Alias";
         break;
+      case bustub::ExpressionType::PARAMETER:
+        name = "Parameter";
+        break;
+      case bustub::ExpressionType::SUBQUERY:
+        name = "Subquery";
+        break;
+      case bustub::ExpressionType::WINDOW:
+        name = "Window";
+        break;
     }
     return formatter<string_view>::format(name, ctx);
   }
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "binder/bound_expression.h"
+#include "binder/statement/select_statement.h"
+#include "common/util/string_util.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/** The kind of a subquery expression. */
+enum class SubqueryType : uint8_t {
+  EXISTS = 0, /**< `EXISTS (SELECT ...)` */
+  IN = 1,     /**< `x IN (SELECT ...)` */
+};
+
+/**
+ * A bound subquery expression, e.g., `EXISTS (SELECT ...)` or `x IN (SELECT y ...)`. The subquery may reference the
+ * columns of the outer query (correlated subquery). `NOT EXISTS` / `NOT IN` are bound as a `not` on top of it.
+ */
+class BoundSubqueryExpr : public BoundExpression {
+ public:
+  BoundSubqueryExpr(SubqueryType subquery_type, std::unique_ptr<BoundExpression> child,
+                    std::unique_ptr<SelectStatement> subquery)
+      : BoundExpression(ExpressionType::SUBQUERY),
+        subquery_type_(subquery_type),
+        child_(std::move(child)),
+        subquery_(std::move(subquery)) {}
+
+  auto ToString() const -> std::string override {
+    if (subquery_type_ == SubqueryType::EXISTS) {
+      return fmt::format("EXISTS ({})", StringUtil::IndentAllLines(subquery_->ToString(), 2, true));
+    }
+    return fmt::format("({} IN ({}))", child_, StringUtil::IndentAllLines(subquery_->ToString(), 2, true));
+  }
+
+  auto HasAggregation() const -> bool override { return false; }
+
+  /** EXISTS or IN. */
+  SubqueryType subquery_type_;
+
+  /** The left side of IN, nullptr for EXISTS. */
+  std::unique_ptr<BoundExpression> child_;
+
+  /** The subquery. */
+  std::unique_ptr<SelectStatement> subquery_;
+};
+
+}  // namespace bustub
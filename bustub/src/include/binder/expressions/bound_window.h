@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_expression.h"
+#include "binder/bound_order_by.h"
+
+namespace bustub {
+
+/** The frames a window function can be computed over. */
+enum class WindowFrameType : uint8_t {
+  PARTITION = 0,        /**< The whole partition, the default without ORDER BY. */
+  RANGE_TO_CURRENT = 1, /**< From the start of the partition to the last peer of the current row, the default with
+                           ORDER BY. */
+  ROWS_TO_CURRENT = 2,  /**< From the start of the partition to the current row. */
+};
+
+/**
+ * A bound window function call, e.g., `rank() OVER (PARTITION BY x ORDER BY y)` or `sum(z) OVER (ORDER BY y)`.
+ */
+class BoundWindow : public BoundExpression {
+ public:
+  BoundWindow(std::string func_name, std::vector<std::unique_ptr<BoundExpression>> args,
+              std::vector<std::unique_ptr<BoundExpression>> partition_by,
+              std::vector<std::unique_ptr<BoundOrderBy>> order_bys, WindowFrameType frame)
+      : BoundExpression(ExpressionType::WINDOW),
+        func_name_(std::move(func_name)),
+        args_(std::move(args)),
+        partition_by_(std::move(partition_by)),
+        order_bys_(std::move(order_bys)),
+        frame_(frame) {}
+
+  auto ToString() const -> std::string override;
+
+  auto HasAggregation() const -> bool override { return false; }
+
+  /** Function name. */
+  std::string func_name_;
+
+  /** Arguments of the function call. */
+  std::vector<std::unique_ptr<BoundExpression>> args_;
+
+  /** PARTITION BY expressions. */
+  std::vector<std::unique_ptr<BoundExpression>> partition_by_;
+
+  /** ORDER BY items. */
+  std::vector<std::unique_ptr<BoundOrderBy>> order_bys_;
+
+  /** The frame of the rows the function is computed over. */
+  WindowFrameType frame_;
+};
+}  // namespace bustub
+
+template <>
+struct fmt::formatter<bustub::WindowFrameType> : formatter<string_view> {
+  template <typename FormatContext>
+  auto format(bustub::WindowFrameType c, FormatContext &ctx) const {
+    string_view name;
+    switch (c) {
+      case bustub::WindowFrameType::PARTITION:
+        name = "Partition";
+        break;
+      case bustub::WindowFrameType::RANGE_TO_CURRENT:
+        name = "RangeToCurrentRow";
+        break;
+      case bustub::WindowFrameType::ROWS_TO_CURRENT:
+        name = "RowsToCurrentRow";
+        break;
+    }
+    return formatter<string_view>::format(name, ctx);
+  }
+};
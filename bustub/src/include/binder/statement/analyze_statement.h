@@ -0,0 +1,39 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/analyze_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "binder/bound_statement.h"
+#include "common/enums/statement_type.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+class AnalyzeStatement : public BoundStatement {
+ public:
+  explicit AnalyzeStatement(std::optional<std::string> table, bool vacuum = false)
+      : BoundStatement(StatementType::ANALYZE_STATEMENT), table_(std::move(table)), vacuum_(vacuum) {}
+
+  /** The table to be analyzed, all tables if not set */
+  std::optional<std::string> table_;
+
+  /** VACUUM: truncate the free pages at the end of the database file instead of analyzing tables */
+  bool vacuum_;
+
+  auto ToString() const -> std::string override {
+    if (vacuum_) {
+      return "BoundVacuum {}";
+    }
+    return fmt::format("BoundAnalyze {{ table={} }}", table_.value_or("<all>"));
+  }
+};
+
+}  // namespace bustub
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/prepare_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_statement.h"
+#include "common/enums/statement_type.h"
+#include "fmt/format.h"
+#include "fmt/ranges.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class PrepareStatement : public BoundStatement {
+ public:
+  explicit PrepareStatement(std::string name, std::vector<TypeId> param_types,
+                            std::shared_ptr<BoundStatement> statement)
+      : BoundStatement(StatementType::PREPARE_STATEMENT),
+        name_(std::move(name)),
+        param_types_(std::move(param_types)),
+        statement_(std::move(statement)) {}
+
+  /** The name of the prepared statement */
+  std::string name_;
+
+  /** The types of the parameters `$1`, `$2`, ... */
+  std::vector<TypeId> param_types_;
+
+  /** The statement being prepared, shared with the prepared statement kept by the instance */
+  std::shared_ptr<BoundStatement> statement_;
+
+  auto ToString() const -> std::string override {
+    return fmt::format("BoundPrepare {{ name={}, params={}, statement={} }}", name_, param_types_.size(),
+                       statement_->ToString());
+  }
+};
+
+class ExecuteStatement : public BoundStatement {
+ public:
+  explicit ExecuteStatement(std::string name, std::vector<Value> params)
+      : BoundStatement(StatementType::EXECUTE_STATEMENT), name_(std::move(name)), params_(std::move(params)) {}
+
+  /** The name of the prepared statement to execute */
+  std::string name_;
+
+  /** The values of the parameters */
+  std::vector<Value> params_;
+
+  auto ToString() const -> std::string override {
+    std::vector<std::string> params;
+    for (const auto &param : params_) {
+      params.push_back(param.ToString());
+    }
+    return fmt::format("BoundExecute {{ name={}, params={} }}", name_, params);
+  }
+};
+
+class DeallocateStatement : public BoundStatement {
+ public:
+  explicit DeallocateStatement(std::optional<std::string> name)
+      : BoundStatement(StatementType::DEALLOCATE_STATEMENT), name_(std::move(name)) {}
+
+  /** The name of the prepared statement to remove, all prepared statements if not set */
+  std::optional<std::string> name_;
+
+  auto ToString() const -> std::string override {
+    return fmt::format("BoundDeallocate {{ name={} }}", name_.value_or("<all>"));
+  }
+};
+
+}  // namespace bustub
@@ -18,7 +18,9 @@ enum class JoinType : uint8_t {
   LEFT = 1,    /**< Left join. */
   RIGHT = 3,   /**< Right join. */
   INNER = 4,   /**< Inner join. */
-  OUTER = 5    /**< Outer join. */
+  OUTER = 5,   /**< Outer join. */
+  SEMI = 6,    /**< Semi join, emits the left tuples having a match. Only produced by the planner for IN / EXISTS. */
+  ANTI = 7     /**< Anti join, emits the left tuples having no match. Only produced by the planner for NOT EXISTS. */
 };
 
 /**
@@ -74,6 +76,12 @@ struct fmt::formatter<bustub::JoinType> : formatter<string_view> {
       case bustub::JoinType::OUTER:
         name = "Outer";
         break;
+      case bustub::JoinType::SEMI:
+        name = "Semi";
+        break;
+      case bustub::JoinType::ANTI:
+        name = "Anti";
+        break;
       default:
         name = "Unknown";
         break;
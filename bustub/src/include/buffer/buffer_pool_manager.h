@@ -87,6 +87,12 @@ class BufferPoolManager {
   /** @return size of the buffer pool */
   virtual auto GetPoolSize() -> size_t = 0;
 
+  /** @return the number of pages fetched from the buffer pool so far */
+  virtual auto GetFetchCount() const -> size_t { return 0; }
+
+  /** @return the number of fetched pages that were not in the buffer pool and had to be read from disk */
+  virtual auto GetMissCount() const -> size_t { return 0; }
+
  protected:
   /**
    * Grading function. Do not modify!
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <mutex>  // NOLINT
 #include <unordered_map>
@@ -19,6 +20,7 @@
 #include "buffer/buffer_pool_manager.h"
 #include "buffer/lru_k_replacer.h"
 #include "common/config.h"
+#include "common/metrics.h"
 #include "container/hash/extendible_hash_table.h"
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
@@ -49,6 +51,12 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   /** @brief Return the size (number of frames) of the buffer pool. */
   auto GetPoolSize() -> size_t override { return pool_size_; }
 
+  /** @brief Return the number of pages fetched so far. */
+  auto GetFetchCount() const -> size_t override { return fetch_count_; }
+
+  /** @brief Return the number of fetches that had to read the page from disk. */
+  auto GetMissCount() const -> size_t override { return miss_count_; }
+
   /** @brief Return the pointer to all the pages in the buffer pool. */
   auto GetPages() -> Page * { return pages_; }
 
@@ -128,12 +136,12 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   /**
    * TODO(P1): Add implementation
    *
-   * @brief Delete a page from the buffer pool. If page_id is not in the buffer pool, do nothing and return true. If the
-   * page is pinned and cannot be deleted, return false immediately.
+   * @brief Delete a page from the buffer pool and free it on disk. If page_id is not in the buffer pool, only free it
+   * on disk and return true. If the page is pinned and cannot be deleted, return false immediately.
    *
    * After deleting the page from the page table, stop tracking the frame in the replacer and add the frame
-   * back to the free list. Also, reset the page's memory and metadata. Finally, you should call DeallocatePage() to
-   * imitate freeing the page on the disk.
+   * back to the free list. Also, reset the page's memory and metadata. Finally, call DeallocatePage() so that the disk
+   * manager can reuse the page.
    *
    * @param page_id id of page to be deleted
    * @return false if the page exists but could not be deleted, true if the page didn't exist or deletion succeeded
@@ -142,8 +150,8 @@ class BufferPoolManagerInstance : public BufferPoolManager {
 
   /** Number of pages in the buffer pool. */
   const size_t pool_size_;      // 缓存池中页的数量
-  /** The next page id to be allocated  */
-  std::atomic<page_id_t> next_page_id_ = 0;  // 下一个将要被分配的页号
+  /** The next page id to be allocated, when there is no disk manager  */
+  std::atomic<page_id_t> next_page_id_ = 0;  // 下一个将要被分配的页号（没有磁盘管理器的时候才使用）
   /** Bucket size for the extendible hash table */ 
   const size_t bucket_size_ = 4;  // 设置可扩展哈希表的桶的大小为4
 
@@ -161,6 +169,17 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   std::list<frame_id_t> free_list_; // 这里维护的应该是pages_中哪些下标对应的位置是没有存放页的
   /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
   std::mutex latch_;
+  /** Number of fetched pages and of fetches that missed the buffer pool, shown by EXPLAIN ANALYZE. */
+  std::atomic<size_t> fetch_count_{0};
+  std::atomic<size_t> miss_count_{0};
+  /** Runtime metrics, shared by every buffer pool of the process and shown by SHOW METRICS. */
+  MetricCounter *metric_fetches_;
+  MetricCounter *metric_misses_;
+  MetricCounter *metric_new_pages_;
+  MetricCounter *metric_evictions_;
+  MetricCounter *metric_dirty_writebacks_;
+  MetricCounter *metric_no_free_frame_;
+  MetricHistogram *metric_miss_latency_;
 
   /**
    * @brief Allocate a page on disk. Caller should acquire the latch before calling this function.
@@ -172,8 +191,11 @@ class BufferPoolManagerInstance : public BufferPoolManager {
    * @brief Deallocate a page on disk. Caller should acquire the latch before calling this function.
    * @param page_id id of the page to deallocate
    */
-  void DeallocatePage(__attribute__((unused)) page_id_t page_id) {
-    // This is a no-nop right now without a more complex data structure to track deallocated pages
+  void DeallocatePage(page_id_t page_id) {
+    // 磁盘管理器记录下被释放的页，之后分配新页的时候优先复用
+    if (disk_manager_ != nullptr) {
+      disk_manager_->DeallocatePage(page_id);
+    }
   }
 
   // TODO(student): You may add additional private members and helper functions
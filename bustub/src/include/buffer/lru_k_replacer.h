@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "common/config.h"
+#include "common/metrics.h"
 #include "common/macros.h"
 
 namespace bustub {
@@ -150,6 +151,8 @@ struct FrameEntry{
   [[maybe_unused]] size_t replacer_size_; // frame_id的范围（frame_id是缓存池中页数组的下标，在这里也代表了缓存池中能够存放页的最大数量）
   [[maybe_unused]] size_t k_;             // 优先剔除访问次数没有达到k次的frame_id
   std::mutex latch_;
+  MetricCounter *metric_evict_failures_; // 没有可以剔除的frame的次数
+  MetricHistogram *metric_evict_latency_; // Evict扫描队列的时间
 };
 
 }  // namespace bustub
@@ -20,6 +20,8 @@
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
+#include "catalog/table_statistics.h"
+#include "common/util/string_util.h"
 #include "container/hash/hash_function.h"
 #include "storage/index/b_plus_tree_index.h"
 #include "storage/index/extendible_hash_table_index.h"
@@ -47,7 +49,11 @@ struct TableInfo {
    * @param oid The unique OID for the table
    */
   TableInfo(Schema schema, std::string name, std::unique_ptr<TableHeap> &&table, table_oid_t oid)
-      : schema_{std::move(schema)}, name_{std::move(name)}, table_{std::move(table)}, oid_{oid} {}
+      : schema_{std::move(schema)},
+        name_{std::move(name)},
+        table_{std::move(table)},
+        oid_{oid},
+        stats_{std::make_unique<TableStatistics>()} {}
   /** The table schema */
   Schema schema_;
   /** The table name */
@@ -56,6 +62,8 @@ struct TableInfo {
   std::unique_ptr<TableHeap> table_;
   /** The table OID */
   const table_oid_t oid_;
+  /** The statistics of the table, row count is always maintained, column statistics only after ANALYZE */
+  std::unique_ptr<TableStatistics> stats_;
 };
 
 /**
@@ -94,9 +102,17 @@ struct IndexInfo {
 };
 
 /**
- * The Catalog is a non-persistent catalog that is designed for
- * use by executors within the DBMS execution engine. It handles
- * table creation, table lookup, index creation, and index lookup.
+ * The Catalog is designed for use by executors within the DBMS execution
+ * engine. It handles table creation, table lookup, index creation, and index
+ * lookup.
+ *
+ * The catalog is in-memory only until `Bootstrap` or `Load` is called. After
+ * that, the schemas, the first page ids of the table heaps, the index
+ * definitions and the statistics are also stored in system tables in the
+ * database file, so that `Load` can restore them after a restart. The first
+ * page ids of the system tables are recorded in the header page, next to the
+ * root page ids of the B+ trees. Tables whose name begins with `__` and tables
+ * without a heap (mock tables) are never persisted.
  */
 class Catalog {
  public:
@@ -150,6 +166,11 @@ class Catalog {
     tables_.emplace(table_oid, std::move(meta));
     table_names_.emplace(table_name, table_oid);
     index_names_.emplace(table_name, std::unordered_map<std::string, index_oid_t>{});
+    version_.fetch_add(1);
+
+    if (IsPersistent() && tmp->table_ != nullptr && !StringUtil::StartsWith(table_name, "__")) {
+      PersistTable(txn, *tmp);
+    }
 
     return tmp;
   }
@@ -246,6 +267,11 @@ class Catalog {
     // Update internal tracking
     indexes_.emplace(index_oid, std::move(index_info));
     table_indexes.emplace(index_name, index_oid);
+    version_.fetch_add(1);
+
+    if (table_rids_.count(table_meta->oid_) != 0) {
+      PersistIndex(txn, *tmp, table_meta->oid_, key_attrs);
+    }
 
     return tmp;
   }
@@ -298,7 +324,7 @@ class Catalog {
    * @param index_oid The OID of the index for which to query
    * @return A (non-owning) pointer to the metadata for the index
    */
-  auto GetIndex(index_oid_t index_oid) -> IndexInfo * {
+  auto GetIndex(index_oid_t index_oid) const -> IndexInfo * {
     auto index = indexes_.find(index_oid);
     if (index == indexes_.end()) {
       return NULL_INDEX_INFO;
@@ -333,6 +359,45 @@ class Catalog {
     return indexes;
   }
 
+  /**
+   * Collect the statistics of table `table_name` (ANALYZE).
+   * @param txn The transaction in which the table is being analyzed
+   * @param table_name The name of the table to analyze
+   * @return A (non-owning) pointer to the refreshed statistics, nullptr if the table doesn't exist or has no heap
+   */
+  auto AnalyzeTable(Transaction *txn, const std::string &table_name) -> TableStatistics * {
+    auto *table_info = GetTable(table_name);
+    if (table_info == NULL_TABLE_INFO || table_info->table_ == nullptr) {
+      return nullptr;
+    }
+    table_info->stats_->Analyze(table_info->table_.get(), table_info->schema_, txn);
+    version_.fetch_add(1);
+    if (table_rids_.count(table_info->oid_) != 0) {
+      PersistStatistics(txn, *table_info);
+    }
+    return table_info->stats_.get();
+  }
+
+  /**
+   * Query the statistics of a table by OID.
+   * @param table_oid The OID of the table
+   * @return A (non-owning) pointer to the statistics of the table, nullptr if the table doesn't exist
+   */
+  auto GetTableStatistics(table_oid_t table_oid) const -> TableStatistics * {
+    auto *table_info = GetTable(table_oid);
+    if (table_info == NULL_TABLE_INFO) {
+      return nullptr;
+    }
+    return table_info->stats_.get();
+  }
+
+  /**
+   * The version of the catalog is bumped whenever a table or an index is created or a table is analyzed, i.e.,
+   * whenever a plan built against the catalog may become stale.
+   * @return The current version of the catalog
+   */
+  auto GetVersion() const -> uint64_t { return version_.load(); }
+
   auto GetTableNames() -> std::vector<std::string> {
     std::vector<std::string> result;
     for (const auto &x : table_names_) {
@@ -341,7 +406,44 @@ class Catalog {
     return result;
   }
 
+  /**
+   * Make the catalog persistent in a new database file: allocate the header page, which must be the first page of
+   * the file, and create the system tables.
+   * @param txn The transaction in which the system tables are created
+   */
+  void Bootstrap(Transaction *txn);
+
+  /**
+   * Make the catalog persistent and restore the tables and indexes stored in an existing database file. Only the
+   * pages of the system tables are read: the table heaps and the B+ trees are opened in place, and their pages are
+   * read when a query first touches them.
+   * @param txn The transaction in which the system tables are read
+   */
+  void Load(Transaction *txn);
+
+  /** @return whether the catalog is stored in the database file, see `Bootstrap` and `Load` */
+  auto IsPersistent() const -> bool { return sys_tables_ != nullptr; }
+
+  /**
+   * Save the row counts of the tables, which are maintained in memory by the executors, e.g. before shutting down.
+   * @param txn The transaction in which the system tables are updated
+   */
+  void SaveRowCounts(Transaction *txn);
+
  private:
+  /** Store the metadata of a new table in the system tables */
+  void PersistTable(Transaction *txn, const TableInfo &table_info);
+
+  /** Store the definition of a new index in the system tables */
+  void PersistIndex(Transaction *txn, const IndexInfo &index_info, table_oid_t table_oid,
+                    const std::vector<uint32_t> &key_attrs);
+
+  /** Replace the column statistics of a table in the system tables */
+  void PersistStatistics(Transaction *txn, const TableInfo &table_info);
+
+  /** Open a system table from the first page id recorded in the header page, or create it if `create` is set */
+  auto OpenSystemTable(Transaction *txn, const std::string &name, bool create) -> std::unique_ptr<TableHeap>;
+
   [[maybe_unused]] BufferPoolManager *bpm_;
   [[maybe_unused]] LockManager *lock_manager_;
   [[maybe_unused]] LogManager *log_manager_;
@@ -371,6 +473,18 @@ class Catalog {
 
   /** The next index identifier to be used. */
   std::atomic<index_oid_t> next_index_oid_{0};
+
+  /** The version of the catalog, see `GetVersion()`. */
+  std::atomic<uint64_t> version_{0};
+
+  /** The system tables storing the metadata, nullptr while the catalog is not persistent. */
+  std::unique_ptr<TableHeap> sys_tables_;
+  std::unique_ptr<TableHeap> sys_columns_;
+  std::unique_ptr<TableHeap> sys_indexes_;
+  std::unique_ptr<TableHeap> sys_statistics_;
+
+  /** Map persisted table identifier -> the RID of its row in the `__tables` system table. */
+  std::unordered_map<table_oid_t, RID> table_rids_;
 };
 
 }  // namespace bustub
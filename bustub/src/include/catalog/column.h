@@ -21,6 +21,7 @@
 
 #include "common/exception.h"
 #include "common/macros.h"
+#include "type/fixed_decimal_type.h"
 #include "type/type.h"
 
 namespace bustub {
@@ -55,6 +56,25 @@ class Column {
     BUSTUB_ASSERT(type == TypeId::VARCHAR, "Wrong constructor for non-VARCHAR type.");
   }
 
+  /**
+   * Fixed-point decimal constructor for creating a Column, a decimal(precision, scale). A FIXED_DECIMAL column made
+   * with the non-variable-length constructor takes values of any scale, up to the maximum precision.
+   * @param column_name name of the column
+   * @param type type of column
+   * @param precision the maximum number of digits
+   * @param scale the number of digits after the decimal point
+   */
+  Column(std::string column_name, TypeId type, uint8_t precision, uint8_t scale)
+      : column_name_(std::move(column_name)),
+        column_type_(type),
+        fixed_length_(FixedDecimalType::SerializedSize(precision)),
+        precision_(precision),
+        scale_(scale) {
+    BUSTUB_ASSERT(type == TypeId::FIXED_DECIMAL, "Wrong constructor for non-FIXED_DECIMAL type.");
+    BUSTUB_ASSERT(precision >= 1 && precision <= BUSTUB_FIXED_DECIMAL_MAX_PRECISION && scale <= precision,
+                  "Invalid precision or scale.");
+  }
+
   /**
    * Replicate a Column with a different name.
    * @param column_name name of the column
@@ -65,6 +85,8 @@ class Column {
         column_type_(column.column_type_),
         fixed_length_(column.fixed_length_),
         variable_length_(column.variable_length_),
+        precision_(column.precision_),
+        scale_(column.scale_),
         column_offset_(column.column_offset_) {}
 
   /** @return column name */
@@ -84,6 +106,12 @@ class Column {
   /** @return column variable length */
   auto GetVariableLength() const -> uint32_t { return variable_length_; }
 
+  /** @return the precision of a FIXED_DECIMAL column, 0 if it takes values of any scale */
+  auto GetPrecision() const -> uint8_t { return precision_; }
+
+  /** @return the scale of a FIXED_DECIMAL column */
+  auto GetScale() const -> uint8_t { return scale_; }
+
   /** @return column's offset in the tuple */
   auto GetOffset() const -> uint32_t { return column_offset_; }
 
@@ -115,6 +143,8 @@ class Column {
       case TypeId::DECIMAL:
       case TypeId::TIMESTAMP:
         return 8;
+      case TypeId::FIXED_DECIMAL:
+        return FixedDecimalType::SerializedSize(BUSTUB_FIXED_DECIMAL_MAX_PRECISION);
       case TypeId::VARCHAR:
         // TODO(Amadou): Confirm this.
         return 12;
@@ -136,6 +166,10 @@ class Column {
   /** For an inlined column, 0. Otherwise, the length of the variable length column. */
   uint32_t variable_length_{0};
 
+  /** For a FIXED_DECIMAL column, the precision and the scale of its values. The precision is 0 if it is not fixed. */
+  uint8_t precision_{0};
+  uint8_t scale_{0};
+
   /** Column offset in the tuple. */
   uint32_t column_offset_{0};
 };
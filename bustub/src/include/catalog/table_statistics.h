@@ -0,0 +1,147 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_statistics.h
+//
+// Identification: src/include/catalog/table_statistics.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/util/hyperloglog.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class TableHeap;
+class Transaction;
+
+/** Number of tuples kept in the reservoir sample when analyzing a table */
+static constexpr size_t STATISTICS_SAMPLE_SIZE = 30000;
+/** Number of buckets of the equi-depth histogram */
+static constexpr size_t STATISTICS_HISTOGRAM_BUCKETS = 64;
+/** Number of most common values kept for each column */
+static constexpr size_t STATISTICS_MCV_COUNT = 10;
+
+/** Selectivity used for an equality predicate when we know nothing about the column */
+static constexpr double DEFAULT_EQ_SELECTIVITY = 0.005;
+/** Selectivity used for a range predicate when we know nothing about the column */
+static constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3.0;
+
+/**
+ * ColumnStatistics describes the value distribution of a single column. It is produced by `TableStatistics::Analyze`
+ * and is immutable afterwards. All fractions are relative to the total number of rows of the table.
+ */
+class ColumnStatistics {
+  friend class TableStatistics;
+
+ public:
+  ColumnStatistics() = default;
+
+  /** Rebuild the statistics of a column, e.g. when they are loaded from the catalog. */
+  ColumnStatistics(double null_frac, double ndv, std::vector<std::pair<Value, double>> mcv, std::vector<Value> bounds)
+      : null_frac_(null_frac), ndv_(ndv), mcv_(std::move(mcv)), bounds_(std::move(bounds)) {}
+
+  /** @return the fraction of rows whose value is NULL */
+  auto NullFraction() const -> double { return null_frac_; }
+
+  /** @return the estimated number of distinct non-NULL values */
+  auto DistinctCount() const -> double { return ndv_; }
+
+  /** @return the most common values together with their frequency, most frequent first */
+  auto MostCommonValues() const -> const std::vector<std::pair<Value, double>> & { return mcv_; }
+
+  /** @return the bucket bounds of the equi-depth histogram, there are `buckets + 1` bounds */
+  auto HistogramBounds() const -> const std::vector<Value> & { return bounds_; }
+
+  /** @return the estimated fraction of rows where `column = val` */
+  auto EstimateEqualSelectivity(const Value &val) const -> double;
+
+  /** @return the estimated fraction of rows where `column < val` (or `column <= val` if `or_equal` is set) */
+  auto EstimateLessThanSelectivity(const Value &val, bool or_equal) const -> double;
+
+  /**
+   * @return the estimated fraction of rows where `lower <(=) column <(=) upper`. A missing bound is unbounded.
+   */
+  auto EstimateRangeSelectivity(const std::optional<Value> &lower, bool lower_inclusive,
+                                const std::optional<Value> &upper, bool upper_inclusive) const -> double;
+
+ private:
+  /** Position of `val` in the histogram, as a fraction of the non-NULL rows that are smaller than it */
+  auto HistogramFraction(const Value &val) const -> double;
+
+  double null_frac_{0};
+  double ndv_{0};
+  std::vector<std::pair<Value, double>> mcv_;
+  std::vector<Value> bounds_;
+};
+
+/**
+ * TableStatistics holds the row count of a table and, once the table has been analyzed, a `ColumnStatistics` for
+ * each of its columns. The row count is kept roughly up-to-date by the insert and delete executors in between two
+ * ANALYZE runs; column statistics are only refreshed by ANALYZE.
+ */
+class TableStatistics {
+ public:
+  TableStatistics() = default;
+
+  /**
+   * Scan the whole table heap, count its rows, compute the per-column NDV with HyperLogLog, and build the
+   * histograms and most common values from a reservoir sample of the rows.
+   * @param heap the table heap to analyze
+   * @param schema the schema of the table
+   * @param txn the transaction performing the scan
+   * @param sample_size the number of rows kept in the reservoir sample
+   */
+  void Analyze(TableHeap *heap, const Schema &schema, Transaction *txn, size_t sample_size = STATISTICS_SAMPLE_SIZE);
+
+  /** @return whether the table has been analyzed at least once */
+  auto IsAnalyzed() const -> bool { return analyzed_; }
+
+  /** @return the (approximate) number of rows in the table */
+  auto GetRowCount() const -> size_t {
+    auto cnt = row_count_.load();
+    return cnt < 0 ? 0 : static_cast<size_t>(cnt);
+  }
+
+  /** Adjust the row count after an insert (positive delta) or a delete (negative delta). */
+  void UpdateRowCount(int64_t delta) { row_count_.fetch_add(delta); }
+
+  /**
+   * Restore the statistics saved by the catalog.
+   * @param row_count the row count of the table
+   * @param columns the statistics of every column, or empty if the table has not been analyzed
+   */
+  void Restore(size_t row_count, std::vector<ColumnStatistics> columns) {
+    row_count_.store(static_cast<int64_t>(row_count));
+    analyzed_ = !columns.empty();
+    columns_ = std::move(columns);
+  }
+
+  /** @return the statistics of the column at `col_idx`, or nullptr if the table has not been analyzed */
+  auto GetColumnStatistics(uint32_t col_idx) const -> const ColumnStatistics * {
+    if (!analyzed_ || col_idx >= columns_.size()) {
+      return nullptr;
+    }
+    return &columns_[col_idx];
+  }
+
+ private:
+  std::atomic<int64_t> row_count_{0};
+  bool analyzed_{false};
+  std::vector<ColumnStatistics> columns_;
+};
+
+}  // namespace bustub
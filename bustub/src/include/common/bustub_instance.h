@@ -25,12 +25,15 @@
 #include "catalog/catalog.h"
 #include "common/config.h"
 #include "common/util/string_util.h"
+#include "execution/execution_profile.h"
 #include "libfort/lib/fort.hpp"
+#include "optimizer/plan_cache.h"
 #include "type/value.h"
 
 namespace bustub {
 
 class Transaction;
+class ExecuteStatement;
 class ExecutorContext;
 class DiskManager;
 class BufferPoolManager;
@@ -40,6 +43,7 @@ class LogManager;
 class CheckpointManager;
 class Catalog;
 class ExecutionEngine;
+class BoundStatement;
 
 class ResultWriter {
  public:
@@ -211,7 +215,11 @@ class BustubInstance {
   auto MakeExecutorContext(Transaction *txn) -> std::unique_ptr<ExecutorContext>;
 
  public:
-  explicit BustubInstance(const std::string &db_file_name);
+  /**
+   * @param db_file_name the database file, created if it does not exist
+   * @param bpm_size the number of frames of the buffer pool
+   */
+  explicit BustubInstance(const std::string &db_file_name, size_t bpm_size = 128);
 
   ~BustubInstance();
 
@@ -264,11 +272,49 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  /** The plan cache is enabled unless `enable_plan_cache` is set to false. */
+  auto IsPlanCacheEnabled() -> bool {
+    auto variable = StringUtil::Lower(GetSessionVariable("enable_plan_cache"));
+    return !(variable == "0" || variable == "false" || variable == "no");
+  }
+
+  /** Plans of recently executed statements. */
+  PlanCache plan_cache_;
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
   void CmdDisplayHelp(ResultWriter &writer);
+  void CmdDisplayMetrics(ResultWriter &writer);
+  void CmdVacuum(ResultWriter &writer);
   void WriteOneCell(const std::string &cell, ResultWriter &writer);
+
+  /** Plan and optimize a select / insert / delete / update statement. */
+  auto PlanStatement(const BoundStatement &statement) -> std::shared_ptr<CachedPlan>;
+
+  /** Get a prepared statement by name, with its plan rebuilt if the catalog has changed since it was planned. */
+  auto GetPreparedStatement(const std::string &name) -> const PreparedStatement &;
+
+  /** Cast the arguments of `EXECUTE` to the parameter types of the prepared statement. */
+  auto CastParameters(const ExecuteStatement &execute_stmt, const PreparedStatement &prepared) -> std::vector<Value>;
+
+  /**
+   * Execute a plan with the given parameter values.
+   * @param profile if not nullptr, collect the runtime statistics of every plan node into it (EXPLAIN ANALYZE)
+   * @return the result set
+   */
+  auto RunPlan(CachedPlan &plan, const std::vector<Value> &params, Transaction *txn,
+               ExecutionProfile *profile = nullptr) -> std::vector<Tuple>;
+
+  /** Execute a plan with the given parameter values, and write the result set. */
+  void ExecutePlan(CachedPlan &plan, const std::vector<Value> &params, ResultWriter &writer, Transaction *txn);
+
+  /** Execute a plan under EXPLAIN ANALYZE, and return the plan annotated with the runtime statistics. */
+  auto AnalyzePlan(CachedPlan &plan, const std::vector<Value> &params, Transaction *txn, bool with_schema)
+      -> std::string;
+
+  /** Statements created by `PREPARE`, by name. */
+  std::unordered_map<std::string, PreparedStatement> prepared_statements_;
   std::unordered_map<std::string, std::string> session_variables_;
 };
 
@@ -0,0 +1,162 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// metrics.h
+//
+// Identification: src/include/common/metrics.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/** Number of shards of a MetricCounter */
+static constexpr size_t METRIC_SHARDS = 16;
+
+/**
+ * MetricCounter is a monotonically increasing counter. Every thread increments its own cache-line aligned shard, so a
+ * counter bumped on a hot path doesn't bounce a cache line between cores. Reading it sums the shards.
+ */
+class MetricCounter {
+ public:
+  void Add(uint64_t n = 1) { shards_[ThreadShard()].value_.fetch_add(n, std::memory_order_relaxed); }
+
+  /** @return the sum of every shard */
+  auto Get() const -> uint64_t;
+
+  void Reset();
+
+  /** @return the shard of the calling thread, assigned round robin the first time the thread touches a counter */
+  static auto ThreadShard() -> size_t;
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> value_{0};
+  };
+  std::array<Shard, METRIC_SHARDS> shards_;
+};
+
+/**
+ * MetricHistogram records latencies, in nanoseconds, in the layout of an HDR histogram: values below 2^SUB_BUCKET_BITS
+ * have a bucket each, and every power of two above is split into 2^SUB_BUCKET_BITS linear buckets. A recorded value is
+ * thus known within 1/16 of itself, and the whole uint64_t range fits in 976 buckets.
+ */
+class MetricHistogram {
+ public:
+  static constexpr size_t SUB_BUCKET_BITS = 4;
+  static constexpr size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr size_t NUM_BUCKETS = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+  void Record(uint64_t value);
+
+  auto Count() const -> uint64_t { return count_.Get(); }
+  auto Sum() const -> uint64_t { return sum_.Get(); }
+  auto Max() const -> uint64_t { return max_.load(std::memory_order_relaxed); }
+
+  /** @return the value below which a fraction `q` of the recorded values lie, rounded up to its bucket's bound */
+  auto Percentile(double q) const -> uint64_t;
+
+  void Reset();
+
+  /** @return the bucket counting `value` */
+  static auto BucketOf(uint64_t value) -> size_t;
+  /** @return the largest value counted by `bucket` */
+  static auto BucketUpperBound(size_t bucket) -> uint64_t;
+
+ private:
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_{};
+  MetricCounter count_;
+  MetricCounter sum_;
+  std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * MetricsRegistry owns the counters and histograms of the process, by name. Components look their metrics up once,
+ * when they are constructed, and keep the pointers: a metric is never destroyed, so updating it is just an atomic add.
+ * Metrics of components with several instances (e.g. two buffer pools) are shared.
+ */
+class MetricsRegistry {
+ public:
+  /** @return the registry of the process */
+  static auto Instance() -> MetricsRegistry &;
+
+  ~MetricsRegistry();
+
+  DISALLOW_COPY_AND_MOVE(MetricsRegistry);
+
+  /** @return the counter named `name`, created on first use */
+  auto GetCounter(const std::string &name) -> MetricCounter *;
+
+  /** @return the histogram named `name`, created on first use */
+  auto GetHistogram(const std::string &name) -> MetricHistogram *;
+
+  /**
+   * @return every metric as (name, value) rows, sorted by name. A histogram `h` gives the rows h.count, h.avg_us,
+   * h.p50_us, h.p99_us, h.p999_us and h.max_us.
+   */
+  auto Snapshot() const -> std::vector<std::pair<std::string, std::string>>;
+
+  /** @return the snapshot as one JSON object, with the time it was taken */
+  auto SnapshotJson() const -> std::string;
+
+  /** Zero every metric */
+  void Reset();
+
+  /** Append a JSON snapshot to the file at `path` every `interval`, from a background thread */
+  void StartSnapshotThread(const std::string &path, std::chrono::milliseconds interval);
+
+  /** Stop the snapshot thread, after writing a last snapshot */
+  void StopSnapshotThread();
+
+ private:
+  MetricsRegistry() = default;
+
+  void RunSnapshotThread(const std::string &path, std::chrono::milliseconds interval);
+
+  /** Protects the maps, not the metrics */
+  mutable std::mutex latch_;
+  std::map<std::string, std::unique_ptr<MetricCounter>> counters_;
+  std::map<std::string, std::unique_ptr<MetricHistogram>> histograms_;
+
+  std::thread snapshot_thread_;
+  std::mutex snapshot_latch_;
+  std::condition_variable snapshot_cv_;
+  bool stop_snapshot_{false};
+};
+
+/** ScopedMetricTimer records the time between its construction and its destruction into a histogram */
+class ScopedMetricTimer {
+ public:
+  explicit ScopedMetricTimer(MetricHistogram *histogram)
+      : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+  ~ScopedMetricTimer() {
+    histogram_->Record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+  }
+
+  DISALLOW_COPY_AND_MOVE(ScopedMetricTimer);
+
+ private:
+  MetricHistogram *histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace bustub
@@ -18,6 +18,7 @@
 #include <string>
 
 #include "common/macros.h"
+#include "type/fixed_decimal_type.h"
 #include "type/value.h"
 
 namespace bustub {
@@ -95,6 +96,11 @@ class HashUtil {
         auto raw = val->GetAs<uint64_t>();
         return Hash<uint64_t>(&raw);
       }
+      case TypeId::FIXED_DECIMAL: {
+        // equal values of different scales (e.g. 1.5 and 1.50) must have the same hash
+        auto [scaled, scale] = FixedDecimalType::Normalize(*val);
+        return CombineHashes(Hash<int128_t>(&scaled), Hash<uint8_t>(&scale));
+      }
       default: {
         UNIMPLEMENTED("Unsupported type.");
       }
@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hyperloglog.h
+//
+// Identification: src/include/common/util/hyperloglog.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "common/util/hash_util.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * HyperLogLog is a fixed-size sketch that estimates the number of distinct values it has seen.
+ * With 2^12 registers the standard error is about 1.6%. Two sketches can be merged, so partial
+ * sketches built over disjoint partitions of the input combine into the sketch of the whole input.
+ */
+class HyperLogLog {
+ public:
+  /** Number of bits of the hash used to pick a register */
+  static constexpr uint32_t PRECISION = 12;
+  /** Number of registers */
+  static constexpr uint32_t NUM_REGISTERS = 1U << PRECISION;
+
+  HyperLogLog() { registers_.fill(0); }
+
+  /** Add a value into the sketch. NULLs are ignored. */
+  void AddValue(const Value &val) {
+    if (val.IsNull()) {
+      return;
+    }
+    AddHash(HashForSketch(val));
+  }
+
+  /** Add an already hashed item into the sketch. */
+  void AddHash(hash_t hash) {
+    // The incoming hash may not spread its bits well enough, so we finalize it first (splitmix64).
+    uint64_t h = static_cast<uint64_t>(hash);
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h = h ^ (h >> 31);
+
+    auto idx = static_cast<uint32_t>(h >> (64 - PRECISION));
+    uint64_t rest = (h << PRECISION) | (1ULL << (PRECISION - 1));
+    auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers_[idx] = std::max(registers_[idx], rank);
+  }
+
+  /** Merge another sketch into this one. */
+  void Merge(const HyperLogLog &other) {
+    for (uint32_t i = 0; i < NUM_REGISTERS; i++) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+  }
+
+  /** @return the estimated number of distinct values added to the sketch */
+  auto Estimate() const -> double {
+    const double m = NUM_REGISTERS;
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double sum = 0;
+    uint32_t zeros = 0;
+    for (auto reg : registers_) {
+      sum += std::ldexp(1.0, -static_cast<int>(reg));
+      if (reg == 0) {
+        zeros++;
+      }
+    }
+    double estimate = alpha * m * m / sum;
+    // Small range correction: fall back to linear counting.
+    if (estimate <= 2.5 * m && zeros != 0) {
+      estimate = m * std::log(m / static_cast<double>(zeros));
+    }
+    return estimate;
+  }
+
+  /** Reset the sketch to the empty state. */
+  void Clear() { registers_.fill(0); }
+
+ private:
+  /**
+   * HashUtil::HashValue collides a lot on small integers (it folds sign-extended bytes), which makes the
+   * sketch under-count badly, so fixed-width values are fed in by their bits and strings with FNV-1a.
+   */
+  static auto HashForSketch(const Value &val) -> hash_t {
+    switch (val.GetTypeId()) {
+      case TypeId::BOOLEAN:
+        return static_cast<hash_t>(val.GetAs<int8_t>());
+      case TypeId::TINYINT:
+        return static_cast<hash_t>(val.GetAs<int8_t>());
+      case TypeId::SMALLINT:
+        return static_cast<hash_t>(val.GetAs<int16_t>());
+      case TypeId::INTEGER:
+        return static_cast<hash_t>(val.GetAs<int32_t>());
+      case TypeId::BIGINT:
+        return static_cast<hash_t>(val.GetAs<int64_t>());
+      case TypeId::TIMESTAMP:
+        return static_cast<hash_t>(val.GetAs<uint64_t>());
+      case TypeId::DECIMAL: {
+        auto raw = val.GetAs<double>();
+        uint64_t bits;
+        std::memcpy(&bits, &raw, sizeof(bits));
+        return static_cast<hash_t>(bits);
+      }
+      case TypeId::VARCHAR: {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        const auto *data = val.GetData();
+        for (uint32_t i = 0; i < val.GetLength(); i++) {
+          h = (h ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ULL;
+        }
+        return static_cast<hash_t>(h);
+      }
+      default:
+        return HashUtil::HashValue(&val);
+    }
+  }
+
+  std::array<uint8_t, NUM_REGISTERS> registers_;
+};
+
+}  // namespace bustub
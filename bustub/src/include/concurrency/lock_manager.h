@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "common/config.h"
+#include "common/metrics.h"
 #include "common/rid.h"
 #include "concurrency/transaction.h"
 
@@ -79,6 +80,10 @@ class LockManager {
    * Creates a new lock manager configured for the deadlock detection policy.
    */
   LockManager() {
+    auto &metrics = MetricsRegistry::Instance();
+    metric_table_lock_requests_ = metrics.GetCounter("lock_manager.table_lock_requests");
+    metric_row_lock_requests_ = metrics.GetCounter("lock_manager.row_lock_requests");
+    metric_deadlock_aborts_ = metrics.GetCounter("lock_manager.deadlock_aborts");
     enable_cycle_detection_ = true;
     cycle_detection_thread_ = new std::thread(&LockManager::RunCycleDetection, this);
   }
@@ -360,6 +365,11 @@ class LockManager {
   // 存放死锁检测等待图中所有的事务id，并标记事务是否从等待图中剔除了（1：在等待图中，0：已经被剔除了）
   std::unordered_map<txn_id_t, int> txn_id_set_; 
   std::mutex waits_for_latch_;
+
+  // 运行时的统计信息（SHOW METRICS中会输出），等待锁的次数和时间在WaitForGrant中记录
+  MetricCounter *metric_table_lock_requests_;
+  MetricCounter *metric_row_lock_requests_;
+  MetricCounter *metric_deadlock_aborts_;
 };
 
 }  // namespace bustub
@@ -326,6 +326,21 @@ class Transaction {
    */
   inline void SetPrevLSN(lsn_t prev_lsn) { prev_lsn_ = prev_lsn; }
 
+  /** @return the number of times the transaction was blocked waiting for a lock */
+  inline auto GetLockWaitCount() const -> size_t { return lock_wait_count_; }
+
+  /** @return the total time the transaction was blocked waiting for locks, in nanoseconds */
+  inline auto GetLockWaitTime() const -> uint64_t { return lock_wait_ns_; }
+
+  /**
+   * Record that the transaction was blocked waiting for a lock.
+   * @param wait_ns how long the transaction was blocked, in nanoseconds
+   */
+  inline void AddLockWait(uint64_t wait_ns) {
+    lock_wait_count_++;
+    lock_wait_ns_ += wait_ns;
+  }
+
  private:
   /** The current transaction state. */
   TransactionState state_{TransactionState::GROWING};
@@ -342,6 +357,9 @@ class Transaction {
   std::shared_ptr<std::deque<IndexWriteRecord>> index_write_set_;
   /** The LSN of the last record written by the transaction. */
   lsn_t prev_lsn_;
+  /** LockManager: how many times and how long the transaction was blocked waiting for a lock. */
+  size_t lock_wait_count_{0};
+  uint64_t lock_wait_ns_{0};
 
   std::mutex latch_;
 
@@ -18,6 +18,7 @@
 #include <unordered_set>
 
 #include "common/config.h"
+#include "common/metrics.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
 #include "recovery/log_manager.h"
@@ -31,7 +32,11 @@ class LockManager;
 class TransactionManager {
  public:
   explicit TransactionManager(LockManager *lock_manager, LogManager *log_manager = nullptr)
-      : lock_manager_(lock_manager), log_manager_(log_manager) {}
+      : lock_manager_(lock_manager),
+        log_manager_(log_manager),
+        metric_begins_(MetricsRegistry::Instance().GetCounter("txn.begins")),
+        metric_commits_(MetricsRegistry::Instance().GetCounter("txn.commits")),
+        metric_aborts_(MetricsRegistry::Instance().GetCounter("txn.aborts")) {}
 
   ~TransactionManager() = default;
 
@@ -139,6 +144,11 @@ class TransactionManager {
   LockManager *lock_manager_ __attribute__((__unused__));
   LogManager *log_manager_ __attribute__((__unused__));
 
+  /** Transactions begun, committed and aborted, shown by SHOW METRICS */
+  MetricCounter *metric_begins_;
+  MetricCounter *metric_commits_;
+  MetricCounter *metric_aborts_;
+
   /** The global transaction latch is used for checkpointing. */
   ReaderWriterLatch global_txn_latch_;
 };
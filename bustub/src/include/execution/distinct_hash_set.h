@@ -0,0 +1,145 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// distinct_hash_set.h
+//
+// Identification: src/include/execution/distinct_hash_set.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "type/type.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * DistinctHashSet is a set of byte strings, e.g. the serialized tuples of SELECT DISTINCT or the serialized inputs of
+ * COUNT(DISTINCT). The strings are appended back to back into a single arena, and an open addressing table (linear
+ * probing, at most half full) holds 16-byte slots with a part of the hash, the length and the arena offset of each
+ * string. Compared to a std::unordered_set of std::vector<Value>, there is no allocation per entry and a lookup only
+ * compares the bytes when the hash and the length match. Two values are equal when their serialized bytes are.
+ */
+class DistinctHashSet {
+ public:
+  /** @return the hash of a byte string, FNV-1a finalized by the mixer of MurmurHash3 */
+  static auto Hash(const char *data, uint32_t size) -> uint64_t {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (uint32_t i = 0; i < size; i++) {
+      h = (h ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  /**
+   * Add a byte string to the set.
+   * @param hash the hash of the string, from Hash
+   * @return true if the string was not in the set yet
+   */
+  auto Insert(const char *data, uint32_t size, uint64_t hash) -> bool {
+    if ((size_ + 1) * 2 > slots_.size()) {
+      Grow();
+    }
+    auto *slot = Find(data, size, hash);
+    if (slot->size_ != EMPTY) {
+      return false;
+    }
+    *slot = {static_cast<uint32_t>(hash >> 32), size, arena_.size()};
+    arena_.insert(arena_.end(), data, data + size);
+    size_++;
+    return true;
+  }
+
+  /** @return whether a byte string, with the given hash, is in the set */
+  auto Contains(const char *data, uint32_t size, uint64_t hash) const -> bool {
+    return !slots_.empty() && Find(data, size, hash)->size_ != EMPTY;
+  }
+
+  /** Add a non-NULL value to the set, @return true if it was not in the set yet */
+  auto Insert(const Value &val) -> bool {
+    uint32_t size = val.GetTypeId() == TypeId::VARCHAR ? val.GetLength() + sizeof(uint32_t)
+                                                       : Type::GetTypeSize(val.GetTypeId());
+    scratch_.assign(size, 0);
+    val.SerializeTo(scratch_.data());
+    return Insert(scratch_.data(), size, Hash(scratch_.data(), size));
+  }
+
+  /** @return the number of strings in the set */
+  auto Size() const -> size_t { return size_; }
+
+  /** @return the number of bytes taken by the arena and the slots */
+  auto MemoryUsage() const -> size_t { return arena_.capacity() + slots_.size() * sizeof(Slot); }
+
+  void Clear() {
+    slots_.clear();
+    arena_.clear();
+    size_ = 0;
+  }
+
+ private:
+  static constexpr uint32_t EMPTY = UINT32_MAX;
+
+  struct Slot {
+    /** The high 32 bits of the hash, checked before the bytes */
+    uint32_t hash_tag_{0};
+    /** The length of the string, EMPTY for a free slot */
+    uint32_t size_{EMPTY};
+    /** The offset of the string in the arena */
+    uint64_t offset_{0};
+  };
+
+  /** @return the slot holding the string, or the free slot where it would go */
+  auto Find(const char *data, uint32_t size, uint64_t hash) const -> const Slot * {
+    auto mask = slots_.size() - 1;
+    auto tag = static_cast<uint32_t>(hash >> 32);
+    for (auto idx = static_cast<size_t>(hash) & mask;; idx = (idx + 1) & mask) {
+      const auto &slot = slots_[idx];
+      if (slot.size_ == EMPTY ||
+          (slot.hash_tag_ == tag && slot.size_ == size && memcmp(arena_.data() + slot.offset_, data, size) == 0)) {
+        return &slot;
+      }
+    }
+  }
+
+  auto Find(const char *data, uint32_t size, uint64_t hash) -> Slot * {
+    return const_cast<Slot *>(static_cast<const DistinctHashSet *>(this)->Find(data, size, hash));
+  }
+
+  /** Double the number of slots and re-insert every string, rehashing it from the arena */
+  void Grow() {
+    std::vector<Slot> old_slots(std::max<size_t>(16, slots_.size() * 2));
+    old_slots.swap(slots_);
+    auto mask = slots_.size() - 1;
+    for (const auto &slot : old_slots) {
+      if (slot.size_ == EMPTY) {
+        continue;
+      }
+      auto hash = Hash(arena_.data() + slot.offset_, slot.size_);
+      auto idx = static_cast<size_t>(hash) & mask;
+      while (slots_[idx].size_ != EMPTY) {
+        idx = (idx + 1) & mask;
+      }
+      slots_[idx] = slot;
+    }
+  }
+
+  std::vector<Slot> slots_;
+  std::vector<char> arena_;
+  size_t size_{0};
+  /** Buffer for the serialized values */
+  std::vector<char> scratch_;
+};
+
+}  // namespace bustub
@@ -16,6 +16,7 @@
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/catalog.h"
+#include "common/metrics.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager.h"
 #include "execution/executor_context.h"
@@ -115,6 +116,12 @@ class ExecutionEngine {
   auto Execute(const AbstractPlanNodeRef &plan, std::vector<Tuple> *result_set, Transaction *txn,
                ExecutorContext *exec_ctx) -> bool {
     BUSTUB_ASSERT((txn == exec_ctx->GetTransaction()), "Broken Invariant");
+    static auto *queries = MetricsRegistry::Instance().GetCounter("executor.queries");
+    static auto *failed_queries = MetricsRegistry::Instance().GetCounter("executor.failed_queries");
+    static auto *rows = MetricsRegistry::Instance().GetCounter("executor.rows");
+    static auto *query_latency = MetricsRegistry::Instance().GetHistogram("executor.query_latency");
+    ScopedMetricTimer timer(query_latency);
+    queries->Add();
 
     // Construct the executor for the abstract plan node
     auto executor = ExecutorFactory::CreateExecutor(exec_ctx, plan);
@@ -124,12 +131,13 @@ class ExecutionEngine {
 
     try {
       executor->Init();
-      PollExecutor(executor.get(), plan, result_set);
+      rows->Add(PollExecutor(executor.get(), plan, result_set));
     } catch (const ExecutionException &ex) {
 #ifndef NDEBUG
       LOG_ERROR("Error Encountered in Executor Execution: %s", ex.what());
 #endif
       executor_succeeded = false;
+      failed_queries->Add();
       if (result_set != nullptr) {
         result_set->clear();
       }
@@ -144,16 +152,20 @@ class ExecutionEngine {
    * @param executor The root executor
    * @param plan The plan to execute
    * @param result_set The tuple result set
+   * @return the number of tuples produced
    */
-  static void PollExecutor(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
-                           std::vector<Tuple> *result_set) {
+  static auto PollExecutor(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
+                           std::vector<Tuple> *result_set) -> size_t {
     RID rid{};
     Tuple tuple{};
+    size_t count = 0;
     while (executor->Next(&tuple, &rid)) {
+      count++;
       if (result_set != nullptr) {
         result_set->push_back(tuple);
       }
     }
+    return count;
   }
 
   [[maybe_unused]] BufferPoolManager *bpm_;
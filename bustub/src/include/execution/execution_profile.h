@@ -0,0 +1,47 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// execution_profile.h
+//
+// Identification: src/include/execution/execution_profile.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace bustub {
+
+class AbstractPlanNode;
+
+/**
+ * The runtime statistics of one plan node, collected by EXPLAIN ANALYZE. All of them include the work done by the
+ * children of the plan node, since a child only runs inside the Init / Next calls of its parent.
+ */
+struct ExecutorStats {
+  /** How many times the executor was initialized, e.g. the inner side of a nested loop join once per outer tuple */
+  size_t init_cnt_{0};
+  /** Wall time spent in Init and in Next, in nanoseconds */
+  uint64_t init_ns_{0};
+  uint64_t next_ns_{0};
+  /** Number of tuples produced */
+  size_t row_cnt_{0};
+  /** Pages fetched from the buffer pool, and how many of them had to be read from disk */
+  size_t page_fetch_cnt_{0};
+  size_t page_miss_cnt_{0};
+  /** How many times and how long the transaction was blocked waiting for locks, in nanoseconds */
+  size_t lock_wait_cnt_{0};
+  uint64_t lock_wait_ns_{0};
+
+  /** @return the statistics in the form appended to the plan node by EXPLAIN ANALYZE */
+  auto ToString() const -> std::string;
+};
+
+/** The statistics of every plan node of an analyzed query. */
+using ExecutionProfile = std::unordered_map<const AbstractPlanNode *, ExecutorStats>;
+
+}  // namespace bustub
@@ -12,12 +12,15 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog.h"
 #include "concurrency/transaction.h"
+#include "execution/execution_profile.h"
+#include "execution/runtime_filter.h"
 #include "storage/page/tmp_tuple_page.h"
 
 namespace bustub {
@@ -60,6 +63,29 @@ class ExecutorContext {
   /** @return the transaction manager */
   auto GetTransactionManager() -> TransactionManager * { return txn_mgr_; }
 
+  /** @return the profile that EXPLAIN ANALYZE collects the statistics of the executors into, nullptr if not analyzing */
+  auto GetProfile() -> ExecutionProfile * { return profile_; }
+
+  /**
+   * Collect the statistics of every executor created in this context, see ExecutorFactory::CreateExecutor.
+   * @param profile the profile to collect into
+   */
+  void SetProfile(ExecutionProfile *profile) { profile_ = profile; }
+
+  /**
+   * @return the runtime filter built by the hash join with `filter_id`, nullptr if that join has not built it yet.
+   * The pointer stays valid when the join rebuilds the filter.
+   */
+  auto GetRuntimeFilter(size_t filter_id) const -> const RuntimeFilter * {
+    auto iter = runtime_filters_.find(filter_id);
+    return iter == runtime_filters_.end() ? nullptr : &iter->second;
+  }
+
+  /** Publish the runtime filter built by the hash join with `filter_id`, see HashJoinPlanNode::runtime_filter_id_ */
+  void SetRuntimeFilter(size_t filter_id, RuntimeFilter filter) {
+    runtime_filters_.insert_or_assign(filter_id, std::move(filter));
+  }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -71,6 +97,10 @@ class ExecutorContext {
   TransactionManager *txn_mgr_;
   /** The lock manager associated with this executor context */
   LockManager *lock_mgr_;
+  /** The profile of EXPLAIN ANALYZE, nullptr if the executors are not profiled */
+  ExecutionProfile *profile_{nullptr};
+  /** The runtime filters published by the hash joins of the query */
+  std::unordered_map<size_t, RuntimeFilter> runtime_filters_;
 };
 
 }  // namespace bustub
@@ -28,8 +28,15 @@ class ExecutorFactory {
    * @param exec_ctx The executor context for the created executor
    * @param plan The plan node that needs to be executed
    * @return An executor for the given plan in the provided context
+   *
+   * When the context has a profile (EXPLAIN ANALYZE), every executor is wrapped by a ProfilingExecutor.
    */
   static auto CreateExecutor(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
       -> std::unique_ptr<AbstractExecutor>;
+
+ private:
+  /** @return the executor of the given plan node itself, without profiling */
+  static auto CreatePlanExecutor(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
+      -> std::unique_ptr<AbstractExecutor>;
 };
 }  // namespace bustub
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <cmath>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -24,6 +25,7 @@
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/aggregation_plan.h"
 #include "storage/table/tuple.h"
+#include "type/type_kernel.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -40,7 +42,35 @@ class SimpleAggregationHashTable {
    */
   SimpleAggregationHashTable(const std::vector<AbstractExpressionRef> &agg_exprs,
                              const std::vector<AggregationType> &agg_types)
-      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {}
+      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {
+    // 在建表的时候按照每个聚集函数的输入类型选好对应的kernel，之后每一行都直接调用，不再走Value的虚函数
+    for (uint32_t i = 0; i < agg_types_.size(); i++) {
+      TypeId type = TypeId::INTEGER;
+      ArithmeticOp op = ArithmeticOp::Add;
+      switch (agg_types_[i]) {
+        case AggregationType::CountStarAggregate:
+        case AggregationType::CountAggregate:
+        case AggregationType::CountDistinctAggregate:
+        case AggregationType::ApproxCountDistinctAggregate:
+          break;
+        case AggregationType::SumAggregate:
+          type = agg_exprs_[i]->GetReturnType();
+          break;
+        case AggregationType::MinAggregate:
+          type = agg_exprs_[i]->GetReturnType();
+          op = ArithmeticOp::Min;
+          break;
+        case AggregationType::MaxAggregate:
+          type = agg_exprs_[i]->GetReturnType();
+          op = ArithmeticOp::Max;
+          break;
+      }
+      kernel_types_.push_back(type);
+      kernels_.push_back(TypeKernels::GetArithmeticKernel(type, op));
+      has_distinct_ = has_distinct_ || agg_types_[i] == AggregationType::CountDistinctAggregate;
+      has_sketch_ = has_sketch_ || agg_types_[i] == AggregationType::ApproxCountDistinctAggregate;
+    }
+  }
 
   /** @return The initial aggregrate value for this aggregation executor */
   // 这里计算并保存了Aggregation结果的数据结构
@@ -49,6 +79,8 @@ class SimpleAggregationHashTable {
     for (const auto &agg_type : agg_types_) {
       switch (agg_type) {
         case AggregationType::CountStarAggregate:
+        case AggregationType::CountDistinctAggregate:
+        case AggregationType::ApproxCountDistinctAggregate:
           // Count start starts at zero.
           values.emplace_back(ValueFactory::GetIntegerValue(0)); 
           break;
@@ -61,7 +93,20 @@ class SimpleAggregationHashTable {
           break;
       }
     }
-    return {values};
+    AggregateValue result{std::move(values)};
+    // 有count(distinct)/approx_count_distinct的时候，每个分组还要带上见过的值的集合/sketch
+    if (has_distinct_) {
+      result.distinct_inputs_.resize(agg_types_.size());
+    }
+    if (has_sketch_) {
+      result.sketches_.resize(agg_types_.size());
+      for (uint32_t i = 0; i < agg_types_.size(); i++) {
+        if (agg_types_[i] == AggregationType::ApproxCountDistinctAggregate) {
+          result.sketches_[i] = std::make_unique<HyperLogLog>();
+        }
+      }
+    }
+    return result;
   }
 
   /**
@@ -75,7 +120,7 @@ class SimpleAggregationHashTable {
     for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
       switch (agg_types_[i]) {
         case AggregationType::CountStarAggregate:{ // 不需要判断input是否为空
-          result->aggregates_[i] = result->aggregates_[i].Add(Value(TypeId::INTEGER,1));
+          result->aggregates_[i] = Combine(i, result->aggregates_[i], Value(TypeId::INTEGER,1), &Value::Add);
           break;
         }
         case AggregationType::CountAggregate:{ // 需要判断input是否为空，同时需要注意result中存在的值一开始是初始化为空的，所以需要重新设置
@@ -84,18 +129,18 @@ class SimpleAggregationHashTable {
               result->aggregates_[i] = Value(TypeId::INTEGER,0);
             }
 
-            result->aggregates_[i] = result->aggregates_[i].Add(Value(TypeId::INTEGER,1));
+            result->aggregates_[i] = Combine(i, result->aggregates_[i], Value(TypeId::INTEGER,1), &Value::Add);
           }
 
           break;
         }
         case AggregationType::SumAggregate:{
           if(!input.aggregates_[i].IsNull()){
-            if(result->aggregates_[i].IsNull()){ // 一开始是未初始化的
-              result->aggregates_[i] = Value(TypeId::INTEGER,0);
+            if(result->aggregates_[i].IsNull()){ // 一开始是未初始化的，直接取第一个输入，这样sum的结果和输入是同一个类型（INTEGER/FIXED_DECIMAL）
+              result->aggregates_[i] = input.aggregates_[i];
+            }else{
+              result->aggregates_[i] = Combine(i, result->aggregates_[i], input.aggregates_[i], &Value::Add);
             }
-
-            result->aggregates_[i] = result->aggregates_[i].Add(input.aggregates_[i]);
           }
 
           break;
@@ -105,7 +150,7 @@ class SimpleAggregationHashTable {
             if(result->aggregates_[i].IsNull()){ // 一开始是未初始化的
               result->aggregates_[i] = input.aggregates_[i];
             }else{
-              result->aggregates_[i] = result->aggregates_[i].Min(input.aggregates_[i]);
+              result->aggregates_[i] = Combine(i, result->aggregates_[i], input.aggregates_[i], &Value::Min);
             }            
           }
 
@@ -116,25 +161,85 @@ class SimpleAggregationHashTable {
             if(result->aggregates_[i].IsNull()){ // 一开始是未初始化的
               result->aggregates_[i] = input.aggregates_[i];
             }else{
-              result->aggregates_[i] = result->aggregates_[i].Max(input.aggregates_[i]);
+              result->aggregates_[i] = Combine(i, result->aggregates_[i], input.aggregates_[i], &Value::Max);
             } 
           }
 
           break;
         }
+        case AggregationType::CountDistinctAggregate:{ // 只有第一次见到的非空值才计数
+          if(!input.aggregates_[i].IsNull() && result->distinct_inputs_[i].Insert(input.aggregates_[i])){
+            result->aggregates_[i] = Combine(i, result->aggregates_[i], Value(TypeId::INTEGER,1), &Value::Add);
+          }
+
+          break;
+        }
+        case AggregationType::ApproxCountDistinctAggregate:{ // 只更新sketch，结果在FinalizeAggregateValue里估算
+          result->sketches_[i]->AddValue(input.aggregates_[i]);
+          break;
+        }
       }
     }
   }
+
+  /**
+   * Writes the estimates of the APPROX_COUNT_DISTINCT aggregates into the result, once every input has been combined,
+   * and frees the distinct sets and the sketches of the group.
+   * @param[out] result The aggregate value to finalize
+   */
+  void FinalizeAggregateValue(AggregateValue *result) {
+    for (uint32_t i = 0; i < result->sketches_.size(); i++) {
+      if (result->sketches_[i] != nullptr) {
+        auto estimate = std::llround(result->sketches_[i]->Estimate());
+        result->aggregates_[i] = ValueFactory::GetIntegerValue(static_cast<int32_t>(estimate));
+      }
+    }
+    result->distinct_inputs_.clear();
+    result->sketches_.clear();
+  }
+
+  /** Finalizes every group of the hash table, see FinalizeAggregateValue */
+  void Finalize() {
+    if (!has_distinct_ && !has_sketch_) {
+      return;
+    }
+    for (auto &[key, value] : ht_) {
+      FinalizeAggregateValue(&value);
+    }
+  }
+
+  /**
+   * Combines two values of the i-th aggregate, with its kernel when both sides have the type it was picked for.
+   * @param op the Value operation to fall back to
+   */
+  auto Combine(uint32_t i, const Value &result, const Value &input, Value (Value::*op)(const Value &) const) const
+      -> Value {
+    if (kernels_[i] != nullptr && result.GetTypeId() == kernel_types_[i] && input.GetTypeId() == kernel_types_[i]) {
+      return kernels_[i](result, input);
+    }
+    return (result.*op)(input);
+  }
+
   /**
    * Inserts a value into the hash table and then combines it with the current aggregation.
    * @param agg_key the key to be inserted
    * @param agg_val the value to be inserted
    */
-  void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
+  void InsertCombine(AggregateKey agg_key, const AggregateValue &agg_val) {
+    auto iter = ht_.find(agg_key);
+    if (iter == ht_.end()) {
+      iter = ht_.emplace(std::move(agg_key), GenerateInitialAggregateValue()).first;
     }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
+    CombineAggregateValues(&iter->second, agg_val);
+  }
+
+  /**
+   * Inserts an aggregate value computed outside of the table, e.g. by the batch kernels, replacing the current one.
+   * @param agg_key the key to be inserted
+   * @param agg_val the value to be inserted
+   */
+  void Insert(AggregateKey agg_key, AggregateValue agg_val) {
+    ht_.insert_or_assign(std::move(agg_key), std::move(agg_val));
   }
 
   /**
@@ -189,6 +294,12 @@ class SimpleAggregationHashTable {
   /** The types of aggregations that we have */
   // 存放的是agge_exprs_这些表达式的对应的具体类型（min/max/count/count(*)）
   const std::vector<AggregationType> &agg_types_; // eg:min,max,sum
+  /** The kernel combining the values of each aggregate, nullptr when there is none, and the type it works on */
+  std::vector<ArithmeticKernel> kernels_;
+  std::vector<TypeId> kernel_types_;
+  /** Whether there is a COUNT(DISTINCT), and an APPROX_COUNT_DISTINCT, among the aggregates */
+  bool has_distinct_{false};
+  bool has_sketch_{false};
 };
 
 /**
@@ -230,7 +341,7 @@ class AggregationExecutor : public AbstractExecutor {
     for (const auto &expr : plan_->GetGroupBys()) {
       keys.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
     }
-    return {keys};
+    return {std::move(keys)};
   }
 
   /** @return The tuple as an AggregateValue */
@@ -239,9 +350,25 @@ class AggregationExecutor : public AbstractExecutor {
     for (const auto &expr : plan_->GetAggregates()) {
       vals.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
     }
-    return {vals};
+    return {std::move(vals)};
   }
 
+  /**
+   * Aggregate the child tuples with the batch kernels of FIXED_DECIMAL, reading the values straight from the tuples.
+   * Only done without GROUP BY, when every aggregate is COUNT(*) or reads a column of type decimal(p, s) with p <= 18.
+   * @return false if the aggregates do not allow it, nothing has been read from the child then
+   */
+  auto AggregateInBatches() -> bool;
+
+  /**
+   * Yield the next group when the child is sorted on the group key: the rows of the group are read and aggregated
+   * until the key changes, nothing is kept in the hash table.
+   */
+  auto NextSorted(Tuple *tuple, RID *rid) -> bool;
+
+  /** The number of values handed to a batch kernel at once */
+  static constexpr size_t BATCH_SIZE = 1024;
+
  private:
   /** The aggregation plan node */
   const AggregationPlanNode *plan_;
@@ -252,5 +379,8 @@ class AggregationExecutor : public AbstractExecutor {
   /** Simple aggregation hash table iterator */
   SimpleAggregationHashTable::Iterator aht_iterator_;
   bool has_no_tuple_;
+  /** The first row of the next group, read from the child by the sorted aggregation */
+  Tuple next_tuple_;
+  bool has_next_tuple_{false};
 };
 }  // namespace bustub
\ No newline at end of file
@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// distinct_executor.h
+//
+// Identification: src/include/execution/executors/distinct_executor.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "execution/distinct_hash_set.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/distinct_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/** The memory the distinct executor may use for the rows it has seen before it spills the new ones to disk */
+static constexpr size_t DISTINCT_MEMORY_BUDGET = 16 << 20;
+
+/**
+ * DistinctExecutor removes the duplicate rows of its child with a DistinctHashSet of the serialized rows. A row is
+ * output as soon as it is seen for the first time, so the executor doesn't block. Once the set reaches
+ * `DISTINCT_MEMORY_BUDGET`, the rows that are not in it are spilled to buffer pool pages, into partitions picked by
+ * their hash. After the child is exhausted, each partition is deduplicated on its own with an empty set, spilling
+ * again to finer partitions if it still doesn't fit. Equal rows always land in the same partition.
+ */
+class DistinctExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new DistinctExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The distinct plan to be executed
+   * @param child_executor The child executor from which tuples are obtained
+   */
+  DistinctExecutor(ExecutorContext *exec_ctx, const DistinctPlanNode *plan,
+                   std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  ~DistinctExecutor() override;
+
+  /** Initialize the distinct */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the distinct.
+   * @param[out] tuple The next tuple produced by the distinct
+   * @param[out] rid The next tuple RID produced by the distinct
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the distinct */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+ private:
+  /** Number of partitions a spill is split into, and the bits of the hash picking one */
+  static constexpr size_t SPILL_PARTITION_BITS = 3;
+  static constexpr size_t NUM_SPILL_PARTITIONS = 1 << SPILL_PARTITION_BITS;
+  /** Partitions are not split further past this level, their rows are kept in memory whatever the budget */
+  static constexpr size_t MAX_SPILL_LEVEL = 8;
+
+  /**
+   * Spilled rows, serialized as `| size (4) | tuple data |` one after the other in buffer pool pages. A size of 0
+   * ends a page. The page being filled is kept in memory until it is full.
+   */
+  struct SpillPartition {
+    std::vector<page_id_t> pages_;
+    std::vector<char> write_buffer_;
+    size_t level_{0};
+  };
+
+  /** @return the next row to deduplicate: from the child, then from the spilled partitions one after the other */
+  auto NextInput(Tuple *tuple) -> bool;
+
+  /** Write a row into the spill partition matching its hash */
+  void Spill(const Tuple &tuple, uint64_t hash);
+
+  /** Write the partially filled page of a partition to the buffer pool */
+  void FlushPartition(SpillPartition *partition);
+
+  /** Queue the partitions spilled while reading the current input, and start new ones */
+  void FinishSpilling();
+
+  /** Read the next row of the partition being read, @return false at its end */
+  auto ReadSpilled(Tuple *tuple) -> bool;
+
+  /** Delete the pages of every partition */
+  void DropPartitions();
+
+  /** The distinct plan node to be executed */
+  const DistinctPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  DistinctHashSet seen_;                     // 当前输入里已经输出过的行
+  bool reading_child_{true};                 // 还在读子执行器，否则在读溢出的分区
+  size_t level_{0};                          // 当前输入的层数：子执行器是0，从第k层分区溢出的行在第k+1层
+  std::vector<SpillPartition> spilling_;     // 当前输入溢出到的分区
+  std::deque<SpillPartition> pending_;       // 等待处理的分区
+  SpillPartition reading_;                   // 正在读的分区
+  size_t reading_page_idx_{0};               // 正在读的页在reading_.pages_中的下标
+  std::vector<char> read_buffer_;            // 正在读的页的内容
+  size_t read_offset_{0};
+};
+}  // namespace bustub
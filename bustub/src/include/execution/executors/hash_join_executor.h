@@ -16,6 +16,7 @@
 #include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "common/bustub_instance.h"
 #include "common/util/hash_util.h"
@@ -26,8 +27,24 @@
 
 namespace bustub{
   struct JoinKey{
-    Value value_;
-    auto operator==(const struct JoinKey &other) const -> bool{return value_.CompareEquals(other.value_) == CmpBool::CmpTrue;}
+    std::vector<Value> values_; // 每个连接条件对应一个值，所有的值都相等才算匹配
+    auto operator==(const struct JoinKey &other) const -> bool{
+      for(size_t i = 0; i < values_.size(); i++){
+        if(values_[i].CompareEquals(other.values_[i]) != CmpBool::CmpTrue){
+          return false;
+        }
+      }
+      return true;
+    }
+    /** @return 是否有值为NULL，NULL不和任何值相等 */
+    auto HasNull() const -> bool{
+      for(const auto &value : values_){
+        if(value.IsNull()){
+          return true;
+        }
+      }
+      return false;
+    }
   };
 } // namespace std;
 
@@ -35,9 +52,12 @@ namespace std{  // 针对JoinKey类型来特化hash函数
   template<>
   struct hash<bustub::JoinKey>{
     auto operator()(const bustub::JoinKey &key)const -> size_t{
+      // 一次遍历所有的key，把每一列的hash合并起来
       size_t cur_hash = 0;
-      if(!key.value_.IsNull()){
-        cur_hash = bustub::HashUtil::CombineHashes(cur_hash, bustub::HashUtil::HashValue(&key.value_));
+      for(const auto &value : key.values_){
+        if(!value.IsNull()){
+          cur_hash = bustub::HashUtil::CombineHashes(cur_hash, bustub::HashUtil::HashValue(&value));
+        }
       }
 
       return cur_hash;
@@ -76,13 +96,25 @@ class HashJoinExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
+  /** @return `true` if the join is a semi join or an anti join, which only outputs the tuples of the left side */
+  auto IsSemiOrAnti() const -> bool {
+    return plan_->GetJoinType() == JoinType::SEMI || plan_->GetJoinType() == JoinType::ANTI;
+  }
+
+  /** Yield the next left tuple that has (semi join) or has no (anti join) match in the hash table */
+  auto NextSemiOrAnti(Tuple *tuple) -> bool;
+
+  /** @return the join key of a tuple, one value per key expression */
+  static auto MakeJoinKey(const std::vector<AbstractExpressionRef> &exprs, const Tuple &tuple, const Schema &schema)
+      -> JoinKey;
+
   /** The NestedLoopJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> left_child_executor_;
   std::unique_ptr<AbstractExecutor> right_child_executor_;
   std::unordered_map<JoinKey, std::vector<Tuple>> right_hash_map_; // 用于存放左表hash之后的数据（注意这里使用的是模板特化之后的hash函数）
+  const std::vector<Tuple> *matched_tuples_{nullptr}; // 和左表tuple的key相同的右表tuple，没有的话为nullptr
   size_t current_index_; // 上一次遍历到tuple的位置
-  JoinKey left_join_key_; // 记录左表tuple的JoinKey
   Tuple left_tuple_;  // 记录左表的tuple
   bool is_matched_; // 标记左表的tuple是否连接成功
 };
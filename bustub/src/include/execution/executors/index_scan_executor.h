@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "common/rid.h"
@@ -42,11 +43,20 @@ class IndexScanExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** Position the cursor at the lower bound of the plan, for a B+ tree index with the given key type. */
+  template <typename KeyType, typename ValueType, typename KeyComparator>
+  void InitCursor(BPlusTreeIndex<KeyType, ValueType, KeyComparator> *tree);
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
 
-  BPlusTreeIndexForOneIntegerColumn *tree_;  // 树的索引
-  IndexIterator<IntegerKeyType, IntegerValueType, IntegerComparatorType> begin_;
-  IndexIterator<IntegerKeyType, IntegerValueType, IntegerComparatorType> end_;
+  const IndexInfo *index_info_;  // 索引的元信息
+  const TableInfo *table_info_;  // 索引对应的表的元信息
+
+  /** Fetch the RID of the next index entry within the key range, returns false once the range is exhausted */
+  std::function<bool(RID *)> next_rid_;
+
+  /** The number of tuples produced so far, checked against the limit of the plan */
+  size_t emitted_{0};
 };
 }  // namespace bustub
@@ -55,5 +55,6 @@ class LimitExecutor : public AbstractExecutor {
   std::unique_ptr<AbstractExecutor> child_executor_;
 
   size_t limit_count_; // 限制获取tuple的数量
+  size_t offset_count_; // 还需要跳过的tuple的数量
 };
 }  // namespace bustub
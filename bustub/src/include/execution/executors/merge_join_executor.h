@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.h
+//
+// Identification: src/include/execution/executors/merge_join_executor.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/merge_join_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * MergeJoinExecutor executes a sort-merge JOIN on two inputs sorted on their join keys.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new MergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The MergeJoin join plan to be executed
+   * @param left_child The child executor that produces tuples for the left side of join, sorted on the left key
+   * @param right_child The child executor that produces tuples for the right side of join, sorted on the right key
+   */
+  MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_child, std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join.
+   * @param[out] rid The next tuple RID, not used by merge join.
+   * @return `true` if a tuple was produced, `false` if there are no more tuples.
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the join */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /** Advance the right side to the run of tuples with key `key`, @return `true` if there is such a run */
+  auto SeekRightRun(const Value &key) -> bool;
+
+  /** Fetch the next right tuple into `right_tuple_` and evaluate its key */
+  void FetchRight();
+
+  /** The MergeJoin plan node to be executed. */
+  const MergeJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_child_executor_;
+  std::unique_ptr<AbstractExecutor> right_child_executor_;
+  Tuple left_tuple_;            // 当前正在连接的左表tuple
+  bool has_left_;               // 是否有正在连接的左表tuple
+  bool left_matched_;           // 当前左表tuple的key是否和right_run_的key相等
+  Tuple right_tuple_;           // 右表中下一个还没有读入right_run_的tuple
+  Value right_key_;             // right_tuple_的key
+  bool has_right_;              // 右表是否还有tuple
+  std::vector<Tuple> right_run_;  // 右表中key相同的一组tuple，左表中key相同的多个tuple都要和它们连接
+  Value run_key_;                 // right_run_的key
+  size_t run_index_;              // 当前左表tuple下一个要连接的right_run_中的位置
+};
+
+}  // namespace bustub
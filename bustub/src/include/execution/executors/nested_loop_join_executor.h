@@ -14,7 +14,9 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "common/config.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/nested_loop_join_plan.h"
@@ -22,8 +24,19 @@
 
 namespace bustub {
 
+/** The memory the outer (left) tuples of one block may use */
+static constexpr size_t NLJ_BLOCK_MEMORY_BUDGET = 4 << 20;
+/** The memory the inner (right) side may use before the rest of it is materialized into buffer pool pages */
+static constexpr size_t NLJ_INNER_MEMORY_BUDGET = 16 << 20;
+
 /**
- * NestedLoopJoinExecutor executes a nested-loop JOIN on two tables.
+ * NestedLoopJoinExecutor executes a block nested-loop JOIN on two tables. The right child runs once per Init: its
+ * tuples are materialized in memory, or past `NLJ_INNER_MEMORY_BUDGET` in chunks of buffer pool pages. The left tuples
+ * are read in blocks of `NLJ_BLOCK_MEMORY_BUDGET`, and every chunk of the inner side is joined against a whole block
+ * before the next chunk is read, so a spilled chunk is read once per block instead of once per left tuple.
+ *
+ * Within a chunk the output is in left-major order; when the inner side fits in memory it is the order of a tuple at a
+ * time nested loop join.
  */
 class NestedLoopJoinExecutor : public AbstractExecutor {
  public:
@@ -38,6 +51,8 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
                          std::unique_ptr<AbstractExecutor> &&left_executor,
                          std::unique_ptr<AbstractExecutor> &&right_executor);
 
+  ~NestedLoopJoinExecutor() override;
+
   /** Initialize the join */
   void Init() override;
 
@@ -53,15 +68,44 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
+  /** Read the right child into the resident chunk, and the spilled chunks if it doesn't fit */
+  void MaterializeInner();
+
+  /** Read the next block of left tuples, @return false if the left child is exhausted */
+  auto NextLeftBlock() -> bool;
+
+  /** Make `chunk_` point to the tuples of the inner chunk `chunk_idx_` */
+  void LoadChunk();
+
+  /** Write the page being filled of the last spilled chunk to the buffer pool */
+  void FlushSpillPage();
+
+  /** Delete the pages of the spilled chunks */
+  void DropSpilledChunks();
+
+  /** @return whether the left and right tuples satisfy the join predicate */
+  auto Matches(const Tuple &left, const Tuple &right) const -> bool;
+
+  /** @return the output tuple joining `left` with `right`, or with NULLs if `right` is null */
+  auto MakeOutput(const Tuple &left, const Tuple *right) const -> Tuple;
+
   /** The NestedLoopJoin plan node to be executed. */
   const NestedLoopJoinPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> left_executor_;   // 左表的执行器
   std::unique_ptr<AbstractExecutor> right_executor_;  // 右表的执行器
-  Tuple left_tuple_{}; // 用来存放左表的tuple
-  bool is_matched_;  // true:匹配成功，false:匹配失败
-  bool left_is_initialized_; // 左表是否是初始化的
-  bool right_is_need_initialized_; // 标记右表是否到达了尾部，即是否遍历完了一遍
-  bool has_no_tuple_;
+
+  std::vector<Tuple> resident_chunk_;                 // 右表常驻内存的部分（右表放得下的时候就是整个右表）
+  std::vector<std::vector<page_id_t>> spilled_chunks_; // 放不下的部分，每个chunk是一组页，一次读一个chunk到内存
+  std::vector<char> spill_buffer_;                    // 正在写的溢出页
+  std::vector<Tuple> loaded_chunk_;                   // 从溢出页读到内存中的chunk
+  const std::vector<Tuple> *chunk_{nullptr};          // 正在连接的chunk
+
+  std::vector<Tuple> left_block_;                     // 当前块中的左表tuple
+  std::vector<bool> left_matched_;                    // 当前块中每个左表tuple是否匹配过
+  size_t chunk_idx_{0};                               // 正在连接的chunk，0是常驻内存的部分
+  size_t left_idx_{0};                                // 正在连接的左表tuple在块中的下标
+  size_t inner_idx_{0};                               // 下一个要比较的右表tuple在chunk中的下标
+  bool has_no_tuple_{false};
 };
 
 }  // namespace bustub
@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// profiling_executor.h
+//
+// Identification: src/include/execution/executors/profiling_executor.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "execution/execution_profile.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * ProfilingExecutor wraps the executor of a plan node when the query runs under EXPLAIN ANALYZE, and records the
+ * time spent, the tuples produced, the buffer pool accesses and the lock waits of the wrapped executor into the
+ * profile of the executor context.
+ */
+class ProfilingExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new ProfilingExecutor instance.
+   * @param exec_ctx The executor context, it must have a profile
+   * @param plan The plan node executed by the wrapped executor
+   * @param child_executor The wrapped executor
+   */
+  ProfilingExecutor(ExecutorContext *exec_ctx, const AbstractPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the wrapped executor */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the wrapped executor.
+   * @param[out] tuple The next tuple produced by the wrapped executor
+   * @param[out] rid The next tuple RID produced by the wrapped executor
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema of the wrapped executor */
+  auto GetOutputSchema() const -> const Schema & override { return child_executor_->GetOutputSchema(); }
+
+ private:
+  /** Run `func` and add the time and the buffer pool / lock activity during it to the statistics */
+  template <typename Func>
+  auto Measure(uint64_t *elapsed_ns, Func &&func);
+
+  /** The wrapped executor */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The statistics of the plan node, owned by the profile of the executor context */
+  ExecutorStats *stats_;
+};
+
+}  // namespace bustub
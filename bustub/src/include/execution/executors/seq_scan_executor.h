@@ -12,11 +12,13 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/runtime_filter.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -53,5 +55,6 @@ class SeqScanExecutor : public AbstractExecutor {
 
   const TableInfo *table_info_; // 表的元信息，用来判断这个表是否可以被scan
   std::unique_ptr<TableIterator> table_iter_{nullptr};
+  std::vector<std::pair<const RuntimeFilter *, uint32_t>> runtime_filters_; // hash join下推下来的runtime filter和对应的列
 };
 }  // namespace bustub
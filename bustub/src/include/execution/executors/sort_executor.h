@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/executor_context.h"
@@ -49,7 +50,17 @@ class SortExecutor : public AbstractExecutor {
   /** @return The output schema for the sort */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
   void SortTuples(std::vector<Tuple> &tuples);
-  auto CompareTuples(Tuple &a, Tuple &b) -> bool;
+
+  /** @return the values of the ORDER BY expressions over a tuple */
+  static auto MakeSortKey(const Tuple &tuple, const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys,
+                          const Schema &schema) -> std::vector<Value>;
+
+  /**
+   * Three-way compare two sort keys made by MakeSortKey. NULL sorts before any other value.
+   * @return < 0, 0 or > 0 when a sorts before, together with or after b
+   */
+  static auto CompareSortKeys(const std::vector<Value> &a, const std::vector<Value> &b,
+                              const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys) -> int;
 
  private:
   /** The sort plan node to be executed */
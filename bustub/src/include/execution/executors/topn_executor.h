@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/executor_context.h"
@@ -24,7 +25,8 @@
 namespace bustub {
 
 /**
- * The TopNExecutor executor executes a topn.
+ * The TopNExecutor executor executes a topn. It keeps a bounded max-heap of the `n + offset` first tuples seen so
+ * far, with their sort keys computed once, so it uses O(n) memory and O(log n) work per child tuple.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
@@ -46,20 +48,25 @@ class TopNExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
-  // 比较函数
-  // (注意这里需要将比较函数定义成静态成员函数才能传递到priority_queue中，但比较函数中会用到实例化之后的成员变量，故这里只能使用lamda匿名函数)
-  // auto Compare(const Tuple &tuple_first,const Tuple &tuple_second) -> bool;
-
   /** @return The output schema for the topn */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
-  void SortTuples(std::vector<Tuple> &tuples);
-  auto CompareTuples(Tuple &a, Tuple &b) -> bool;
-  
+
  private:
+  /** A tuple in the heap with its sort key. seq_ is the position in the child, equal keys keep the child order. */
+  struct HeapEntry {
+    std::vector<Value> key_;
+    size_t seq_;
+    Tuple tuple_;
+  };
+
+  /** @return whether a sorts before b */
+  auto SortsBefore(const HeapEntry &a, const HeapEntry &b) const -> bool;
+
   /** The topn plan node to be executed */
   const TopNPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> child_executor_; // 子执行器
-  std::queue<Tuple> queue_;
-  size_t limit_count_;
+  std::vector<HeapEntry> heap_;  // 大顶堆，堆顶是当前保留的tuple中排在最后的那个
+  std::vector<Tuple> output_;    // 排好序之后跳过offset个的结果
+  size_t cursor_{0};             // output_中下一个要输出的位置
 };
 }  // namespace bustub
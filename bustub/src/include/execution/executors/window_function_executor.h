@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// window_function_executor.h
+//
+// Identification: src/include/execution/executors/window_function_executor.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/window_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * The WindowFunctionExecutor executor computes window functions over its child, one partition at a time. The child
+ * produces the rows sorted by the partition keys and then by the order keys, so only the rows of the current partition
+ * are buffered.
+ */
+class WindowFunctionExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new WindowFunctionExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The window function plan to be executed
+   * @param child_executor The child executor, sorted by the partition keys and the order keys
+   */
+  WindowFunctionExecutor(ExecutorContext *exec_ctx, const WindowFunctionPlanNode *plan,
+                         std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the window function */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the window function.
+   * @param[out] tuple The next tuple produced by the window function
+   * @param[out] rid The next tuple RID produced by the window function
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the window function */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+ private:
+  /** Read the next partition from the child and compute its output tuples, @return false if there is none */
+  auto NextPartition() -> bool;
+
+  /** Compute a window function for every row of the current partition */
+  auto ComputeWindowFunction(const WindowFunctionPlanNode::WindowFunction &window_function) -> std::vector<Value>;
+
+  /** @return whether the rows at i and j of the current partition are peers, i.e. equal on the ORDER BY */
+  auto IsPeer(size_t i, size_t j) const -> bool;
+
+  /** Add an input to the value of an aggregate window function */
+  static void Accumulate(WindowFunctionType type, const Value &input, Value *result);
+
+  /** The window function plan node to be executed */
+  const WindowFunctionPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> partition_keys_; // 分区的key，用来判断分区是否结束
+  std::vector<Tuple> partition_;                  // 当前分区的所有tuple
+  std::vector<std::vector<Value>> order_keys_;    // 当前分区每个tuple的ORDER BY的值
+  std::vector<Tuple> output_;                     // 当前分区计算好的输出
+  size_t cursor_{0};                              // output_中下一个要输出的位置
+  Tuple lookahead_;                               // 多读出来的下一个分区的第一个tuple
+  std::vector<Value> lookahead_partition_key_;    // lookahead_的分区key
+  bool has_lookahead_{false};
+  bool child_done_{false};
+};
+}  // namespace bustub
@@ -12,7 +12,6 @@
 
 #pragma once
 
-#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,37 +31,27 @@ namespace bustub {
 enum class ArithmeticType { Plus, Minus };
 
 /**
- * ArithmeticExpression represents two expressions being computed, ONLY SUPPORT INTEGER FOR NOW.
+ * ArithmeticExpression represents two expressions being computed, ONLY SUPPORT INTEGER AND FIXED_DECIMAL FOR NOW.
+ * The result is a FIXED_DECIMAL as soon as one side is.
  */
 class ArithmeticExpression : public AbstractExpression {
  public:
   /** Creates a new comparison expression representing (left comp_type right). */
-  ArithmeticExpression(AbstractExpressionRef left, AbstractExpressionRef right, ArithmeticType compute_type)
-      : AbstractExpression({std::move(left), std::move(right)}, TypeId::INTEGER), compute_type_{compute_type} {
-    if (GetChildAt(0)->GetReturnType() != TypeId::INTEGER || GetChildAt(1)->GetReturnType() != TypeId::INTEGER) {
-      throw bustub::NotImplementedException("only support integer for now");
-    }
-  }
+  ArithmeticExpression(const AbstractExpressionRef &left, const AbstractExpressionRef &right,
+                       ArithmeticType compute_type)
+      : AbstractExpression({left, right}, InferReturnType(*left, *right)), compute_type_{compute_type} {}
 
   auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override {
     Value lhs = GetChildAt(0)->Evaluate(tuple, schema);
     Value rhs = GetChildAt(1)->Evaluate(tuple, schema);
-    auto res = PerformComputation(lhs, rhs);
-    if (res == std::nullopt) {
-      return ValueFactory::GetNullValueByType(TypeId::INTEGER);
-    }
-    return ValueFactory::GetIntegerValue(*res);
+    return PerformComputation(lhs, rhs);
   }
 
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     Value lhs = GetChildAt(0)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
     Value rhs = GetChildAt(1)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
-    auto res = PerformComputation(lhs, rhs);
-    if (res == std::nullopt) {
-      return ValueFactory::GetNullValueByType(TypeId::INTEGER);
-    }
-    return ValueFactory::GetIntegerValue(*res);
+    return PerformComputation(lhs, rhs);
   }
 
   /** @return the string representation of the expression node and its children */
@@ -75,15 +64,38 @@ class ArithmeticExpression : public AbstractExpression {
   ArithmeticType compute_type_;
 
  private:
-  auto PerformComputation(const Value &lhs, const Value &rhs) const -> std::optional<int32_t> {
+  static auto InferReturnType(const AbstractExpression &left, const AbstractExpression &right) -> TypeId {
+    auto supported = [](TypeId type) { return type == TypeId::INTEGER || type == TypeId::FIXED_DECIMAL; };
+    if (!supported(left.GetReturnType()) || !supported(right.GetReturnType())) {
+      throw bustub::NotImplementedException("only support integer and decimal for now");
+    }
+    if (left.GetReturnType() == TypeId::FIXED_DECIMAL || right.GetReturnType() == TypeId::FIXED_DECIMAL) {
+      return TypeId::FIXED_DECIMAL;
+    }
+    return TypeId::INTEGER;
+  }
+
+  auto PerformComputation(const Value &lhs, const Value &rhs) const -> Value {
     if (lhs.IsNull() || rhs.IsNull()) {
-      return std::nullopt;
+      return ValueFactory::GetNullValueByType(GetReturnType());
+    }
+    if (GetReturnType() == TypeId::FIXED_DECIMAL) {
+      // the arithmetic of FIXED_DECIMAL is exact, an INTEGER on the left is converted first
+      auto exact_lhs = ValueFactory::CastAsFixedDecimal(lhs);
+      switch (compute_type_) {
+        case ArithmeticType::Plus:
+          return exact_lhs.Add(rhs);
+        case ArithmeticType::Minus:
+          return exact_lhs.Subtract(rhs);
+        default:
+          UNREACHABLE("Unsupported arithmetic type.");
+      }
     }
     switch (compute_type_) {
       case ArithmeticType::Plus:
-        return lhs.GetAs<int32_t>() + rhs.GetAs<int32_t>();
+        return ValueFactory::GetIntegerValue(lhs.GetAs<int32_t>() + rhs.GetAs<int32_t>());
       case ArithmeticType::Minus:
-        return lhs.GetAs<int32_t>() - rhs.GetAs<int32_t>();
+        return ValueFactory::GetIntegerValue(lhs.GetAs<int32_t>() - rhs.GetAs<int32_t>());
       default:
         UNREACHABLE("Unsupported arithmetic type.");
     }
@@ -19,7 +19,9 @@
 #include "catalog/schema.h"
 #include "execution/expressions/abstract_expression.h"
 #include "fmt/format.h"
+#include "common/macros.h"
 #include "storage/table/tuple.h"
+#include "type/type_kernel.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -34,7 +36,11 @@ class ComparisonExpression : public AbstractExpression {
  public:
   /** Creates a new comparison expression representing (left comp_type right). */
   ComparisonExpression(AbstractExpressionRef left, AbstractExpressionRef right, ComparisonType comp_type)
-      : AbstractExpression({std::move(left), std::move(right)}, TypeId::BOOLEAN), comp_type_{comp_type} {}
+      : AbstractExpression({std::move(left), std::move(right)}, TypeId::BOOLEAN),
+        comp_type_{comp_type},
+        left_type_{GetChildAt(0)->GetReturnType()},
+        right_type_{GetChildAt(1)->GetReturnType()},
+        kernel_{TypeKernels::GetCompareKernel(left_type_, right_type_, ToCompareOp(comp_type))} {}
 
   auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override {
     Value lhs = GetChildAt(0)->Evaluate(tuple, schema);
@@ -59,7 +65,31 @@ class ComparisonExpression : public AbstractExpression {
   ComparisonType comp_type_;
 
  private:
+  static auto ToCompareOp(ComparisonType comp_type) -> CompareOp {
+    switch (comp_type) {
+      case ComparisonType::Equal:
+        return CompareOp::Equal;
+      case ComparisonType::NotEqual:
+        return CompareOp::NotEqual;
+      case ComparisonType::LessThan:
+        return CompareOp::LessThan;
+      case ComparisonType::LessThanOrEqual:
+        return CompareOp::LessThanOrEqual;
+      case ComparisonType::GreaterThan:
+        return CompareOp::GreaterThan;
+      case ComparisonType::GreaterThanOrEqual:
+        return CompareOp::GreaterThanOrEqual;
+      default:
+        UNREACHABLE("Unsupported comparison type.");
+    }
+  }
+
   auto PerformComparison(const Value &lhs, const Value &rhs) const -> CmpBool {
+    // The kernel was picked for the return types of the children, the values only have other types when a child
+    // lies about its type (e.g. a NULL constant), so check them before taking the fast path.
+    if (kernel_ != nullptr && lhs.GetTypeId() == left_type_ && rhs.GetTypeId() == right_type_) {
+      return kernel_(lhs, rhs);
+    }
     switch (comp_type_) {
       case ComparisonType::Equal:
         return lhs.CompareEquals(rhs);
@@ -77,6 +107,12 @@ class ComparisonExpression : public AbstractExpression {
         BUSTUB_ASSERT(false, "Unsupported comparison type.");
     }
   }
+
+  /** The return types of the children when the expression was built */
+  TypeId left_type_;
+  TypeId right_type_;
+  /** The kernel comparing values of these types, nullptr if there is none */
+  CompareKernel kernel_;
 };
 }  // namespace bustub
 
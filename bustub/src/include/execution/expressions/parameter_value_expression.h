@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parameter_value_expression.h
+//
+// Identification: src/include/expression/parameter_value_expression.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "fmt/format.h"
+
+namespace bustub {
+/**
+ * ParameterValueExpression represents a parameter of a prepared statement, e.g. `$1`. The value is kept in a slot
+ * shared by all copies of the expression, so that a cached plan can be executed again with new parameter values by
+ * filling the slots, without touching the plan itself.
+ */
+class ParameterValueExpression : public AbstractExpression {
+ public:
+  /**
+   * Creates a new parameter value expression.
+   * @param param_idx the index of the parameter, starting from 0
+   * @param slot the slot holding the value of the parameter
+   * @param ret_type the declared type of the parameter
+   */
+  ParameterValueExpression(size_t param_idx, std::shared_ptr<Value> slot, TypeId ret_type)
+      : AbstractExpression({}, ret_type), param_idx_(param_idx), slot_(std::move(slot)) {}
+
+  auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override { return *slot_; }
+
+  auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
+                    const Schema &right_schema) const -> Value override {
+    return *slot_;
+  }
+
+  /** @return the string representation of the plan node and its children */
+  auto ToString() const -> std::string override { return fmt::format("${}", param_idx_ + 1); }
+
+  BUSTUB_EXPR_CLONE_WITH_CHILDREN(ParameterValueExpression);
+
+  /** The index of the parameter, starting from 0 */
+  size_t param_idx_;
+
+  /** The slot holding the value of the parameter */
+  std::shared_ptr<Value> slot_;
+};
+}  // namespace bustub
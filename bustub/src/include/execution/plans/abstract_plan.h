@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -42,12 +43,15 @@ enum class PlanType {
   NestedLoopJoin,
   NestedIndexJoin,
   HashJoin,
+  MergeJoin,
   Filter,
   Values,
   Projection,
   Sort,
   TopN,
-  MockScan
+  MockScan,
+  Window,
+  Distinct
 };
 
 class AbstractPlanNode;
@@ -92,6 +96,13 @@ class AbstractPlanNode {
     return fmt::format("{}{}", PlanNodeToString(), ChildrenToString(2, with_schema));
   }
 
+  /**
+   * @return the string representation of the plan node and its children, with `annotate(node)` appended to every
+   * node, e.g. the runtime statistics of EXPLAIN ANALYZE
+   */
+  auto ToString(bool with_schema, const std::function<std::string(const AbstractPlanNode &)> &annotate) const
+      -> std::string;
+
   /** @return the cloned plan node with new children */
   virtual auto CloneWithChildren(std::vector<AbstractPlanNodeRef> children) const
       -> std::unique_ptr<AbstractPlanNode> = 0;
@@ -110,7 +121,9 @@ class AbstractPlanNode {
   virtual auto PlanNodeToString() const -> std::string { return "<unknown>"; }
 
   /** @return the string representation of the plan node's children */
-  auto ChildrenToString(int indent, bool with_schema = true) const -> std::string;
+  auto ChildrenToString(int indent, bool with_schema = true,
+                        const std::function<std::string(const AbstractPlanNode &)> &annotate = nullptr) const
+      -> std::string;
 
  private:
 };
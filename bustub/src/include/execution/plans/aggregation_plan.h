@@ -18,6 +18,8 @@
 #include <vector>
 
 #include "common/util/hash_util.h"
+#include "common/util/hyperloglog.h"
+#include "execution/distinct_hash_set.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "fmt/format.h"
@@ -25,8 +27,19 @@
 
 namespace bustub {
 
-/** AggregationType enumerates all the possible aggregation functions in our system */
-enum class AggregationType { CountStarAggregate, CountAggregate, SumAggregate, MinAggregate, MaxAggregate };
+/**
+ * AggregationType enumerates all the possible aggregation functions in our system. ApproxCountDistinctAggregate
+ * estimates the number of distinct values with a HyperLogLog sketch.
+ */
+enum class AggregationType {
+  CountStarAggregate,
+  CountAggregate,
+  SumAggregate,
+  MinAggregate,
+  MaxAggregate,
+  CountDistinctAggregate,
+  ApproxCountDistinctAggregate
+};
 
 /**
  * AggregationPlanNode represents the various SQL aggregation functions.
@@ -79,6 +92,9 @@ class AggregationPlanNode : public AbstractPlanNode {
                              const std::vector<AbstractExpressionRef> &aggregates,
                              const std::vector<AggregationType> &agg_types) -> Schema;
 
+  /** @return the type of the result of an aggregate, SUM / MIN / MAX of a FIXED_DECIMAL stay exact */
+  static auto InferAggReturnType(const AbstractExpressionRef &aggregate, AggregationType agg_type) -> TypeId;
+
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(AggregationPlanNode);
 
   /** The GROUP BY expressions */
@@ -87,6 +103,11 @@ class AggregationPlanNode : public AbstractPlanNode {
   std::vector<AbstractExpressionRef> aggregates_; // min/max/count/count(*)对应的那些列
   /** The aggregation types */  
   std::vector<AggregationType> agg_types_;        // 聚集函数的类型
+  /**
+   * Whether the child produces the rows of each group consecutively (sorted on the group keys), so that the groups are
+   * aggregated one at a time instead of in a hash table. Set by `Optimizer::OptimizeSortedAggregation`.
+   */
+  bool sorted_input_{false};
 
  protected:
   auto PlanNodeToString() const -> std::string override;
@@ -116,6 +137,10 @@ struct AggregateKey {
 struct AggregateValue {
   /** The aggregate values */
   std::vector<Value> aggregates_;   // 这里对应的是87、89两个按照列具体分组之后聚合函数计算出来的值，这里对应的是某一个分组
+  /** The values already counted by each COUNT(DISTINCT), only sized when the aggregation has one */
+  std::vector<DistinctHashSet> distinct_inputs_;
+  /** The sketch of each APPROX_COUNT_DISTINCT, nullptr for the other aggregates */
+  std::vector<std::unique_ptr<HyperLogLog>> sketches_;
 };
 
 }  // namespace bustub
@@ -160,6 +185,12 @@ struct fmt::formatter<bustub::AggregationType> : formatter<std::string> {
       case AggregationType::MaxAggregate:
         name = "max";
         break;
+      case AggregationType::CountDistinctAggregate:
+        name = "count_distinct";
+        break;
+      case AggregationType::ApproxCountDistinctAggregate:
+        name = "approx_count_distinct";
+        break;
     }
     return formatter<std::string>::format(name, ctx);
   }
@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// distinct_plan.h
+//
+// Identification: src/include/execution/plans/distinct_plan.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "execution/plans/abstract_plan.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/**
+ * DistinctPlanNode removes the duplicate rows of its child, for SELECT DISTINCT. Its output has the columns of its
+ * child.
+ */
+class DistinctPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new DistinctPlanNode instance.
+   * @param output The output schema, the one of the child
+   * @param child The child plan from which tuples are obtained
+   */
+  DistinctPlanNode(SchemaRef output, AbstractPlanNodeRef child)
+      : AbstractPlanNode(std::move(output), {std::move(child)}) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::Distinct; }
+
+  /** @return The child plan node */
+  auto GetChildPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Distinct should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(DistinctPlanNode);
+
+ protected:
+  auto PlanNodeToString() const -> std::string override { return "Distinct"; }
+};
+
+}  // namespace bustub
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,7 +24,8 @@
 namespace bustub {
 
 /**
- * Hash join performs a JOIN operation with a hash table.
+ * Hash join performs a JOIN operation with a hash table. The join key is a list of expressions on each side, and two
+ * rows match when all their keys are equal, e.g. `a.x = b.x AND a.y = b.y` has the keys `[a.x, a.y]` and `[b.x, b.y]`.
  */
 class HashJoinPlanNode : public AbstractPlanNode {
  public:
@@ -31,25 +33,30 @@ class HashJoinPlanNode : public AbstractPlanNode {
    * Construct a new HashJoinPlanNode instance.
    * @param output_schema The output schema for the JOIN
    * @param children The child plans from which tuples are obtained
-   * @param left_key_expression The expression for the left JOIN key
-   * @param right_key_expression The expression for the right JOIN key
+   * @param left_key_expressions The expressions for the left JOIN key
+   * @param right_key_expressions The expressions for the right JOIN key, as many as the left ones
    */
   HashJoinPlanNode(SchemaRef output_schema, AbstractPlanNodeRef left, AbstractPlanNodeRef right,
-                   AbstractExpressionRef left_key_expression, AbstractExpressionRef right_key_expression,
-                   JoinType join_type)
+                   std::vector<AbstractExpressionRef> left_key_expressions,
+                   std::vector<AbstractExpressionRef> right_key_expressions, JoinType join_type)
       : AbstractPlanNode(std::move(output_schema), {std::move(left), std::move(right)}),
-        left_key_expression_{std::move(left_key_expression)},
-        right_key_expression_{std::move(right_key_expression)},
-        join_type_(join_type) {}
+        left_key_expressions_{std::move(left_key_expressions)},
+        right_key_expressions_{std::move(right_key_expressions)},
+        join_type_(join_type) {
+    BUSTUB_ASSERT(!left_key_expressions_.empty() && left_key_expressions_.size() == right_key_expressions_.size(),
+                  "Hash joins should have as many left keys as right keys.");
+  }
 
   /** @return The type of the plan node */
   auto GetType() const -> PlanType override { return PlanType::HashJoin; }
 
-  /** @return The expression to compute the left join key */
-  auto LeftJoinKeyExpression() const -> const AbstractExpression & { return *left_key_expression_; }
+  /** @return The expressions to compute the left join key */
+  auto LeftJoinKeyExpressions() const -> const std::vector<AbstractExpressionRef> & { return left_key_expressions_; }
 
-  /** @return The expression to compute the right join key */
-  auto RightJoinKeyExpression() const -> const AbstractExpression & { return *right_key_expression_; }
+  /** @return The expressions to compute the right join key */
+  auto RightJoinKeyExpressions() const -> const std::vector<AbstractExpressionRef> & {
+    return right_key_expressions_;
+  }
 
   /** @return The left plan node of the hash join */
   auto GetLeftPlan() const -> AbstractPlanNodeRef {
@@ -68,19 +75,22 @@ class HashJoinPlanNode : public AbstractPlanNode {
 
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(HashJoinPlanNode);
 
-  /** The expression to compute the left JOIN key */
-  AbstractExpressionRef left_key_expression_;
-  /** The expression to compute the right JOIN key */
-  AbstractExpressionRef right_key_expression_;
+  /** The expressions to compute the left JOIN key */
+  std::vector<AbstractExpressionRef> left_key_expressions_;
+  /** The expressions to compute the right JOIN key */
+  std::vector<AbstractExpressionRef> right_key_expressions_;
 
   /** The join type */
   JoinType join_type_;
 
+  /**
+   * The id of the runtime filter built from the first right join key for the scans of the left side, nullopt if none.
+   * See `SeqScanPlanNode::runtime_filters_`.
+   */
+  std::optional<size_t> runtime_filter_id_;
+
  protected:
-  auto PlanNodeToString() const -> std::string override {
-    return fmt::format("HashJoin {{ type={}, left_key={}, right_key={} }}", join_type_, left_key_expression_,
-                       right_key_expression_);
-  }
+  auto PlanNodeToString() const -> std::string override;
 };
 
 }  // namespace bustub
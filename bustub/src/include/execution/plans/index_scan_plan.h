@@ -12,12 +12,15 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "type/value.h"
 
 namespace bustub {
 /**
@@ -29,9 +32,20 @@ class IndexScanPlanNode : public AbstractPlanNode {
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
    * @param table_oid the identifier of table to be scanned
+   * @param filter_predicate the predicate the scanned tuples must satisfy, nullptr if none
+   * @param lower_bound the smallest key to scan (inclusive), one expression per key column; empty if unbounded
+   * @param upper_bound the largest key to scan (inclusive), one expression per key column; empty if unbounded
+   * @param limit the number of tuples after which the scan stops, std::nullopt to scan the whole range
    */
-  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
-      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, AbstractExpressionRef filter_predicate = nullptr,
+                    std::vector<AbstractExpressionRef> lower_bound = {},
+                    std::vector<AbstractExpressionRef> upper_bound = {}, std::optional<size_t> limit = std::nullopt)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        filter_predicate_(std::move(filter_predicate)),
+        lower_bound_(std::move(lower_bound)),
+        upper_bound_(std::move(upper_bound)),
+        limit_(limit) {}
 
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
@@ -43,10 +57,24 @@ class IndexScanPlanNode : public AbstractPlanNode {
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
 
+  /** The predicate to filter in index scan, for the conjuncts that are not covered by the key range. */
+  AbstractExpressionRef filter_predicate_;
+
+  /**
+   * The key range to scan. The full index is scanned in key order when both are empty. The bounds are constants or
+   * parameters of a prepared statement, they are evaluated when the scan starts.
+   */
+  std::vector<AbstractExpressionRef> lower_bound_;
+  std::vector<AbstractExpressionRef> upper_bound_;
+
+  /**
+   * The scan stops after producing this many tuples that satisfy the filter. Pushed down from a LIMIT over the scan
+   * (see OptimizeSortLimitAsTopN), so an ORDER BY ... LIMIT k served by the index only reads k entries.
+   */
+  std::optional<size_t> limit_;
+
  protected:
-  auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
-  }
+  auto PlanNodeToString() const -> std::string override;
 };
 
 }  // namespace bustub
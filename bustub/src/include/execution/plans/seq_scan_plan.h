@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "binder/table_ref/bound_base_table_ref.h"
 #include "catalog/catalog.h"
@@ -62,12 +63,25 @@ class SeqScanPlanNode : public AbstractPlanNode {
   */
   AbstractExpressionRef filter_predicate_;
 
+  /**
+   * The runtime filters of the hash joins above the scan, as (runtime filter id, column index) pairs. A row is skipped
+   * if the value of a column can't be found in the filter of its join.
+   */
+  std::vector<std::pair<size_t, uint32_t>> runtime_filters_;
+
  protected:
   auto PlanNodeToString() const -> std::string override {
+    std::string runtime_filters;
+    for (const auto &[filter_id, col_idx] : runtime_filters_) {
+      runtime_filters += fmt::format("{}rf{}(#0.{})", runtime_filters.empty() ? "" : ", ", filter_id, col_idx);
+    }
+    if (!runtime_filters.empty()) {
+      runtime_filters = fmt::format(", runtime_filters=[{}]", runtime_filters);
+    }
     if (filter_predicate_) {
-      return fmt::format("SeqScan {{ table={}, filter={} }}", table_name_, filter_predicate_);
+      return fmt::format("SeqScan {{ table={}, filter={}{} }}", table_name_, filter_predicate_, runtime_filters);
     }
-    return fmt::format("SeqScan {{ table={} }}", table_name_);
+    return fmt::format("SeqScan {{ table={}{} }}", table_name_, runtime_filters);
   }
 };
 
@@ -36,10 +36,15 @@ class TopNPlanNode : public AbstractPlanNode {
    * @param child The child plan node
    * @param order_bys The sort expressions and their order by types.
    * @param n Retain n elements.
+   * @param offset Skip the first offset elements before the n retained ones.
    */
   TopNPlanNode(SchemaRef output, AbstractPlanNodeRef child,
-               std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys, std::size_t n)
-      : AbstractPlanNode(std::move(output), {std::move(child)}), order_bys_(std::move(order_bys)), n_{n} {}
+               std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys, std::size_t n,
+               std::size_t offset = 0)
+      : AbstractPlanNode(std::move(output), {std::move(child)}),
+        order_bys_(std::move(order_bys)),
+        n_{n},
+        offset_{offset} {}
 
   /** @return The type of the plan node */
   auto GetType() const -> PlanType override { return PlanType::TopN; }
@@ -47,6 +52,9 @@ class TopNPlanNode : public AbstractPlanNode {
   /** @return The N (limit) */
   auto GetN() const -> size_t { return n_; }
 
+  /** @return The offset */
+  auto GetOffset() const -> size_t { return offset_; }
+
   /** @return Get order by expressions */
   auto GetOrderBy() const -> const std::vector<std::pair<OrderByType, AbstractExpressionRef>> & { return order_bys_; }
 
@@ -60,6 +68,7 @@ class TopNPlanNode : public AbstractPlanNode {
 
   std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys_;
   std::size_t n_;
+  std::size_t offset_;
 
  protected:
   auto PlanNodeToString() const -> std::string override;
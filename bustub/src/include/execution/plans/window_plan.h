@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// window_plan.h
+//
+// Identification: src/include/execution/plans/window_plan.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "binder/expressions/bound_window.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/** WindowFunctionType enumerates all the window functions supported by the system */
+enum class WindowFunctionType {
+  CountStarAggregate,
+  CountAggregate,
+  SumAggregate,
+  MinAggregate,
+  MaxAggregate,
+  RowNumber,
+  Rank,
+  DenseRank
+};
+
+/**
+ * WindowFunctionPlanNode computes window functions, e.g. `rank() OVER (PARTITION BY x ORDER BY y)`, over its child.
+ * The child produces the rows sorted by the partition keys and then by the order keys (the planner puts a sort under
+ * this node), so that every partition, and every group of peers in a partition, is a run of consecutive rows. All the
+ * window functions of a node share the same PARTITION BY and ORDER BY, and are computed in a single pass.
+ *
+ * The output has one column per item of the select list: `columns_` are the expressions evaluated over the child for
+ * the plain columns, and `window_functions_` hold the window function of the other columns, by column index.
+ */
+class WindowFunctionPlanNode : public AbstractPlanNode {
+ public:
+  /** A window function of the select list */
+  struct WindowFunction {
+    /** The argument of the function, a constant for the functions without argument */
+    AbstractExpressionRef function_;
+    WindowFunctionType type_;
+    WindowFrameType frame_;
+  };
+
+  /**
+   * Construct a new WindowFunctionPlanNode.
+   * @param output_schema The output format of this plan node
+   * @param child The child plan, sorted by the partition keys and the order keys
+   * @param columns The expressions of the plain columns, a placeholder at the index of a window function
+   * @param partition_by The PARTITION BY expressions
+   * @param order_by The ORDER BY of the windows
+   * @param window_functions The window functions, by column index
+   */
+  WindowFunctionPlanNode(SchemaRef output_schema, AbstractPlanNodeRef child, std::vector<AbstractExpressionRef> columns,
+                         std::vector<AbstractExpressionRef> partition_by,
+                         std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_by,
+                         std::unordered_map<uint32_t, WindowFunction> window_functions)
+      : AbstractPlanNode(std::move(output_schema), {std::move(child)}),
+        columns_(std::move(columns)),
+        partition_by_(std::move(partition_by)),
+        order_by_(std::move(order_by)),
+        window_functions_(std::move(window_functions)) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::Window; }
+
+  /** @return the child of the window function plan node */
+  auto GetChildPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Window function expected to only have one child.");
+    return GetChildAt(0);
+  }
+
+  /** @return the type of the result of a window function over an argument */
+  static auto InferWindowReturnType(const WindowFunction &window_function) -> TypeId;
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(WindowFunctionPlanNode);
+
+  /** The expressions of the output columns, placeholders for the window functions */
+  std::vector<AbstractExpressionRef> columns_;
+  /** The PARTITION BY expressions */
+  std::vector<AbstractExpressionRef> partition_by_;
+  /** The ORDER BY of the windows */
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_by_;
+  /** The window functions, by output column index */
+  std::unordered_map<uint32_t, WindowFunction> window_functions_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
+
+template <>
+struct fmt::formatter<bustub::WindowFunctionType> : formatter<std::string> {
+  template <typename FormatContext>
+  auto format(bustub::WindowFunctionType c, FormatContext &ctx) const {
+    using bustub::WindowFunctionType;
+    std::string name = "unknown";
+    switch (c) {
+      case WindowFunctionType::CountStarAggregate:
+        name = "count_star";
+        break;
+      case WindowFunctionType::CountAggregate:
+        name = "count";
+        break;
+      case WindowFunctionType::SumAggregate:
+        name = "sum";
+        break;
+      case WindowFunctionType::MinAggregate:
+        name = "min";
+        break;
+      case WindowFunctionType::MaxAggregate:
+        name = "max";
+        break;
+      case WindowFunctionType::RowNumber:
+        name = "row_number";
+        break;
+      case WindowFunctionType::Rank:
+        name = "rank";
+        break;
+      case WindowFunctionType::DenseRank:
+        name = "dense_rank";
+        break;
+    }
+    return formatter<std::string>::format(name, ctx);
+  }
+};
@@ -0,0 +1,112 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.h
+//
+// Identification: src/include/execution/runtime_filter.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * A RuntimeFilter summarizes the join keys of the build side of a hash join, with a Bloom filter and the min / max
+ * key. The hash join publishes it in the executor context once the hash table is built, and the scans of the probe
+ * side use it to drop the rows that can't find a match before they are locked, copied and sent up to the join. It
+ * never rejects a key that was inserted, but may accept a key that wasn't.
+ */
+class RuntimeFilter {
+ public:
+  /** Bits of the Bloom filter per distinct key, about 1.7% false positives with 3 hash functions */
+  static constexpr size_t BITS_PER_KEY = 10;
+  static constexpr size_t NUM_HASHES = 3;
+
+  /**
+   * Create an empty filter.
+   * @param key_cnt the number of distinct keys that will be inserted
+   */
+  explicit RuntimeFilter(size_t key_cnt) : bits_(std::max<size_t>(1, (key_cnt * BITS_PER_KEY + 63) / 64)) {}
+
+  /** Add a non-NULL join key of the build side */
+  void Insert(const Value &key) {
+    if (min_.IsNull() || key.CompareLessThan(min_) == CmpBool::CmpTrue) {
+      min_ = key;
+    }
+    if (max_.IsNull() || key.CompareGreaterThan(max_) == CmpBool::CmpTrue) {
+      max_ = key;
+    }
+    auto [h1, h2] = Hash(key);
+    for (size_t i = 0; i < NUM_HASHES; i++) {
+      auto bit = (h1 + i * h2) % (bits_.size() * 64);
+      bits_[bit / 64] |= uint64_t{1} << (bit % 64);
+    }
+  }
+
+  /** @return false if the key of a probe row is certainly not among the inserted keys, a NULL key never matches */
+  auto MayContain(const Value &key) const -> bool {
+    if (key.IsNull() || min_.IsNull()) {
+      return false;
+    }
+    if (key.CompareLessThan(min_) == CmpBool::CmpTrue || key.CompareGreaterThan(max_) == CmpBool::CmpTrue) {
+      return false;
+    }
+    auto [h1, h2] = Hash(key);
+    for (size_t i = 0; i < NUM_HASHES; i++) {
+      auto bit = (h1 + i * h2) % (bits_.size() * 64);
+      if ((bits_[bit / 64] & (uint64_t{1} << (bit % 64))) == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  /**
+   * Two hashes of the key for double hashing. HashValue maps many integers to the same hash, so integers are hashed
+   * from their value instead, and the result goes through the finalizer of MurmurHash3.
+   */
+  static auto Hash(const Value &key) -> std::pair<uint64_t, uint64_t> {
+    uint64_t h;
+    switch (key.GetTypeId()) {
+      case TypeId::TINYINT:
+        h = static_cast<uint64_t>(static_cast<int64_t>(key.GetAs<int8_t>()));
+        break;
+      case TypeId::SMALLINT:
+        h = static_cast<uint64_t>(static_cast<int64_t>(key.GetAs<int16_t>()));
+        break;
+      case TypeId::INTEGER:
+        h = static_cast<uint64_t>(static_cast<int64_t>(key.GetAs<int32_t>()));
+        break;
+      case TypeId::BIGINT:
+        h = static_cast<uint64_t>(key.GetAs<int64_t>());
+        break;
+      default:
+        h = HashUtil::HashValue(&key);
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return {h, (h >> 32) | 1};
+  }
+
+  /** The bits of the Bloom filter */
+  std::vector<uint64_t> bits_;
+  /** The smallest and the largest key, NULL while empty */
+  Value min_;
+  Value max_;
+};
+
+}  // namespace bustub
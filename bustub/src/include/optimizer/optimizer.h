@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -16,6 +17,15 @@
 
 namespace bustub {
 
+/** Number of rows we assume for a table when we know nothing about it */
+static constexpr size_t DEFAULT_TABLE_CARDINALITY = 1000;
+/** Join clusters with more relations than this are ordered greedily instead of with dynamic programming */
+static constexpr size_t JOIN_ORDER_DP_THRESHOLD = 10;
+/** A filtered seq scan is turned into an index scan only if the key range selects at most this fraction of rows */
+static constexpr double INDEX_SCAN_SELECTIVITY_THRESHOLD = 0.2;
+/** A hash join whose hash table is estimated to be larger than this (in bytes) is run as a merge join if possible */
+static constexpr size_t HASH_JOIN_MEMORY_BUDGET = 16 << 20;
+
 /**
  * The optimizer takes an `AbstractPlanNode` and outputs an optimized `AbstractPlanNode`.
  */
@@ -43,13 +53,85 @@ class Optimizer {
    */
   auto OptimizeMergeFilterNLJ(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief push filter conditions down to the lowest operator that can evaluate them.
+   * Predicates are split into conjuncts and moved through projections (by substituting the projected expressions),
+   * aggregations (only the ones on group by columns), sorts and joins. At an inner join, conjuncts that reference
+   * one side only go to that side and the rest become the join condition; `col op const` conjuncts are also copied
+   * to the other columns of the same `col = col` equivalence class. Filters that end up right above a seq scan are
+   * merged into it later by `OptimizeMergeFilterScan`.
+   */
+  auto OptimizePredicatePushdown(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief push `predicates`, which are conjuncts over the output of `plan`, as far down into `plan` as possible.
+   */
+  auto PushDownPredicates(const AbstractPlanNodeRef &plan, std::vector<AbstractExpressionRef> predicates)
+      -> AbstractPlanNodeRef;
+
   /**
    * @brief optimize nested loop join into hash join.
    * In the starter code, we will check NLJs with exactly one equal condition. You can further support optimizing joins
-   * with multiple eq conditions.
+   * with multiple eq conditions. For inner joins, the other conjuncts of the join condition are evaluated by a filter
+   * on top of the hash join.
    */
   auto OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief reorder a cluster of inner joins by cost.
+   * A tree of inner nested loop joins (together with a filter right above it) is flattened into its base relations
+   * and join conjuncts. Conjuncts that touch a single relation are pushed right above that relation, and the join
+   * order is enumerated with dynamic programming over connected sub-plans (or greedily for wide joins), minimizing
+   * the sum of the estimated intermediate result sizes. The smaller input of each join is placed on the right, which
+   * is the build side of hash join, unless the other one can be probed through an index. A projection on top restores
+   * the original column order. Only clusters of three or more relations are reordered.
+   */
+  auto OptimizeJoinOrder(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief swap the children of an inner hash join so that the smaller input is the build (right) side.
+   */
+  auto OptimizeHashJoinBuildSide(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief turn an inner or left hash join on columns into a merge join, when it doesn't need an extra sort: either
+   * both inputs are already sorted on the join keys (e.g. index scans, or ORDER BY in a subquery), or the hash table
+   * would exceed `HASH_JOIN_MEMORY_BUDGET` and each unsorted input is a seq scan that can be read in key order from
+   * an index instead.
+   */
+  auto OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief let an inner or semi hash join on columns build a runtime filter (Bloom filter + min / max) from its right
+   * keys, and push it down to the seq scan producing its left key, which then skips the rows that can't match before
+   * they reach the join. See `RuntimeFilter`.
+   */
+  auto OptimizeHashJoinRuntimeFilter(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief add the runtime filter `filter_id` on the column `col_idx` of a plan to the seq scan producing that column.
+   * @return the new plan, or nullptr if the column doesn't come straight from a seq scan
+   */
+  auto PushRuntimeFilter(const AbstractPlanNodeRef &plan, size_t filter_id, uint32_t col_idx) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief let an aggregation grouping by a single column aggregate one group at a time, without a hash table, when its
+   * input is already sorted on that column (e.g. an index scan, or ORDER BY in a subquery). See
+   * `AggregationPlanNode::sorted_input_`.
+   */
+  auto OptimizeSortedAggregation(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief check whether the output of a plan is sorted in ascending order on its column `col_idx`.
+   */
+  auto IsSortedOn(const AbstractPlanNode &plan, uint32_t col_idx) -> bool;
+
+  /**
+   * @brief replace a (filtered) seq scan with a full index scan producing the same rows sorted on column `col_idx`.
+   * @return the index scan, or nullptr if the plan is not a seq scan or there is no index on that column
+   */
+  auto AsOrderedIndexScan(const AbstractPlanNodeRef &plan, uint32_t col_idx) -> AbstractPlanNodeRef;
+
   /**
    * @brief optimize nested loop join into index join.
    */
@@ -61,7 +143,7 @@ class Optimizer {
   auto OptimizeEliminateTrueFilter(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
   /**
-   * @brief merge filter into filter_predicate of seq scan plan node
+   * @brief merge filter into filter_predicate of seq scan plan node, AND-ing it with the existing one if any
    */
   auto OptimizeMergeFilterScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
@@ -85,30 +167,67 @@ class Optimizer {
    */
   auto OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief optimize seq scan with filter as index scan over a key range.
+   * Conjuncts of the filter are turned into the bounds of an index: equalities on a prefix of the key columns,
+   * optionally followed by a range (`<`, `<=`, `>`, `>=`, BETWEEN) on the next key column. Among all indexes of the
+   * table, the one whose range has the lowest estimated selectivity is picked, and it is only used if that
+   * selectivity is below `INDEX_SCAN_SELECTIVITY_THRESHOLD`. Conjuncts not covered by the range stay in the filter
+   * of the index scan. Index scans produced by `OptimizeOrderByAsIndexScan` get their filter turned into a range too.
+   */
+  auto OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /** @brief check if the index can be matched */
   auto MatchIndex(const std::string &table_name, uint32_t index_key_idx)
       -> std::optional<std::tuple<index_oid_t, std::string>>;
 
   /**
-   * @brief optimize sort + limit as top N
+   * @brief optimize sort + limit as top N, and push a limit over an index scan into the scan
    */
   auto OptimizeSortLimitAsTopN(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
   /**
-   * @brief get the estimated cardinality for a table based on the table name. Useful when join reordering. BusTub
-   * doesn't support statistics for now, so it's the only way for you to get the table size :(
+   * @brief get the estimated cardinality for a table. Useful when join reordering. The row count maintained in the
+   * table statistics is used when the table has been analyzed or written by DML; otherwise we fall back to guessing
+   * from the table name (e.g. `_1m`, `_100k`).
    *
    * @param table_name
    * @return std::optional<size_t>
    */
   auto EstimatedCardinality(const std::string &table_name) -> std::optional<size_t>;
 
+  /**
+   * @brief estimate the fraction of rows of `table_name` that satisfies `predicate`. The predicate must reference the
+   * columns of the table itself (e.g. the filter predicate of a seq scan). Conjunctions are assumed independent.
+   * When the table has not been analyzed, we fall back to the default selectivities in `table_statistics.h`.
+   *
+   * @param table_name
+   * @param predicate
+   * @return the selectivity in [0, 1]
+   */
+  auto EstimatedSelectivity(const std::string &table_name, const AbstractExpression &predicate) -> double;
+
+  /**
+   * @brief estimate the number of rows produced by a plan, using the table statistics for scans and filters and
+   * simple rules of thumb for everything else.
+   */
+  auto EstimatedPlanCardinality(const AbstractPlanNode &plan) -> double;
+
+  /**
+   * @brief get the estimated number of distinct values of a column of a plan. Only known for (filtered) scans over
+   * analyzed tables.
+   */
+  auto EstimatedDistinctCount(const AbstractPlanNode &plan, uint32_t col_idx) -> std::optional<double>;
+
   /** Catalog will be used during the planning process. USERS SHOULD ENSURE IT OUTLIVES
    * OPTIMIZER, otherwise it's a dangling reference.
    */
   const Catalog &catalog_;
 
   const bool force_starter_rule_;
+
+  /** The id of the next runtime filter, unique within the plan being optimized */
+  size_t next_runtime_filter_id_{0};
 };
 
 }  // namespace bustub
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// optimizer_util.h
+//
+// Identification: src/include/optimizer/optimizer_util.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "type/value_factory.h"
+
+/**
+ * Helpers on expressions shared by the optimizer rules.
+ */
+
+namespace bustub {
+
+/** @return a copy of `expr` in which every column value expression is replaced by `rewrite(column)` */
+inline auto RewriteColumns(const AbstractExpressionRef &expr,
+                           const std::function<AbstractExpressionRef(const ColumnValueExpression &)> &rewrite)
+    -> AbstractExpressionRef {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column_value_expr != nullptr) {
+    return rewrite(*column_value_expr);
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(RewriteColumns(child, rewrite));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/** @return whether `pred` holds for every column value expression in `expr` (true if there is none) */
+inline auto AllColumns(const AbstractExpression &expr, const std::function<bool(const ColumnValueExpression &)> &pred)
+    -> bool {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(&expr);
+      column_value_expr != nullptr) {
+    return pred(*column_value_expr);
+  }
+  for (const auto &child : expr.GetChildren()) {
+    if (!AllColumns(*child, pred)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Split `a AND b AND ...` into its conjuncts and append them to `conjuncts`. */
+inline void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    SplitConjuncts(logic_expr->GetChildAt(0), conjuncts);
+    SplitConjuncts(logic_expr->GetChildAt(1), conjuncts);
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+/** @return the conjunction of `conjuncts`, or `true` if there is none */
+inline auto MakeConjunction(const std::vector<AbstractExpressionRef> &conjuncts) -> AbstractExpressionRef {
+  if (conjuncts.empty()) {
+    return std::make_shared<ConstantValueExpression>(ValueFactory::GetBooleanValue(true));
+  }
+  auto expr = conjuncts[0];
+  for (size_t i = 1; i < conjuncts.size(); i++) {
+    expr = std::make_shared<LogicExpression>(expr, conjuncts[i], LogicType::And);
+  }
+  return expr;
+}
+
+/** @return the two columns of a `<column> = <column>` conjunct */
+inline auto AsEquiJoinColumns(const AbstractExpression &expr)
+    -> std::optional<std::pair<const ColumnValueExpression *, const ColumnValueExpression *>> {
+  if (const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr);
+      cmp_expr != nullptr && cmp_expr->comp_type_ == ComparisonType::Equal) {
+    const auto *left = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(0).get());
+    const auto *right = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(1).get());
+    if (left != nullptr && right != nullptr) {
+      return std::make_optional(std::make_pair(left, right));
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace bustub
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// plan_cache.h
+//
+// Identification: src/include/optimizer/plan_cache.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_statement.h"
+#include "catalog/schema.h"
+#include "execution/plans/abstract_plan.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** Number of plans of ad-hoc statements kept in the plan cache */
+static constexpr size_t PLAN_CACHE_SIZE = 128;
+
+/**
+ * An optimized plan that can be executed many times. The parameters of a prepared statement are evaluated through the
+ * slots in `parameters_` (see `ParameterValueExpression`), so executing the plan with other parameter values only
+ * needs to fill the slots.
+ */
+struct CachedPlan {
+  /** The optimized plan */
+  AbstractPlanNodeRef plan_;
+  /** The output schema of the statement, as planned before optimization */
+  SchemaRef output_schema_;
+  /** The value slots of the parameters, nullptr for parameters that are not referenced */
+  std::vector<std::shared_ptr<Value>> parameters_;
+  /** The catalog version the plan was built against, the plan is stale once the catalog changes */
+  uint64_t catalog_version_;
+  /** Held while the parameter slots are filled and the plan is executed */
+  std::mutex latch_;
+};
+
+/** A statement created by `PREPARE`. */
+struct PreparedStatement {
+  /** The bound statement, kept to plan it again when the catalog changes */
+  std::shared_ptr<BoundStatement> statement_;
+  /** The types of the parameters `$1`, `$2`, ... */
+  std::vector<TypeId> param_types_;
+  /** The plan of the statement */
+  std::shared_ptr<CachedPlan> plan_;
+};
+
+/**
+ * PlanCache keeps the plans of recently executed statements, keyed by their normalized SQL text. A plan is only
+ * returned if the catalog has not changed since it was built. When the cache is full, the least recently used plan
+ * is evicted.
+ */
+class PlanCache {
+ public:
+  explicit PlanCache(size_t capacity = PLAN_CACHE_SIZE) : capacity_(capacity) {}
+
+  /**
+   * Look up a plan.
+   * @param key the normalized SQL text, see `NormalizeSql()`
+   * @param catalog_version the current version of the catalog
+   * @return the cached plan, nullptr if there is none or if it is stale
+   */
+  auto Get(const std::string &key, uint64_t catalog_version) -> std::shared_ptr<CachedPlan>;
+
+  /** Add a plan to the cache, replacing the plan with the same key and evicting the least recently used plan. */
+  void Put(const std::string &key, std::shared_ptr<CachedPlan> plan);
+
+  /**
+   * Normalize a SQL text so that statements that only differ in whitespace, comments, the case of keywords and
+   * unquoted identifiers, and trailing semicolons share a cache entry.
+   */
+  static auto NormalizeSql(const std::string &sql) -> std::string;
+
+  auto GetHitCount() const -> size_t { return hit_count_; }
+  auto GetMissCount() const -> size_t { return miss_count_; }
+
+ private:
+  std::mutex latch_;
+  size_t capacity_;
+  /** Most recently used plan at the front */
+  std::list<std::pair<std::string, std::shared_ptr<CachedPlan>>> lru_list_;
+  std::unordered_map<std::string, decltype(lru_list_)::iterator> entries_;
+  size_t hit_count_{0};
+  size_t miss_count_{0};
+};
+
+}  // namespace bustub
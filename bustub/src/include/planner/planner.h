@@ -26,6 +26,7 @@ class BoundExpression;
 class BoundTableRef;
 class BoundBinaryOp;
 class BoundConstant;
+class BoundParameter;
 class BoundColumnRef;
 class BoundUnaryOp;
 class BoundBaseTableRef;
@@ -35,6 +36,7 @@ class BoundJoinRef;
 class BoundExpressionListRef;
 class BoundAggCall;
 class BoundCTERef;
+class BoundSubqueryExpr;
 class ColumnValueExpression;
 
 /**
@@ -110,6 +112,22 @@ class Planner {
 
   auto PlanExpressionListRef(const BoundExpressionListRef &table_ref) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief Plan the WHERE clause over `child`.
+   *
+   * A WHERE without subquery becomes a `FilterPlanNode`. Otherwise every conjunct that is `[NOT] EXISTS (...)` or
+   * `x IN (...)` becomes a semi / anti `NestedLoopJoinPlanNode` with the subquery on the right side, and the other
+   * conjuncts a filter on top of them. The correlated conjuncts of a subquery's WHERE, i.e. those referencing the
+   * columns of the outer query, become the join condition, so the subquery doesn't need to be re-executed for each
+   * outer tuple.
+   */
+  auto PlanWhere(const BoundExpression &where, AbstractPlanNodeRef child) -> AbstractPlanNodeRef;
+
+  auto PlanConjuncts(const std::vector<const BoundExpression *> &conjuncts, AbstractPlanNodeRef child)
+      -> AbstractPlanNodeRef;
+
+  auto PlanSubqueryJoin(const BoundSubqueryExpr &expr, bool is_anti, AbstractPlanNodeRef left) -> AbstractPlanNodeRef;
+
   void AddAggCallToContext(BoundExpression &expr);
 
   auto PlanExpression(const BoundExpression &expr, const std::vector<AbstractPlanNodeRef> &children)
@@ -124,8 +142,21 @@ class Planner {
   auto PlanConstant(const BoundConstant &expr, const std::vector<AbstractPlanNodeRef> &children)
       -> AbstractExpressionRef;
 
+  auto PlanParameter(const BoundParameter &expr, const std::vector<AbstractPlanNodeRef> &children)
+      -> AbstractExpressionRef;
+
   auto PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRef child) -> AbstractPlanNodeRef;
 
+  /** @return whether the select list has a window function, e.g. `rank() over (order by x)` */
+  auto HasWindowFunction(const SelectStatement &statement) -> bool;
+
+  /**
+   * @brief Plan a select list with window functions over `child` as a `WindowFunctionPlanNode` on top of a sort by
+   * the PARTITION BY and ORDER BY of the windows. Window functions are only supported at the top level of the select
+   * list, without GROUP BY or aggregation.
+   */
+  auto PlanSelectWindow(const SelectStatement &statement, AbstractPlanNodeRef child) -> AbstractPlanNodeRef;
+
   auto PlanAggCall(const BoundAggCall &agg_call, const std::vector<AbstractPlanNodeRef> &children)
       -> std::tuple<AggregationType, std::vector<AbstractExpressionRef>>;
 
@@ -144,6 +175,9 @@ class Planner {
   /** the root plan node of the plan tree */
   AbstractPlanNodeRef plan_;
 
+  /** the value slots of the parameters `$1`, `$2`, ... referenced by the plan tree, see `ParameterValueExpression` */
+  std::vector<std::shared_ptr<Value>> parameters_;
+
  private:
   PlannerContext ctx_;
 
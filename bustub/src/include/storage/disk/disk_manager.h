@@ -16,6 +16,7 @@
 #include <fstream>
 #include <future>  // NOLINT
 #include <mutex>   // NOLINT
+#include <set>
 #include <string>
 
 #include "common/config.h"
@@ -25,6 +26,10 @@ namespace bustub {
 /**
  * DiskManager takes care of the allocation and deallocation of pages within a database. It performs the reading and
  * writing of pages to and from disk, providing a logical file layer within the context of a database management system.
+ *
+ * Deallocated pages are recorded in a free-page bitmap, one bit per page, kept next to the database file in
+ * `<name>.fsm` so that it survives a restart. Allocation reuses the lowest free page before growing the file, which keeps
+ * the live pages packed at its start, and `ShrinkFile` gives the free pages at the end of the file back to the OS.
  */
 class DiskManager {
  public:
@@ -74,6 +79,31 @@ class DiskManager {
    */
   auto ReadLog(char *log_data, int size, int offset) -> bool;
 
+  /**
+   * Allocate a page: the lowest free page if there is one, or a new page at the end of the file.
+   * @return the id of the allocated page
+   */
+  auto AllocatePage() -> page_id_t;
+
+  /**
+   * Deallocate a page, so that it can be reused by AllocatePage. The page must not be in use anymore, in particular not
+   * in the buffer pool.
+   * @param page_id id of the page
+   */
+  void DeallocatePage(page_id_t page_id);
+
+  /**
+   * Truncate the free pages at the end of the database file. Pages can be allocated and deallocated meanwhile.
+   * @return the number of pages released
+   */
+  auto ShrinkFile() -> page_id_t;
+
+  /** @return the number of pages in the database file */
+  auto GetNumPages() -> page_id_t;
+
+  /** @return the number of free pages, which the next allocations will reuse */
+  auto GetNumFreePages() -> size_t;
+
   /** @return the number of disk flushes */
   auto GetNumFlushes() const -> int;
 
@@ -94,6 +124,10 @@ class DiskManager {
 
  protected:
   auto GetFileSize(const std::string &file_name) -> int;
+  /** Load the free-page bitmap of the database file, or discard it if the database file is new */
+  void LoadFreePages();
+  /** Write the bit of `page_id` to the free-page bitmap file, creating it if needed */
+  void WriteFreePageBit(page_id_t page_id);
   // stream to write log file
   std::fstream log_io_;
   std::string log_name_;
@@ -106,6 +140,15 @@ class DiskManager {
   std::future<void> *flush_log_f_{nullptr};
   // With multiple buffer pool instances, need to protect file access
   std::mutex db_io_latch_;
+  // stream to write the free-page bitmap, opened when the first page is deallocated
+  std::fstream fsm_io_;
+  std::string fsm_name_;
+  // free pages, ordered so that the lowest one is reused first
+  std::set<page_id_t> free_pages_;
+  // the id of the page after the last allocated one
+  page_id_t next_page_id_{0};
+  // protects free_pages_, next_page_id_ and fsm_io_, taken before db_io_latch_
+  std::mutex allocation_latch_;
 };
 
 }  // namespace bustub
@@ -94,6 +94,9 @@ class BPlusTree {
   // return the page id of the root node
   auto GetRootPageId() -> page_id_t;
 
+  // 从header page中读取根页ID，重新打开数据库中已经存在的树
+  auto LoadRootPageId() -> bool;
+
   // index iterator
   auto Begin() -> INDEXITERATOR_TYPE;
   auto Begin(const KeyType &key) -> INDEXITERATOR_TYPE;
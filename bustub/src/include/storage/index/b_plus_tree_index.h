@@ -41,6 +41,15 @@ class BPlusTreeIndex : public Index {
 
   auto GetEndIterator() -> INDEXITERATOR_TYPE;
 
+  auto GetComparator() const -> const KeyComparator & { return comparator_; }
+
+  /**
+   * Reopen the B+ tree persisted in the database file, with the root page id recorded in the header page under the
+   * name of the index.
+   * @return false if there is no such record, the index is empty then
+   */
+  auto Reopen() -> bool { return container_.LoadRootPageId(); }
+
  protected:
   // comparator for key
   KeyComparator comparator_;
@@ -59,4 +68,13 @@ using BPlusTreeIndexIteratorForOneIntegerColumn =
     IndexIterator<IntegerKeyType, IntegerValueType, IntegerComparatorType>;
 using IntegerHashFunctionType = HashFunction<IntegerKeyType>;
 
+/** Composite indexes over two integer columns use a key that fits both of them. */
+
+constexpr static const auto TWO_INTEGER_SIZE = 8;
+using TwoIntegerKeyType = GenericKey<TWO_INTEGER_SIZE>;
+using TwoIntegerComparatorType = GenericComparator<TWO_INTEGER_SIZE>;
+using BPlusTreeIndexForTwoIntegerColumn =
+    BPlusTreeIndex<TwoIntegerKeyType, IntegerValueType, TwoIntegerComparatorType>;
+using TwoIntegerHashFunctionType = HashFunction<TwoIntegerKeyType>;
+
 }  // namespace bustub
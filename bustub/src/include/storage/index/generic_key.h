@@ -13,8 +13,10 @@
 #pragma once
 
 #include <cstring>
+#include <vector>
 
 #include "storage/table/tuple.h"
+#include "type/type_kernel.h"
 #include "type/value.h"
 
 namespace bustub {
@@ -80,6 +82,15 @@ class GenericComparator {
     uint32_t column_count = key_schema_->GetColumnCount();
 
     for (uint32_t i = 0; i < column_count; i++) {
+      if (kernels_[i] != nullptr) {
+        // compare the serialized values in place, without building a Value for each side
+        int cmp = kernels_[i](ColumnData(lhs, i), ColumnData(rhs, i));
+        if (cmp != 0) {
+          return cmp < 0 ? -1 : 1;
+        }
+        continue;
+      }
+
       Value lhs_value = (lhs.ToValue(key_schema_, i));
       Value rhs_value = (rhs.ToValue(key_schema_, i));
 
@@ -94,13 +105,30 @@ class GenericComparator {
     return 0;
   }
 
-  GenericComparator(const GenericComparator &other) : key_schema_{other.key_schema_} {}
+  GenericComparator(const GenericComparator &other) = default;
 
   // constructor
-  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
+  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {
+    for (const auto &col : key_schema_->GetColumns()) {
+      kernels_.push_back(TypeKernels::GetKeyCompareKernel(col.GetType()));
+    }
+  }
 
  private:
+  /** @return where the i-th column of the key is serialized, the same place ToValue reads it from */
+  inline auto ColumnData(const GenericKey<KeySize> &key, uint32_t column_idx) const -> const char * {
+    const auto &col = key_schema_->GetColumn(column_idx);
+    if (col.IsInlined()) {
+      return key.data_ + col.GetOffset();
+    }
+    int32_t offset;
+    memcpy(&offset, key.data_ + col.GetOffset(), sizeof(int32_t));
+    return key.data_ + offset;
+  }
+
   Schema *key_schema_;
+  /** The kernel comparing each column of the key, picked once from the key schema */
+  std::vector<KeyCompareKernel> kernels_;
 };
 
 }  // namespace bustub
@@ -30,6 +30,10 @@ class IndexIterator {
   IndexIterator(BufferPoolManager *buffer_pool_manager,page_id_t page_id,Page *page,int index = 0);
   ~IndexIterator();  // NOLINT
 
+  // 迭代器持有叶子页的读锁，只能移动不能拷贝，否则会重复释放
+  IndexIterator(IndexIterator &&other) noexcept;
+  auto operator=(IndexIterator &&other) noexcept -> IndexIterator &;
+
   auto IsEnd() -> bool;
 
   auto operator*() -> const MappingType &;
@@ -40,6 +40,9 @@ namespace bustub {
  *  | TupleCount (4) | Tuple_1 offset (4) | Tuple_1 size (4) | ... |
  *  ----------------------------------------------------------------
  *
+ *  A tuple that grows beyond the free space of its page is moved to another page, and its slot keeps a forwarding
+ *  RID (FORWARD_FLAG) to the new location, so the RID stored in the indexes stays valid. The moved tuple is flagged
+ *  with MOVED_FLAG: it is only reached through the slot forwarding to it, and skipped by sequential scans.
  */
 class TablePage : public Page {
  public:
@@ -107,6 +110,29 @@ class TablePage : public Page {
   auto UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID &rid, Transaction *txn,
                    LockManager *lock_manager, LogManager *log_manager) -> bool;
 
+  /**
+   * Replace a tuple with a forwarding RID to the location it was moved to, or redirect an existing forwarding RID.
+   * @param rid rid of the tuple
+   * @param forward_rid the new location of the tuple
+   * @param[out] old_tuple old value of the slot
+   * @param txn transaction performing the update
+   * @param lock_manager the lock manager
+   * @param log_manager the log manager
+   * @return true if the forwarding RID was written (i.e. the tuple exists and there is enough space)
+   */
+  auto ForwardTuple(const RID &rid, const RID &forward_rid, Tuple *old_tuple, Transaction *txn,
+                    LockManager *lock_manager, LogManager *log_manager) -> bool;
+
+  /**
+   * @param rid rid of the tuple
+   * @param[out] forward_rid the location the tuple was moved to
+   * @return true if the slot holds a forwarding RID, even if the tuple is marked as deleted
+   */
+  auto GetForwardRid(const RID &rid, RID *forward_rid) -> bool;
+
+  /** Flag a tuple just inserted as moved here from the slot of another page, so that scans skip it. */
+  void MarkMoved(const RID &rid);
+
   /** To be called on commit or abort. Actually perform the delete or rollback an insert. */
   void ApplyDelete(const RID &rid, Transaction *txn, LogManager *log_manager);
 
@@ -191,6 +217,16 @@ class TablePage : public Page {
     memcpy(GetData() + OFFSET_TUPLE_SIZE + SIZE_TUPLE * slot_num, &size, sizeof(uint32_t));
   }
 
+  /** The slot holds a forwarding RID instead of the tuple, see the header comment */
+  static constexpr uint32_t FORWARD_FLAG = 1U << 30;
+  /** The slot holds a tuple moved from another slot, see the header comment */
+  static constexpr uint32_t MOVED_FLAG = 1U << 29;
+
+  /** @return tuple size with all the flags unset */
+  static auto GetTupleLength(uint32_t tuple_size) -> uint32_t {
+    return tuple_size & ~(static_cast<uint32_t>(DELETE_MASK) | FORWARD_FLAG | MOVED_FLAG);
+  }
+
   /** @return true if the tuple is deleted or empty */
   static auto IsDeleted(uint32_t tuple_size) -> bool {
     return static_cast<bool>(tuple_size & DELETE_MASK) || tuple_size == 0;
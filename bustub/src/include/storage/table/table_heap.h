@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
@@ -68,7 +70,8 @@ class TableHeap {
   auto MarkDelete(const RID &rid, Transaction *txn) -> bool;  // for delete
 
   /**
-   * if the new tuple is too large to fit in the old page, return false (will delete and insert)
+   * Update a tuple in place. If the new tuple is too large to fit in its page, it is moved to another page and the
+   * old slot forwards to it, so the RID of the tuple doesn't change and the indexes stay valid.
    * @param tuple new tuple
    * @param rid rid of the old tuple
    * @param txn transaction performing the update
@@ -109,10 +112,31 @@ class TableHeap {
   inline auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
 
  private:
+  /**
+   * Insert a tuple into the first page with enough space, creating a new page if there is none.
+   * @param tuple tuple to insert
+   * @param[out] rid the rid of the inserted tuple
+   * @param txn the transaction performing the insert
+   * @param is_moved whether the tuple is moved from the slot of another page, see TablePage
+   * @return true iff the insert is successful
+   */
+  auto PlaceTuple(const Tuple &tuple, RID *rid, Transaction *txn, bool is_moved) -> bool;
+
+  /**
+   * Move a tuple that doesn't fit in its page anymore to another page, and forward its slot to the new location.
+   * @param tuple new tuple
+   * @param rid rid of the tuple, i.e. its original slot
+   * @param cur_rid where the tuple is stored now, the original slot or the location it was moved to before
+   * @param txn transaction performing the update
+   * @return true iff the move is successful
+   */
+  auto MoveTuple(const Tuple &tuple, const RID &rid, const RID &cur_rid, Transaction *txn) -> bool;
+
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   LogManager *log_manager_;
   page_id_t first_page_id_{};     // 某个表的第一个页页号
+  std::atomic<page_id_t> move_page_id_{INVALID_PAGE_ID};  // 上一个被移动的tuple所在的页，移动tuple时从这一页开始找空间
 };
 
 }  // namespace bustub
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// fixed_decimal_type.h
+//
+// Identification: src/include/type/fixed_decimal_type.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "type/numeric_type.h"
+
+namespace bustub {
+
+/**
+ * FixedDecimalType is an exact decimal(p, s): a number of at most p digits, s of them after the decimal point, held as
+ * an integer scaled by 10^s. The arithmetic is done on the scaled integers in 128 bits and throws when a result does
+ * not fit in 38 digits, so unlike DECIMAL (a double) it never rounds silently. The result of an operation carries its
+ * own precision and scale, following the SQL rules (e.g. the scale of a product is the sum of the scales).
+ *
+ * A value is serialized as one header byte, the scale with the high bit set when the value is wide, followed by the
+ * scaled value as an int64_t (precision <= 18) or an int128_t. The header makes a serialized value self-describing,
+ * so that the expressions and the schemas of the intermediate results only need to know the type id.
+ */
+class FixedDecimalType : public NumericType {
+ public:
+  FixedDecimalType();
+
+  // Other mathematical functions
+  auto Add(const Value &left, const Value &right) const -> Value override;
+  auto Subtract(const Value &left, const Value &right) const -> Value override;
+  auto Multiply(const Value &left, const Value &right) const -> Value override;
+  auto Divide(const Value &left, const Value &right) const -> Value override;
+  auto Modulo(const Value &left, const Value &right) const -> Value override;
+  auto Min(const Value &left, const Value &right) const -> Value override;
+  auto Max(const Value &left, const Value &right) const -> Value override;
+  auto Sqrt(const Value &val) const -> Value override;
+  auto IsZero(const Value &val) const -> bool override;
+
+  // Comparison functions
+  auto CompareEquals(const Value &left, const Value &right) const -> CmpBool override;
+  auto CompareNotEquals(const Value &left, const Value &right) const -> CmpBool override;
+  auto CompareLessThan(const Value &left, const Value &right) const -> CmpBool override;
+  auto CompareLessThanEquals(const Value &left, const Value &right) const -> CmpBool override;
+  auto CompareGreaterThan(const Value &left, const Value &right) const -> CmpBool override;
+  auto CompareGreaterThanEquals(const Value &left, const Value &right) const -> CmpBool override;
+
+  auto CastAs(const Value &val, TypeId type_id) const -> Value override;
+
+  // Fixed decimal types are always inlined
+  auto IsInlined(const Value &val) const -> bool override { return true; }
+
+  // Debug
+  auto ToString(const Value &val) const -> std::string override;
+
+  // Serialize this value into the given storage space
+  void SerializeTo(const Value &val, char *storage) const override;
+
+  // Deserialize a value of the given type from the given storage space.
+  auto DeserializeFrom(const char *storage) const -> Value override;
+
+  // Create a copy of this value
+  auto Copy(const Value &val) const -> Value override;
+
+  /** @return the value scaled by 10^scale */
+  static auto GetScaled(const Value &val) -> int128_t;
+  static auto GetPrecision(const Value &val) -> uint8_t { return val.precision_; }
+  static auto GetScale(const Value &val) -> uint8_t { return val.scale_; }
+
+  /** @return the number of bytes taken by a serialized value of the given precision */
+  static auto SerializedSize(uint8_t precision) -> uint32_t {
+    return precision <= BUSTUB_FIXED_DECIMAL_MAX_NARROW_PRECISION ? 1 + sizeof(int64_t) : 1 + sizeof(int128_t);
+  }
+
+  /**
+   * Three-way compare a non-NULL FIXED_DECIMAL with a non-NULL value of any numeric type, used by the comparisons of
+   * the other numeric types when their right side is a FIXED_DECIMAL.
+   * @return < 0, 0 or > 0 when left is less than, equal to or greater than right
+   */
+  static auto Compare(const Value &left, const Value &right) -> int;
+
+  /** @return the scaled value and the scale of a non-NULL value with its trailing zeros removed, equal values of
+   * different scales (e.g. 1.5 and 1.50) have the same normalized form */
+  static auto Normalize(const Value &val) -> std::pair<int128_t, uint8_t>;
+
+  /**
+   * Parse an exact decimal like "-12.345" or "1.5e3". Digits beyond a scale of 38 are rounded.
+   * @throw Exception if the string is not a number or has more than 38 significant digits
+   */
+  static auto FromString(const std::string &str) -> Value;
+
+  /** Convert a value of a numeric type or a VARCHAR to a FIXED_DECIMAL, keeping all of its digits */
+  static auto FromValue(const Value &val) -> Value;
+
+  /**
+   * Convert a FIXED_DECIMAL to the given precision and scale, rounding half away from zero when digits are dropped.
+   * @throw Exception if the value has more than precision - scale digits before the decimal point
+   */
+  static auto Rescale(const Value &val, uint8_t precision, uint8_t scale) -> Value;
+
+  /** @return 10^exp, exp <= 38 */
+  static auto PowerOfTen(uint8_t exp) -> int128_t;
+
+ private:
+  auto OperateNull(const Value &left, const Value &right) const -> Value override;
+
+  /** @return the scaled value and the scale of a non-NULL integer, VARCHAR or FIXED_DECIMAL */
+  static auto Unpack(const Value &val) -> std::pair<int128_t, uint8_t>;
+};
+}  // namespace bustub
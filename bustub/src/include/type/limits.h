@@ -51,6 +51,13 @@ static constexpr uint64_t BUSTUB_TIMESTAMP_NULL = ULLONG_MAX;
 static constexpr double BUSTUB_DECIMAL_NULL = DBL_LOWEST;
 static constexpr int8_t BUSTUB_BOOLEAN_NULL = SCHAR_MIN;
 
+// FIXED_DECIMAL holds a decimal of at most 38 digits as an integer scaled by 10^scale. Values of at most 18 digits
+// fit in an int64_t and are stored as one in a tuple.
+using int128_t = __int128;
+static constexpr uint8_t BUSTUB_FIXED_DECIMAL_MAX_PRECISION = 38;
+static constexpr uint8_t BUSTUB_FIXED_DECIMAL_MAX_NARROW_PRECISION = 18;
+static constexpr int128_t BUSTUB_FIXED_DECIMAL_NULL = static_cast<int128_t>(static_cast<unsigned __int128>(1) << 127);
+
 static constexpr uint32_t BUSTUB_VARCHAR_MAX_LEN = UINT_MAX;
 
 // Use to make TEXT type as the alias of VARCHAR(TEXT_MAX_LENGTH)
@@ -14,5 +14,6 @@
 
 namespace bustub {
 // Every possible SQL type ID
-enum TypeId { INVALID = 0, BOOLEAN, TINYINT, SMALLINT, INTEGER, BIGINT, DECIMAL, VARCHAR, TIMESTAMP };
+// New types are appended at the end, the ids are persisted in the catalog.
+enum TypeId { INVALID = 0, BOOLEAN, TINYINT, SMALLINT, INTEGER, BIGINT, DECIMAL, VARCHAR, TIMESTAMP, FIXED_DECIMAL };
 }  // namespace bustub
@@ -0,0 +1,171 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// type_kernel.h
+//
+// Identification: src/include/type/type_kernel.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "type/limits.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** The comparisons implemented by the kernels */
+enum class CompareOp { Equal, NotEqual, LessThan, LessThanOrEqual, GreaterThan, GreaterThanOrEqual };
+
+/** The binary operations implemented by the kernels */
+enum class ArithmeticOp { Add, Subtract, Min, Max };
+
+/** Compare two values, with the same result as the matching Value::CompareXXX */
+using CompareKernel = CmpBool (*)(const Value &left, const Value &right);
+
+/** Combine two values, with the same result as the matching Value::Add / Subtract / Min / Max */
+using ArithmeticKernel = Value (*)(const Value &left, const Value &right);
+
+/**
+ * Three-way compare two serialized values of a column, as laid out in a tuple or an index key: the value itself for
+ * fixed-width types, the length and the characters for VARCHAR. A NULL compares equal to anything, like in the
+ * comparator of the indexes.
+ */
+using KeyCompareKernel = int (*)(const char *left, const char *right);
+
+/** The C++ type that holds a value of a fixed-width type in Value and in a tuple, and its NULL */
+template <TypeId>
+struct TypeTraits;
+
+template <>
+struct TypeTraits<TypeId::BOOLEAN> {
+  using T = int8_t;
+  static constexpr T NULL_VALUE = BUSTUB_BOOLEAN_NULL;
+};
+
+template <>
+struct TypeTraits<TypeId::TINYINT> {
+  using T = int8_t;
+  static constexpr T NULL_VALUE = BUSTUB_INT8_NULL;
+};
+
+template <>
+struct TypeTraits<TypeId::SMALLINT> {
+  using T = int16_t;
+  static constexpr T NULL_VALUE = BUSTUB_INT16_NULL;
+};
+
+template <>
+struct TypeTraits<TypeId::INTEGER> {
+  using T = int32_t;
+  static constexpr T NULL_VALUE = BUSTUB_INT32_NULL;
+};
+
+template <>
+struct TypeTraits<TypeId::BIGINT> {
+  using T = int64_t;
+  static constexpr T NULL_VALUE = BUSTUB_INT64_NULL;
+};
+
+template <>
+struct TypeTraits<TypeId::DECIMAL> {
+  using T = double;
+  static constexpr T NULL_VALUE = BUSTUB_DECIMAL_NULL;
+};
+
+/**
+ * TypeKernels hands out statically dispatched implementations of the comparison and arithmetic operators of Value.
+ * Each kernel is a template instantiated for one pair of types and one operator that works on the raw values, without
+ * going through Type::GetInstance and the virtual functions of the type classes. Callers look a kernel up once, when
+ * the types of both sides are known (e.g. when an expression is built), and call it for every row. A lookup returns
+ * nullptr for the combinations without a kernel (e.g. a cast is needed), and the caller keeps using Value for them.
+ */
+class TypeKernels {
+ public:
+  /** @return the kernel comparing a value of type left with a value of type right, nullptr if there is none */
+  static auto GetCompareKernel(TypeId left, TypeId right, CompareOp op) -> CompareKernel;
+
+  /** @return the kernel combining two values of the given type, nullptr if there is none */
+  static auto GetArithmeticKernel(TypeId type, ArithmeticOp op) -> ArithmeticKernel;
+
+  /** @return the kernel comparing two serialized values of the given type, nullptr if there is none */
+  static auto GetKeyCompareKernel(TypeId type) -> KeyCompareKernel;
+
+  /*
+   * Batch kernels over a column of FIXED_DECIMAL values of one scale and a precision of at most 18, given as the
+   * scaled int64_t stored in the tuples, BUSTUB_INT64_NULL for a NULL. The loops do not branch on the values, so that
+   * the compiler turns them into SIMD code.
+   */
+
+  /** @return the sum of the non-NULL values */
+  static auto SumFixedDecimals(const int64_t *values, size_t count) -> int128_t;
+
+  /** @return the smallest non-NULL value, BUSTUB_INT64_MAX if there is none */
+  static auto MinFixedDecimals(const int64_t *values, size_t count) -> int64_t;
+
+  /** @return the largest non-NULL value, BUSTUB_INT64_NULL if there is none */
+  static auto MaxFixedDecimals(const int64_t *values, size_t count) -> int64_t;
+
+  /** @return the number of non-NULL values */
+  static auto CountFixedDecimals(const int64_t *values, size_t count) -> size_t;
+
+  /**
+   * Select the values for which `value op constant` holds, a NULL never does.
+   * @param[out] selection the positions of the selected values, room for count positions
+   * @return the number of selected values
+   */
+  static auto SelectFixedDecimals(const int64_t *values, size_t count, CompareOp op, int64_t constant,
+                                  uint32_t *selection) -> size_t;
+
+ private:
+  template <TypeId Left, TypeId Right, class Op>
+  static auto CompareFixed(const Value &left, const Value &right) -> CmpBool;
+
+  template <class Op>
+  static auto CompareVarchar(const Value &left, const Value &right) -> CmpBool;
+
+  template <TypeId Type>
+  static auto AddFixed(const Value &left, const Value &right) -> Value;
+
+  template <TypeId Type>
+  static auto SubtractFixed(const Value &left, const Value &right) -> Value;
+
+  template <TypeId Type, class Op>
+  static auto PickFixed(const Value &left, const Value &right) -> Value;
+
+  template <TypeId Type>
+  static auto CompareFixedKeys(const char *left, const char *right) -> int;
+
+  static auto CompareVarcharKeys(const char *left, const char *right) -> int;
+
+  template <class Op>
+  static auto CompareFixedDecimal(const Value &left, const Value &right) -> CmpBool;
+
+  template <bool Subtract>
+  static auto AddFixedDecimal(const Value &left, const Value &right) -> Value;
+
+  template <class Op>
+  static auto PickFixedDecimal(const Value &left, const Value &right) -> Value;
+
+  static auto CompareFixedDecimalKeys(const char *left, const char *right) -> int;
+
+  template <class Op>
+  static auto SelectFixedDecimalsWith(const int64_t *values, size_t count, int64_t constant, uint32_t *selection)
+      -> size_t;
+
+  template <TypeId Left, class Op>
+  static auto SelectCompareRight(TypeId right) -> CompareKernel;
+
+  template <class Op>
+  static auto SelectCompare(TypeId left, TypeId right) -> CompareKernel;
+
+  template <TypeId Type>
+  static auto SelectArithmetic(ArithmeticOp op) -> ArithmeticKernel;
+};
+
+}  // namespace bustub
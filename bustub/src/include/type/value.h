@@ -39,9 +39,11 @@ class Value {
   friend class IntegerType;
   friend class BigintType;
   friend class DecimalType;
+  friend class FixedDecimalType;
   friend class TimestampType;
   friend class BooleanType;
   friend class VarlenType;
+  friend class TypeKernels;
 
  public:
   explicit Value(const TypeId type) : manage_data_(false), type_id_(type) { size_.len_ = BUSTUB_VALUE_NULL; }
@@ -58,12 +60,16 @@ class Value {
   Value(TypeId type, int64_t i);
   // TIMESTAMP
   Value(TypeId type, uint64_t i);
+  // FIXED_DECIMAL, the value is scaled by 10^scale
+  Value(TypeId type, int128_t scaled, uint8_t precision, uint8_t scale);
   // VARCHAR
   Value(TypeId type, const char *data, uint32_t len, bool manage_data);
   Value(TypeId type, const std::string &data);
 
   Value() : Value(TypeId::INVALID) {}
   Value(const Value &other);
+  // Steal the data of other, which is left a NULL of the same type
+  Value(Value &&other) noexcept;
   auto operator=(Value other) -> Value &;
   ~Value();
   // NOLINTNEXTLINE
@@ -71,6 +77,8 @@ class Value {
     std::swap(first.value_, second.value_);
     std::swap(first.size_, second.size_);
     std::swap(first.manage_data_, second.manage_data_);
+    std::swap(first.precision_, second.precision_);
+    std::swap(first.scale_, second.scale_);
     std::swap(first.type_id_, second.type_id_);
   }
   // check whether value is integer
@@ -145,6 +153,14 @@ class Value {
   inline auto Copy() const -> Value { return Type::GetInstance(type_id_)->Copy(*this); }
 
  protected:
+  // Strings that fit in the value (including the trailing '\0') are stored inline instead of on the heap
+  static constexpr uint32_t VARLEN_INLINE_SIZE = 16;
+
+  // Whether the data of a VARCHAR is stored in inline_
+  inline auto IsInlined() const -> bool { return manage_data_ && size_.len_ <= VARLEN_INLINE_SIZE; }
+  // The data of a VARCHAR, wherever it is stored
+  inline auto GetVarlen() const -> const char * { return IsInlined() ? value_.inline_ : value_.const_varlen_; }
+
   // The actual value item
   union Val {
     int8_t boolean_;
@@ -154,8 +170,11 @@ class Value {
     int64_t bigint_;
     double decimal_;
     uint64_t timestamp_;
+    // the int128_t of a FIXED_DECIMAL, kept as two words so that the union does not need a 16-byte alignment
+    uint64_t fixed_decimal_[2];
     char *varlen_;
     const char *const_varlen_;
+    char inline_[VARLEN_INLINE_SIZE];
   } value_;
 
   union {
@@ -164,6 +183,9 @@ class Value {
   } size_;
 
   bool manage_data_;
+  // The precision and the scale of a FIXED_DECIMAL
+  uint8_t precision_{0};
+  uint8_t scale_{0};
   // The data type
   TypeId type_id_;
 };
@@ -21,6 +21,7 @@
 #include "type/abstract_pool.h"
 #include "type/boolean_type.h"
 #include "type/decimal_type.h"
+#include "type/fixed_decimal_type.h"
 #include "type/numeric_type.h"
 #include "type/timestamp_type.h"
 #include "type/value.h"
@@ -50,6 +51,16 @@ class ValueFactory {
 
   static inline auto GetDecimalValue(double value) -> Value { return {TypeId::DECIMAL, value}; }
 
+  /** @return the FIXED_DECIMAL scaled / 10^scale */
+  static inline auto GetFixedDecimalValue(int128_t scaled, uint8_t precision, uint8_t scale) -> Value {
+    return {TypeId::FIXED_DECIMAL, scaled, precision, scale};
+  }
+
+  /** @return the exact FIXED_DECIMAL written in the string, like "-12.50" */
+  static inline auto GetFixedDecimalValue(const std::string &value) -> Value {
+    return FixedDecimalType::FromString(value);
+  }
+
   static inline auto GetBooleanValue(CmpBool value) -> Value {
     return {TypeId::BOOLEAN, value == CmpBool::CmpNull ? BUSTUB_BOOLEAN_NULL : static_cast<int8_t>(value)};
   }
@@ -95,6 +106,9 @@ class ValueFactory {
       case TypeId::DECIMAL:
         ret_value = GetDecimalValue(BUSTUB_DECIMAL_NULL);
         break;
+      case TypeId::FIXED_DECIMAL:
+        ret_value = GetFixedDecimalValue(BUSTUB_FIXED_DECIMAL_NULL, BUSTUB_FIXED_DECIMAL_MAX_PRECISION, 0);
+        break;
       case TypeId::VARCHAR:
         ret_value = GetVarcharValue(nullptr, false, nullptr);
         break;
@@ -121,6 +135,8 @@ class ValueFactory {
         return GetBigIntValue(0);
       case TypeId::DECIMAL:
         return GetDecimalValue(static_cast<double>(0));
+      case TypeId::FIXED_DECIMAL:
+        return GetFixedDecimalValue(0, 1, 0);
       case TypeId::VARCHAR:
         return GetVarcharValue(zero_string);
       default:
@@ -370,6 +386,16 @@ class ValueFactory {
     throw Exception(Type::GetInstance(value.GetTypeId())->ToString(value) + " is not coercable to DECIMAL.");
   }
 
+  static inline auto CastAsFixedDecimal(const Value &value) -> Value { return FixedDecimalType::FromValue(value); }
+
+  /**
+   * Cast the value to a FIXED_DECIMAL of the given precision and scale, e.g. to store it in a decimal(p, s) column.
+   * @throw Exception if the value has more than precision - scale digits before the decimal point
+   */
+  static inline auto CastAsFixedDecimal(const Value &value, uint8_t precision, uint8_t scale) -> Value {
+    return FixedDecimalType::Rescale(FixedDecimalType::FromValue(value), precision, scale);
+  }
+
   static inline auto CastAsVarchar(const Value &value) -> Value {
     if (Type::GetInstance(TypeId::VARCHAR)->IsCoercableFrom(value.GetTypeId())) {
       if (value.IsNull()) {
@@ -382,6 +408,7 @@ class ValueFactory {
         case TypeId::INTEGER:
         case TypeId::BIGINT:
         case TypeId::DECIMAL:
+        case TypeId::FIXED_DECIMAL:
         case TypeId::VARCHAR:
           return ValueFactory::GetVarcharValue(value.ToString());
         default:
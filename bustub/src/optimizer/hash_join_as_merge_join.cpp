@@ -0,0 +1,148 @@
+#include <memory>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/catalog.h"
+#include "catalog/schema.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/nested_index_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "optimizer/optimizer.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return true if the first order by is ascending on column `col_idx` */
+auto IsOrderedOn(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys, uint32_t col_idx)
+    -> bool {
+  if (order_bys.empty() || !(order_bys[0].first == OrderByType::ASC || order_bys[0].first == OrderByType::DEFAULT)) {
+    return false;
+  }
+  const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(order_bys[0].second.get());
+  return column_value_expr != nullptr && column_value_expr->GetColIdx() == col_idx;
+}
+
+}  // namespace
+
+auto Optimizer::IsSortedOn(const AbstractPlanNode &plan, uint32_t col_idx) -> bool {
+  switch (plan.GetType()) {
+    case PlanType::Sort:
+      return IsOrderedOn(dynamic_cast<const SortPlanNode &>(plan).GetOrderBy(), col_idx);
+    case PlanType::TopN:
+      return IsOrderedOn(dynamic_cast<const TopNPlanNode &>(plan).GetOrderBy(), col_idx);
+    case PlanType::IndexScan: {
+      // The index is sorted by its first key column, with or without a key range.
+      const auto *index_info = catalog_.GetIndex(dynamic_cast<const IndexScanPlanNode &>(plan).GetIndexOid());
+      const auto *table_info = catalog_.GetTable(index_info->table_name_);
+      return index_info->key_schema_.GetColumn(0).GetName() == table_info->schema_.GetColumn(col_idx).GetName();
+    }
+    case PlanType::Filter:
+    case PlanType::Limit:
+      return IsSortedOn(*plan.GetChildAt(0), col_idx);
+    case PlanType::Projection: {
+      const auto &expr = dynamic_cast<const ProjectionPlanNode &>(plan).GetExpressions()[col_idx];
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      return column_value_expr != nullptr && IsSortedOn(*plan.GetChildAt(0), column_value_expr->GetColIdx());
+    }
+    case PlanType::Aggregation:
+      // A sorted aggregation outputs its groups in the order of its input, the group key comes first.
+      return col_idx == 0 && dynamic_cast<const AggregationPlanNode &>(plan).sorted_input_;
+    case PlanType::NestedIndexJoin: {
+      // The left rows are output in their order.
+      const auto &child = *plan.GetChildAt(0);
+      return col_idx < child.OutputSchema().GetColumnCount() && IsSortedOn(child, col_idx);
+    }
+    case PlanType::MergeJoin: {
+      // Sorted on the join key, which equals on both sides for the rows that matched.
+      const auto &merge_join_plan = dynamic_cast<const MergeJoinPlanNode &>(plan);
+      const auto left_column_cnt = merge_join_plan.GetLeftPlan()->OutputSchema().GetColumnCount();
+      const auto *left_key = dynamic_cast<const ColumnValueExpression *>(merge_join_plan.left_key_expression_.get());
+      const auto *right_key = dynamic_cast<const ColumnValueExpression *>(merge_join_plan.right_key_expression_.get());
+      return (left_key != nullptr && left_key->GetColIdx() == col_idx) ||
+             (merge_join_plan.GetJoinType() == JoinType::INNER && right_key != nullptr &&
+              left_column_cnt + right_key->GetColIdx() == col_idx);
+    }
+    default:
+      return false;
+  }
+}
+
+auto Optimizer::AsOrderedIndexScan(const AbstractPlanNodeRef &plan, uint32_t col_idx) -> AbstractPlanNodeRef {
+  if (plan->GetType() != PlanType::SeqScan) {
+    return nullptr;
+  }
+  const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*plan);
+  const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
+  for (const auto *index : catalog_.GetTableIndexes(table_info->name_)) {
+    if (index->key_schema_.GetColumn(0).GetName() == table_info->schema_.GetColumn(col_idx).GetName()) {
+      return std::make_shared<IndexScanPlanNode>(seq_scan.output_schema_, index->index_oid_,
+                                                 seq_scan.filter_predicate_);
+    }
+  }
+  return nullptr;
+}
+
+auto Optimizer::OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeHashJoinAsMergeJoin(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::HashJoin) {
+    const auto &hash_join_plan = dynamic_cast<const HashJoinPlanNode &>(*optimized_plan);
+    if (!(hash_join_plan.GetJoinType() == JoinType::INNER || hash_join_plan.GetJoinType() == JoinType::LEFT)) {
+      return optimized_plan;
+    }
+    // A merge join has a single key.
+    if (hash_join_plan.LeftJoinKeyExpressions().size() != 1) {
+      return optimized_plan;
+    }
+    const auto &left_key_expr = hash_join_plan.LeftJoinKeyExpressions()[0];
+    const auto &right_key_expr = hash_join_plan.RightJoinKeyExpressions()[0];
+    const auto *left_key = dynamic_cast<const ColumnValueExpression *>(left_key_expr.get());
+    const auto *right_key = dynamic_cast<const ColumnValueExpression *>(right_key_expr.get());
+    if (left_key == nullptr || right_key == nullptr) {
+      return optimized_plan;
+    }
+
+    auto left_plan = hash_join_plan.GetLeftPlan();
+    auto right_plan = hash_join_plan.GetRightPlan();
+    auto left_sorted = IsSortedOn(*left_plan, left_key->GetColIdx());
+    auto right_sorted = IsSortedOn(*right_plan, right_key->GetColIdx());
+    if (!left_sorted || !right_sorted) {
+      // Sorting an unsorted input would take as much memory as the hash table, so only the inputs that an index can
+      // provide in key order are acceptable, and only if the hash table is too large.
+      auto hash_table_size = EstimatedPlanCardinality(*right_plan) *
+                             static_cast<double>(sizeof(Tuple) + right_plan->OutputSchema().GetLength());
+      if (hash_table_size <= static_cast<double>(HASH_JOIN_MEMORY_BUDGET)) {
+        return optimized_plan;
+      }
+      if (!left_sorted && (left_plan = AsOrderedIndexScan(left_plan, left_key->GetColIdx())) == nullptr) {
+        return optimized_plan;
+      }
+      if (!right_sorted && (right_plan = AsOrderedIndexScan(right_plan, right_key->GetColIdx())) == nullptr) {
+        return optimized_plan;
+      }
+    }
+    return std::make_shared<MergeJoinPlanNode>(hash_join_plan.output_schema_, std::move(left_plan),
+                                               std::move(right_plan), left_key_expr, right_key_expr,
+                                               hash_join_plan.GetJoinType());
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,123 @@
+#include <memory>
+#include <vector>
+
+#include "binder/table_ref/bound_join_ref.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/nested_index_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the join type of a join plan */
+auto JoinTypeOf(const AbstractPlanNode &plan) -> JoinType {
+  switch (plan.GetType()) {
+    case PlanType::NestedLoopJoin:
+      return dynamic_cast<const NestedLoopJoinPlanNode &>(plan).GetJoinType();
+    case PlanType::HashJoin:
+      return dynamic_cast<const HashJoinPlanNode &>(plan).GetJoinType();
+    case PlanType::MergeJoin:
+      return dynamic_cast<const MergeJoinPlanNode &>(plan).GetJoinType();
+    default:
+      return dynamic_cast<const NestedIndexJoinPlanNode &>(plan).GetJoinType();
+  }
+}
+
+}  // namespace
+
+auto Optimizer::PushRuntimeFilter(const AbstractPlanNodeRef &plan, size_t filter_id, uint32_t col_idx)
+    -> AbstractPlanNodeRef {
+  // Every output row carrying a value of column `col_idx` that is not in the filter will be dropped by the hash join,
+  // so the row it comes from can be dropped by the scan producing it. Limits and aggregations would change their
+  // result if some input rows were dropped, the filter is not pushed through them.
+  switch (plan->GetType()) {
+    case PlanType::SeqScan: {
+      auto seq_scan = std::make_shared<SeqScanPlanNode>(dynamic_cast<const SeqScanPlanNode &>(*plan));
+      seq_scan->runtime_filters_.emplace_back(filter_id, col_idx);
+      return seq_scan;
+    }
+    case PlanType::Filter:
+    case PlanType::Sort:
+    case PlanType::Distinct: {
+      auto child = PushRuntimeFilter(plan->GetChildAt(0), filter_id, col_idx);
+      return child == nullptr ? nullptr : plan->CloneWithChildren({child});
+    }
+    case PlanType::Projection: {
+      const auto &expr = dynamic_cast<const ProjectionPlanNode &>(*plan).GetExpressions()[col_idx];
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      if (column_value_expr == nullptr) {
+        return nullptr;
+      }
+      auto child = PushRuntimeFilter(plan->GetChildAt(0), filter_id, column_value_expr->GetColIdx());
+      return child == nullptr ? nullptr : plan->CloneWithChildren({child});
+    }
+    case PlanType::NestedLoopJoin:
+    case PlanType::HashJoin:
+    case PlanType::MergeJoin:
+    case PlanType::NestedIndexJoin: {
+      // The columns of the left side are passed through by every join type. The columns of the right side are NULL
+      // padded by a left join, and not output by semi / anti joins, so only an inner join can drop its right rows.
+      const auto &left = plan->GetChildAt(0);
+      const auto left_column_cnt = left->OutputSchema().GetColumnCount();
+      if (col_idx < left_column_cnt) {
+        auto child = PushRuntimeFilter(left, filter_id, col_idx);
+        if (child == nullptr) {
+          return nullptr;
+        }
+        auto children = plan->GetChildren();
+        children[0] = std::move(child);
+        return plan->CloneWithChildren(std::move(children));
+      }
+      if (plan->GetType() == PlanType::NestedIndexJoin || JoinTypeOf(*plan) != JoinType::INNER) {
+        return nullptr;
+      }
+      auto child = PushRuntimeFilter(plan->GetChildAt(1), filter_id, col_idx - left_column_cnt);
+      return child == nullptr ? nullptr : plan->CloneWithChildren({left, child});
+    }
+    default:
+      return nullptr;
+  }
+}
+
+auto Optimizer::OptimizeHashJoinRuntimeFilter(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeHashJoinRuntimeFilter(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::HashJoin) {
+    const auto &hash_join_plan = dynamic_cast<const HashJoinPlanNode &>(*optimized_plan);
+    // A left / anti join outputs the left rows without a match too, so the filter can't drop them.
+    if (!(hash_join_plan.GetJoinType() == JoinType::INNER || hash_join_plan.GetJoinType() == JoinType::SEMI)) {
+      return optimized_plan;
+    }
+    // Every match has the same value in the first key on both sides, so filtering on it alone is enough.
+    const auto *left_key =
+        dynamic_cast<const ColumnValueExpression *>(hash_join_plan.LeftJoinKeyExpressions()[0].get());
+    if (left_key == nullptr) {
+      return optimized_plan;
+    }
+    auto filter_id = next_runtime_filter_id_;
+    auto left_plan = PushRuntimeFilter(hash_join_plan.GetLeftPlan(), filter_id, left_key->GetColIdx());
+    if (left_plan == nullptr) {
+      return optimized_plan;
+    }
+    next_runtime_filter_id_++;
+    auto new_plan = std::make_shared<HashJoinPlanNode>(hash_join_plan);
+    new_plan->children_ = {std::move(left_plan), hash_join_plan.GetRightPlan()};
+    new_plan->runtime_filter_id_ = filter_id;
+    return new_plan;
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,444 @@
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "catalog/table_statistics.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/optimizer_util.h"
+
+namespace bustub {
+
+namespace {
+
+/** A set of relations of a join cluster, bit i stands for the i-th relation */
+using RelationSet = uint64_t;
+
+/** A base relation of a join cluster, i.e. an input that is not itself an inner nested loop join. */
+struct JoinRelation {
+  AbstractPlanNodeRef plan_;
+  /** Position of the first column of this relation in the output of the whole cluster */
+  uint32_t offset_;
+  /** Number of columns of this relation */
+  uint32_t width_;
+};
+
+/** A conjunct of the join condition. Its columns refer to the output of the whole cluster, all with tuple_idx 0. */
+struct JoinConjunct {
+  AbstractExpressionRef expr_;
+  RelationSet relations_;
+  double selectivity_;
+};
+
+/** A node of the join tree picked by the enumerator. Leaves (single relations) have no children. */
+struct JoinTree {
+  RelationSet relations_;
+  double card_;
+  double cost_;
+  std::shared_ptr<JoinTree> left_;
+  std::shared_ptr<JoinTree> right_;
+};
+
+auto RelationCount(RelationSet set) -> int { return __builtin_popcountll(set); }
+
+auto IsInnerNLJ(const AbstractPlanNode &plan) -> bool {
+  return plan.GetType() == PlanType::NestedLoopJoin &&
+         dynamic_cast<const NestedLoopJoinPlanNode &>(plan).GetJoinType() == JoinType::INNER;
+}
+
+/** Flatten a tree of inner nested loop joins into its relations and the conjuncts of all its join predicates. */
+void FlattenJoinCluster(const AbstractPlanNodeRef &plan, uint32_t offset, std::vector<JoinRelation> *relations,
+                        std::vector<AbstractExpressionRef> *conjuncts) {
+  if (!IsInnerNLJ(*plan)) {
+    relations->push_back(JoinRelation{plan, offset, plan->OutputSchema().GetColumnCount()});
+    return;
+  }
+  const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+  BUSTUB_ENSURE(nlj_plan.GetChildren().size() == 2, "NLJ should have exactly 2 children.");
+  const auto left_column_cnt = nlj_plan.GetLeftPlan()->OutputSchema().GetColumnCount();
+  FlattenJoinCluster(nlj_plan.GetLeftPlan(), offset, relations, conjuncts);
+  FlattenJoinCluster(nlj_plan.GetRightPlan(), offset + left_column_cnt, relations, conjuncts);
+  auto predicate = RewriteColumns(nlj_plan.predicate_, [&](const ColumnValueExpression &col) -> AbstractExpressionRef {
+    auto col_idx = offset + col.GetColIdx() + (col.GetTupleIdx() == 0 ? 0 : left_column_cnt);
+    return std::make_shared<ColumnValueExpression>(0, col_idx, col.GetReturnType());
+  });
+  SplitConjuncts(predicate, conjuncts);
+}
+
+auto CollectRelations(const AbstractExpression &expr, const std::vector<size_t> &column_relation) -> RelationSet {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(&expr);
+      column_value_expr != nullptr) {
+    return RelationSet{1} << column_relation[column_value_expr->GetColIdx()];
+  }
+  RelationSet set = 0;
+  for (const auto &child : expr.GetChildren()) {
+    set |= CollectRelations(*child, column_relation);
+  }
+  return set;
+}
+
+/**
+ * JoinEnumerator picks a join tree for a set of relations, minimizing the sum of the estimated sizes of all
+ * intermediate results (C_out). Only the shape of the tree is decided here; the caller picks the build side.
+ */
+class JoinEnumerator {
+ public:
+  JoinEnumerator(std::vector<double> relation_cards, const std::vector<JoinConjunct> &conjuncts)
+      : relation_cards_(std::move(relation_cards)), conjuncts_(conjuncts) {}
+
+  auto Enumerate() -> std::shared_ptr<JoinTree> {
+    return relation_cards_.size() <= JOIN_ORDER_DP_THRESHOLD ? EnumerateDP() : EnumerateGreedy();
+  }
+
+ private:
+  auto Leaf(size_t idx) const -> std::shared_ptr<JoinTree> {
+    return std::make_shared<JoinTree>(JoinTree{RelationSet{1} << idx, relation_cards_[idx], 0, nullptr, nullptr});
+  }
+
+  auto Join(const std::shared_ptr<JoinTree> &left, const std::shared_ptr<JoinTree> &right, double card) const
+      -> std::shared_ptr<JoinTree> {
+    return std::make_shared<JoinTree>(
+        JoinTree{left->relations_ | right->relations_, card, left->cost_ + right->cost_ + card, left, right});
+  }
+
+  /** Estimated size of the join of all relations in `set`, assuming the conjuncts are independent */
+  auto Cardinality(RelationSet set) const -> double {
+    double card = 1;
+    for (size_t i = 0; i < relation_cards_.size(); i++) {
+      if ((set >> i & 1) != 0) {
+        card *= relation_cards_[i];
+      }
+    }
+    for (const auto &conjunct : conjuncts_) {
+      if (RelationCount(conjunct.relations_) >= 2 && (conjunct.relations_ & ~set) == 0) {
+        card *= conjunct.selectivity_;
+      }
+    }
+    return std::max(1.0, card);
+  }
+
+  /** @return whether some conjunct joins a relation of `left` with a relation of `right` */
+  auto IsConnected(RelationSet left, RelationSet right) const -> bool {
+    return std::any_of(conjuncts_.begin(), conjuncts_.end(), [&](const JoinConjunct &conjunct) {
+      return (conjunct.relations_ & ~(left | right)) == 0 && (conjunct.relations_ & left) != 0 &&
+             (conjunct.relations_ & right) != 0;
+    });
+  }
+
+  /**
+   * Dynamic programming over all subsets of relations. A subset is only split into two unconnected halves (i.e. a
+   * cross product) when it cannot be split into connected ones.
+   */
+  auto EnumerateDP() -> std::shared_ptr<JoinTree> {
+    const RelationSet all = (RelationSet{1} << relation_cards_.size()) - 1;
+    std::vector<std::shared_ptr<JoinTree>> best(all + 1);
+    for (size_t i = 0; i < relation_cards_.size(); i++) {
+      best[RelationSet{1} << i] = Leaf(i);
+    }
+    for (RelationSet set = 1; set <= all; set++) {
+      if (RelationCount(set) < 2) {
+        continue;
+      }
+      const auto card = Cardinality(set);
+      for (bool connected_only : {true, false}) {
+        for (RelationSet left = (set - 1) & set; left > 0; left = (left - 1) & set) {
+          const auto right = set ^ left;
+          if (connected_only && !IsConnected(left, right)) {
+            continue;
+          }
+          const auto cost = best[left]->cost_ + best[right]->cost_ + card;
+          if (best[set] == nullptr || cost < best[set]->cost_) {
+            best[set] = Join(best[left], best[right], card);
+          }
+        }
+        if (best[set] != nullptr) {
+          break;
+        }
+      }
+    }
+    return best[all];
+  }
+
+  /** Greedy operator ordering: keep joining the pair of sub-plans with the smallest result. */
+  auto EnumerateGreedy() -> std::shared_ptr<JoinTree> {
+    std::vector<std::shared_ptr<JoinTree>> trees;
+    for (size_t i = 0; i < relation_cards_.size(); i++) {
+      trees.push_back(Leaf(i));
+    }
+    while (trees.size() > 1) {
+      size_t best_left = 0;
+      size_t best_right = 0;
+      double best_card = 0;
+      for (bool connected_only : {true, false}) {
+        for (size_t i = 0; i < trees.size(); i++) {
+          for (size_t j = i + 1; j < trees.size(); j++) {
+            if (connected_only && !IsConnected(trees[i]->relations_, trees[j]->relations_)) {
+              continue;
+            }
+            const auto card = Cardinality(trees[i]->relations_ | trees[j]->relations_);
+            if (best_right == 0 || card < best_card) {
+              best_left = i;
+              best_right = j;
+              best_card = card;
+            }
+          }
+        }
+        if (best_right != 0) {
+          break;
+        }
+      }
+      trees[best_left] = Join(trees[best_left], trees[best_right], best_card);
+      trees.erase(trees.begin() + static_cast<std::ptrdiff_t>(best_right));
+    }
+    return trees[0];
+  }
+
+  std::vector<double> relation_cards_;
+  const std::vector<JoinConjunct> &conjuncts_;
+};
+
+}  // namespace
+
+auto Optimizer::OptimizeJoinOrder(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  // A filter right above the cluster is part of the join condition as well.
+  AbstractPlanNodeRef join_root = plan;
+  AbstractExpressionRef filter_predicate = nullptr;
+  if (plan->GetType() == PlanType::Filter && IsInnerNLJ(*plan->GetChildAt(0))) {
+    join_root = plan->GetChildAt(0);
+    filter_predicate = dynamic_cast<const FilterPlanNode &>(*plan).GetPredicate();
+  }
+
+  std::vector<JoinRelation> relations;
+  std::vector<AbstractExpressionRef> exprs;
+  if (IsInnerNLJ(*join_root)) {
+    FlattenJoinCluster(join_root, 0, &relations, &exprs);
+  }
+  if (relations.size() < 3 || relations.size() >= sizeof(RelationSet) * 8) {
+    std::vector<AbstractPlanNodeRef> children;
+    for (const auto &child : plan->GetChildren()) {
+      children.emplace_back(OptimizeJoinOrder(child));
+    }
+    return plan->CloneWithChildren(std::move(children));
+  }
+  if (filter_predicate != nullptr) {
+    SplitConjuncts(filter_predicate, &exprs);
+  }
+
+  const auto relation_cnt = relations.size();
+  const RelationSet all = (RelationSet{1} << relation_cnt) - 1;
+  std::vector<size_t> column_relation;
+  for (size_t i = 0; i < relation_cnt; i++) {
+    relations[i].plan_ = OptimizeJoinOrder(relations[i].plan_);
+    column_relation.insert(column_relation.end(), relations[i].width_, i);
+  }
+  auto column_type = [&](uint32_t col_idx) {
+    const auto &relation = relations[column_relation[col_idx]];
+    return relation.plan_->OutputSchema().GetColumn(col_idx - relation.offset_).GetType();
+  };
+
+  // 1.把只涉及一个关系的条件下推到该关系上方，估计每个关系过滤之后的基数
+  std::vector<JoinConjunct> conjuncts;
+  std::vector<std::vector<AbstractExpressionRef>> relation_filters(relation_cnt);
+  for (const auto &expr : exprs) {
+    if (IsPredicateTrue(*expr)) {
+      continue;
+    }
+    auto set = CollectRelations(*expr, column_relation);
+    if (RelationCount(set) == 1) {
+      const auto &relation = relations[__builtin_ctzll(set)];
+      relation_filters[__builtin_ctzll(set)].push_back(
+          RewriteColumns(expr, [&](const ColumnValueExpression &col) -> AbstractExpressionRef {
+            return std::make_shared<ColumnValueExpression>(0, col.GetColIdx() - relation.offset_, col.GetReturnType());
+          }));
+      continue;
+    }
+    conjuncts.push_back(JoinConjunct{expr, set, 1.0});
+  }
+
+  std::vector<double> base_cards(relation_cnt);
+  std::vector<double> relation_cards(relation_cnt);
+  for (size_t i = 0; i < relation_cnt; i++) {
+    auto &relation = relations[i];
+    base_cards[i] = std::max(1.0, EstimatedPlanCardinality(*relation.plan_));
+    relation_cards[i] = base_cards[i];
+    if (!relation_filters[i].empty()) {
+      auto predicate = MakeConjunction(relation_filters[i]);
+      std::string table_name;
+      if (relation.plan_->GetType() == PlanType::SeqScan) {
+        table_name = dynamic_cast<const SeqScanPlanNode &>(*relation.plan_).table_name_;
+      }
+      relation_cards[i] = std::max(1.0, base_cards[i] * EstimatedSelectivity(table_name, *predicate));
+      relation.plan_ = std::make_shared<FilterPlanNode>(relation.plan_->output_schema_, predicate, relation.plan_);
+    }
+  }
+
+  // 2.估计每个连接条件的选择率：等值连接使用1/max(NDV)，没有统计信息时假设是主外键连接
+  for (auto &conjunct : conjuncts) {
+    if (RelationCount(conjunct.relations_) < 2) {
+      continue;
+    }
+    conjunct.selectivity_ = DEFAULT_RANGE_SELECTIVITY;
+    if (auto columns = AsEquiJoinColumns(*conjunct.expr_); columns.has_value()) {
+      double ndv = 1;
+      for (const auto *col : {columns->first, columns->second}) {
+        auto relation_idx = column_relation[col->GetColIdx()];
+        const auto &relation = relations[relation_idx];
+        ndv = std::max(ndv, EstimatedDistinctCount(*relation.plan_, col->GetColIdx() - relation.offset_)
+                                .value_or(base_cards[relation_idx]));
+      }
+      conjunct.selectivity_ = 1.0 / ndv;
+    }
+  }
+
+  // 3.枚举连接顺序
+  auto tree = JoinEnumerator(relation_cards, conjuncts).Enumerate();
+
+  // 4.根据连接树重新生成计划，较小的一侧放在右边（hash join的build侧），除非另一侧可以走索引
+  auto column_position = [&](const std::vector<size_t> &order, uint32_t col_idx) -> uint32_t {
+    uint32_t position = 0;
+    for (auto relation_idx : order) {
+      if (relation_idx == column_relation[col_idx]) {
+        return position + col_idx - relations[relation_idx].offset_;
+      }
+      position += relations[relation_idx].width_;
+    }
+    UNREACHABLE("column not in the join order");
+  };
+  auto can_probe_by_index = [&](const JoinTree &side, const std::vector<const JoinConjunct *> &join_conjuncts) {
+    if (side.left_ != nullptr) {
+      return false;
+    }
+    const auto &relation = relations[__builtin_ctzll(side.relations_)];
+    if (relation.plan_->GetType() != PlanType::SeqScan) {
+      return false;
+    }
+    const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*relation.plan_);
+    if (seq_scan.filter_predicate_ != nullptr) {
+      return false;
+    }
+    return std::any_of(join_conjuncts.begin(), join_conjuncts.end(), [&](const JoinConjunct *conjunct) {
+      auto columns = AsEquiJoinColumns(*conjunct->expr_);
+      if (!columns.has_value()) {
+        return false;
+      }
+      for (const auto *col : {columns->first, columns->second}) {
+        if ((side.relations_ >> column_relation[col->GetColIdx()] & 1) != 0 &&
+            MatchIndex(seq_scan.table_name_, col->GetColIdx() - relation.offset_).has_value()) {
+          return true;
+        }
+      }
+      return false;
+    });
+  };
+
+  std::function<std::pair<AbstractPlanNodeRef, std::vector<size_t>>(const JoinTree &)> build_plan =
+      [&](const JoinTree &node) -> std::pair<AbstractPlanNodeRef, std::vector<size_t>> {
+    if (node.left_ == nullptr) {
+      auto relation_idx = static_cast<size_t>(__builtin_ctzll(node.relations_));
+      return {relations[relation_idx].plan_, {relation_idx}};
+    }
+    std::vector<const JoinConjunct *> join_conjuncts;
+    for (const auto &conjunct : conjuncts) {
+      if (conjunct.relations_ == 0 ? node.relations_ == all
+                                   : (conjunct.relations_ & ~node.relations_) == 0 &&
+                                         (conjunct.relations_ & ~node.left_->relations_) != 0 &&
+                                         (conjunct.relations_ & ~node.right_->relations_) != 0) {
+        join_conjuncts.push_back(&conjunct);
+      }
+    }
+    auto left = node.left_;
+    auto right = node.right_;
+    auto left_probe = can_probe_by_index(*left, join_conjuncts);
+    auto right_probe = can_probe_by_index(*right, join_conjuncts);
+    if (left_probe != right_probe ? left_probe : left->card_ < right->card_) {
+      std::swap(left, right);
+    }
+    auto [left_plan, left_order] = build_plan(*left);
+    auto [right_plan, right_order] = build_plan(*right);
+
+    std::vector<AbstractExpressionRef> predicates;
+    auto rewrite_for_join = [&](const ColumnValueExpression &col) -> AbstractExpressionRef {
+      auto col_idx = col.GetColIdx();
+      if ((left->relations_ >> column_relation[col_idx] & 1) != 0) {
+        return std::make_shared<ColumnValueExpression>(0, column_position(left_order, col_idx), col.GetReturnType());
+      }
+      return std::make_shared<ColumnValueExpression>(1, column_position(right_order, col_idx), col.GetReturnType());
+    };
+    for (const auto *conjunct : join_conjuncts) {
+      predicates.push_back(RewriteColumns(conjunct->expr_, rewrite_for_join));
+    }
+    auto order = left_order;
+    order.insert(order.end(), right_order.begin(), right_order.end());
+    auto join_plan = std::make_shared<NestedLoopJoinPlanNode>(
+        std::make_shared<Schema>(NestedLoopJoinPlanNode::InferJoinSchema(*left_plan, *right_plan)), left_plan,
+        right_plan, MakeConjunction(predicates), JoinType::INNER);
+    return {join_plan, order};
+  };
+  auto [join_plan, order] = build_plan(*tree);
+
+  // 5.恢复原来的列顺序
+  if (std::is_sorted(order.begin(), order.end())) {
+    return join_plan;
+  }
+  std::vector<AbstractExpressionRef> columns;
+  for (uint32_t col_idx = 0; col_idx < column_relation.size(); col_idx++) {
+    columns.push_back(
+        std::make_shared<ColumnValueExpression>(0, column_position(order, col_idx), column_type(col_idx)));
+  }
+  return std::make_shared<ProjectionPlanNode>(plan->output_schema_, std::move(columns), join_plan);
+}
+
+auto Optimizer::OptimizeHashJoinBuildSide(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeHashJoinBuildSide(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::HashJoin) {
+    const auto &hash_join_plan = dynamic_cast<const HashJoinPlanNode &>(*optimized_plan);
+    const auto &left_plan = hash_join_plan.GetLeftPlan();
+    const auto &right_plan = hash_join_plan.GetRightPlan();
+    // Estimates of joins are rough, so we only trust the ones of (filtered) base relations. Inputs of a reordered
+    // join cluster already have the smaller side on the right.
+    auto is_join = [](const AbstractPlanNode &node) {
+      return node.GetType() == PlanType::NestedLoopJoin || node.GetType() == PlanType::HashJoin ||
+             node.GetType() == PlanType::NestedIndexJoin;
+    };
+    if (hash_join_plan.GetJoinType() != JoinType::INNER || is_join(*left_plan) || is_join(*right_plan)) {
+      return optimized_plan;
+    }
+    if (EstimatedPlanCardinality(*right_plan) <= EstimatedPlanCardinality(*left_plan)) {
+      return optimized_plan;
+    }
+    auto swapped_plan = std::make_shared<HashJoinPlanNode>(
+        std::make_shared<Schema>(NestedLoopJoinPlanNode::InferJoinSchema(*right_plan, *left_plan)), right_plan,
+        left_plan, hash_join_plan.RightJoinKeyExpressions(), hash_join_plan.LeftJoinKeyExpressions(), JoinType::INNER);
+    const auto left_column_cnt = left_plan->OutputSchema().GetColumnCount();
+    const auto right_column_cnt = right_plan->OutputSchema().GetColumnCount();
+    std::vector<AbstractExpressionRef> columns;
+    for (uint32_t i = 0; i < left_column_cnt + right_column_cnt; i++) {
+      auto col_idx = i < left_column_cnt ? right_column_cnt + i : i - left_column_cnt;
+      columns.push_back(std::make_shared<ColumnValueExpression>(
+          0, col_idx, hash_join_plan.OutputSchema().GetColumn(i).GetType()));
+    }
+    return std::make_shared<ProjectionPlanNode>(hash_join_plan.output_schema_, std::move(columns),
+                                                std::move(swapped_plan));
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
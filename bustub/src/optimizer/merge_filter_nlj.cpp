@@ -60,7 +60,9 @@ auto Optimizer::OptimizeMergeFilterNLJ(const AbstractPlanNodeRef &plan) -> Abstr
       // Has exactly two children
       BUSTUB_ENSURE(child_plan->GetChildren().size() == 2, "NLJ should have exactly 2 children.");
 
-      if (IsPredicateTrue(nlj_plan.Predicate())) {
+      // A filter above an anti join removes the rows it outputs, while the join condition only decides which rows are
+      // not output, so it can't be merged.
+      if (IsPredicateTrue(nlj_plan.Predicate()) && nlj_plan.GetJoinType() != JoinType::ANTI) {
         // Only rewrite when NLJ has always true predicate.
         return std::make_shared<NestedLoopJoinPlanNode>(
             filter_plan.output_schema_, nlj_plan.GetLeftPlan(), nlj_plan.GetRightPlan(),
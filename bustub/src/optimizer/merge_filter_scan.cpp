@@ -1,5 +1,6 @@
 #include <memory>
 #include <vector>
+#include "execution/expressions/logic_expression.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/seq_scan_plan.h"
@@ -26,10 +27,12 @@ auto Optimizer::OptimizeMergeFilterScan(const AbstractPlanNodeRef &plan) -> Abst
     const auto &child_plan = *optimized_plan->children_[0];
     if (child_plan.GetType() == PlanType::SeqScan) {
       const auto &seq_scan_plan = dynamic_cast<const SeqScanPlanNode &>(child_plan);
-      if (seq_scan_plan.filter_predicate_ == nullptr) {
-        return std::make_shared<SeqScanPlanNode>(filter_plan.output_schema_, seq_scan_plan.table_oid_,
-                                                 seq_scan_plan.table_name_, filter_plan.GetPredicate());
+      auto predicate = filter_plan.GetPredicate();
+      if (seq_scan_plan.filter_predicate_ != nullptr) {
+        predicate = std::make_shared<LogicExpression>(seq_scan_plan.filter_predicate_, predicate, LogicType::And);
       }
+      return std::make_shared<SeqScanPlanNode>(filter_plan.output_schema_, seq_scan_plan.table_oid_,
+                                               seq_scan_plan.table_name_, std::move(predicate));
     }
   }
 
@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 #include "catalog/column.h"
 #include "catalog/schema.h"
 #include "execution/expressions/column_value_expression.h"
@@ -29,7 +31,9 @@ auto Optimizer::OptimizeMergeProjection(const AbstractPlanNodeRef &plan) -> Abst
     if (std::equal(child_columns.begin(), child_columns.end(), projection_columns.begin(), projection_columns.end(),
                    [](auto &&child_col, auto &&proj_col) {
                      // TODO(chi): consider VARCHAR length
-                     return child_col.GetType() == proj_col.GetType();
+                     return child_col.GetType() == proj_col.GetType() &&
+                            child_col.GetPrecision() == proj_col.GetPrecision() &&
+                            child_col.GetScale() == proj_col.GetScale();
                    })) {
       const auto &exprs = projection_plan.GetExpressions();
       // If all items are column value expressions
@@ -46,7 +50,13 @@ auto Optimizer::OptimizeMergeProjection(const AbstractPlanNodeRef &plan) -> Abst
       }
       if (is_identical) {
         auto plan = child_plan->CloneWithChildren(child_plan->GetChildren());
-        plan->output_schema_ = std::make_shared<Schema>(projection_schema);
+        // Keep the columns of the child, they describe how its tuples are laid out (e.g. the size of a FIXED_DECIMAL).
+        std::vector<std::string> column_names;
+        for (const auto &column : projection_columns) {
+          column_names.push_back(column.GetName());
+        }
+        plan->output_schema_ =
+            std::make_shared<Schema>(ProjectionPlanNode::RenameSchema(child_schema, column_names));
         return plan;
       }
     }
@@ -1,5 +1,8 @@
 #include <algorithm>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 #include "catalog/column.h"
 #include "catalog/schema.h"
 #include "common/exception.h"
@@ -13,10 +16,52 @@
 #include "execution/plans/nested_loop_join_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "optimizer/optimizer.h"
+#include "optimizer/optimizer_util.h"
 #include "type/type_id.h"
 
 namespace bustub {
 
+namespace {
+
+/** @return the side (0 = left, 1 = right) of the join that every column of `expr` is from, nullopt if none or both */
+auto SideOf(const AbstractExpression &expr) -> std::optional<uint32_t> {
+  std::optional<uint32_t> side;
+  bool one_side = AllColumns(expr, [&side](const ColumnValueExpression &col) {
+    if (!side.has_value()) {
+      side = col.GetTupleIdx();
+    }
+    return *side == col.GetTupleIdx();
+  });
+  return one_side ? side : std::nullopt;
+}
+
+/**
+ * @return the (left key, right key) of an `<expr> = <expr>` conjunct of which one side only reads the left table and
+ * the other only the right table, with the columns of both keys rewritten to tuple 0.
+ */
+auto AsEquiJoinKeys(const AbstractExpression &expr) -> std::optional<std::pair<AbstractExpressionRef, AbstractExpressionRef>> {
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr);
+  if (cmp_expr == nullptr || cmp_expr->comp_type_ != ComparisonType::Equal) {
+    return std::nullopt;
+  }
+  auto first_side = SideOf(*cmp_expr->GetChildAt(0));
+  auto second_side = SideOf(*cmp_expr->GetChildAt(1));
+  if (!first_side.has_value() || !second_side.has_value() || *first_side == *second_side) {
+    return std::nullopt;
+  }
+  auto to_tuple_0 = [](const ColumnValueExpression &col) {
+    return std::make_shared<ColumnValueExpression>(0, col.GetColIdx(), col.GetReturnType());
+  };
+  auto first = RewriteColumns(cmp_expr->GetChildAt(0), to_tuple_0);
+  auto second = RewriteColumns(cmp_expr->GetChildAt(1), to_tuple_0);
+  if (*first_side == 0) {
+    return std::make_pair(std::move(first), std::move(second));
+  }
+  return std::make_pair(std::move(second), std::move(first));
+}
+
+}  // namespace
+
 auto Optimizer::OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
   std::vector<AbstractPlanNodeRef> children;
   for (const auto &child : plan->GetChildren()) {
@@ -29,34 +74,39 @@ auto Optimizer::OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> Abstra
     // Has exactly two children
     BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
 
-    // Check if expr is equal condition where one is for the left table, and one is for the right table.
-    if (const auto *expr = dynamic_cast<const ComparisonExpression *>(&nlj_plan.Predicate()); expr != nullptr) {
-      if (expr->comp_type_ == ComparisonType::Equal) {
-        if (const auto *left_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[0].get());
-            left_expr != nullptr) {
-          if (const auto *right_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[1].get());
-              right_expr != nullptr) {
-            // Ensure both exprs have tuple_id == 0
-            auto left_expr_tuple_0 =
-                std::make_shared<ColumnValueExpression>(0, left_expr->GetColIdx(), left_expr->GetReturnType());
-            auto right_expr_tuple_0 =
-                std::make_shared<ColumnValueExpression>(0, right_expr->GetColIdx(), right_expr->GetReturnType());
-            // Now it's in form of <column_expr> = <column_expr>. Let's check if one of them is from the left table, and
-            // the other is from the right table.
-            if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1) {
-              return std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
-                                                        nlj_plan.GetRightPlan(), std::move(left_expr_tuple_0),
-                                                        std::move(right_expr_tuple_0), nlj_plan.GetJoinType());
-            }
-            if (left_expr->GetTupleIdx() == 1 && right_expr->GetTupleIdx() == 0) {
-              return std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
-                                                        nlj_plan.GetRightPlan(), std::move(right_expr_tuple_0),
-                                                        std::move(left_expr_tuple_0), nlj_plan.GetJoinType());
-            }
-          }
-        }
+    // Every conjunct of the join condition that is an equal condition where one side is for the left table, and the
+    // other for the right table, becomes a pair of join keys. For inner joins, the remaining conjuncts are evaluated by
+    // a filter on top of the hash join; the other join types need the whole condition to be made of join keys.
+    std::vector<AbstractExpressionRef> conjuncts;
+    SplitConjuncts(nlj_plan.predicate_, &conjuncts);
+    std::vector<AbstractExpressionRef> left_keys;
+    std::vector<AbstractExpressionRef> right_keys;
+    std::vector<AbstractExpressionRef> residual_conjuncts;
+    for (const auto &conjunct : conjuncts) {
+      if (auto keys = AsEquiJoinKeys(*conjunct); keys.has_value()) {
+        left_keys.push_back(std::move(keys->first));
+        right_keys.push_back(std::move(keys->second));
+      } else {
+        residual_conjuncts.push_back(conjunct);
       }
     }
+    if (left_keys.empty() || (!residual_conjuncts.empty() && nlj_plan.GetJoinType() != JoinType::INNER)) {
+      return optimized_plan;
+    }
+
+    AbstractPlanNodeRef hash_join_plan =
+        std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(), nlj_plan.GetRightPlan(),
+                                           std::move(left_keys), std::move(right_keys), nlj_plan.GetJoinType());
+    if (residual_conjuncts.empty()) {
+      return hash_join_plan;
+    }
+    // The filter sees the output of the join, so the columns of the right table are shifted.
+    const auto left_column_cnt = nlj_plan.GetLeftPlan()->OutputSchema().GetColumnCount();
+    auto residual = RewriteColumns(MakeConjunction(residual_conjuncts), [&](const ColumnValueExpression &col) {
+      auto col_idx = col.GetColIdx() + (col.GetTupleIdx() == 0 ? 0 : left_column_cnt);
+      return std::make_shared<ColumnValueExpression>(0, col_idx, col.GetReturnType());
+    });
+    return std::make_shared<FilterPlanNode>(nlj_plan.output_schema_, std::move(residual), std::move(hash_join_plan));
   }
 
   return optimized_plan;
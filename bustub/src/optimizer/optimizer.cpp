@@ -1,7 +1,20 @@
 #include "optimizer/optimizer.h"
+#include <algorithm>
 #include <optional>
+#include "catalog/table_statistics.h"
 #include "common/util/string_util.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "execution/plans/values_plan.h"
 
 namespace bustub {
 
@@ -21,6 +34,12 @@ auto Optimizer::Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef
 }
 
 auto Optimizer::EstimatedCardinality(const std::string &table_name) -> std::optional<size_t> {
+  if (const auto *table_info = catalog_.GetTable(table_name); table_info != nullptr) {
+    const auto *stats = table_info->stats_.get();
+    if (stats->IsAnalyzed() || stats->GetRowCount() > 0) {
+      return std::make_optional(stats->GetRowCount());
+    }
+  }
   if (StringUtil::EndsWith(table_name, "_1m")) {
     return std::make_optional(1000000);
   }
@@ -42,4 +61,151 @@ auto Optimizer::EstimatedCardinality(const std::string &table_name) -> std::opti
   return std::nullopt;
 }
 
+auto Optimizer::EstimatedSelectivity(const std::string &table_name, const AbstractExpression &predicate) -> double {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(&predicate); logic_expr != nullptr) {
+    auto left = EstimatedSelectivity(table_name, *logic_expr->GetChildAt(0));
+    auto right = EstimatedSelectivity(table_name, *logic_expr->GetChildAt(1));
+    if (logic_expr->logic_type_ == LogicType::And) {
+      return left * right;
+    }
+    return left + right - left * right;
+  }
+
+  if (const auto *const_expr = dynamic_cast<const ConstantValueExpression *>(&predicate); const_expr != nullptr) {
+    return IsPredicateTrue(*const_expr) ? 1.0 : 0.0;
+  }
+
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&predicate);
+  if (cmp_expr == nullptr) {
+    return DEFAULT_RANGE_SELECTIVITY;
+  }
+
+  // Normalize to `<column> <op> <constant>`.
+  auto comp_type = cmp_expr->comp_type_;
+  const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(0).get());
+  const auto *value_expr = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(1).get());
+  if (column_expr == nullptr || value_expr == nullptr) {
+    column_expr = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(1).get());
+    value_expr = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(0).get());
+    switch (comp_type) {
+      case ComparisonType::LessThan:
+        comp_type = ComparisonType::GreaterThan;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        comp_type = ComparisonType::GreaterThanOrEqual;
+        break;
+      case ComparisonType::GreaterThan:
+        comp_type = ComparisonType::LessThan;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        comp_type = ComparisonType::LessThanOrEqual;
+        break;
+      default:
+        break;
+    }
+  }
+
+  const ColumnStatistics *col_stats = nullptr;
+  if (const auto *table_info = catalog_.GetTable(table_name); table_info != nullptr && column_expr != nullptr) {
+    col_stats = table_info->stats_->GetColumnStatistics(column_expr->GetColIdx());
+  }
+
+  if (col_stats == nullptr || value_expr == nullptr) {
+    if (comp_type == ComparisonType::Equal) {
+      return DEFAULT_EQ_SELECTIVITY;
+    }
+    if (comp_type == ComparisonType::NotEqual) {
+      return 1.0 - DEFAULT_EQ_SELECTIVITY;
+    }
+    return DEFAULT_RANGE_SELECTIVITY;
+  }
+
+  const auto &val = value_expr->val_;
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return col_stats->EstimateEqualSelectivity(val);
+    case ComparisonType::NotEqual:
+      return std::max(0.0, 1.0 - col_stats->NullFraction() - col_stats->EstimateEqualSelectivity(val));
+    case ComparisonType::LessThan:
+      return col_stats->EstimateLessThanSelectivity(val, false);
+    case ComparisonType::LessThanOrEqual:
+      return col_stats->EstimateLessThanSelectivity(val, true);
+    case ComparisonType::GreaterThan:
+      return col_stats->EstimateRangeSelectivity(val, false, std::nullopt, false);
+    case ComparisonType::GreaterThanOrEqual:
+      return col_stats->EstimateRangeSelectivity(val, true, std::nullopt, false);
+  }
+  return DEFAULT_RANGE_SELECTIVITY;
+}
+
+auto Optimizer::EstimatedPlanCardinality(const AbstractPlanNode &plan) -> double {
+  switch (plan.GetType()) {
+    case PlanType::SeqScan: {
+      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(plan);
+      auto card = static_cast<double>(EstimatedCardinality(seq_scan.table_name_).value_or(DEFAULT_TABLE_CARDINALITY));
+      if (seq_scan.filter_predicate_ != nullptr) {
+        card *= EstimatedSelectivity(seq_scan.table_name_, *seq_scan.filter_predicate_);
+      }
+      return card;
+    }
+    case PlanType::MockScan: {
+      const auto &mock_scan = dynamic_cast<const MockScanPlanNode &>(plan);
+      return static_cast<double>(EstimatedCardinality(mock_scan.GetTable()).value_or(DEFAULT_TABLE_CARDINALITY));
+    }
+    case PlanType::Values:
+      return static_cast<double>(dynamic_cast<const ValuesPlanNode &>(plan).GetValues().size());
+    case PlanType::Filter: {
+      const auto &filter = dynamic_cast<const FilterPlanNode &>(plan);
+      const auto &child = *filter.GetChildPlan();
+      std::string table_name;
+      if (child.GetType() == PlanType::SeqScan) {
+        table_name = dynamic_cast<const SeqScanPlanNode &>(child).table_name_;
+      }
+      return EstimatedPlanCardinality(child) * EstimatedSelectivity(table_name, *filter.GetPredicate());
+    }
+    case PlanType::Aggregation: {
+      const auto &agg = dynamic_cast<const AggregationPlanNode &>(plan);
+      return agg.GetGroupBys().empty() ? 1.0 : EstimatedPlanCardinality(*agg.GetChildPlan());
+    }
+    case PlanType::Limit: {
+      const auto &limit = dynamic_cast<const LimitPlanNode &>(plan);
+      return std::min(static_cast<double>(limit.GetLimit()), EstimatedPlanCardinality(*limit.GetChildPlan()));
+    }
+    case PlanType::TopN: {
+      const auto &topn = dynamic_cast<const TopNPlanNode &>(plan);
+      return std::min(static_cast<double>(topn.GetN()), EstimatedPlanCardinality(*topn.GetChildPlan()));
+    }
+    case PlanType::NestedIndexJoin:
+      return EstimatedPlanCardinality(*plan.GetChildAt(0));
+    case PlanType::NestedLoopJoin:
+    case PlanType::HashJoin:
+    case PlanType::MergeJoin:
+      // Assume a key / foreign key join: every row of the larger side matches at most one row of the other side.
+      return std::max(EstimatedPlanCardinality(*plan.GetChildAt(0)), EstimatedPlanCardinality(*plan.GetChildAt(1)));
+    default:
+      break;
+  }
+  if (plan.GetChildren().empty()) {
+    return static_cast<double>(DEFAULT_TABLE_CARDINALITY);
+  }
+  return EstimatedPlanCardinality(*plan.GetChildAt(0));
+}
+
+auto Optimizer::EstimatedDistinctCount(const AbstractPlanNode &plan, uint32_t col_idx) -> std::optional<double> {
+  const auto *node = &plan;
+  while (node->GetType() == PlanType::Filter) {
+    node = node->GetChildAt(0).get();
+  }
+  if (node->GetType() != PlanType::SeqScan) {
+    return std::nullopt;
+  }
+  const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*node);
+  if (const auto *table_info = catalog_.GetTable(seq_scan.table_name_); table_info != nullptr) {
+    if (const auto *col_stats = table_info->stats_->GetColumnStatistics(col_idx); col_stats != nullptr) {
+      return std::make_optional(std::max(1.0, col_stats->DistinctCount()));
+    }
+  }
+  return std::nullopt;
+}
+
 }  // namespace bustub
@@ -11,10 +11,18 @@ auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanN
   auto p = plan;
   p = OptimizeMergeProjection(p);
   p = OptimizeMergeFilterNLJ(p);
+  p = OptimizePredicatePushdown(p);
+  p = OptimizeJoinOrder(p);
+  p = OptimizeMergeFilterScan(p);
   p = OptimizeNLJAsIndexJoin(p);
   p = OptimizeNLJAsHashJoin(p);  // Enable this rule after you have implemented hash join.
+  p = OptimizeHashJoinBuildSide(p);
   p = OptimizeOrderByAsIndexScan(p);
+  p = OptimizeSeqScanAsIndexScan(p);
+  p = OptimizeSortedAggregation(p);
+  p = OptimizeHashJoinAsMergeJoin(p);
   p = OptimizeSortLimitAsTopN(p);
+  p = OptimizeHashJoinRuntimeFilter(p);
   return p;
 }
 
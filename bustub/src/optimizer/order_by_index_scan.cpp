@@ -61,11 +61,13 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
       const auto indices = catalog_.GetTableIndexes(table_info->name_);
 
       for (const auto *index : indices) {
+        // The index is sorted by its first key column, it does not matter whether there are more.
         const auto &columns = index->key_schema_.GetColumns();
-        if (columns.size() == 1 &&
-            columns[0].GetName() == table_info->schema_.GetColumn(order_by_column_id).GetName()) {
-          // Index matched, return index scan instead
-          return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_);
+        if (columns[0].GetName() == table_info->schema_.GetColumn(order_by_column_id).GetName()) {
+          // Index matched, return index scan instead. The filter of the seq scan is kept in the index scan, and
+          // OptimizeSeqScanAsIndexScan may later turn it into a key range.
+          return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_,
+                                                     seq_scan.filter_predicate_);
         }
       }
     }
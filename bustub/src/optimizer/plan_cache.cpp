@@ -0,0 +1,94 @@
+#include "optimizer/plan_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace bustub {
+
+auto PlanCache::Get(const std::string &key, uint64_t catalog_version) -> std::shared_ptr<CachedPlan> {
+  std::scoped_lock lock(latch_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    miss_count_++;
+    return nullptr;
+  }
+  if (it->second->second->catalog_version_ != catalog_version) {
+    lru_list_.erase(it->second);
+    entries_.erase(it);
+    miss_count_++;
+    return nullptr;
+  }
+  lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+  hit_count_++;
+  return it->second->second;
+}
+
+void PlanCache::Put(const std::string &key, std::shared_ptr<CachedPlan> plan) {
+  std::scoped_lock lock(latch_);
+  if (auto it = entries_.find(key); it != entries_.end()) {
+    lru_list_.erase(it->second);
+    entries_.erase(it);
+  }
+  lru_list_.emplace_front(key, std::move(plan));
+  entries_.emplace(key, lru_list_.begin());
+  if (lru_list_.size() > capacity_) {
+    entries_.erase(lru_list_.back().first);
+    lru_list_.pop_back();
+  }
+}
+
+auto PlanCache::NormalizeSql(const std::string &sql) -> std::string {
+  std::string result;
+  result.reserve(sql.size());
+  bool pending_space = false;
+  size_t i = 0;
+  while (i < sql.size()) {
+    char c = sql[i];
+    if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+      pending_space = true;
+      i++;
+      continue;
+    }
+    // 1.注释和空白一样处理
+    if (c == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+      while (i < sql.size() && sql[i] != '\n') {
+        i++;
+      }
+      pending_space = true;
+      continue;
+    }
+    if (c == '/' && i + 1 < sql.size() && sql[i + 1] == '*') {
+      auto end = sql.find("*/", i + 2);
+      i = end == std::string::npos ? sql.size() : end + 2;
+      pending_space = true;
+      continue;
+    }
+    if (pending_space && !result.empty()) {
+      result.push_back(' ');
+    }
+    pending_space = false;
+    // 2.字符串和带引号的标识符原样保留，其余部分不区分大小写
+    if (c == '\'' || c == '"') {
+      auto end = i + 1;
+      while (end < sql.size() && sql[end] != c) {
+        end++;
+      }
+      end = std::min(end + 1, sql.size());
+      result.append(sql, i, end - i);
+      i = end;
+      continue;
+    }
+    result.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    i++;
+  }
+  // 3.去掉末尾的分号
+  while (!result.empty() && (result.back() == ';' || result.back() == ' ')) {
+    result.pop_back();
+  }
+  return result;
+}
+
+}  // namespace bustub
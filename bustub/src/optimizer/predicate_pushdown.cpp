@@ -0,0 +1,256 @@
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/optimizer_util.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the column of a `<column> op <constant>` (or `<constant> op <column>`) conjunct */
+auto AsColumnConstantComparison(const AbstractExpression &expr) -> const ColumnValueExpression * {
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr);
+  if (cmp_expr == nullptr) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < 2; i++) {
+    const auto *column = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(i).get());
+    const auto *constant = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(1 - i).get());
+    if (column != nullptr && constant != nullptr) {
+      return column;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * Derive new conjuncts through the equivalence classes formed by the `<column> = <column>` conjuncts, e.g. derive
+ * `b.y < 5` from `a.x = b.y AND a.x < 5`. The derived conjuncts are appended to `conjuncts`.
+ */
+void DeriveTransitivePredicates(std::vector<AbstractExpressionRef> *conjuncts, uint32_t column_cnt) {
+  std::vector<uint32_t> parent(column_cnt);
+  std::iota(parent.begin(), parent.end(), 0);
+  std::function<uint32_t(uint32_t)> find = [&](uint32_t col_idx) {
+    return parent[col_idx] == col_idx ? col_idx : parent[col_idx] = find(parent[col_idx]);
+  };
+  std::vector<const ColumnValueExpression *> columns(column_cnt, nullptr);
+  for (const auto &conjunct : *conjuncts) {
+    if (auto equi_columns = AsEquiJoinColumns(*conjunct); equi_columns.has_value()) {
+      columns[equi_columns->first->GetColIdx()] = equi_columns->first;
+      columns[equi_columns->second->GetColIdx()] = equi_columns->second;
+      parent[find(equi_columns->first->GetColIdx())] = find(equi_columns->second->GetColIdx());
+    }
+  }
+
+  std::unordered_set<std::string> known;
+  for (const auto &conjunct : *conjuncts) {
+    known.insert(conjunct->ToString());
+  }
+  const auto conjunct_cnt = conjuncts->size();
+  for (size_t i = 0; i < conjunct_cnt; i++) {
+    auto conjunct = (*conjuncts)[i];
+    const auto *column = AsColumnConstantComparison(*conjunct);
+    if (column == nullptr) {
+      continue;
+    }
+    for (uint32_t col_idx = 0; col_idx < column_cnt; col_idx++) {
+      if (col_idx == column->GetColIdx() || columns[col_idx] == nullptr || find(col_idx) != find(column->GetColIdx())) {
+        continue;
+      }
+      auto derived = RewriteColumns(conjunct, [&](const ColumnValueExpression &) -> AbstractExpressionRef {
+        return std::make_shared<ColumnValueExpression>(0, col_idx, columns[col_idx]->GetReturnType());
+      });
+      if (known.insert(derived->ToString()).second) {
+        conjuncts->push_back(std::move(derived));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+auto Optimizer::OptimizePredicatePushdown(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  return PushDownPredicates(plan, {});
+}
+
+auto Optimizer::PushDownPredicates(const AbstractPlanNodeRef &plan, std::vector<AbstractExpressionRef> predicates)
+    -> AbstractPlanNodeRef {
+  auto with_filter = [](AbstractPlanNodeRef child,
+                        const std::vector<AbstractExpressionRef> &conjuncts) -> AbstractPlanNodeRef {
+    if (conjuncts.empty()) {
+      return child;
+    }
+    auto output_schema = child->output_schema_;
+    return std::make_shared<FilterPlanNode>(std::move(output_schema), MakeConjunction(conjuncts), std::move(child));
+  };
+
+  switch (plan->GetType()) {
+    case PlanType::Filter: {
+      // 1.拆开过滤条件，和上层传下来的条件一起继续下推
+      const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*plan);
+      std::vector<AbstractExpressionRef> conjuncts;
+      SplitConjuncts(filter_plan.GetPredicate(), &conjuncts);
+      for (auto &conjunct : conjuncts) {
+        if (!IsPredicateTrue(*conjunct)) {
+          predicates.push_back(std::move(conjunct));
+        }
+      }
+      return PushDownPredicates(filter_plan.GetChildPlan(), std::move(predicates));
+    }
+    case PlanType::Projection: {
+      // 2.把条件里引用的输出列替换成投影表达式，穿过投影
+      const auto &projection_plan = dynamic_cast<const ProjectionPlanNode &>(*plan);
+      const auto &exprs = projection_plan.GetExpressions();
+      std::vector<AbstractExpressionRef> child_predicates;
+      for (const auto &predicate : predicates) {
+        child_predicates.push_back(RewriteColumns(predicate, [&](const ColumnValueExpression &col) {
+          return exprs[col.GetColIdx()];
+        }));
+      }
+      return plan->CloneWithChildren(
+          {PushDownPredicates(projection_plan.GetChildPlan(), std::move(child_predicates))});
+    }
+    case PlanType::Aggregation: {
+      // 3.只引用group by列的条件可以穿过聚合，其余的（例如HAVING中的聚合结果）留在聚合上方
+      const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*plan);
+      const auto &group_bys = agg_plan.GetGroupBys();
+      std::vector<AbstractExpressionRef> child_predicates;
+      std::vector<AbstractExpressionRef> remaining;
+      for (auto &predicate : predicates) {
+        if (!group_bys.empty() && AllColumns(*predicate, [&](const ColumnValueExpression &col) {
+              return col.GetColIdx() < group_bys.size();
+            })) {
+          child_predicates.push_back(RewriteColumns(predicate, [&](const ColumnValueExpression &col) {
+            return group_bys[col.GetColIdx()];
+          }));
+        } else {
+          remaining.push_back(std::move(predicate));
+        }
+      }
+      return with_filter(
+          plan->CloneWithChildren({PushDownPredicates(agg_plan.GetChildPlan(), std::move(child_predicates))}),
+          remaining);
+    }
+    case PlanType::Sort:
+    case PlanType::Distinct:
+      return plan->CloneWithChildren({PushDownPredicates(plan->GetChildAt(0), std::move(predicates))});
+    case PlanType::NestedLoopJoin: {
+      const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+      BUSTUB_ENSURE(nlj_plan.GetChildren().size() == 2, "NLJ should have exactly 2 children.");
+      const auto left_column_cnt = nlj_plan.GetLeftPlan()->OutputSchema().GetColumnCount();
+      const auto right_column_cnt = nlj_plan.GetRightPlan()->OutputSchema().GetColumnCount();
+
+      // 4.把连接条件改写成基于连接输出的列（tuple_idx都为0），和上层传下来的条件统一处理
+      std::vector<AbstractExpressionRef> join_conjuncts;
+      auto join_predicate =
+          RewriteColumns(nlj_plan.predicate_, [&](const ColumnValueExpression &col) -> AbstractExpressionRef {
+            auto col_idx = col.GetColIdx() + (col.GetTupleIdx() == 0 ? 0 : left_column_cnt);
+            return std::make_shared<ColumnValueExpression>(0, col_idx, col.GetReturnType());
+          });
+      SplitConjuncts(join_predicate, &join_conjuncts);
+      auto is_left_only = [&](const AbstractExpression &expr) {
+        return AllColumns(expr, [&](const ColumnValueExpression &col) { return col.GetColIdx() < left_column_cnt; });
+      };
+      auto is_right_only = [&](const AbstractExpression &expr) {
+        return AllColumns(expr, [&](const ColumnValueExpression &col) { return col.GetColIdx() >= left_column_cnt; });
+      };
+      auto to_right = [&](const AbstractExpressionRef &expr) {
+        return RewriteColumns(expr, [&](const ColumnValueExpression &col) -> AbstractExpressionRef {
+          return std::make_shared<ColumnValueExpression>(0, col.GetColIdx() - left_column_cnt, col.GetReturnType());
+        });
+      };
+
+      // 5.内连接：先通过等值连接条件推导出传递条件，然后只涉及一侧的条件下推到对应的一侧，其余的作为连接条件；
+      // 左外连接：上层的条件只有涉及左侧的可以下推，ON中只涉及右侧的条件可以下推到右侧，其余保持不动
+      std::vector<AbstractExpressionRef> left_predicates;
+      std::vector<AbstractExpressionRef> right_predicates;
+      std::vector<AbstractExpressionRef> join_predicates;
+      std::vector<AbstractExpressionRef> remaining;
+      if (nlj_plan.GetJoinType() == JoinType::INNER) {
+        auto conjuncts = std::move(predicates);
+        conjuncts.insert(conjuncts.end(), join_conjuncts.begin(), join_conjuncts.end());
+        DeriveTransitivePredicates(&conjuncts, left_column_cnt + right_column_cnt);
+        for (auto &conjunct : conjuncts) {
+          if (IsPredicateTrue(*conjunct)) {
+            continue;
+          }
+          auto left_only = is_left_only(*conjunct);
+          auto right_only = is_right_only(*conjunct);
+          if (left_only && !right_only) {
+            left_predicates.push_back(std::move(conjunct));
+          } else if (right_only && !left_only) {
+            right_predicates.push_back(to_right(conjunct));
+          } else {
+            join_predicates.push_back(std::move(conjunct));
+          }
+        }
+      } else if (nlj_plan.GetJoinType() == JoinType::LEFT) {
+        for (auto &predicate : predicates) {
+          (is_left_only(*predicate) && !is_right_only(*predicate) ? left_predicates : remaining)
+              .push_back(std::move(predicate));
+        }
+        for (auto &conjunct : join_conjuncts) {
+          if (IsPredicateTrue(*conjunct)) {
+            continue;
+          }
+          if (is_right_only(*conjunct) && !is_left_only(*conjunct)) {
+            right_predicates.push_back(to_right(conjunct));
+          } else {
+            join_predicates.push_back(std::move(conjunct));
+          }
+        }
+      } else if (nlj_plan.GetJoinType() == JoinType::SEMI || nlj_plan.GetJoinType() == JoinType::ANTI) {
+        // 半连接和反连接只输出左侧的列，上层的条件都可以下推到左侧；连接条件中只涉及右侧的条件下推到右侧
+        left_predicates = std::move(predicates);
+        for (auto &conjunct : join_conjuncts) {
+          if (IsPredicateTrue(*conjunct)) {
+            continue;
+          }
+          if (is_right_only(*conjunct) && !is_left_only(*conjunct)) {
+            right_predicates.push_back(to_right(conjunct));
+          } else {
+            join_predicates.push_back(std::move(conjunct));
+          }
+        }
+      } else {
+        remaining = std::move(predicates);
+        join_predicates = std::move(join_conjuncts);
+      }
+
+      auto left_plan = PushDownPredicates(nlj_plan.GetLeftPlan(), std::move(left_predicates));
+      auto right_plan = PushDownPredicates(nlj_plan.GetRightPlan(), std::move(right_predicates));
+      return with_filter(std::make_shared<NestedLoopJoinPlanNode>(
+                             nlj_plan.output_schema_, std::move(left_plan), std::move(right_plan),
+                             RewriteExpressionForJoin(MakeConjunction(join_predicates), left_column_cnt,
+                                                      right_column_cnt),
+                             nlj_plan.GetJoinType()),
+                         remaining);
+    }
+    default: {
+      // 6.其他算子（scan、limit、topN等）不能再继续下推，条件停在它的上方，之后由MergeFilterScan合并进scan
+      std::vector<AbstractPlanNodeRef> children;
+      for (const auto &child : plan->GetChildren()) {
+        children.emplace_back(PushDownPredicates(child, {}));
+      }
+      return with_filter(plan->CloneWithChildren(std::move(children)), predicates);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/parameter_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/optimizer_util.h"
+#include "type/limits.h"
+#include "type/type_id.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * A `<column> op <integer constant or parameter>` conjunct, normalized so that the column is on the left. `value_` is
+ * only set for constants, the value of a parameter is not known until the plan is executed.
+ */
+struct ColumnBound {
+  uint32_t col_idx_;
+  ComparisonType comp_type_;
+  AbstractExpressionRef bound_;
+  std::optional<int64_t> value_;
+};
+
+auto AsColumnBound(const AbstractExpression &expr) -> std::optional<ColumnBound> {
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr);
+  if (cmp_expr == nullptr || cmp_expr->comp_type_ == ComparisonType::NotEqual) {
+    return std::nullopt;
+  }
+  for (size_t i = 0; i < 2; i++) {
+    const auto *column = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(i).get());
+    const auto &bound = cmp_expr->GetChildAt(1 - i);
+    const auto *constant = dynamic_cast<const ConstantValueExpression *>(bound.get());
+    const auto *parameter = dynamic_cast<const ParameterValueExpression *>(bound.get());
+    if (column == nullptr || bound->GetReturnType() != TypeId::INTEGER) {
+      continue;
+    }
+    std::optional<int64_t> value;
+    if (constant != nullptr && !constant->val_.IsNull()) {
+      value = constant->val_.GetAs<int32_t>();
+    } else if (parameter == nullptr) {
+      continue;
+    }
+    auto comp_type = cmp_expr->comp_type_;
+    if (i == 1) {
+      // `c < col` is `col > c`
+      switch (comp_type) {
+        case ComparisonType::LessThan:
+          comp_type = ComparisonType::GreaterThan;
+          break;
+        case ComparisonType::LessThanOrEqual:
+          comp_type = ComparisonType::GreaterThanOrEqual;
+          break;
+        case ComparisonType::GreaterThan:
+          comp_type = ComparisonType::LessThan;
+          break;
+        case ComparisonType::GreaterThanOrEqual:
+          comp_type = ComparisonType::LessThanOrEqual;
+          break;
+        default:
+          break;
+      }
+    }
+    return ColumnBound{column->GetColIdx(), comp_type, bound, value};
+  }
+  return std::nullopt;
+}
+
+auto MakeIntegerConstant(int64_t value) -> AbstractExpressionRef {
+  return std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(static_cast<int32_t>(value)));
+}
+
+/** The key range of an index that covers some conjuncts of a scan filter. */
+struct IndexRange {
+  std::vector<AbstractExpressionRef> lower_;
+  std::vector<AbstractExpressionRef> upper_;
+  /** The conjuncts the range is built from */
+  std::vector<AbstractExpressionRef> covered_;
+  /** The conjuncts that still have to be checked on the scanned tuples */
+  std::vector<AbstractExpressionRef> remaining_;
+};
+
+/**
+ * Turn the conjuncts on the key columns of `index` into an inclusive key range: equalities on a prefix of the key
+ * columns, optionally followed by a range on the next key column. Key columns after that are unbounded.
+ *
+ * Bounds on constants are folded into a single range per column. A parameter can't be folded with other bounds
+ * before its value is known, so a parameter is only used if it is an equality, or if there are no constant bounds on
+ * the column; the conjuncts that are not used stay in the filter.
+ * @return the key range, or nullopt if the first key column is not restricted at all
+ */
+auto BuildIndexRange(const IndexInfo &index, const std::vector<AbstractExpressionRef> &conjuncts)
+    -> std::optional<IndexRange> {
+  const auto &key_attrs = index.index_->GetKeyAttrs();
+  for (const auto &column : index.key_schema_.GetColumns()) {
+    if (column.GetType() != TypeId::INTEGER) {
+      return std::nullopt;
+    }
+  }
+
+  // covered: the conjunct is used by the range; checked: the conjunct still has to be checked by the filter
+  std::vector<bool> covered(conjuncts.size(), false);
+  std::vector<bool> checked(conjuncts.size(), true);
+  IndexRange range;
+  for (auto key_attr : key_attrs) {
+    int64_t lo = BUSTUB_INT32_MIN;
+    int64_t hi = BUSTUB_INT32_MAX;
+    std::vector<size_t> constant_bounds;
+    std::optional<size_t> param_eq;
+    std::optional<size_t> param_lo;
+    std::optional<size_t> param_hi;
+    std::vector<std::optional<ColumnBound>> bounds(conjuncts.size());
+    for (size_t i = 0; i < conjuncts.size(); i++) {
+      bounds[i] = AsColumnBound(*conjuncts[i]);
+      if (!bounds[i].has_value() || bounds[i]->col_idx_ != key_attr) {
+        continue;
+      }
+      const auto &bound = *bounds[i];
+      if (!bound.value_.has_value()) {
+        auto *param = &param_lo;
+        if (bound.comp_type_ == ComparisonType::Equal) {
+          param = &param_eq;
+        } else if (bound.comp_type_ == ComparisonType::LessThan ||
+                   bound.comp_type_ == ComparisonType::LessThanOrEqual) {
+          param = &param_hi;
+        }
+        if (!param->has_value()) {
+          *param = i;
+        }
+        continue;
+      }
+      switch (bound.comp_type_) {
+        case ComparisonType::Equal:
+          lo = std::max(lo, *bound.value_);
+          hi = std::min(hi, *bound.value_);
+          break;
+        case ComparisonType::LessThan:
+          hi = std::min(hi, *bound.value_ - 1);
+          break;
+        case ComparisonType::LessThanOrEqual:
+          hi = std::min(hi, *bound.value_);
+          break;
+        case ComparisonType::GreaterThan:
+          lo = std::max(lo, *bound.value_ + 1);
+          break;
+        case ComparisonType::GreaterThanOrEqual:
+          lo = std::max(lo, *bound.value_);
+          break;
+        default:
+          continue;
+      }
+      constant_bounds.push_back(i);
+    }
+
+    if (param_eq.has_value()) {
+      // 1.参数等值条件，这一列是一个点，可以继续使用下一列
+      range.lower_.push_back(bounds[*param_eq]->bound_);
+      range.upper_.push_back(bounds[*param_eq]->bound_);
+      covered[*param_eq] = true;
+      checked[*param_eq] = false;
+      continue;
+    }
+    if (!constant_bounds.empty()) {
+      // 2.常量条件合并成一个范围
+      if (lo > hi) {
+        // Nothing can match, make sure the range stays empty after converting the bounds back to integers.
+        lo = BUSTUB_INT32_MAX;
+        hi = BUSTUB_INT32_MIN;
+      }
+      range.lower_.push_back(MakeIntegerConstant(lo));
+      range.upper_.push_back(MakeIntegerConstant(hi));
+      for (auto i : constant_bounds) {
+        covered[i] = true;
+        checked[i] = false;
+      }
+      // Only an equality allows the next key column to narrow the range further.
+      if (lo != hi) {
+        break;
+      }
+      continue;
+    }
+    if (param_lo.has_value() || param_hi.has_value()) {
+      // 3.参数范围条件，严格不等的条件作为闭区间的边界，但仍然需要由过滤条件检查
+      range.lower_.push_back(param_lo.has_value() ? bounds[*param_lo]->bound_ : MakeIntegerConstant(BUSTUB_INT32_MIN));
+      range.upper_.push_back(param_hi.has_value() ? bounds[*param_hi]->bound_ : MakeIntegerConstant(BUSTUB_INT32_MAX));
+      for (auto param : {param_lo, param_hi}) {
+        if (param.has_value()) {
+          covered[*param] = true;
+          auto comp_type = bounds[*param]->comp_type_;
+          checked[*param] = comp_type == ComparisonType::LessThan || comp_type == ComparisonType::GreaterThan;
+        }
+      }
+    }
+    break;
+  }
+  if (range.lower_.empty()) {
+    return std::nullopt;
+  }
+
+  while (range.lower_.size() < key_attrs.size()) {
+    range.lower_.push_back(MakeIntegerConstant(BUSTUB_INT32_MIN));
+    range.upper_.push_back(MakeIntegerConstant(BUSTUB_INT32_MAX));
+  }
+  for (size_t i = 0; i < conjuncts.size(); i++) {
+    if (covered[i]) {
+      range.covered_.push_back(conjuncts[i]);
+    }
+    if (checked[i]) {
+      range.remaining_.push_back(conjuncts[i]);
+    }
+  }
+  return range;
+}
+
+auto MakeFilterPredicate(const std::vector<AbstractExpressionRef> &conjuncts) -> AbstractExpressionRef {
+  return conjuncts.empty() ? nullptr : MakeConjunction(conjuncts);
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeSeqScanAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::SeqScan) {
+    const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*optimized_plan);
+    if (seq_scan.filter_predicate_ == nullptr) {
+      return optimized_plan;
+    }
+    std::vector<AbstractExpressionRef> conjuncts;
+    SplitConjuncts(seq_scan.filter_predicate_, &conjuncts);
+
+    // 1.对每个索引计算能够覆盖的key范围，选择估计选择率最低的那个。同一列上的上下界并不独立，
+    // 有统计信息（且边界都是常量）时用 P(lo<=x<=hi) = P(x>=lo) + P(x<=hi) - 1 估计，而不是把两者相乘
+    const auto *stats = catalog_.GetTable(seq_scan.table_name_)->stats_.get();
+    auto range_selectivity = [&](const std::vector<AbstractExpressionRef> &covered) {
+      std::vector<uint32_t> col_idxs;
+      for (const auto &conjunct : covered) {
+        col_idxs.push_back(AsColumnBound(*conjunct)->col_idx_);
+      }
+      std::sort(col_idxs.begin(), col_idxs.end());
+      col_idxs.erase(std::unique(col_idxs.begin(), col_idxs.end()), col_idxs.end());
+      double selectivity = 1.0;
+      for (auto col_idx : col_idxs) {
+        double sum = 0.0;
+        double product = 1.0;
+        size_t bound_cnt = 0;
+        bool all_constant = true;
+        for (const auto &conjunct : covered) {
+          auto bound = AsColumnBound(*conjunct);
+          if (bound->col_idx_ == col_idx) {
+            auto conjunct_selectivity = EstimatedSelectivity(seq_scan.table_name_, *conjunct);
+            sum += conjunct_selectivity;
+            product *= conjunct_selectivity;
+            bound_cnt++;
+            all_constant = all_constant && bound->value_.has_value();
+          }
+        }
+        selectivity *= all_constant && stats->GetColumnStatistics(col_idx) != nullptr
+                           ? std::max(0.0, sum - static_cast<double>(bound_cnt - 1))
+                           : product;
+      }
+      return selectivity;
+    };
+    const IndexInfo *best_index = nullptr;
+    std::optional<IndexRange> best_range;
+    double best_selectivity = 1.0;
+    for (const auto *index : catalog_.GetTableIndexes(seq_scan.table_name_)) {
+      auto range = BuildIndexRange(*index, conjuncts);
+      if (!range.has_value()) {
+        continue;
+      }
+      auto selectivity = range_selectivity(range->covered_);
+      if (best_index == nullptr || selectivity < best_selectivity) {
+        best_index = index;
+        best_range = std::move(range);
+        best_selectivity = selectivity;
+      }
+    }
+
+    // 2.范围太大时回表的随机访问比顺序扫描更慢，这种情况下保留顺序扫描
+    if (best_index == nullptr || best_selectivity > INDEX_SCAN_SELECTIVITY_THRESHOLD) {
+      return optimized_plan;
+    }
+    return std::make_shared<IndexScanPlanNode>(seq_scan.output_schema_, best_index->index_oid_,
+                                               MakeFilterPredicate(best_range->remaining_),
+                                               std::move(best_range->lower_), std::move(best_range->upper_));
+  }
+
+  if (optimized_plan->GetType() == PlanType::IndexScan) {
+    // 3.为了排序而选择的索引扫描（见OptimizeOrderByAsIndexScan）只需要把过滤条件转成key范围
+    const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*optimized_plan);
+    if (index_scan.filter_predicate_ == nullptr || !index_scan.lower_bound_.empty() ||
+        !index_scan.upper_bound_.empty()) {
+      return optimized_plan;
+    }
+    std::vector<AbstractExpressionRef> conjuncts;
+    SplitConjuncts(index_scan.filter_predicate_, &conjuncts);
+    auto range = BuildIndexRange(*catalog_.GetIndex(index_scan.GetIndexOid()), conjuncts);
+    if (!range.has_value()) {
+      return optimized_plan;
+    }
+    return std::make_shared<IndexScanPlanNode>(index_scan.output_schema_, index_scan.GetIndexOid(),
+                                               MakeFilterPredicate(range->remaining_), std::move(range->lower_),
+                                               std::move(range->upper_), index_scan.limit_);
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -1,5 +1,7 @@
+#include <limits>
 #include <memory>
 #include <vector>
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/sort_plan.h"
 #include "execution/plans/topn_plan.h"
@@ -21,14 +23,47 @@ auto Optimizer::OptimizeSortLimitAsTopN(const AbstractPlanNodeRef &plan) -> Abst
 
   // 3.判断当前节点的plan是否应用TopN优化
   // 这里尤其需要注意的是必须当前节点的PlanType为Limit，子节点的PlanType为Sort才能转化为TopN
+  // 只有OFFSET没有LIMIT的时候（limit是size_t的最大值）还是要全部排序，不转化
   if(plan->GetType() == PlanType::Limit && 
-      plan->GetChildren().size() == 1 && plan->GetChildAt(0)->GetType() == PlanType::Sort){
+      plan->GetChildren().size() == 1 && plan->GetChildAt(0)->GetType() == PlanType::Sort &&
+      dynamic_cast<const LimitPlanNode&>(*plan).GetLimit() != std::numeric_limits<size_t>::max()){
       BUSTUB_ENSURE(optimized_plan->GetChildren().size() == 1,"sort limit no possible !!!");
       const auto &child_plan = optimized_plan->GetChildren()[0];
       const auto &sort_plan = dynamic_cast<const SortPlanNode&>(*child_plan);
       const auto &limit_plan = dynamic_cast<const LimitPlanNode&>(*plan);
       return std::make_shared<TopNPlanNode>(plan->output_schema_,child_plan->GetChildAt(0),
-                  sort_plan.GetOrderBy(),limit_plan.GetLimit());
+                  sort_plan.GetOrderBy(),limit_plan.GetLimit(),limit_plan.GetOffset());
+  }
+
+  // 4.排序已经被OptimizeOrderByAsIndexScan换成了按索引顺序的扫描（或者本来就没有排序），
+  // 把limit+offset下推到索引扫描里，扫描出这么多满足条件的tuple之后就不再遍历索引。中间可以隔着不改变行数的投影
+  if(optimized_plan->GetType() == PlanType::Limit){
+      const auto &limit_plan = dynamic_cast<const LimitPlanNode&>(*optimized_plan);
+      if(limit_plan.GetLimit() > std::numeric_limits<size_t>::max() - limit_plan.GetOffset()){
+          return optimized_plan;
+      }
+      auto limit = limit_plan.GetLimit() + limit_plan.GetOffset();
+      std::vector<AbstractPlanNodeRef> projections;
+      auto child = limit_plan.GetChildPlan();
+      while(child->GetType() == PlanType::Projection){
+          projections.push_back(child);
+          child = child->GetChildAt(0);
+      }
+      if(child->GetType() != PlanType::IndexScan){
+          return optimized_plan;
+      }
+      const auto &index_scan = dynamic_cast<const IndexScanPlanNode&>(*child);
+      if(index_scan.limit_.has_value() && *index_scan.limit_ <= limit){
+          return optimized_plan;
+      }
+      AbstractPlanNodeRef new_child = std::make_shared<IndexScanPlanNode>(index_scan.output_schema_,
+                  index_scan.GetIndexOid(),index_scan.filter_predicate_,index_scan.lower_bound_,
+                  index_scan.upper_bound_,limit);
+      for(auto it = projections.rbegin(); it != projections.rend(); ++it){
+          new_child = (*it)->CloneWithChildren({new_child});
+      }
+      // offset还是要由limit跳过
+      return optimized_plan->CloneWithChildren({new_child});
   }
 
   return optimized_plan;
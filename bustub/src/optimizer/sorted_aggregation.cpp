@@ -0,0 +1,36 @@
+#include <memory>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeSortedAggregation(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeSortedAggregation(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Aggregation) {
+    return optimized_plan;
+  }
+  const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+  // Being sorted on the first of several group keys does not put the rows of a group together, only a single group
+  // key is handled.
+  if (agg_plan.GetGroupBys().size() != 1) {
+    return optimized_plan;
+  }
+  const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(agg_plan.GetGroupByAt(0).get());
+  if (column_value_expr == nullptr || !IsSortedOn(*agg_plan.GetChildPlan(), column_value_expr->GetColIdx())) {
+    return optimized_plan;
+  }
+  auto sorted_agg_plan = std::make_shared<AggregationPlanNode>(agg_plan);
+  sorted_agg_plan->sorted_input_ = true;
+  return sorted_agg_plan;
+}
+
+}  // namespace bustub
@@ -31,6 +31,12 @@ auto Planner::GetAggCallFromFactory(const std::string &func_name, std::vector<Ab
     if (func_name == "count") {
       return {AggregationType::CountAggregate, {std::move(expr)}};
     }
+    if (func_name == "count_distinct") {
+      return {AggregationType::CountDistinctAggregate, {std::move(expr)}};
+    }
+    if (func_name == "approx_count_distinct") {
+      return {AggregationType::ApproxCountDistinctAggregate, {std::move(expr)}};
+    }
   }
   throw Exception(fmt::format("unsupported agg_call {} with {} args", func_name, args.size()));
 }
@@ -26,8 +26,14 @@ namespace bustub {
 
 auto Planner::PlanAggCall(const BoundAggCall &agg_call, const std::vector<AbstractPlanNodeRef> &children)
     -> std::tuple<AggregationType, std::vector<AbstractExpressionRef>> {
+  auto func_name = agg_call.func_name_;
   if (agg_call.is_distinct_) {
-    throw NotImplementedException("distinct agg is not implemented yet");
+    // MIN / MAX are the same with or without DISTINCT.
+    if (func_name == "count") {
+      func_name = "count_distinct";
+    } else if (func_name != "min" && func_name != "max") {
+      throw NotImplementedException(fmt::format("{}(DISTINCT) is not supported", func_name));
+    }
   }
 
   std::vector<AbstractExpressionRef> exprs;
@@ -41,7 +47,7 @@ auto Planner::PlanAggCall(const BoundAggCall &agg_call, const std::vector<Abstra
     }
   }
 
-  return GetAggCallFromFactory(agg_call.func_name_, std::move(exprs));
+  return GetAggCallFromFactory(func_name, std::move(exprs));
 }
 
 // TODO(chi): clang-tidy on macOS will suggest changing it to const reference. Looks like a bug.
@@ -126,7 +132,8 @@ auto Planner::PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRe
     agg_types.push_back(agg_type);
     output_col_names.emplace_back(fmt::format("agg#{}", term_idx));
     ctx_.expr_in_agg_.emplace_back(
-        std::make_unique<ColumnValueExpression>(0, agg_begin_idx + term_idx, TypeId::INTEGER));
+        std::make_unique<ColumnValueExpression>(0, agg_begin_idx + term_idx,
+                                                AggregationPlanNode::InferAggReturnType(input_exprs.back(), agg_type)));
 
     term_idx += 1;
   }
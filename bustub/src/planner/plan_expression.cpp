@@ -7,6 +7,7 @@
 #include "binder/expressions/bound_binary_op.h"
 #include "binder/expressions/bound_column_ref.h"
 #include "binder/expressions/bound_constant.h"
+#include "binder/expressions/bound_parameter.h"
 #include "binder/expressions/bound_unary_op.h"
 #include "binder/statement/select_statement.h"
 #include "common/exception.h"
@@ -14,9 +15,11 @@
 #include "common/util/string_util.h"
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/parameter_value_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "fmt/format.h"
 #include "planner/planner.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
@@ -99,6 +102,18 @@ auto Planner::PlanConstant(const BoundConstant &expr, const std::vector<Abstract
   return std::make_shared<ConstantValueExpression>(expr.val_);
 }
 
+auto Planner::PlanParameter(const BoundParameter &expr, const std::vector<AbstractPlanNodeRef> &children)
+    -> AbstractExpressionRef {
+  if (expr.param_idx_ >= parameters_.size()) {
+    parameters_.resize(expr.param_idx_ + 1);
+  }
+  auto &slot = parameters_[expr.param_idx_];
+  if (slot == nullptr) {
+    slot = std::make_shared<Value>(ValueFactory::GetNullValueByType(expr.type_id_));
+  }
+  return std::make_shared<ParameterValueExpression>(expr.param_idx_, slot, expr.type_id_);
+}
+
 void Planner::AddAggCallToContext(BoundExpression &expr) {
   switch (expr.type_) {
     case ExpressionType::AGG_CALL: {
@@ -119,7 +134,8 @@ void Planner::AddAggCallToContext(BoundExpression &expr) {
       AddAggCallToContext(*binary_op_expr.rarg_);
       return;
     }
-    case ExpressionType::CONSTANT: {
+    case ExpressionType::CONSTANT:
+    case ExpressionType::PARAMETER: {
       return;
     }
     case ExpressionType::ALIAS: {
@@ -154,11 +170,21 @@ auto Planner::PlanExpression(const BoundExpression &expr, const std::vector<Abst
       const auto &constant_expr = dynamic_cast<const BoundConstant &>(expr);
       return std::make_tuple(UNNAMED_COLUMN, PlanConstant(constant_expr, children));
     }
+    case ExpressionType::PARAMETER: {
+      const auto &parameter_expr = dynamic_cast<const BoundParameter &>(expr);
+      return std::make_tuple(UNNAMED_COLUMN, PlanParameter(parameter_expr, children));
+    }
     case ExpressionType::ALIAS: {
       const auto &alias_expr = dynamic_cast<const BoundAlias &>(expr);
       auto [_1, expr] = PlanExpression(*alias_expr.child_, children);
       return std::make_tuple(alias_expr.alias_, std::move(expr));
     }
+    case ExpressionType::SUBQUERY: {
+      throw NotImplementedException("subquery is only supported as a conjunct of WHERE");
+    }
+    case ExpressionType::WINDOW: {
+      throw NotImplementedException("window function is only supported as an item of the select list");
+    }
     default:
       break;
   }
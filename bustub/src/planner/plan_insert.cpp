@@ -17,6 +17,7 @@
 #include "execution/plans/delete_plan.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/insert_plan.h"
+#include "execution/plans/projection_plan.h"
 #include "execution/plans/update_plan.h"
 #include "execution/plans/values_plan.h"
 #include "planner/planner.h"
@@ -29,11 +30,31 @@ auto Planner::PlanInsert(const InsertStatement &statement) -> AbstractPlanNodeRe
 
   const auto &table_schema = statement.table_->schema_.GetColumns();
   const auto &child_schema = select->OutputSchema().GetColumns();
+  // An exact decimal column also takes integers, they are converted when the rows are laid out for the table.
   if (!std::equal(table_schema.cbegin(), table_schema.cend(), child_schema.cbegin(), child_schema.cend(),
-                  [](auto &&col1, auto &&col2) { return col1.GetType() == col2.GetType(); })) {
+                  [](auto &&col1, auto &&col2) {
+                    return col1.GetType() == col2.GetType() ||
+                           (col1.GetType() == TypeId::FIXED_DECIMAL && col2.GetType() >= TypeId::TINYINT &&
+                            col2.GetType() <= TypeId::BIGINT);
+                  })) {
     throw bustub::Exception("table schema mismatch");
   }
 
+  // The insert stores the rows of its child as they are, so rows laid out differently from the table are converted by a
+  // projection first, e.g. a literal 0.125 into a decimal(10,2) column becomes 0.13 stored in 9 bytes.
+  if (!std::equal(table_schema.cbegin(), table_schema.cend(), child_schema.cbegin(), child_schema.cend(),
+                  [](auto &&col1, auto &&col2) {
+                    return col1.GetType() == col2.GetType() && col1.GetPrecision() == col2.GetPrecision() &&
+                           col1.GetScale() == col2.GetScale();
+                  })) {
+    std::vector<AbstractExpressionRef> exprs;
+    for (uint32_t idx = 0; idx < child_schema.size(); idx++) {
+      exprs.emplace_back(std::make_shared<ColumnValueExpression>(0, idx, child_schema[idx].GetType()));
+    }
+    select = std::make_shared<ProjectionPlanNode>(std::make_shared<Schema>(statement.table_->schema_), std::move(exprs),
+                                                  std::move(select));
+  }
+
   auto insert_schema = std::make_shared<Schema>(std::vector{Column("__bustub_internal.insert_rows", TypeId::INTEGER)});
 
   return std::make_shared<InsertPlanNode>(std::move(insert_schema), std::move(select), statement.table_->oid_);
@@ -1,3 +1,4 @@
+#include <limits>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -20,6 +21,7 @@
 #include "execution/expressions/column_value_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "execution/plans/aggregation_plan.h"
+#include "execution/plans/distinct_plan.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/projection_plan.h"
@@ -52,9 +54,7 @@ auto Planner::PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRe
   }
 
   if (!statement.where_->IsInvalid()) {
-    auto schema = plan->OutputSchema();
-    auto [_, expr] = PlanExpression(*statement.where_, {plan});
-    plan = std::make_shared<FilterPlanNode>(std::make_shared<Schema>(schema), std::move(expr), std::move(plan));
+    plan = PlanWhere(*statement.where_, std::move(plan));
   }
 
   bool has_agg = false;
@@ -65,7 +65,13 @@ auto Planner::PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRe
     }
   }
 
-  if (!statement.having_->IsInvalid() || !statement.group_by_.empty() || has_agg) {
+  if (HasWindowFunction(statement)) {
+    if (!statement.having_->IsInvalid() || !statement.group_by_.empty() || has_agg) {
+      throw NotImplementedException("window functions with aggregation are not supported");
+    }
+    // Plan window functions
+    plan = PlanSelectWindow(statement, std::move(plan));
+  } else if (!statement.having_->IsInvalid() || !statement.group_by_.empty() || has_agg) {
     // Plan aggregation
     plan = PlanSelectAgg(statement, std::move(plan));
   } else {
@@ -86,19 +92,9 @@ auto Planner::PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRe
                                                 std::move(exprs), std::move(plan));
   }
 
-  // Plan DISTINCT as group agg
+  // Plan DISTINCT
   if (statement.is_distinct_) {
-    auto child = std::move(plan);
-
-    std::vector<AbstractExpressionRef> distinct_exprs;
-    size_t col_idx = 0;
-    for (const auto &col : child->OutputSchema().GetColumns()) {
-      distinct_exprs.emplace_back(std::make_shared<ColumnValueExpression>(0, col_idx++, col.GetType()));
-    }
-
-    plan = std::make_shared<AggregationPlanNode>(std::make_shared<Schema>(child->OutputSchema()), child,
-                                                 std::move(distinct_exprs), std::vector<AbstractExpressionRef>{},
-                                                 std::vector<AggregationType>{});
+    plan = std::make_shared<DistinctPlanNode>(std::make_shared<Schema>(plan->OutputSchema()), std::move(plan));
   }
 
   // Plan ORDER BY
@@ -145,11 +141,9 @@ auto Planner::PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRe
       }
     }
 
-    if (offset != std::nullopt) {
-      throw NotImplementedException("OFFSET clause is not supported yet.");
-    }
-
-    plan = std::make_shared<LimitPlanNode>(std::make_shared<Schema>(plan->OutputSchema()), plan, *limit);
+    // OFFSET without LIMIT returns every row after the offset.
+    plan = std::make_shared<LimitPlanNode>(std::make_shared<Schema>(plan->OutputSchema()), plan,
+                                           limit.value_or(std::numeric_limits<size_t>::max()), offset.value_or(0));
   }
 
   return plan;
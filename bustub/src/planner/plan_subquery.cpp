@@ -0,0 +1,217 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_expression.h"
+#include "binder/bound_table_ref.h"
+#include "binder/expressions/bound_alias.h"
+#include "binder/expressions/bound_binary_op.h"
+#include "binder/expressions/bound_column_ref.h"
+#include "binder/expressions/bound_subquery.h"
+#include "binder/expressions/bound_unary_op.h"
+#include "binder/statement/select_statement.h"
+#include "binder/table_ref/bound_join_ref.h"
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "planner/planner.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Split a bound expression on `and` into its conjuncts. */
+void CollectConjuncts(const BoundExpression &expr, std::vector<const BoundExpression *> *conjuncts) {
+  if (expr.type_ == ExpressionType::BINARY_OP) {
+    const auto &binary_op_expr = dynamic_cast<const BoundBinaryOp &>(expr);
+    if (binary_op_expr.op_name_ == "and") {
+      CollectConjuncts(*binary_op_expr.larg_, conjuncts);
+      CollectConjuncts(*binary_op_expr.rarg_, conjuncts);
+      return;
+    }
+  }
+  conjuncts->push_back(&expr);
+}
+
+/** @return true if there is a subquery anywhere in the expression */
+auto HasSubquery(const BoundExpression &expr) -> bool {
+  switch (expr.type_) {
+    case ExpressionType::SUBQUERY:
+      return true;
+    case ExpressionType::BINARY_OP: {
+      const auto &binary_op_expr = dynamic_cast<const BoundBinaryOp &>(expr);
+      return HasSubquery(*binary_op_expr.larg_) || HasSubquery(*binary_op_expr.rarg_);
+    }
+    case ExpressionType::UNARY_OP:
+      return HasSubquery(*dynamic_cast<const BoundUnaryOp &>(expr).arg_);
+    case ExpressionType::ALIAS:
+      return HasSubquery(*dynamic_cast<const BoundAlias &>(expr).child_);
+    default:
+      return false;
+  }
+}
+
+/**
+ * @return true if all the columns referenced by the expression are in the schema. The inside of a nested subquery is
+ * not checked, only the left side of IN.
+ */
+auto ColumnsIn(const BoundExpression &expr, const Schema &schema) -> bool {
+  switch (expr.type_) {
+    case ExpressionType::COLUMN_REF:
+      return schema.TryGetColIdx(expr.ToString()).has_value();
+    case ExpressionType::BINARY_OP: {
+      const auto &binary_op_expr = dynamic_cast<const BoundBinaryOp &>(expr);
+      return ColumnsIn(*binary_op_expr.larg_, schema) && ColumnsIn(*binary_op_expr.rarg_, schema);
+    }
+    case ExpressionType::UNARY_OP:
+      return ColumnsIn(*dynamic_cast<const BoundUnaryOp &>(expr).arg_, schema);
+    case ExpressionType::ALIAS:
+      return ColumnsIn(*dynamic_cast<const BoundAlias &>(expr).child_, schema);
+    case ExpressionType::SUBQUERY: {
+      const auto &subquery_expr = dynamic_cast<const BoundSubqueryExpr &>(expr);
+      return subquery_expr.child_ == nullptr || ColumnsIn(*subquery_expr.child_, schema);
+    }
+    default:
+      return true;
+  }
+}
+
+/**
+ * @return the subquery if the conjunct is `[NOT] EXISTS (...)` or `x IN (...)`, nullptr otherwise. `is_anti` is set
+ * when the subquery is negated.
+ */
+auto AsSubqueryConjunct(const BoundExpression &expr, bool *is_anti) -> const BoundSubqueryExpr * {
+  *is_anti = false;
+  if (expr.type_ == ExpressionType::SUBQUERY) {
+    return &dynamic_cast<const BoundSubqueryExpr &>(expr);
+  }
+  if (expr.type_ == ExpressionType::UNARY_OP) {
+    const auto &unary_op_expr = dynamic_cast<const BoundUnaryOp &>(expr);
+    if (unary_op_expr.op_name_ == "not" && unary_op_expr.arg_->type_ == ExpressionType::SUBQUERY) {
+      const auto &subquery_expr = dynamic_cast<const BoundSubqueryExpr &>(*unary_op_expr.arg_);
+      if (subquery_expr.subquery_type_ == SubqueryType::IN) {
+        // `x NOT IN (...)` is NULL rather than true when the subquery returns a NULL, which an anti join can't express.
+        throw NotImplementedException("NOT IN subquery is not supported, use NOT EXISTS instead");
+      }
+      *is_anti = true;
+      return &subquery_expr;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+auto Planner::PlanWhere(const BoundExpression &where, AbstractPlanNodeRef child) -> AbstractPlanNodeRef {
+  if (!HasSubquery(where)) {
+    auto schema = child->OutputSchema();
+    auto [_, expr] = PlanExpression(where, {child});
+    return std::make_shared<FilterPlanNode>(std::make_shared<Schema>(schema), std::move(expr), std::move(child));
+  }
+  std::vector<const BoundExpression *> conjuncts;
+  CollectConjuncts(where, &conjuncts);
+  return PlanConjuncts(conjuncts, std::move(child));
+}
+
+auto Planner::PlanConjuncts(const std::vector<const BoundExpression *> &conjuncts, AbstractPlanNodeRef child)
+    -> AbstractPlanNodeRef {
+  // Subqueries become semi / anti joins with the child, the other conjuncts are evaluated by a filter on top of them.
+  // Predicate pushdown moves the filter below the joins later.
+  std::vector<const BoundExpression *> others;
+  for (const auto *conjunct : conjuncts) {
+    bool is_anti;
+    if (const auto *subquery_expr = AsSubqueryConjunct(*conjunct, &is_anti); subquery_expr != nullptr) {
+      child = PlanSubqueryJoin(*subquery_expr, is_anti, std::move(child));
+    } else {
+      others.push_back(conjunct);
+    }
+  }
+  if (others.empty()) {
+    return child;
+  }
+
+  AbstractExpressionRef predicate = nullptr;
+  for (const auto *conjunct : others) {
+    auto [_, expr] = PlanExpression(*conjunct, {child});
+    predicate = predicate == nullptr ? std::move(expr)
+                                     : GetBinaryExpressionFromFactory("and", std::move(predicate), std::move(expr));
+  }
+  auto schema = child->OutputSchema();
+  return std::make_shared<FilterPlanNode>(std::make_shared<Schema>(schema), std::move(predicate), std::move(child));
+}
+
+auto Planner::PlanSubqueryJoin(const BoundSubqueryExpr &expr, bool is_anti, AbstractPlanNodeRef left)
+    -> AbstractPlanNodeRef {
+  const auto &subquery = *expr.subquery_;
+  auto join_type = is_anti ? JoinType::ANTI : JoinType::SEMI;
+  auto output_schema = std::make_shared<Schema>(left->OutputSchema());
+
+  auto ctx_guard = NewContext();
+  if (!subquery.ctes_.empty()) {
+    ctx_.cte_list_ = &subquery.ctes_;
+  }
+
+  // A conjunct of the subquery's WHERE referencing a column not produced by its FROM is correlated with the outer query.
+  AbstractPlanNodeRef from = nullptr;
+  std::vector<const BoundExpression *> inner_conjuncts;
+  std::vector<const BoundExpression *> correlated_conjuncts;
+  if (subquery.table_->type_ != TableReferenceType::EMPTY && !subquery.where_->IsInvalid()) {
+    from = PlanTableRef(*subquery.table_);
+    std::vector<const BoundExpression *> conjuncts;
+    CollectConjuncts(*subquery.where_, &conjuncts);
+    for (const auto *conjunct : conjuncts) {
+      (ColumnsIn(*conjunct, from->OutputSchema()) ? inner_conjuncts : correlated_conjuncts).push_back(conjunct);
+    }
+  }
+
+  if (correlated_conjuncts.empty()) {
+    // Uncorrelated: the subquery is planned as usual, and its only column is compared with the left side of IN.
+    auto right = PlanSelect(subquery);
+    AbstractExpressionRef predicate = nullptr;
+    if (expr.subquery_type_ == SubqueryType::IN) {
+      auto [_, lhs] = PlanExpression(*expr.child_, {left});
+      auto rhs = std::make_shared<ColumnValueExpression>(1, 0, right->OutputSchema().GetColumn(0).GetType());
+      predicate = GetBinaryExpressionFromFactory("=", std::move(lhs), std::move(rhs));
+    } else {
+      predicate = std::make_shared<ConstantValueExpression>(ValueFactory::GetBooleanValue(true));
+    }
+    return std::make_shared<NestedLoopJoinPlanNode>(std::move(output_schema), std::move(left), std::move(right),
+                                                    std::move(predicate), join_type);
+  }
+
+  // Correlated: the correlated conjuncts become the join condition, so the subquery can't be planned on its own. Only
+  // the subqueries whose result doesn't depend on the rows grouped / limited together can be decorrelated this way.
+  bool has_agg = false;
+  for (const auto &item : subquery.select_list_) {
+    has_agg = has_agg || item->HasAggregation();
+  }
+  if (has_agg || !subquery.group_by_.empty() || !subquery.having_->IsInvalid() ||
+      !subquery.limit_count_->IsInvalid() || !subquery.limit_offset_->IsInvalid()) {
+    throw NotImplementedException("correlated subquery with aggregation or LIMIT is not supported");
+  }
+
+  auto right = PlanConjuncts(inner_conjuncts, std::move(from));
+  std::vector<AbstractPlanNodeRef> children = {left, right};
+  AbstractExpressionRef predicate = nullptr;
+  for (const auto *conjunct : correlated_conjuncts) {
+    auto [_, expr] = PlanExpression(*conjunct, children);
+    predicate = predicate == nullptr ? std::move(expr)
+                                     : GetBinaryExpressionFromFactory("and", std::move(predicate), std::move(expr));
+  }
+  if (expr.subquery_type_ == SubqueryType::IN) {
+    auto [_1, lhs] = PlanExpression(*expr.child_, children);
+    auto [_2, rhs] = PlanExpression(*subquery.select_list_[0], children);
+    predicate = GetBinaryExpressionFromFactory(
+        "and", std::move(predicate), GetBinaryExpressionFromFactory("=", std::move(lhs), std::move(rhs)));
+  }
+  return std::make_shared<NestedLoopJoinPlanNode>(std::move(output_schema), std::move(left), std::move(right),
+                                                  std::move(predicate), join_type);
+}
+
+}  // namespace bustub
@@ -0,0 +1,162 @@
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_expression.h"
+#include "binder/bound_order_by.h"
+#include "binder/expressions/bound_alias.h"
+#include "binder/expressions/bound_window.h"
+#include "binder/statement/select_statement.h"
+#include "binder/tokens.h"
+#include "common/exception.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/window_plan.h"
+#include "fmt/format.h"
+#include "fmt/ranges.h"
+#include "planner/planner.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** @return the window function of a select list item, `rank() over (...)` or `rank() over (...) as r` */
+static auto GetWindow(const BoundExpression &item) -> const BoundWindow * {
+  if (item.type_ == ExpressionType::WINDOW) {
+    return &dynamic_cast<const BoundWindow &>(item);
+  }
+  if (item.type_ == ExpressionType::ALIAS) {
+    const auto &alias = dynamic_cast<const BoundAlias &>(item);
+    if (alias.child_->type_ == ExpressionType::WINDOW) {
+      return &dynamic_cast<const BoundWindow &>(*alias.child_);
+    }
+  }
+  return nullptr;
+}
+
+auto Planner::HasWindowFunction(const SelectStatement &statement) -> bool {
+  for (const auto &item : statement.select_list_) {
+    if (GetWindow(*item) != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static auto GetWindowFunctionType(const std::string &func_name) -> WindowFunctionType {
+  if (func_name == "count_star") {
+    return WindowFunctionType::CountStarAggregate;
+  }
+  if (func_name == "count") {
+    return WindowFunctionType::CountAggregate;
+  }
+  if (func_name == "sum") {
+    return WindowFunctionType::SumAggregate;
+  }
+  if (func_name == "min") {
+    return WindowFunctionType::MinAggregate;
+  }
+  if (func_name == "max") {
+    return WindowFunctionType::MaxAggregate;
+  }
+  if (func_name == "row_number") {
+    return WindowFunctionType::RowNumber;
+  }
+  if (func_name == "rank") {
+    return WindowFunctionType::Rank;
+  }
+  if (func_name == "dense_rank") {
+    return WindowFunctionType::DenseRank;
+  }
+  throw Exception(fmt::format("unsupported window function {}", func_name));
+}
+
+/* NOLINTNEXTLINE */
+auto Planner::PlanSelectWindow(const SelectStatement &statement, AbstractPlanNodeRef child) -> AbstractPlanNodeRef {
+  /* A select list with window functions, e.g.
+   * ```
+   * select x, rank() over (partition by y order by z), sum(z) over (partition by y order by z) from t;
+   * ```
+   * is planned as
+   * ```
+   * WindowFunc columns=[x, rank, sum] partition_by=[y] order_by=[z]
+   *   Sort y, z
+   *     <Filter / Table Scan>
+   * ```
+   * The sort puts every partition in consecutive rows, ordered by the ORDER BY of the window, so that the window
+   * functions are computed in one pass over each partition. As there is only one sort, all the window functions must
+   * have the same PARTITION BY and ORDER BY.
+   */
+  std::vector<AbstractExpressionRef> columns;
+  std::vector<std::string> column_names;
+  std::unordered_map<uint32_t, WindowFunctionPlanNode::WindowFunction> window_functions;
+  std::vector<AbstractExpressionRef> partition_by;
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_by;
+  const BoundWindow *first_window = nullptr;
+
+  for (const auto &item : statement.select_list_) {
+    const auto *window = GetWindow(*item);
+    if (window == nullptr) {
+      auto [name, expr] = PlanExpression(*item, {child});
+      if (name == UNNAMED_COLUMN) {
+        name = fmt::format("__unnamed#{}", universal_id_++);
+      }
+      columns.emplace_back(std::move(expr));
+      column_names.emplace_back(std::move(name));
+      continue;
+    }
+    std::string name = item->type_ == ExpressionType::ALIAS ? dynamic_cast<const BoundAlias &>(*item).alias_
+                                                            : fmt::format("__unnamed#{}", universal_id_++);
+
+    if (first_window == nullptr) {
+      first_window = window;
+      for (const auto &expr : window->partition_by_) {
+        auto [_, partition_expr] = PlanExpression(*expr, {child});
+        partition_by.emplace_back(std::move(partition_expr));
+      }
+      for (const auto &item_order_by : window->order_bys_) {
+        auto [_, order_expr] = PlanExpression(*item_order_by->expr_, {child});
+        order_by.emplace_back(item_order_by->type_, std::move(order_expr));
+      }
+    } else if (fmt::format("{}", window->partition_by_) != fmt::format("{}", first_window->partition_by_) ||
+               fmt::format("{}", window->order_bys_) != fmt::format("{}", first_window->order_bys_)) {
+      throw NotImplementedException("window functions with different PARTITION BY or ORDER BY are not supported");
+    }
+
+    AbstractExpressionRef arg = std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(1));
+    if (!window->args_.empty()) {
+      auto [_, arg_expr] = PlanExpression(*window->args_[0], {child});
+      arg = std::move(arg_expr);
+    }
+    WindowFunctionPlanNode::WindowFunction function{std::move(arg), GetWindowFunctionType(window->func_name_),
+                                                    window->frame_};
+    // The column itself is filled by the executor, the placeholder only carries its type.
+    columns.emplace_back(
+        std::make_shared<ColumnValueExpression>(0, 0, WindowFunctionPlanNode::InferWindowReturnType(function)));
+    column_names.emplace_back(std::move(name));
+    window_functions.emplace(columns.size() - 1, std::move(function));
+  }
+
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> sort_keys;
+  for (const auto &expr : partition_by) {
+    sort_keys.emplace_back(OrderByType::ASC, expr);
+  }
+  sort_keys.insert(sort_keys.end(), order_by.begin(), order_by.end());
+  if (!sort_keys.empty()) {
+    child = std::make_shared<SortPlanNode>(std::make_shared<Schema>(child->OutputSchema()), std::move(child),
+                                           std::move(sort_keys));
+  }
+
+  auto schema = std::make_shared<Schema>(
+      ProjectionPlanNode::RenameSchema(ProjectionPlanNode::InferProjectionSchema(columns), column_names));
+  return std::make_shared<WindowFunctionPlanNode>(std::move(schema), std::move(child), std::move(columns),
+                                                  std::move(partition_by), std::move(order_by),
+                                                  std::move(window_functions));
+}
+
+}  // namespace bustub
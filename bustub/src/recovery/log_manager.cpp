@@ -12,6 +12,8 @@
 
 #include "recovery/log_manager.h"
 
+#include "common/metrics.h"
+
 namespace bustub {
 /*
  * set enable_logging = true
@@ -49,6 +51,10 @@ void LogManager::StopFlushThread() {}
  *  }
  *
  */
-auto LogManager::AppendLogRecord(LogRecord *log_record) -> lsn_t { return INVALID_LSN; }
+auto LogManager::AppendLogRecord(LogRecord *log_record) -> lsn_t {
+  static auto *appended = MetricsRegistry::Instance().GetCounter("log.records_appended");
+  appended->Add();
+  return INVALID_LSN;
+}
 
 }  // namespace bustub
@@ -12,14 +12,19 @@
 
 #include <sys/stat.h>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <iterator>
 #include <mutex>  // NOLINT
 #include <string>
 #include <thread>  // NOLINT
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/metrics.h"
 #include "storage/disk/disk_manager.h"
 
 namespace bustub {
@@ -37,6 +42,7 @@ DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
     return;
   }
   log_name_ = file_name_.substr(0, n) + ".log";
+  fsm_name_ = file_name_.substr(0, n) + ".fsm";
 
   log_io_.open(log_name_, std::ios::binary | std::ios::in | std::ios::app | std::ios::out);
   // directory or file does not exist
@@ -61,6 +67,35 @@ DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
     }
   }
   buffer_used = nullptr;
+
+  // Pages are allocated after the end of the file, or in its free pages.
+  auto file_size = GetFileSize(file_name_);
+  next_page_id_ = file_size <= 0 ? 0 : static_cast<page_id_t>((file_size + BUSTUB_PAGE_SIZE - 1) / BUSTUB_PAGE_SIZE);
+  LoadFreePages();
+}
+
+/**
+ * Read the free-page bitmap. A new database file has no free pages, whatever a leftover bitmap file says.
+ */
+void DiskManager::LoadFreePages() {
+  if (next_page_id_ == 0) {
+    std::remove(fsm_name_.c_str());
+    return;
+  }
+  fsm_io_.open(fsm_name_, std::ios::binary | std::ios::in | std::ios::out);
+  if (!fsm_io_.is_open()) {
+    fsm_io_.clear();
+    return;
+  }
+  char byte;
+  for (page_id_t page_id = 0; page_id < next_page_id_ && fsm_io_.get(byte); page_id += 8) {
+    for (page_id_t bit = 0; bit < 8 && page_id + bit < next_page_id_; bit++) {
+      if ((byte & (1 << bit)) != 0) {
+        free_pages_.insert(page_id + bit);
+      }
+    }
+  }
+  fsm_io_.clear();
 }
 
 /**
@@ -71,6 +106,10 @@ void DiskManager::ShutDown() {
     std::scoped_lock scoped_db_io_latch(db_io_latch_);
     db_io_.close();
   }
+  {
+    std::scoped_lock scoped_allocation_latch(allocation_latch_);
+    fsm_io_.close();
+  }
   log_io_.close();
 }
 
@@ -78,7 +117,9 @@ void DiskManager::ShutDown() {
  * Write the contents of the specified page into disk file
  */
 void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
+  static auto *write_latency = MetricsRegistry::Instance().GetHistogram("disk.page_write_latency");
   std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  ScopedMetricTimer timer(write_latency);
   size_t offset = static_cast<size_t>(page_id) * BUSTUB_PAGE_SIZE;
   // set write cursor to offset
   num_writes_ += 1;
@@ -97,7 +138,9 @@ void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
  * Read the contents of the specified page into the given memory area
  */
 void DiskManager::ReadPage(page_id_t page_id, char *page_data) {
+  static auto *read_latency = MetricsRegistry::Instance().GetHistogram("disk.page_read_latency");
   std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  ScopedMetricTimer timer(read_latency);
   int offset = page_id * BUSTUB_PAGE_SIZE;
   // check if read beyond file length
   if (offset > GetFileSize(file_name_)) {
@@ -127,6 +170,8 @@ void DiskManager::ReadPage(page_id_t page_id, char *page_data) {
  * Only return when sync is done, and only perform sequence write
  */
 void DiskManager::WriteLog(char *log_data, int size) {
+  static auto *flush_latency = MetricsRegistry::Instance().GetHistogram("log.flush_latency");
+  static auto *flushed_bytes = MetricsRegistry::Instance().GetCounter("log.flushed_bytes");
   // enforce swap log buffer
   assert(log_data != buffer_used);
   buffer_used = log_data;
@@ -143,6 +188,8 @@ void DiskManager::WriteLog(char *log_data, int size) {
   }
 
   num_flushes_ += 1;
+  flushed_bytes->Add(size);
+  ScopedMetricTimer timer(flush_latency);
   // sequence write
   log_io_.write(log_data, size);
 
@@ -184,6 +231,101 @@ auto DiskManager::ReadLog(char *log_data, int size, int offset) -> bool {
   return true;
 }
 
+/**
+ * Allocate the lowest free page, or a new page at the end of the file
+ */
+auto DiskManager::AllocatePage() -> page_id_t {
+  static auto *reused_pages = MetricsRegistry::Instance().GetCounter("disk.reused_pages");
+  std::scoped_lock scoped_allocation_latch(allocation_latch_);
+  if (free_pages_.empty()) {
+    return next_page_id_++;
+  }
+  auto page_id = *free_pages_.begin();
+  free_pages_.erase(free_pages_.begin());
+  WriteFreePageBit(page_id);
+  reused_pages->Add();
+  return page_id;
+}
+
+/**
+ * Record a page as free, it is reused by the next allocations
+ */
+void DiskManager::DeallocatePage(page_id_t page_id) {
+  static auto *freed_pages = MetricsRegistry::Instance().GetCounter("disk.freed_pages");
+  std::scoped_lock scoped_allocation_latch(allocation_latch_);
+  if (page_id < 0 || page_id >= next_page_id_ || !free_pages_.insert(page_id).second) {
+    return;
+  }
+  WriteFreePageBit(page_id);
+  freed_pages->Add();
+}
+
+/**
+ * Give the free pages at the end of the file back to the OS
+ */
+auto DiskManager::ShrinkFile() -> page_id_t {
+  std::scoped_lock scoped_allocation_latch(allocation_latch_);
+  page_id_t released = 0;
+  while (!free_pages_.empty() && *free_pages_.rbegin() == next_page_id_ - 1) {
+    free_pages_.erase(std::prev(free_pages_.end()));
+    WriteFreePageBit(--next_page_id_);
+    released++;
+  }
+  if (released == 0) {
+    return 0;
+  }
+
+  // Pages after next_page_id_ are not allocated, so nothing writes there: the file can be cut while it is in use.
+  std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  auto new_size = static_cast<std::uintmax_t>(next_page_id_) * BUSTUB_PAGE_SIZE;
+  db_io_.flush();
+  std::error_code ec;
+  if (static_cast<std::uintmax_t>(GetFileSize(file_name_)) > new_size) {
+    std::filesystem::resize_file(file_name_, new_size, ec);
+  }
+  if (fsm_io_.is_open()) {
+    fsm_io_.flush();
+    std::filesystem::resize_file(fsm_name_, (next_page_id_ + 7) / 8, ec);
+  }
+  if (ec) {
+    LOG_DEBUG("I/O error while truncating the db file: %s", ec.message().c_str());
+  }
+  return released;
+}
+
+/**
+ * Write the byte holding the bit of a page to the free-page bitmap file. Nothing is written for an in-memory database.
+ */
+void DiskManager::WriteFreePageBit(page_id_t page_id) {
+  if (fsm_name_.empty()) {
+    return;
+  }
+  if (!fsm_io_.is_open()) {
+    fsm_io_.open(fsm_name_, std::ios::binary | std::ios::trunc | std::ios::out | std::ios::in);
+    if (!fsm_io_.is_open()) {
+      throw Exception("can't open free-page bitmap file");
+    }
+  }
+  page_id_t first = page_id / 8 * 8;
+  char byte = 0;
+  for (page_id_t bit = 0; bit < 8; bit++) {
+    if (free_pages_.count(first + bit) != 0) {
+      byte = static_cast<char>(byte | (1 << bit));
+    }
+  }
+  fsm_io_.seekp(page_id / 8);
+  fsm_io_.put(byte);
+  fsm_io_.flush();
+}
+
+/**
+ * Returns the number of free pages
+ */
+auto DiskManager::GetNumFreePages() -> size_t {
+  std::scoped_lock scoped_allocation_latch(allocation_latch_);
+  return free_pages_.size();
+}
+
 /**
  * Returns number of flushes made so far
  */
@@ -199,6 +341,15 @@ auto DiskManager::GetNumWrites() const -> int { return num_writes_; }
  */
 auto DiskManager::GetFlushState() const -> bool { return flush_log_; }
 
+/**
+ * Returns the number of pages in the db file, 0 if it doesn't exist (e.g. DiskManagerMemory)
+ */
+auto DiskManager::GetNumPages() -> page_id_t {
+  std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  auto file_size = GetFileSize(file_name_);
+  return file_size <= 0 ? 0 : static_cast<page_id_t>((file_size + BUSTUB_PAGE_SIZE - 1) / BUSTUB_PAGE_SIZE);
+}
+
 /**
  * Private helper function to get disk file size
  */
@@ -735,6 +735,21 @@ auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE {
   Page* page = GetLeafPage(key,nullptr,Operation::SEARCH,true);
   auto leaf_page = reinterpret_cast<LeafPage*>(page->GetData());
   auto index = leaf_page->KeyIndex(key,comparator_);
+
+  // 4.如果key比叶子页中所有的key都大，则第一个不小于key的键值对在下一个叶子页的开头
+  if(index == leaf_page->GetSize() && leaf_page->GetNextPageId() != INVALID_PAGE_ID){
+    Page *next_page = buffer_pool_manager_->FetchPage(leaf_page->GetNextPageId());
+    if(next_page == nullptr){
+      page->RUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      throw Exception(ExceptionType::OUT_OF_MEMORY,std::string("can't fetch the page"));
+    }
+    next_page->RLatch();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page = next_page;
+    index = 0;
+  }
   return INDEXITERATOR_TYPE(buffer_pool_manager_,page->GetPageId(),page,index); 
 }
 
@@ -769,6 +784,22 @@ auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t {
   return root_page_id_; 
 }
 
+/*
+ * 从header page中读取这棵树记录的根页ID，用来在数据库重启之后重新打开已经存在的树
+ * @return: 如果header page中没有这棵树的记录，返回false，树保持为空
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::LoadRootPageId() -> bool {
+  auto *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(HEADER_PAGE_ID));
+  page_id_t root_page_id;
+  auto found = header_page->GetRootId(index_name_, &root_page_id);
+  buffer_pool_manager_->UnpinPage(HEADER_PAGE_ID, false);
+  if (found) {
+    root_page_id_ = root_page_id;
+  }
+  return found;
+}
+
 /*****************************************************************************
  * UTILITIES AND DEBUG
  *****************************************************************************/
@@ -785,7 +816,10 @@ void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
   auto *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(HEADER_PAGE_ID));
   if (insert_record != 0) {
     // create a new record<index_name + root_page_id> in header_page
-    header_page->InsertRecord(index_name_, root_page_id_);
+    // 树被删空之后再插入时记录已经存在了，这时只需要更新根页ID
+    if (!header_page->InsertRecord(index_name_, root_page_id_)) {
+      header_page->UpdateRecord(index_name_, root_page_id_);
+    }
   } else {
     // update root_page_id in header_page
     header_page->UpdateRecord(index_name_, root_page_id_);
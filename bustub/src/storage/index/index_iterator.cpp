@@ -30,9 +30,35 @@ INDEXITERATOR_TYPE::~IndexIterator(){
     }
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(IndexIterator &&other) noexcept
+    :buffer_pool_manager_(other.buffer_pool_manager_),page_(other.page_),page_id_(other.page_id_),index_(other.index_){
+    other.page_ = nullptr;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::operator=(IndexIterator &&other) noexcept -> IndexIterator & {
+    if(this != &other){
+        if(page_ != nullptr){
+            page_->RUnlatch();
+            buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+        }
+        buffer_pool_manager_ = other.buffer_pool_manager_;
+        page_ = other.page_;
+        page_id_ = other.page_id_;
+        index_ = other.index_;
+        other.page_ = nullptr;
+    }
+    return *this;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto INDEXITERATOR_TYPE::IsEnd() -> bool {
     // 如果leaf_page_的nextPageId不存在且当前已经遍历到叶子页的最后一个键值对的后面一个时，说明已经遍历完了
+    // 空树的迭代器没有对应的叶子页
+    if(page_ == nullptr){
+        return true;
+    }
     auto leaf_page = reinterpret_cast<LeafPage*>(page_->GetData());
     return leaf_page->GetSize() == index_ && leaf_page->GetNextPageId() == INVALID_PAGE_ID;
 }
@@ -155,6 +155,9 @@ auto TablePage::UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID
     }
     return false;
   }
+  // A forwarding RID or a moved tuple keeps its flag.
+  uint32_t flags = tuple_size & (FORWARD_FLAG | MOVED_FLAG);
+  tuple_size = GetTupleLength(tuple_size);
   // If there is not enuogh space to update, we need to update via delete followed by an insert (not enough space).
   if (GetFreeSpaceRemaining() + tuple_size < new_tuple.size_) {
     return false;
@@ -196,7 +199,7 @@ auto TablePage::UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID
           tuple_offset - free_space_pointer);
   SetFreeSpacePointer(free_space_pointer + tuple_size - new_tuple.size_);
   memcpy(GetData() + tuple_offset + tuple_size - new_tuple.size_, new_tuple.data_, new_tuple.size_);
-  SetTupleSize(slot_num, new_tuple.size_);
+  SetTupleSize(slot_num, new_tuple.size_ | flags);
 
   // Update all tuple offsets.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
@@ -208,17 +211,51 @@ auto TablePage::UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID
   return true;
 }
 
+auto TablePage::ForwardTuple(const RID &rid, const RID &forward_rid, Tuple *old_tuple, Transaction *txn,
+                             LockManager *lock_manager, LogManager *log_manager) -> bool {
+  // The forwarding RID is stored as the data of the slot.
+  char data[sizeof(page_id_t) + sizeof(uint32_t)];
+  page_id_t page_id = forward_rid.GetPageId();
+  uint32_t slot_num = forward_rid.GetSlotNum();
+  memcpy(data, &page_id, sizeof(page_id_t));
+  memcpy(data + sizeof(page_id_t), &slot_num, sizeof(uint32_t));
+  Tuple forward_tuple;
+  forward_tuple.size_ = sizeof(data);
+  forward_tuple.data_ = data;
+  bool is_updated = UpdateTuple(forward_tuple, old_tuple, rid, txn, lock_manager, log_manager);
+  if (is_updated) {
+    SetTupleSize(rid.GetSlotNum(), GetTupleSize(rid.GetSlotNum()) | FORWARD_FLAG);
+  }
+  return is_updated;
+}
+
+auto TablePage::GetForwardRid(const RID &rid, RID *forward_rid) -> bool {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (slot_num >= GetTupleCount() || (GetTupleSize(slot_num) & FORWARD_FLAG) == 0) {
+    return false;
+  }
+  page_id_t page_id;
+  uint32_t forward_slot_num;
+  const char *data = GetData() + GetTupleOffsetAtSlot(slot_num);
+  memcpy(&page_id, data, sizeof(page_id_t));
+  memcpy(&forward_slot_num, data + sizeof(page_id_t), sizeof(uint32_t));
+  forward_rid->Set(page_id, forward_slot_num);
+  return true;
+}
+
+void TablePage::MarkMoved(const RID &rid) {
+  BUSTUB_ASSERT(rid.GetSlotNum() < GetTupleCount(), "Cannot have more slots than tuples.");
+  SetTupleSize(rid.GetSlotNum(), GetTupleSize(rid.GetSlotNum()) | MOVED_FLAG);
+}
+
 void TablePage::ApplyDelete(const RID &rid, Transaction *txn, LogManager *log_manager) {
   uint32_t slot_num = rid.GetSlotNum();
   BUSTUB_ASSERT(slot_num < GetTupleCount(), "Cannot have more slots than tuples.");
 
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
   uint32_t tuple_size = GetTupleSize(slot_num);
-  // Check if this is a delete operation, i.e. commit a delete.
-  if (IsDeleted(tuple_size)) {
-    tuple_size = UnsetDeletedFlag(tuple_size);
-  }
-  // Otherwise we are rolling back an insert.
+  // Either this is a delete operation, i.e. commit a delete, or we are rolling back an insert.
+  tuple_size = GetTupleLength(tuple_size);
 
   // We need to copy out the deleted tuple for undo purposes.
   Tuple delete_tuple;
@@ -315,7 +352,7 @@ auto TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
 
   // At this point, we have at least a shared lock on the RID. Copy the tuple data into our result.
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
-  tuple->size_ = tuple_size;
+  tuple->size_ = GetTupleLength(tuple_size);
   if (tuple->allocated_) {
     delete[] tuple->data_;
   }
@@ -329,7 +366,7 @@ auto TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
 auto TablePage::GetFirstTupleRid(RID *first_rid) -> bool {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
-    if (!IsDeleted(GetTupleSize(i))) {
+    if (!IsDeleted(GetTupleSize(i)) && (GetTupleSize(i) & MOVED_FLAG) == 0) {
       first_rid->Set(GetTablePageId(), i);
       return true;
     }
@@ -342,7 +379,7 @@ auto TablePage::GetNextTupleRid(const RID &cur_rid, RID *next_rid) -> bool {
   BUSTUB_ASSERT(cur_rid.GetPageId() == GetTablePageId(), "Wrong table!");
   // Find and return the first valid tuple after our current slot number.
   for (auto i = cur_rid.GetSlotNum() + 1; i < GetTupleCount(); ++i) {
-    if (!IsDeleted(GetTupleSize(i))) {
+    if (!IsDeleted(GetTupleSize(i)) && (GetTupleSize(i) & MOVED_FLAG) == 0) {
       next_rid->Set(GetTablePageId(), i);
       return true;
     }
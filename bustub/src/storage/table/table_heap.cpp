@@ -42,8 +42,19 @@ auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> b
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
+  if (!PlaceTuple(tuple, rid, txn, false)) {
+    return false;
+  }
+  // Update the transaction's write set.
+  txn->GetWriteSet()->emplace_back(*rid, WType::INSERT, Tuple{}, this);
+  return true;
+}
 
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
+auto TableHeap::PlaceTuple(const Tuple &tuple, RID *rid, Transaction *txn, bool is_moved) -> bool {
+  // A moved tuple is placed from the page where the last one was, instead of walking the whole table every time.
+  page_id_t start_page_id = is_moved ? move_page_id_.load() : INVALID_PAGE_ID;
+  auto cur_page = static_cast<TablePage *>(
+      buffer_pool_manager_->FetchPage(start_page_id != INVALID_PAGE_ID ? start_page_id : first_page_id_));
   if (cur_page == nullptr) {
     txn->SetState(TransactionState::ABORTED);
     return false;
@@ -82,12 +93,15 @@ auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> b
       cur_page = new_page;
     }
   }
+  // A moved tuple must be flagged before the page is unlatched, or a scan could return it twice.
+  if (is_moved) {
+    cur_page->MarkMoved(*rid);
+    move_page_id_ = cur_page->GetTablePageId();
+  }
   // This line has caused most of us to double-take and "whoa double unlatch".
   // We are not, in fact, double unlatching. See the invariant above.
   cur_page->WUnlatch();
   buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
-  // Update the transaction's write set.
-  txn->GetWriteSet()->emplace_back(*rid, WType::INSERT, Tuple{}, this);
   return true;
 }
 
@@ -111,19 +125,38 @@ auto TableHeap::MarkDelete(const RID &rid, Transaction *txn) -> bool {
 }
 
 auto TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn) -> bool {
-  // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
-  // If the page could not be found, then abort the transaction.
-  if (page == nullptr) {
-    txn->SetState(TransactionState::ABORTED);
-    return false;
-  }
-  // Update the tuple; but first save the old value for rollbacks.
   Tuple old_tuple;
-  page->WLatch();
-  bool is_updated = page->UpdateTuple(tuple, &old_tuple, rid, txn, lock_manager_, log_manager_);
-  page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), is_updated);
+  RID cur_rid = rid;
+  bool is_updated = false;
+  bool is_full = false;
+  while (true) {
+    // Find the page which contains the tuple.
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(cur_rid.GetPageId()));
+    // If the page could not be found, then abort the transaction.
+    if (page == nullptr) {
+      txn->SetState(TransactionState::ABORTED);
+      return false;
+    }
+    page->WLatch();
+    // If the tuple was moved to another page, follow its slot and update it there.
+    RID forward_rid;
+    if (page->GetForwardRid(cur_rid, &forward_rid) && page->GetTuple(cur_rid, &old_tuple, txn, lock_manager_)) {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetTablePageId(), false);
+      cur_rid = forward_rid;
+      continue;
+    }
+    // Update the tuple; but first save the old value for rollbacks.
+    is_updated = page->UpdateTuple(tuple, &old_tuple, cur_rid, txn, lock_manager_, log_manager_);
+    // If the tuple exists but there is no room for the new value in its page, it has to be moved.
+    is_full = !is_updated && page->GetTuple(cur_rid, &old_tuple, txn, lock_manager_);
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetTablePageId(), is_updated);
+    break;
+  }
+  if (is_full) {
+    is_updated = MoveTuple(tuple, rid, cur_rid, txn);
+  }
   // Update the transaction's write set.
   if (is_updated && txn->GetState() != TransactionState::ABORTED) {
     txn->GetWriteSet()->emplace_back(rid, WType::UPDATE, old_tuple, this);
@@ -131,18 +164,54 @@ auto TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn
   return is_updated;
 }
 
+auto TableHeap::MoveTuple(const Tuple &tuple, const RID &rid, const RID &cur_rid, Transaction *txn) -> bool {
+  if (tuple.size_ + 32 > BUSTUB_PAGE_SIZE) {  // larger than one page size
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  // Store the new value on a page with enough space. It is flagged as moved, so scans skip it until the original slot
+  // forwards to it.
+  RID new_rid;
+  if (!PlaceTuple(tuple, &new_rid, txn, true)) {
+    return false;
+  }
+  // Forward the original slot to the new location, the RID in the indexes stays valid.
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
+  Tuple old_slot;
+  page->WLatch();
+  bool is_forwarded = page->ForwardTuple(rid, new_rid, &old_slot, txn, lock_manager_, log_manager_);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), is_forwarded);
+  if (!is_forwarded) {
+    ApplyDelete(new_rid, txn);
+    return false;
+  }
+  // The location the tuple was moved to before isn't referenced anymore.
+  if (!(cur_rid == rid)) {
+    ApplyDelete(cur_rid, txn);
+  }
+  return true;
+}
+
 void TableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
   // Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
   // Delete the tuple from the page.
   page->WLatch();
+  RID forward_rid;
+  bool is_forwarded = page->GetForwardRid(rid, &forward_rid);
   page->ApplyDelete(rid, txn, log_manager_);
   /** Commented out to make compatible with p4; This is called only on commit or delete, which consequently unlocks the
    * tuple; so should be fine */
   // lock_manager_->Unlock(txn, rid);
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  // The tuple was moved to another page, delete it there too.
+  if (is_forwarded) {
+    ApplyDelete(forward_rid, txn);
+  }
 }
 
 void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
@@ -167,8 +236,16 @@ auto TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn) -> bool
   // Read the tuple from the page.
   page->RLatch();
   bool res = page->GetTuple(rid, tuple, txn, lock_manager_);
+  RID forward_rid;
+  bool is_forwarded = res && page->GetForwardRid(rid, &forward_rid);
   page->RUnlatch();
   buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+  // The slot only holds the location the tuple was moved to, read it from there but keep its original RID.
+  if (is_forwarded) {
+    RID tuple_rid = rid;  // rid may refer to tuple->rid_, e.g. in TableIterator
+    res = GetTuple(forward_rid, tuple, txn);
+    tuple->rid_ = tuple_rid;
+  }
   return res;
 }
 
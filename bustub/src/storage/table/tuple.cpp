@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "storage/table/tuple.h"
@@ -55,6 +56,15 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true)
         len = 0;
       }
       offset += (len + sizeof(uint32_t));
+    } else if (col.GetType() == TypeId::FIXED_DECIMAL) {
+      // Convert to the precision and the scale of the column, the precision decides how many bytes the value takes.
+      auto fixed = FixedDecimalType::FromValue(values[i]);
+      if (col.GetPrecision() == 0) {
+        fixed = FixedDecimalType::Rescale(fixed, BUSTUB_FIXED_DECIMAL_MAX_PRECISION, FixedDecimalType::GetScale(fixed));
+      } else {
+        fixed = FixedDecimalType::Rescale(fixed, col.GetPrecision(), col.GetScale());
+      }
+      fixed.SerializeTo(data_ + col.GetOffset());
     } else {
       values[i].SerializeTo(data_ + col.GetOffset());
     }
@@ -95,6 +105,27 @@ auto Tuple::operator=(const Tuple &other) -> Tuple & {
   return *this;
 }
 
+Tuple::Tuple(Tuple &&other) noexcept
+    : allocated_(other.allocated_), rid_(other.rid_), size_(other.size_), data_(other.data_) {
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+}
+
+auto Tuple::operator=(Tuple &&other) noexcept -> Tuple & {
+  if (this == &other) {
+    return *this;
+  }
+  if (allocated_) {
+    delete[] data_;
+  }
+  allocated_ = std::exchange(other.allocated_, false);
+  rid_ = other.rid_;
+  size_ = std::exchange(other.size_, 0);
+  data_ = std::exchange(other.data_, nullptr);
+  return *this;
+}
+
 auto Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const -> Value {
   assert(schema);
   assert(data_);
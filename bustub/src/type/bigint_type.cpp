@@ -16,6 +16,7 @@
 #include <string>
 
 #include "type/bigint_type.h"
+#include "type/fixed_decimal_type.h"
 namespace bustub {
 #define BIGINT_COMPARE_FUNC(OP)                                           \
   switch (right.GetTypeId()) {                                            \
@@ -29,6 +30,8 @@ namespace bustub {
       return GetCmpBool(left.value_.bigint_ OP right.GetAs<int64_t>());   \
     case TypeId::DECIMAL:                                                 \
       return GetCmpBool(left.value_.bigint_ OP right.GetAs<double>());    \
+    case TypeId::FIXED_DECIMAL:                                           \
+      return GetCmpBool(0 OP FixedDecimalType::Compare(right, left));     \
     case TypeId::VARCHAR: {                                               \
       auto r_value = right.CastAs(TypeId::BIGINT);                        \
       return GetCmpBool(left.value_.bigint_ OP r_value.GetAs<int64_t>()); \
@@ -314,6 +317,8 @@ auto BigintType::CastAs(const Value &val, const TypeId type_id) const -> Value {
       return {type_id, static_cast<double>(val.GetAs<int64_t>())};
     }
 
+    case TypeId::FIXED_DECIMAL:
+      return FixedDecimalType::FromValue(val);
     case TypeId::VARCHAR: {
       if (val.IsNull()) {
         return {TypeId::VARCHAR, nullptr, 0, false};
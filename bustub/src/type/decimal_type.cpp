@@ -17,6 +17,7 @@
 
 #include "common/exception.h"
 #include "type/decimal_type.h"
+#include "type/fixed_decimal_type.h"
 
 namespace bustub {
 #define DECIMAL_COMPARE_FUNC(OP)                                          \
@@ -31,6 +32,8 @@ namespace bustub {
       return GetCmpBool(left.value_.decimal_ OP right.GetAs<int64_t>());  \
     case TypeId::DECIMAL:                                                 \
       return GetCmpBool(left.value_.decimal_ OP right.GetAs<double>());   \
+    case TypeId::FIXED_DECIMAL:                                           \
+      return GetCmpBool(0 OP FixedDecimalType::Compare(right, left));     \
     case TypeId::VARCHAR: {                                               \
       auto r_value = right.CastAs(TypeId::DECIMAL);                       \
       return GetCmpBool(left.value_.decimal_ OP r_value.GetAs<double>()); \
@@ -51,6 +54,10 @@ namespace bustub {
       return Value(TypeId::DECIMAL, left.value_.decimal_ OP right.GetAs<int64_t>());  \
     case TypeId::DECIMAL:                                                             \
       return Value(TypeId::DECIMAL, left.value_.decimal_ OP right.GetAs<double>());   \
+    case TypeId::FIXED_DECIMAL: {                                                     \
+      auto r_value = right.CastAs(TypeId::DECIMAL);                                   \
+      return Value(TypeId::DECIMAL, left.value_.decimal_ OP r_value.GetAs<double>()); \
+    }                                                                                 \
     case TypeId::VARCHAR: {                                                           \
       auto r_value = right.CastAs(TypeId::DECIMAL);                                   \
       return Value(TypeId::DECIMAL, left.value_.decimal_ OP r_value.GetAs<double>()); \
@@ -306,6 +313,8 @@ auto DecimalType::CastAs(const Value &val, const TypeId type_id) const -> Value
     }
     case TypeId::DECIMAL:
       return val.Copy();
+    case TypeId::FIXED_DECIMAL:
+      return FixedDecimalType::FromValue(val);
     case TypeId::VARCHAR: {
       if (val.IsNull()) {
         return {TypeId::VARCHAR, nullptr, 0, false};
@@ -0,0 +1,583 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// fixed_decimal_type.cpp
+//
+// Identification: src/type/fixed_decimal_type.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "common/exception.h"
+#include "type/fixed_decimal_type.h"
+
+namespace bustub {
+
+namespace {
+
+/** The header bit of a serialized value stored as an int128_t */
+constexpr uint8_t WIDE_FLAG = 0x80;
+
+auto OutOfRange() -> Exception { return Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range."); }
+
+auto Abs(int128_t v) -> int128_t { return v < 0 ? -v : v; }
+
+/** @return the number of digits of a non-negative value, 1 for zero */
+auto DigitCount(int128_t v) -> uint8_t {
+  uint8_t digits = 1;
+  while (digits < BUSTUB_FIXED_DECIMAL_MAX_PRECISION + 1 && v >= FixedDecimalType::PowerOfTen(digits)) {
+    digits++;
+  }
+  return digits;
+}
+
+/** @return false if v * 10^exp overflows, result is left untouched then */
+auto MultiplyPowerOfTen(int128_t v, uint32_t exp, int128_t *result) -> bool {
+  while (exp > BUSTUB_FIXED_DECIMAL_MAX_PRECISION) {
+    if (__builtin_mul_overflow(v, FixedDecimalType::PowerOfTen(BUSTUB_FIXED_DECIMAL_MAX_PRECISION), &v)) {
+      return false;
+    }
+    exp -= BUSTUB_FIXED_DECIMAL_MAX_PRECISION;
+  }
+  if (__builtin_mul_overflow(v, FixedDecimalType::PowerOfTen(exp), &v)) {
+    return false;
+  }
+  *result = v;
+  return true;
+}
+
+/** @return a / b rounded half away from zero */
+auto DivideRound(int128_t a, int128_t b) -> int128_t {
+  int128_t quotient = a / b;
+  int128_t remainder = Abs(a % b);
+  // remainder >= |b| - remainder is 2 * remainder >= |b| without the overflow
+  if (remainder >= Abs(b) - remainder) {
+    quotient += ((a < 0) == (b < 0)) ? 1 : -1;
+  }
+  return quotient;
+}
+
+/** @return the value with a precision wide enough for its digits, or throw if it has more than 38 digits */
+auto MakeValue(int128_t scaled, uint32_t precision, uint8_t scale) -> Value {
+  auto digits = DigitCount(Abs(scaled));
+  if (digits > BUSTUB_FIXED_DECIMAL_MAX_PRECISION) {
+    throw OutOfRange();
+  }
+  precision = std::max<uint32_t>({precision, digits, scale, 1});
+  precision = std::min<uint32_t>(precision, BUSTUB_FIXED_DECIMAL_MAX_PRECISION);
+  return {TypeId::FIXED_DECIMAL, scaled, static_cast<uint8_t>(precision), scale};
+}
+
+auto ToDouble(int128_t scaled, uint8_t scale) -> double {
+  return static_cast<double>(scaled) / std::pow(10.0, static_cast<double>(scale));
+}
+
+/** Bring two scaled values to the larger of their scales, @return false on an overflow */
+auto Align(int128_t *a, uint8_t a_scale, int128_t *b, uint8_t b_scale) -> bool {
+  if (a_scale < b_scale) {
+    return MultiplyPowerOfTen(*a, b_scale - a_scale, a);
+  }
+  return MultiplyPowerOfTen(*b, a_scale - b_scale, b);
+}
+
+}  // namespace
+
+#define FIXED_DECIMAL_COMPARE_FUNC(OP)                                   \
+  if (left.IsNull() || right.IsNull()) {                                 \
+    return CmpBool::CmpNull;                                             \
+  }                                                                      \
+  return GetCmpBool(FixedDecimalType::Compare(left, right) OP 0);  // NOLINT
+
+FixedDecimalType::FixedDecimalType() : NumericType(TypeId::FIXED_DECIMAL) {}
+
+auto FixedDecimalType::PowerOfTen(uint8_t exp) -> int128_t {
+  static const auto POWERS = [] {
+    std::array<int128_t, BUSTUB_FIXED_DECIMAL_MAX_PRECISION + 1> powers{};
+    powers[0] = 1;
+    for (size_t i = 1; i < powers.size(); i++) {
+      powers[i] = powers[i - 1] * 10;
+    }
+    return powers;
+  }();
+  assert(exp <= BUSTUB_FIXED_DECIMAL_MAX_PRECISION);
+  return POWERS[exp];
+}
+
+auto FixedDecimalType::GetScaled(const Value &val) -> int128_t {
+  int128_t scaled;
+  memcpy(&scaled, val.value_.fixed_decimal_, sizeof(int128_t));
+  return scaled;
+}
+
+auto FixedDecimalType::IsZero(const Value &val) const -> bool { return GetScaled(val) == 0; }
+
+auto FixedDecimalType::Unpack(const Value &val) -> std::pair<int128_t, uint8_t> {
+  switch (val.GetTypeId()) {
+    case TypeId::TINYINT:
+      return {val.GetAs<int8_t>(), 0};
+    case TypeId::SMALLINT:
+      return {val.GetAs<int16_t>(), 0};
+    case TypeId::INTEGER:
+      return {val.GetAs<int32_t>(), 0};
+    case TypeId::BIGINT:
+      return {val.GetAs<int64_t>(), 0};
+    case TypeId::FIXED_DECIMAL:
+      return {GetScaled(val), val.scale_};
+    default: {
+      auto fixed = FromValue(val);
+      return {GetScaled(fixed), fixed.scale_};
+    }
+  }
+}
+
+auto FixedDecimalType::Compare(const Value &left, const Value &right) -> int {
+  assert(left.GetTypeId() == TypeId::FIXED_DECIMAL);
+  if (right.GetTypeId() == TypeId::DECIMAL) {
+    double lhs = ToDouble(GetScaled(left), left.scale_);
+    double rhs = right.GetAs<double>();
+    return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+  }
+  int128_t lhs = GetScaled(left);
+  auto [rhs, rhs_scale] = Unpack(right);
+  if (!Align(&lhs, left.scale_, &rhs, rhs_scale)) {
+    // the side being scaled up is larger in magnitude than any value of the other side
+    int128_t larger = left.scale_ < rhs_scale ? lhs : -rhs;
+    return larger < 0 ? -1 : 1;
+  }
+  return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+}
+
+auto FixedDecimalType::Normalize(const Value &val) -> std::pair<int128_t, uint8_t> {
+  int128_t scaled = GetScaled(val);
+  uint8_t scale = val.scale_;
+  while (scale > 0 && scaled % 10 == 0) {
+    scaled /= 10;
+    scale--;
+  }
+  return {scaled, scale};
+}
+
+auto FixedDecimalType::Add(const Value &left, const Value &right) const -> Value {
+  assert(left.CheckComparable(right));
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  if (right.GetTypeId() == TypeId::DECIMAL) {
+    return {TypeId::DECIMAL, ToDouble(GetScaled(left), left.scale_) + right.GetAs<double>()};
+  }
+  int128_t lhs = GetScaled(left);
+  auto [rhs, rhs_scale] = Unpack(right);
+  int128_t result;
+  if (!Align(&lhs, left.scale_, &rhs, rhs_scale) || __builtin_add_overflow(lhs, rhs, &result)) {
+    throw OutOfRange();
+  }
+  uint8_t scale = std::max(left.scale_, rhs_scale);
+  return MakeValue(result, std::max(left.precision_ - left.scale_, DigitCount(Abs(rhs)) - scale) + scale + 1, scale);
+}
+
+auto FixedDecimalType::Subtract(const Value &left, const Value &right) const -> Value {
+  assert(left.CheckComparable(right));
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  if (right.GetTypeId() == TypeId::DECIMAL) {
+    return {TypeId::DECIMAL, ToDouble(GetScaled(left), left.scale_) - right.GetAs<double>()};
+  }
+  int128_t lhs = GetScaled(left);
+  auto [rhs, rhs_scale] = Unpack(right);
+  int128_t result;
+  if (!Align(&lhs, left.scale_, &rhs, rhs_scale) || __builtin_sub_overflow(lhs, rhs, &result)) {
+    throw OutOfRange();
+  }
+  uint8_t scale = std::max(left.scale_, rhs_scale);
+  return MakeValue(result, std::max(left.precision_ - left.scale_, DigitCount(Abs(rhs)) - scale) + scale + 1, scale);
+}
+
+auto FixedDecimalType::Multiply(const Value &left, const Value &right) const -> Value {
+  assert(left.CheckComparable(right));
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  if (right.GetTypeId() == TypeId::DECIMAL) {
+    return {TypeId::DECIMAL, ToDouble(GetScaled(left), left.scale_) * right.GetAs<double>()};
+  }
+  auto [rhs, rhs_scale] = Unpack(right);
+  int128_t result;
+  if (__builtin_mul_overflow(GetScaled(left), rhs, &result)) {
+    throw OutOfRange();
+  }
+  uint32_t scale = left.scale_ + rhs_scale;
+  if (scale > BUSTUB_FIXED_DECIMAL_MAX_PRECISION) {
+    result = DivideRound(result, PowerOfTen(scale - BUSTUB_FIXED_DECIMAL_MAX_PRECISION));
+    scale = BUSTUB_FIXED_DECIMAL_MAX_PRECISION;
+  }
+  return MakeValue(result, left.precision_ + DigitCount(Abs(rhs)), static_cast<uint8_t>(scale));
+}
+
+auto FixedDecimalType::Divide(const Value &left, const Value &right) const -> Value {
+  assert(left.CheckComparable(right));
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  if (right.IsZero()) {
+    throw Exception(ExceptionType::DIVIDE_BY_ZERO, "Division by zero on right-hand side");
+  }
+  if (right.GetTypeId() == TypeId::DECIMAL) {
+    return {TypeId::DECIMAL, ToDouble(GetScaled(left), left.scale_) / right.GetAs<double>()};
+  }
+  auto [rhs, rhs_scale] = Unpack(right);
+  // keep at least 6 digits after the decimal point, like 1 / 3 = 0.333333
+  uint8_t scale = std::max<uint8_t>({left.scale_, rhs_scale, 6});
+  int128_t lhs;
+  if (!MultiplyPowerOfTen(GetScaled(left), scale - left.scale_ + rhs_scale, &lhs)) {
+    throw OutOfRange();
+  }
+  return MakeValue(DivideRound(lhs, rhs), 0, scale);
+}
+
+auto FixedDecimalType::Modulo(const Value &left, const Value &right) const -> Value {
+  assert(left.CheckComparable(right));
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  if (right.IsZero()) {
+    throw Exception(ExceptionType::DIVIDE_BY_ZERO, "Division by zero on right-hand side");
+  }
+  if (right.GetTypeId() == TypeId::DECIMAL) {
+    return {TypeId::DECIMAL, ValMod(ToDouble(GetScaled(left), left.scale_), right.GetAs<double>())};
+  }
+  int128_t lhs = GetScaled(left);
+  auto [rhs, rhs_scale] = Unpack(right);
+  if (!Align(&lhs, left.scale_, &rhs, rhs_scale)) {
+    // one side is far larger than the other
+    if (left.scale_ < rhs_scale) {
+      throw OutOfRange();
+    }
+    return left.Copy();
+  }
+  return MakeValue(lhs % rhs, 0, std::max(left.scale_, rhs_scale));
+}
+
+auto FixedDecimalType::Min(const Value &left, const Value &right) const -> Value {
+  assert(left.CheckComparable(right));
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  if (Compare(left, right) <= 0) {
+    return left.Copy();
+  }
+  return right.Copy();
+}
+
+auto FixedDecimalType::Max(const Value &left, const Value &right) const -> Value {
+  assert(left.CheckComparable(right));
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  if (Compare(left, right) >= 0) {
+    return left.Copy();
+  }
+  return right.Copy();
+}
+
+auto FixedDecimalType::Sqrt(const Value &val) const -> Value {
+  if (val.IsNull()) {
+    return {TypeId::DECIMAL, BUSTUB_DECIMAL_NULL};
+  }
+  if (GetScaled(val) < 0) {
+    throw Exception(ExceptionType::DECIMAL, "Cannot take square root of a negative number.");
+  }
+  return {TypeId::DECIMAL, std::sqrt(ToDouble(GetScaled(val), val.scale_))};
+}
+
+auto FixedDecimalType::OperateNull(const Value &left __attribute__((unused)),
+                                   const Value &right __attribute__((unused))) const -> Value {
+  return {TypeId::FIXED_DECIMAL, BUSTUB_FIXED_DECIMAL_NULL, BUSTUB_FIXED_DECIMAL_MAX_PRECISION, 0};
+}
+
+auto FixedDecimalType::CompareEquals(const Value &left, const Value &right) const -> CmpBool {
+  assert(left.CheckComparable(right));
+  FIXED_DECIMAL_COMPARE_FUNC(==);
+}
+
+auto FixedDecimalType::CompareNotEquals(const Value &left, const Value &right) const -> CmpBool {
+  assert(left.CheckComparable(right));
+  FIXED_DECIMAL_COMPARE_FUNC(!=);
+}
+
+auto FixedDecimalType::CompareLessThan(const Value &left, const Value &right) const -> CmpBool {
+  assert(left.CheckComparable(right));
+  FIXED_DECIMAL_COMPARE_FUNC(<);
+}
+
+auto FixedDecimalType::CompareLessThanEquals(const Value &left, const Value &right) const -> CmpBool {
+  assert(left.CheckComparable(right));
+  FIXED_DECIMAL_COMPARE_FUNC(<=);
+}
+
+auto FixedDecimalType::CompareGreaterThan(const Value &left, const Value &right) const -> CmpBool {
+  assert(left.CheckComparable(right));
+  FIXED_DECIMAL_COMPARE_FUNC(>);
+}
+
+auto FixedDecimalType::CompareGreaterThanEquals(const Value &left, const Value &right) const -> CmpBool {
+  assert(left.CheckComparable(right));
+  FIXED_DECIMAL_COMPARE_FUNC(>=);
+}
+
+auto FixedDecimalType::CastAs(const Value &val, const TypeId type_id) const -> Value {
+  // the integer types round half away from zero
+  auto to_integer = [&val](int64_t min, int64_t max) -> int64_t {
+    int128_t rounded = DivideRound(GetScaled(val), PowerOfTen(val.scale_));
+    if (rounded > max || rounded < min) {
+      throw OutOfRange();
+    }
+    return static_cast<int64_t>(rounded);
+  };
+  switch (type_id) {
+    case TypeId::TINYINT: {
+      if (val.IsNull()) {
+        return {type_id, BUSTUB_INT8_NULL};
+      }
+      return {type_id, static_cast<int8_t>(to_integer(BUSTUB_INT8_MIN, BUSTUB_INT8_MAX))};
+    }
+    case TypeId::SMALLINT: {
+      if (val.IsNull()) {
+        return {type_id, BUSTUB_INT16_NULL};
+      }
+      return {type_id, static_cast<int16_t>(to_integer(BUSTUB_INT16_MIN, BUSTUB_INT16_MAX))};
+    }
+    case TypeId::INTEGER: {
+      if (val.IsNull()) {
+        return {type_id, BUSTUB_INT32_NULL};
+      }
+      return {type_id, static_cast<int32_t>(to_integer(BUSTUB_INT32_MIN, BUSTUB_INT32_MAX))};
+    }
+    case TypeId::BIGINT: {
+      if (val.IsNull()) {
+        return {type_id, BUSTUB_INT64_NULL};
+      }
+      return {type_id, to_integer(BUSTUB_INT64_MIN, BUSTUB_INT64_MAX)};
+    }
+    case TypeId::DECIMAL: {
+      if (val.IsNull()) {
+        return {type_id, BUSTUB_DECIMAL_NULL};
+      }
+      return {type_id, ToDouble(GetScaled(val), val.scale_)};
+    }
+    case TypeId::FIXED_DECIMAL:
+      return val.Copy();
+    case TypeId::VARCHAR: {
+      if (val.IsNull()) {
+        return {TypeId::VARCHAR, nullptr, 0, false};
+      }
+      return {TypeId::VARCHAR, val.ToString()};
+    }
+    default:
+      break;
+  }
+  throw Exception("FIXED_DECIMAL is not coercable to " + Type::TypeIdToString(type_id));
+}
+
+auto FixedDecimalType::ToString(const Value &val) const -> std::string {
+  if (val.IsNull()) {
+    return "fixed_decimal_null";
+  }
+  int128_t scaled = GetScaled(val);
+  int128_t magnitude = Abs(scaled);
+  std::string digits;
+  do {
+    digits.push_back(static_cast<char>('0' + static_cast<int>(magnitude % 10)));
+    magnitude /= 10;
+  } while (magnitude != 0);
+  // at least one digit before the decimal point
+  while (digits.size() <= val.scale_) {
+    digits.push_back('0');
+  }
+  std::reverse(digits.begin(), digits.end());
+  if (val.scale_ > 0) {
+    digits.insert(digits.end() - val.scale_, '.');
+  }
+  return scaled < 0 ? "-" + digits : digits;
+}
+
+void FixedDecimalType::SerializeTo(const Value &val, char *storage) const {
+  int128_t scaled = GetScaled(val);
+  if (val.precision_ <= BUSTUB_FIXED_DECIMAL_MAX_NARROW_PRECISION) {
+    int64_t narrow = val.IsNull() ? BUSTUB_INT64_NULL : static_cast<int64_t>(scaled);
+    assert(val.IsNull() || narrow == scaled);
+    storage[0] = static_cast<char>(val.scale_);
+    memcpy(storage + 1, &narrow, sizeof(int64_t));
+    return;
+  }
+  storage[0] = static_cast<char>(val.scale_ | WIDE_FLAG);
+  memcpy(storage + 1, &scaled, sizeof(int128_t));
+}
+
+// Deserialize a value of the given type from the given storage space.
+auto FixedDecimalType::DeserializeFrom(const char *storage) const -> Value {
+  auto header = static_cast<uint8_t>(storage[0]);
+  auto scale = static_cast<uint8_t>(header & ~WIDE_FLAG);
+  if ((header & WIDE_FLAG) == 0) {
+    int64_t narrow;
+    memcpy(&narrow, storage + 1, sizeof(int64_t));
+    int128_t scaled = narrow == BUSTUB_INT64_NULL ? BUSTUB_FIXED_DECIMAL_NULL : narrow;
+    return {type_id_, scaled, BUSTUB_FIXED_DECIMAL_MAX_NARROW_PRECISION, scale};
+  }
+  int128_t scaled;
+  memcpy(&scaled, storage + 1, sizeof(int128_t));
+  return {type_id_, scaled, BUSTUB_FIXED_DECIMAL_MAX_PRECISION, scale};
+}
+
+auto FixedDecimalType::Copy(const Value &val) const -> Value {
+  return {TypeId::FIXED_DECIMAL, GetScaled(val), val.precision_, val.scale_};
+}
+
+auto FixedDecimalType::FromString(const std::string &str) -> Value {
+  auto invalid = [&str]() { return Exception("Invalid input syntax for decimal: \'" + str + "\'"); };
+
+  // 1. The sign, the digits without the decimal point, and the exponent of the last digit.
+  size_t pos = 0;
+  auto skip_spaces = [&]() {
+    while (pos < str.size() && std::isspace(static_cast<unsigned char>(str[pos])) != 0) {
+      pos++;
+    }
+  };
+  skip_spaces();
+  bool negative = false;
+  if (pos < str.size() && (str[pos] == '-' || str[pos] == '+')) {
+    negative = str[pos++] == '-';
+  }
+  std::string digits;
+  int32_t exponent = 0;
+  bool seen_point = false;
+  bool seen_digit = false;
+  for (; pos < str.size(); pos++) {
+    char c = str[pos];
+    if (std::isdigit(static_cast<unsigned char>(c)) != 0) {
+      seen_digit = true;
+      // leading zeros are not significant
+      if (!digits.empty() || c != '0') {
+        digits.push_back(c);
+      }
+      if (seen_point) {
+        exponent--;
+      }
+    } else if (c == '.' && !seen_point) {
+      seen_point = true;
+    } else {
+      break;
+    }
+  }
+  if (!seen_digit) {
+    throw invalid();
+  }
+  if (pos < str.size() && (str[pos] == 'e' || str[pos] == 'E')) {
+    size_t end = 0;
+    int32_t power = 0;
+    try {
+      power = std::stoi(str.substr(pos + 1), &end);
+    } catch (std::exception &e) {
+      throw invalid();
+    }
+    if (end == 0 || power > 1000 || power < -1000) {
+      throw invalid();
+    }
+    exponent += power;
+    pos += end + 1;
+  }
+  skip_spaces();
+  if (pos != str.size()) {
+    throw invalid();
+  }
+
+  // 2. Round away the digits beyond the maximum scale.
+  bool round_up = false;
+  if (exponent < -BUSTUB_FIXED_DECIMAL_MAX_PRECISION) {
+    auto drop = static_cast<size_t>(-BUSTUB_FIXED_DECIMAL_MAX_PRECISION - exponent);
+    exponent = -BUSTUB_FIXED_DECIMAL_MAX_PRECISION;
+    if (drop <= digits.size()) {
+      round_up = digits[digits.size() - drop] >= '5';
+      digits.resize(digits.size() - drop);
+    } else {
+      digits.clear();
+    }
+  }
+  if (digits.size() > BUSTUB_FIXED_DECIMAL_MAX_PRECISION) {
+    throw OutOfRange();
+  }
+
+  // 3. The scaled value, an exponent above zero appends zeros.
+  int128_t scaled = 0;
+  for (char c : digits) {
+    scaled = scaled * 10 + (c - '0');
+  }
+  scaled += round_up ? 1 : 0;
+  uint8_t scale = 0;
+  if (exponent > 0) {
+    if (scaled != 0 && (exponent > BUSTUB_FIXED_DECIMAL_MAX_PRECISION ||
+                        !MultiplyPowerOfTen(scaled, static_cast<uint32_t>(exponent), &scaled))) {
+      throw OutOfRange();
+    }
+  } else {
+    scale = static_cast<uint8_t>(-exponent);
+  }
+  return MakeValue(negative ? -scaled : scaled, 0, scale);
+}
+
+auto FixedDecimalType::FromValue(const Value &val) -> Value {
+  if (val.IsNull()) {
+    return {TypeId::FIXED_DECIMAL, BUSTUB_FIXED_DECIMAL_NULL, BUSTUB_FIXED_DECIMAL_MAX_PRECISION, 0};
+  }
+  switch (val.GetTypeId()) {
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+      return MakeValue(Unpack(val).first, 0, 0);
+    case TypeId::DECIMAL: {
+      // the shortest string that reads back as the same double, so 0.1 becomes 0.1 and not 0.1000000000000000055...
+      auto d = val.GetAs<double>();
+      if (!std::isfinite(d)) {
+        throw OutOfRange();
+      }
+      return FromString(fmt::format("{}", d));
+    }
+    case TypeId::VARCHAR:
+      return FromString(val.ToString());
+    case TypeId::FIXED_DECIMAL:
+      return val.Copy();
+    default:
+      break;
+  }
+  throw Exception(Type::TypeIdToString(val.GetTypeId()) + " is not coercable to FIXED_DECIMAL.");
+}
+
+auto FixedDecimalType::Rescale(const Value &val, uint8_t precision, uint8_t scale) -> Value {
+  assert(val.GetTypeId() == TypeId::FIXED_DECIMAL);
+  if (val.IsNull()) {
+    return {TypeId::FIXED_DECIMAL, BUSTUB_FIXED_DECIMAL_NULL, precision, scale};
+  }
+  int128_t scaled = GetScaled(val);
+  if (scale >= val.scale_) {
+    if (!MultiplyPowerOfTen(scaled, scale - val.scale_, &scaled)) {
+      throw OutOfRange();
+    }
+  } else {
+    scaled = DivideRound(scaled, PowerOfTen(val.scale_ - scale));
+  }
+  if (DigitCount(Abs(scaled)) > precision) {
+    throw OutOfRange();
+  }
+  return {TypeId::FIXED_DECIMAL, scaled, precision, scale};
+}
+
+}  // namespace bustub
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <string>
 
+#include "type/fixed_decimal_type.h"
 #include "type/integer_type.h"
 
 namespace bustub {
@@ -30,6 +31,8 @@ namespace bustub {
       return GetCmpBool(left.value_.integer_ OP right.GetAs<int64_t>());   \
     case TypeId::DECIMAL:                                                  \
       return GetCmpBool(left.value_.integer_ OP right.GetAs<double>());    \
+    case TypeId::FIXED_DECIMAL:                                            \
+      return GetCmpBool(0 OP FixedDecimalType::Compare(right, left));      \
     case TypeId::VARCHAR: {                                                \
       auto r_value = right.CastAs(TypeId::INTEGER);                        \
       return GetCmpBool(left.value_.integer_ OP r_value.GetAs<int32_t>()); \
@@ -315,6 +318,8 @@ auto IntegerType::CastAs(const Value &val, const TypeId type_id) const -> Value
       }
       return {type_id, static_cast<double>(val.GetAs<int32_t>())};
     }
+    case TypeId::FIXED_DECIMAL:
+      return FixedDecimalType::FromValue(val);
     case TypeId::VARCHAR: {
       if (val.IsNull()) {
         return {TypeId::VARCHAR, nullptr, 0, false};
@@ -16,6 +16,7 @@
 #include <string>
 
 #include "common/exception.h"
+#include "type/fixed_decimal_type.h"
 #include "type/tinyint_type.h"
 
 namespace bustub {
@@ -31,6 +32,8 @@ namespace bustub {
       return GetCmpBool(left.value_.tinyint_ OP right.GetAs<int64_t>());  \
     case TypeId::DECIMAL:                                                 \
       return GetCmpBool(left.value_.tinyint_ OP right.GetAs<double>());   \
+    case TypeId::FIXED_DECIMAL:                                           \
+      return GetCmpBool(0 OP FixedDecimalType::Compare(right, left));     \
     case TypeId::VARCHAR: {                                               \
       auto r_value = right.CastAs(TypeId::TINYINT);                       \
       return GetCmpBool(left.value_.tinyint_ OP r_value.GetAs<int8_t>()); \
@@ -313,6 +316,8 @@ auto TinyintType::CastAs(const Value &val, const TypeId type_id) const -> Value
       }
       return {type_id, static_cast<double>(val.GetAs<int8_t>())};
     }
+    case TypeId::FIXED_DECIMAL:
+      return FixedDecimalType::FromValue(val);
     case TypeId::VARCHAR: {
       if (val.IsNull()) {
         return {TypeId::VARCHAR, nullptr, 0, false};
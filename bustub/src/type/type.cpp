@@ -15,8 +15,10 @@
 #include "type/bigint_type.h"
 #include "type/boolean_type.h"
 #include "type/decimal_type.h"
+#include "type/fixed_decimal_type.h"
 #include "type/integer_type.h"
 #include "type/smallint_type.h"
+#include "type/timestamp_type.h"
 #include "type/tinyint_type.h"
 #include "type/value.h"
 #include "type/varlen_type.h"
@@ -24,8 +26,9 @@
 namespace bustub {
 
 Type *Type::k_types[] = {
-    new Type(TypeId::INVALID),        new BooleanType(), new TinyintType(), new SmallintType(),
-    new IntegerType(TypeId::INTEGER), new BigintType(),  new DecimalType(), new VarlenType(TypeId::VARCHAR),
+    new Type(TypeId::INVALID),        new BooleanType(),     new TinyintType(),      new SmallintType(),
+    new IntegerType(TypeId::INTEGER), new BigintType(),      new DecimalType(),      new VarlenType(TypeId::VARCHAR),
+    new TimestampType(),              new FixedDecimalType(),
 };
 
 // Get the size of this data type in bytes
@@ -42,6 +45,9 @@ auto Type::GetTypeSize(const TypeId type_id) -> uint64_t {
     case DECIMAL:
     case TIMESTAMP:
       return 8;
+    case FIXED_DECIMAL:
+      // the size of the widest values, see FixedDecimalType::SerializedSize
+      return 17;
     case VARCHAR:
       return 0;
     default:
@@ -61,12 +67,14 @@ auto Type::IsCoercableFrom(const TypeId type_id) const -> bool {
     case INTEGER:
     case BIGINT:
     case DECIMAL:
+    case FIXED_DECIMAL:
       switch (type_id) {
         case TINYINT:
         case SMALLINT:
         case INTEGER:
         case BIGINT:
         case DECIMAL:
+        case FIXED_DECIMAL:
         case VARCHAR:
           return true;
         default:
@@ -83,6 +91,7 @@ auto Type::IsCoercableFrom(const TypeId type_id) const -> bool {
         case INTEGER:
         case BIGINT:
         case DECIMAL:
+        case FIXED_DECIMAL:
         case TIMESTAMP:
         case VARCHAR:
           return true;
@@ -113,6 +122,8 @@ auto Type::TypeIdToString(const TypeId type_id) -> std::string {
       return "DECIMAL";
     case TIMESTAMP:
       return "TIMESTAMP";
+    case FIXED_DECIMAL:
+      return "FIXED_DECIMAL";
     case VARCHAR:
       return "VARCHAR";
     default:
@@ -134,6 +145,9 @@ auto Type::GetMinValue(TypeId type_id) -> Value {
       return {type_id, BUSTUB_INT64_MIN};
     case DECIMAL:
       return {type_id, BUSTUB_DECIMAL_MIN};
+    case FIXED_DECIMAL:
+      return {type_id, 1 - FixedDecimalType::PowerOfTen(BUSTUB_FIXED_DECIMAL_MAX_PRECISION),
+              BUSTUB_FIXED_DECIMAL_MAX_PRECISION, 0};
     case TIMESTAMP:
       return {type_id, 0};
     case VARCHAR:
@@ -158,6 +172,9 @@ auto Type::GetMaxValue(TypeId type_id) -> Value {
       return {type_id, BUSTUB_INT64_MAX};
     case DECIMAL:
       return {type_id, BUSTUB_DECIMAL_MAX};
+    case FIXED_DECIMAL:
+      return {type_id, FixedDecimalType::PowerOfTen(BUSTUB_FIXED_DECIMAL_MAX_PRECISION) - 1,
+              BUSTUB_FIXED_DECIMAL_MAX_PRECISION, 0};
     case TIMESTAMP:
       return {type_id, BUSTUB_TIMESTAMP_MAX};
     case VARCHAR:
@@ -0,0 +1,370 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// type_kernel.cpp
+//
+// Identification: src/type/type_kernel.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include "common/exception.h"
+#include "type/fixed_decimal_type.h"
+#include "type/type_kernel.h"
+#include "type/type_util.h"
+
+namespace bustub {
+
+template <TypeId Left, TypeId Right, class Op>
+auto TypeKernels::CompareFixed(const Value &left, const Value &right) -> CmpBool {
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::CmpNull;
+  }
+  // the usual arithmetic conversions promote both sides like the type classes do
+  return GetCmpBool(Op{}(left.GetAs<typename TypeTraits<Left>::T>(), right.GetAs<typename TypeTraits<Right>::T>()));
+}
+
+template <class Op>
+auto TypeKernels::CompareVarchar(const Value &left, const Value &right) -> CmpBool {
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::CmpNull;
+  }
+  uint32_t len1 = left.size_.len_;
+  uint32_t len2 = right.size_.len_;
+  if (len1 == BUSTUB_VARCHAR_MAX_LEN || len2 == BUSTUB_VARCHAR_MAX_LEN) {
+    return GetCmpBool(Op{}(len1, len2));
+  }
+  return GetCmpBool(Op{}(TypeUtil::CompareStrings(left.GetVarlen(), len1 - 1, right.GetVarlen(), len2 - 1), 0));
+}
+
+template <TypeId Type>
+auto TypeKernels::AddFixed(const Value &left, const Value &right) -> Value {
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  using T = typename TypeTraits<Type>::T;
+  T result;
+  if constexpr (Type == TypeId::DECIMAL) {
+    result = left.GetAs<T>() + right.GetAs<T>();
+  } else if (__builtin_add_overflow(left.GetAs<T>(), right.GetAs<T>(), &result)) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+  }
+  return {Type, result};
+}
+
+template <TypeId Type>
+auto TypeKernels::SubtractFixed(const Value &left, const Value &right) -> Value {
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  using T = typename TypeTraits<Type>::T;
+  T result;
+  if constexpr (Type == TypeId::DECIMAL) {
+    result = left.GetAs<T>() - right.GetAs<T>();
+  } else if (__builtin_sub_overflow(left.GetAs<T>(), right.GetAs<T>(), &result)) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+  }
+  return {Type, result};
+}
+
+template <TypeId Type, class Op>
+auto TypeKernels::PickFixed(const Value &left, const Value &right) -> Value {
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  using T = typename TypeTraits<Type>::T;
+  return Op{}(left.GetAs<T>(), right.GetAs<T>()) ? left : right;
+}
+
+template <TypeId Type>
+auto TypeKernels::CompareFixedKeys(const char *left, const char *right) -> int {
+  using T = typename TypeTraits<Type>::T;
+  T lhs;
+  T rhs;
+  memcpy(&lhs, left, sizeof(T));
+  memcpy(&rhs, right, sizeof(T));
+  if (lhs == TypeTraits<Type>::NULL_VALUE || rhs == TypeTraits<Type>::NULL_VALUE) {
+    return 0;
+  }
+  return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+}
+
+auto TypeKernels::CompareVarcharKeys(const char *left, const char *right) -> int {
+  uint32_t len1;
+  uint32_t len2;
+  memcpy(&len1, left, sizeof(uint32_t));
+  memcpy(&len2, right, sizeof(uint32_t));
+  if (len1 == BUSTUB_VALUE_NULL || len2 == BUSTUB_VALUE_NULL) {
+    return 0;
+  }
+  if (len1 == BUSTUB_VARCHAR_MAX_LEN || len2 == BUSTUB_VARCHAR_MAX_LEN) {
+    return len1 < len2 ? -1 : (len2 < len1 ? 1 : 0);
+  }
+  return TypeUtil::CompareStrings(left + sizeof(uint32_t), len1 - 1, right + sizeof(uint32_t), len2 - 1);
+}
+
+template <class Op>
+auto TypeKernels::CompareFixedDecimal(const Value &left, const Value &right) -> CmpBool {
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::CmpNull;
+  }
+  // the scaled values of a column share its scale, the other cases align the scales first
+  if (left.scale_ == right.scale_) {
+    return GetCmpBool(Op{}(FixedDecimalType::GetScaled(left), FixedDecimalType::GetScaled(right)));
+  }
+  return GetCmpBool(Op{}(FixedDecimalType::Compare(left, right), 0));
+}
+
+template <bool Subtract>
+auto TypeKernels::AddFixedDecimal(const Value &left, const Value &right) -> Value {
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  if (left.scale_ != right.scale_) {
+    return Subtract ? left.Subtract(right) : left.Add(right);
+  }
+  int128_t result;
+  bool overflow = Subtract
+                      ? __builtin_sub_overflow(FixedDecimalType::GetScaled(left), FixedDecimalType::GetScaled(right), &result)
+                      : __builtin_add_overflow(FixedDecimalType::GetScaled(left), FixedDecimalType::GetScaled(right), &result);
+  int128_t limit = FixedDecimalType::PowerOfTen(BUSTUB_FIXED_DECIMAL_MAX_PRECISION);
+  if (overflow || result >= limit || result <= -limit) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+  }
+  // the sum of two values of precision p has at most p + 1 digits
+  auto precision = std::min<int>(BUSTUB_FIXED_DECIMAL_MAX_PRECISION, std::max(left.precision_, right.precision_) + 1);
+  return {TypeId::FIXED_DECIMAL, result, static_cast<uint8_t>(precision), left.scale_};
+}
+
+template <class Op>
+auto TypeKernels::PickFixedDecimal(const Value &left, const Value &right) -> Value {
+  if (left.IsNull() || right.IsNull()) {
+    return left.OperateNull(right);
+  }
+  // equal values may differ in scale (1.5 and 1.50), so a tie returns the left side like Value does
+  return Op{}(FixedDecimalType::Compare(left, right), 0) ? left : right;
+}
+
+auto TypeKernels::CompareFixedDecimalKeys(const char *left, const char *right) -> int {
+  auto lhs = Type::GetInstance(TypeId::FIXED_DECIMAL)->DeserializeFrom(left);
+  auto rhs = Type::GetInstance(TypeId::FIXED_DECIMAL)->DeserializeFrom(right);
+  if (lhs.IsNull() || rhs.IsNull()) {
+    return 0;
+  }
+  int cmp = FixedDecimalType::Compare(lhs, rhs);
+  return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+}
+
+auto TypeKernels::SumFixedDecimals(const int64_t *values, size_t count) -> int128_t {
+  // |value| < 10^18, so eight of them add up in an int64_t, and only the partial sums need 128 bits
+  constexpr size_t block = 8;
+  int128_t sum = 0;
+  size_t i = 0;
+  for (; i + block <= count; i += block) {
+    int64_t partial = 0;
+    for (size_t j = 0; j < block; j++) {
+      int64_t value = values[i + j];
+      partial += value & -static_cast<int64_t>(value != BUSTUB_INT64_NULL);
+    }
+    sum += partial;
+  }
+  for (; i < count; i++) {
+    sum += values[i] & -static_cast<int64_t>(values[i] != BUSTUB_INT64_NULL);
+  }
+  return sum;
+}
+
+auto TypeKernels::MinFixedDecimals(const int64_t *values, size_t count) -> int64_t {
+  int64_t min = BUSTUB_INT64_MAX;
+  for (size_t i = 0; i < count; i++) {
+    min = std::min(min, values[i] == BUSTUB_INT64_NULL ? BUSTUB_INT64_MAX : values[i]);
+  }
+  return min;
+}
+
+auto TypeKernels::MaxFixedDecimals(const int64_t *values, size_t count) -> int64_t {
+  // NULL is the smallest int64_t, so it never wins
+  int64_t max = BUSTUB_INT64_NULL;
+  for (size_t i = 0; i < count; i++) {
+    max = std::max(max, values[i]);
+  }
+  return max;
+}
+
+auto TypeKernels::CountFixedDecimals(const int64_t *values, size_t count) -> size_t {
+  size_t non_null = 0;
+  for (size_t i = 0; i < count; i++) {
+    non_null += static_cast<size_t>(values[i] != BUSTUB_INT64_NULL);
+  }
+  return non_null;
+}
+
+template <class Op>
+auto TypeKernels::SelectFixedDecimalsWith(const int64_t *values, size_t count, int64_t constant, uint32_t *selection)
+    -> size_t {
+  size_t selected = 0;
+  for (size_t i = 0; i < count; i++) {
+    // always write the position, and only keep it when the value qualifies
+    selection[selected] = static_cast<uint32_t>(i);
+    selected += static_cast<size_t>((values[i] != BUSTUB_INT64_NULL) & Op{}(values[i], constant));
+  }
+  return selected;
+}
+
+auto TypeKernels::SelectFixedDecimals(const int64_t *values, size_t count, CompareOp op, int64_t constant,
+                                      uint32_t *selection) -> size_t {
+  switch (op) {
+    case CompareOp::Equal:
+      return SelectFixedDecimalsWith<std::equal_to<>>(values, count, constant, selection);
+    case CompareOp::NotEqual:
+      return SelectFixedDecimalsWith<std::not_equal_to<>>(values, count, constant, selection);
+    case CompareOp::LessThan:
+      return SelectFixedDecimalsWith<std::less<>>(values, count, constant, selection);
+    case CompareOp::LessThanOrEqual:
+      return SelectFixedDecimalsWith<std::less_equal<>>(values, count, constant, selection);
+    case CompareOp::GreaterThan:
+      return SelectFixedDecimalsWith<std::greater<>>(values, count, constant, selection);
+    case CompareOp::GreaterThanOrEqual:
+      return SelectFixedDecimalsWith<std::greater_equal<>>(values, count, constant, selection);
+    default:
+      return 0;
+  }
+}
+
+template <TypeId Left, class Op>
+auto TypeKernels::SelectCompareRight(TypeId right) -> CompareKernel {
+  switch (right) {
+    case TypeId::TINYINT:
+      return &CompareFixed<Left, TypeId::TINYINT, Op>;
+    case TypeId::SMALLINT:
+      return &CompareFixed<Left, TypeId::SMALLINT, Op>;
+    case TypeId::INTEGER:
+      return &CompareFixed<Left, TypeId::INTEGER, Op>;
+    case TypeId::BIGINT:
+      return &CompareFixed<Left, TypeId::BIGINT, Op>;
+    case TypeId::DECIMAL:
+      return &CompareFixed<Left, TypeId::DECIMAL, Op>;
+    default:
+      // VARCHAR is cast to the type of the left side first
+      return nullptr;
+  }
+}
+
+template <class Op>
+auto TypeKernels::SelectCompare(TypeId left, TypeId right) -> CompareKernel {
+  switch (left) {
+    case TypeId::TINYINT:
+      return SelectCompareRight<TypeId::TINYINT, Op>(right);
+    case TypeId::SMALLINT:
+      return SelectCompareRight<TypeId::SMALLINT, Op>(right);
+    case TypeId::INTEGER:
+      return SelectCompareRight<TypeId::INTEGER, Op>(right);
+    case TypeId::BIGINT:
+      return SelectCompareRight<TypeId::BIGINT, Op>(right);
+    case TypeId::DECIMAL:
+      return SelectCompareRight<TypeId::DECIMAL, Op>(right);
+    case TypeId::BOOLEAN:
+      return right == TypeId::BOOLEAN ? &CompareFixed<TypeId::BOOLEAN, TypeId::BOOLEAN, Op> : nullptr;
+    case TypeId::VARCHAR:
+      return right == TypeId::VARCHAR ? &CompareVarchar<Op> : nullptr;
+    case TypeId::FIXED_DECIMAL:
+      return right == TypeId::FIXED_DECIMAL ? &CompareFixedDecimal<Op> : nullptr;
+    default:
+      return nullptr;
+  }
+}
+
+auto TypeKernels::GetCompareKernel(TypeId left, TypeId right, CompareOp op) -> CompareKernel {
+  switch (op) {
+    case CompareOp::Equal:
+      return SelectCompare<std::equal_to<>>(left, right);
+    case CompareOp::NotEqual:
+      return SelectCompare<std::not_equal_to<>>(left, right);
+    case CompareOp::LessThan:
+      return SelectCompare<std::less<>>(left, right);
+    case CompareOp::LessThanOrEqual:
+      return SelectCompare<std::less_equal<>>(left, right);
+    case CompareOp::GreaterThan:
+      return SelectCompare<std::greater<>>(left, right);
+    case CompareOp::GreaterThanOrEqual:
+      return SelectCompare<std::greater_equal<>>(left, right);
+    default:
+      return nullptr;
+  }
+}
+
+template <TypeId Type>
+auto TypeKernels::SelectArithmetic(ArithmeticOp op) -> ArithmeticKernel {
+  switch (op) {
+    case ArithmeticOp::Add:
+      return &AddFixed<Type>;
+    case ArithmeticOp::Subtract:
+      return &SubtractFixed<Type>;
+    case ArithmeticOp::Min:
+      // both sides have the same type, so which one is returned on a tie does not matter
+      return &PickFixed<Type, std::less<>>;
+    case ArithmeticOp::Max:
+      return &PickFixed<Type, std::greater_equal<>>;
+    default:
+      return nullptr;
+  }
+}
+
+auto TypeKernels::GetArithmeticKernel(TypeId type, ArithmeticOp op) -> ArithmeticKernel {
+  switch (type) {
+    case TypeId::TINYINT:
+      return SelectArithmetic<TypeId::TINYINT>(op);
+    case TypeId::SMALLINT:
+      return SelectArithmetic<TypeId::SMALLINT>(op);
+    case TypeId::INTEGER:
+      return SelectArithmetic<TypeId::INTEGER>(op);
+    case TypeId::BIGINT:
+      return SelectArithmetic<TypeId::BIGINT>(op);
+    case TypeId::DECIMAL:
+      return SelectArithmetic<TypeId::DECIMAL>(op);
+    case TypeId::FIXED_DECIMAL:
+      switch (op) {
+        case ArithmeticOp::Add:
+          return &AddFixedDecimal<false>;
+        case ArithmeticOp::Subtract:
+          return &AddFixedDecimal<true>;
+        case ArithmeticOp::Min:
+          return &PickFixedDecimal<std::less_equal<>>;
+        case ArithmeticOp::Max:
+          return &PickFixedDecimal<std::greater_equal<>>;
+        default:
+          return nullptr;
+      }
+    default:
+      return nullptr;
+  }
+}
+
+auto TypeKernels::GetKeyCompareKernel(TypeId type) -> KeyCompareKernel {
+  switch (type) {
+    case TypeId::BOOLEAN:
+      return &CompareFixedKeys<TypeId::BOOLEAN>;
+    case TypeId::TINYINT:
+      return &CompareFixedKeys<TypeId::TINYINT>;
+    case TypeId::SMALLINT:
+      return &CompareFixedKeys<TypeId::SMALLINT>;
+    case TypeId::INTEGER:
+      return &CompareFixedKeys<TypeId::INTEGER>;
+    case TypeId::BIGINT:
+      return &CompareFixedKeys<TypeId::BIGINT>;
+    case TypeId::DECIMAL:
+      return &CompareFixedKeys<TypeId::DECIMAL>;
+    case TypeId::VARCHAR:
+      return &CompareVarcharKeys;
+    case TypeId::FIXED_DECIMAL:
+      return &CompareFixedDecimalKeys;
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace bustub
@@ -22,25 +22,35 @@ Value::Value(const Value &other) {
   type_id_ = other.type_id_;
   size_ = other.size_;
   manage_data_ = other.manage_data_;
+  precision_ = other.precision_;
+  scale_ = other.scale_;
   value_ = other.value_;
   switch (type_id_) {
     case TypeId::VARCHAR:
       if (size_.len_ == BUSTUB_VALUE_NULL) {
         value_.varlen_ = nullptr;
-      } else {
-        if (manage_data_) {
-          value_.varlen_ = new char[size_.len_];
-          memcpy(value_.varlen_, other.value_.varlen_, size_.len_);
-        } else {
-          value_ = other.value_;
-        }
+      } else if (manage_data_ && !IsInlined()) {
+        value_.varlen_ = new char[size_.len_];
+        memcpy(value_.varlen_, other.value_.varlen_, size_.len_);
       }
       break;
     default:
-      value_ = other.value_;
+      break;
   }
 }
 
+Value::Value(Value &&other) noexcept
+    : value_(other.value_),
+      size_(other.size_),
+      manage_data_(other.manage_data_),
+      precision_(other.precision_),
+      scale_(other.scale_),
+      type_id_(other.type_id_) {
+  // the heap data now belongs to this value
+  other.manage_data_ = false;
+  other.size_.len_ = BUSTUB_VALUE_NULL;
+}
+
 auto Value::operator=(Value other) -> Value & {
   Swap(*this, other);
   return *this;
@@ -210,6 +220,21 @@ Value::Value(TypeId type, float f) : Value(type) {
   }
 }
 
+// FIXED_DECIMAL
+Value::Value(TypeId type, int128_t scaled, uint8_t precision, uint8_t scale) : Value(type) {
+  switch (type) {
+    case TypeId::FIXED_DECIMAL:
+      assert(precision <= BUSTUB_FIXED_DECIMAL_MAX_PRECISION && scale <= precision);
+      memcpy(value_.fixed_decimal_, &scaled, sizeof(int128_t));
+      precision_ = precision;
+      scale_ = scale;
+      size_.len_ = (scaled == BUSTUB_FIXED_DECIMAL_NULL ? BUSTUB_VALUE_NULL : 0);
+      break;
+    default:
+      throw Exception(ExceptionType::INCOMPATIBLE_TYPE, "Invalid Type for fixed decimal Value constructor");
+  }
+}
+
 // VARCHAR
 Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Value(type) {
   switch (type) {
@@ -221,10 +246,12 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Va
         manage_data_ = manage_data;
         if (manage_data_) {
           assert(len < BUSTUB_VARCHAR_MAX_LEN);
-          value_.varlen_ = new char[len];
-          assert(value_.varlen_ != nullptr);
           size_.len_ = len;
-          memcpy(value_.varlen_, data, len);
+          if (!IsInlined()) {
+            value_.varlen_ = new char[len];
+            assert(value_.varlen_ != nullptr);
+          }
+          memcpy(IsInlined() ? value_.inline_ : value_.varlen_, data, len);
         } else {
           // FUCK YOU GCC I do what I want.
           value_.const_varlen_ = data;
@@ -243,10 +270,12 @@ Value::Value(TypeId type, const std::string &data) : Value(type) {
       manage_data_ = true;
       // TODO(TAs): How to represent a null string here?
       uint32_t len = static_cast<uint32_t>(data.length()) + 1;
-      value_.varlen_ = new char[len];
-      assert(value_.varlen_ != nullptr);
       size_.len_ = len;
-      memcpy(value_.varlen_, data.c_str(), len);
+      if (!IsInlined()) {
+        value_.varlen_ = new char[len];
+        assert(value_.varlen_ != nullptr);
+      }
+      memcpy(IsInlined() ? value_.inline_ : value_.varlen_, data.c_str(), len);
       break;
     }
     default:
@@ -258,7 +287,7 @@ Value::Value(TypeId type, const std::string &data) : Value(type) {
 Value::~Value() {
   switch (type_id_) {
     case TypeId::VARCHAR:
-      if (manage_data_) {
+      if (manage_data_ && !IsInlined()) {
         delete[] value_.varlen_;
       }
       break;
@@ -276,12 +305,14 @@ auto Value::CheckComparable(const Value &o) const -> bool {
     case TypeId::INTEGER:
     case TypeId::BIGINT:
     case TypeId::DECIMAL:
+    case TypeId::FIXED_DECIMAL:
       switch (o.GetTypeId()) {
         case TypeId::TINYINT:
         case TypeId::SMALLINT:
         case TypeId::INTEGER:
         case TypeId::BIGINT:
         case TypeId::DECIMAL:
+        case TypeId::FIXED_DECIMAL:
         case TypeId::VARCHAR:
           return true;
         default:
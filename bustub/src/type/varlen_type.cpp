@@ -14,6 +14,7 @@
 #include <string>
 
 #include "common/exception.h"
+#include "type/fixed_decimal_type.h"
 #include "type/type_util.h"
 #include "type/varlen_type.h"
 
@@ -41,7 +42,7 @@ VarlenType::VarlenType(TypeId type) : Type(type) {}
 VarlenType::~VarlenType() = default;
 
 // Access the raw variable length data
-auto VarlenType::GetData(const Value &val) const -> const char * { return val.value_.varlen_; }
+auto VarlenType::GetData(const Value &val) const -> const char * { return val.GetVarlen(); }
 
 // Get the length of the variable length data (including the length field)
 auto VarlenType::GetLength(const Value &val) const -> uint32_t { return val.size_.len_; }
@@ -162,7 +163,7 @@ void VarlenType::SerializeTo(const Value &val, char *storage) const {
     return;
   }
   memcpy(storage, &len, sizeof(uint32_t));
-  memcpy(storage + sizeof(uint32_t), val.value_.varlen_, len);
+  memcpy(storage + sizeof(uint32_t), val.GetVarlen(), len);
 }
 
 // Deserialize a value of the given type from the given storage space.
@@ -257,6 +258,8 @@ auto VarlenType::CastAs(const Value &value, const TypeId type_id) const -> Value
       }
       return {type_id, res};
     }
+    case TypeId::FIXED_DECIMAL:
+      return FixedDecimalType::FromValue(value);
     case TypeId::VARCHAR:
       return value.Copy();
     default:
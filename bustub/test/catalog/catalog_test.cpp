@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -17,6 +20,7 @@
 #include "buffer/buffer_pool_manager_instance.h"
 #include "catalog/catalog.h"
 #include "catalog/table_generator.h"
+#include "common/bustub_instance.h"
 #include "execution/executor_context.h"
 #include "gtest/gtest.h"
 #include "type/value_factory.h"
@@ -688,4 +692,94 @@ TEST(CatalogTest, DISABLED_IndexInteraction3) {
   remove("catalog_test.log");
 }
 
+/** Run a statement and return its rows, one line per row with the cells separated by tabs */
+static auto RunSql(BustubInstance *bustub, const std::string &sql) -> std::string {
+  std::stringstream ss;
+  SimpleStreamWriter writer(ss, true);
+  bustub->ExecuteSql(sql, writer);
+  return ss.str();
+}
+
+TEST(CatalogTest, PersistentCatalog) {
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+  std::vector<std::string> bounds;
+  size_t mcv_cnt;
+  {
+    auto bustub = std::make_unique<BustubInstance>("catalog_test.db");
+    RunSql(bustub.get(), "create table t1(a int, b varchar(16));");
+    RunSql(bustub.get(), "insert into t1 values (1, 'one'), (2, 'two'), (3, 'three');");
+    RunSql(bustub.get(), "create index t1a on t1(a);");
+    RunSql(bustub.get(), "analyze t1;");
+    const auto *stats = bustub->catalog_->GetTable("t1")->stats_->GetColumnStatistics(1);
+    for (const auto &bound : stats->HistogramBounds()) {
+      bounds.push_back(bound.ToString());
+    }
+    mcv_cnt = stats->MostCommonValues().size();
+  }
+
+  auto bustub = std::make_unique<BustubInstance>("catalog_test.db");
+  auto *table_info = bustub->catalog_->GetTable("t1");
+  ASSERT_NE(Catalog::NULL_TABLE_INFO, table_info);
+  ASSERT_EQ(2, table_info->schema_.GetColumnCount());
+  EXPECT_EQ(TypeId::VARCHAR, table_info->schema_.GetColumn(1).GetType());
+  EXPECT_EQ(16, table_info->schema_.GetColumn(1).GetLength());
+  EXPECT_EQ(3, table_info->stats_->GetRowCount());
+
+  // The statistics of the last ANALYZE are restored
+  ASSERT_TRUE(table_info->stats_->IsAnalyzed());
+  EXPECT_DOUBLE_EQ(3, table_info->stats_->GetColumnStatistics(0)->DistinctCount());
+  const auto *stats = table_info->stats_->GetColumnStatistics(1);
+  EXPECT_EQ(mcv_cnt, stats->MostCommonValues().size());
+  ASSERT_EQ(bounds.size(), stats->HistogramBounds().size());
+  for (size_t i = 0; i < bounds.size(); i++) {
+    EXPECT_EQ(bounds[i], stats->HistogramBounds()[i].ToString());
+  }
+
+  // The rows of the table heap and the entries of the index are read in place
+  EXPECT_EQ("1\tone\t\n2\ttwo\t\n3\tthree\t\n", RunSql(bustub.get(), "select * from t1 order by a;"));
+  auto indexes = bustub->catalog_->GetTableIndexes("t1");
+  ASSERT_EQ(1, indexes.size());
+  EXPECT_EQ("t1a", indexes[0]->name_);
+  EXPECT_EQ("two\t\n", RunSql(bustub.get(), "select b from t1 where a = 2;"));
+
+  // New tables and indexes get new identifiers, and the index keeps being maintained
+  RunSql(bustub.get(), "insert into t1 values (4, 'four');");
+  EXPECT_EQ("four\t\n", RunSql(bustub.get(), "select b from t1 where a = 4;"));
+  RunSql(bustub.get(), "create table t2(c int);");
+  EXPECT_NE(table_info->oid_, bustub->catalog_->GetTable("t2")->oid_);
+
+  bustub.reset();
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
+TEST(CatalogTest, PersistentCatalogStartup) {
+  const size_t table_cnt = 1000;
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+  {
+    auto bustub = std::make_unique<BustubInstance>("catalog_test.db");
+    for (size_t i = 0; i < table_cnt; i++) {
+      RunSql(bustub.get(), fmt::format("create table t{}(a int, b varchar(32), c int);", i));
+    }
+  }
+
+  // Only the system tables are read at startup
+  auto start = std::chrono::steady_clock::now();
+  auto bustub = std::make_unique<BustubInstance>("catalog_test.db");
+  auto elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "startup with " << table_cnt << " tables: " << elapsed << " ms" << std::endl;
+
+  EXPECT_EQ(table_cnt, bustub->catalog_->GetTableNames().size());
+  auto *table_info = bustub->catalog_->GetTable(fmt::format("t{}", table_cnt - 1));
+  ASSERT_NE(Catalog::NULL_TABLE_INFO, table_info);
+  EXPECT_EQ(3, table_info->schema_.GetColumnCount());
+
+  bustub.reset();
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
 }  // namespace bustub
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_statistics_test.cpp
+//
+// Identification: test/catalog/table_statistics_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "catalog/catalog.h"
+#include "catalog/table_statistics.h"
+#include "common/util/hyperloglog.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+TEST(TableStatisticsTest, HyperLogLogTest) {
+  HyperLogLog hll;
+  for (int i = 0; i < 100000; i++) {
+    hll.AddValue(ValueFactory::GetIntegerValue(i % 20000));
+  }
+  EXPECT_NEAR(hll.Estimate(), 20000, 20000 * 0.05);
+
+  // Merging two sketches over disjoint halves gives the sketch of the union.
+  HyperLogLog left;
+  HyperLogLog right;
+  for (int i = 0; i < 50000; i++) {
+    left.AddValue(ValueFactory::GetIntegerValue(i));
+    right.AddValue(ValueFactory::GetIntegerValue(i + 50000));
+  }
+  left.Merge(right);
+  EXPECT_NEAR(left.Estimate(), 100000, 100000 * 0.05);
+}
+
+TEST(TableStatisticsTest, AnalyzeTest) {
+  auto disk_manager = std::make_unique<DiskManagerMemory>(1000);
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(64, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  Transaction txn(0);
+
+  std::vector<Column> columns{};
+  columns.emplace_back("a", TypeId::INTEGER);
+  columns.emplace_back("b", TypeId::INTEGER);
+  Schema schema{columns};
+  auto *table_info = catalog->CreateTable(&txn, "t", schema);
+  ASSERT_NE(Catalog::NULL_TABLE_INFO, table_info);
+
+  // a: 0..9999 uniform, b: 90% of the rows are 7, the rest NULL.
+  const int rows = 10000;
+  for (int i = 0; i < rows; i++) {
+    std::vector<Value> values{ValueFactory::GetIntegerValue(i),
+                              i % 10 == 0 ? ValueFactory::GetNullValueByType(TypeId::INTEGER)
+                                          : ValueFactory::GetIntegerValue(7)};
+    RID rid;
+    ASSERT_TRUE(table_info->table_->InsertTuple(Tuple{values, &schema}, &rid, &txn));
+  }
+
+  EXPECT_FALSE(table_info->stats_->IsAnalyzed());
+  auto *stats = catalog->AnalyzeTable(&txn, "t");
+  ASSERT_NE(nullptr, stats);
+  EXPECT_TRUE(stats->IsAnalyzed());
+  EXPECT_EQ(rows, stats->GetRowCount());
+
+  const auto *a = stats->GetColumnStatistics(0);
+  ASSERT_NE(nullptr, a);
+  EXPECT_DOUBLE_EQ(0, a->NullFraction());
+  EXPECT_NEAR(rows, a->DistinctCount(), rows * 0.05);
+  EXPECT_TRUE(a->MostCommonValues().empty());
+  EXPECT_NEAR(0.25, a->EstimateLessThanSelectivity(ValueFactory::GetIntegerValue(2500), false), 0.02);
+  EXPECT_NEAR(0.1,
+              a->EstimateRangeSelectivity(ValueFactory::GetIntegerValue(1000), true,
+                                          ValueFactory::GetIntegerValue(2000), false),
+              0.02);
+  EXPECT_NEAR(1.0 / rows, a->EstimateEqualSelectivity(ValueFactory::GetIntegerValue(42)), 1.0 / rows);
+
+  const auto *b = stats->GetColumnStatistics(1);
+  ASSERT_NE(nullptr, b);
+  EXPECT_NEAR(0.1, b->NullFraction(), 0.001);
+  EXPECT_NEAR(1, b->DistinctCount(), 0.5);
+  ASSERT_EQ(1, b->MostCommonValues().size());
+  EXPECT_NEAR(0.9, b->EstimateEqualSelectivity(ValueFactory::GetIntegerValue(7)), 0.01);
+  EXPECT_NEAR(0, b->EstimateEqualSelectivity(ValueFactory::GetIntegerValue(8)), 0.01);
+
+  // The row count follows inserts and deletes between two ANALYZE runs.
+  stats->UpdateRowCount(5);
+  stats->UpdateRowCount(-2);
+  EXPECT_EQ(rows + 3, stats->GetRowCount());
+}
+
+}  // namespace bustub
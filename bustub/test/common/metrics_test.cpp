@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// metrics_test.cpp
+//
+// Identification: test/common/metrics_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/metrics.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(MetricsTest, CounterSumsShards) {
+  MetricCounter counter;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&counter] {
+      for (int j = 0; j < 1000; j++) {
+        counter.Add();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(8000, counter.Get());
+
+  counter.Reset();
+  EXPECT_EQ(0, counter.Get());
+}
+
+TEST(MetricsTest, HistogramBuckets) {
+  // Small values have a bucket each, larger ones are known within 1/16.
+  for (uint64_t value : {0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 100ULL, 12345ULL, 1ULL << 40, ~0ULL}) {
+    auto bucket = MetricHistogram::BucketOf(value);
+    ASSERT_LT(bucket, MetricHistogram::NUM_BUCKETS);
+    EXPECT_GE(MetricHistogram::BucketUpperBound(bucket), value);
+    EXPECT_LE(MetricHistogram::BucketUpperBound(bucket) - value, value / 16);
+    if (bucket > 0) {
+      EXPECT_LT(MetricHistogram::BucketUpperBound(bucket - 1), value);
+    }
+  }
+}
+
+TEST(MetricsTest, HistogramPercentiles) {
+  MetricHistogram histogram;
+  EXPECT_EQ(0, histogram.Percentile(0.5));
+
+  for (uint64_t value = 1; value <= 1000; value++) {
+    histogram.Record(value * 1000);
+  }
+  EXPECT_EQ(1000, histogram.Count());
+  EXPECT_EQ(1000 * 1001 / 2 * 1000, histogram.Sum());
+  EXPECT_EQ(1000000, histogram.Max());
+  EXPECT_NEAR(500000, histogram.Percentile(0.5), 500000 / 16);
+  EXPECT_NEAR(990000, histogram.Percentile(0.99), 990000 / 16);
+  EXPECT_EQ(1000000, histogram.Percentile(1.0));
+
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.Count());
+  EXPECT_EQ(0, histogram.Max());
+}
+
+TEST(MetricsTest, RegistrySnapshot) {
+  auto &registry = MetricsRegistry::Instance();
+  auto *counter = registry.GetCounter("test.counter");
+  EXPECT_EQ(counter, registry.GetCounter("test.counter"));
+  counter->Add(3);
+  registry.GetHistogram("test.latency")->Record(2000);
+
+  bool found_counter = false;
+  bool found_histogram = false;
+  for (const auto &[name, value] : registry.Snapshot()) {
+    if (name == "test.counter") {
+      found_counter = true;
+      EXPECT_EQ("3", value);
+    }
+    if (name == "test.latency.count") {
+      found_histogram = true;
+      EXPECT_EQ("1", value);
+    }
+  }
+  EXPECT_TRUE(found_counter);
+  EXPECT_TRUE(found_histogram);
+  EXPECT_NE(std::string::npos, registry.SnapshotJson().find("\"test.counter\": 3"));
+}
+
+}  // namespace bustub
@@ -24,12 +24,14 @@ class DiskManagerTest : public ::testing::Test {
   void SetUp() override {
     remove("test.db");
     remove("test.log");
+    remove("test.fsm");
   }
 
   // This function is called after every test.
   void TearDown() override {
     remove("test.db");
     remove("test.log");
+    remove("test.fsm");
   };
 };
 
@@ -72,6 +74,58 @@ TEST_F(DiskManagerTest, ReadWriteLogTest) {
   dm.ShutDown();
 }
 
+// NOLINTNEXTLINE
+TEST_F(DiskManagerTest, ReuseFreePagesTest) {
+  char data[BUSTUB_PAGE_SIZE] = {0};
+  auto dm = DiskManager("test.db");
+  for (page_id_t i = 0; i < 8; i++) {
+    EXPECT_EQ(i, dm.AllocatePage());
+    dm.WritePage(i, data);
+  }
+
+  // The lowest free page is reused first, a page is freed once.
+  dm.DeallocatePage(5);
+  dm.DeallocatePage(2);
+  dm.DeallocatePage(2);
+  EXPECT_EQ(2, dm.GetNumFreePages());
+  EXPECT_EQ(2, dm.AllocatePage());
+  EXPECT_EQ(5, dm.AllocatePage());
+  EXPECT_EQ(8, dm.AllocatePage());
+  EXPECT_EQ(0, dm.GetNumFreePages());
+
+  dm.ShutDown();
+}
+
+// NOLINTNEXTLINE
+TEST_F(DiskManagerTest, ShrinkFileTest) {
+  char data[BUSTUB_PAGE_SIZE] = {0};
+  {
+    auto dm = DiskManager("test.db");
+    for (page_id_t i = 0; i < 10; i++) {
+      dm.WritePage(dm.AllocatePage(), data);
+    }
+    for (page_id_t i : {3, 7, 8, 9}) {
+      dm.DeallocatePage(i);
+    }
+    dm.ShutDown();
+  }
+
+  // The free pages are still known after a restart.
+  auto dm = DiskManager("test.db");
+  EXPECT_EQ(10, dm.GetNumPages());
+  EXPECT_EQ(4, dm.GetNumFreePages());
+
+  // Only the free pages at the end of the file can be released.
+  EXPECT_EQ(3, dm.ShrinkFile());
+  EXPECT_EQ(7, dm.GetNumPages());
+  EXPECT_EQ(1, dm.GetNumFreePages());
+  EXPECT_EQ(0, dm.ShrinkFile());
+  EXPECT_EQ(3, dm.AllocatePage());
+  EXPECT_EQ(7, dm.AllocatePage());
+
+  dm.ShutDown();
+}
+
 // NOLINTNEXTLINE
 TEST_F(DiskManagerTest, ThrowBadFileTest) { EXPECT_THROW(DiskManager("dev/null\\/foo/bar/baz/test.db"), Exception); }
 
@@ -21,6 +21,7 @@
 #include "logging/common.h"
 #include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 // NOLINTNEXTLINE
@@ -71,4 +72,76 @@ TEST(TupleTest, DISABLED_TableHeapTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(TupleTest, TableHeapMoveTest) {
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 300}}};
+  auto make_tuple = [&](int a, const std::string &b) {
+    return Tuple{std::vector<Value>{ValueFactory::GetIntegerValue(a), ValueFactory::GetVarcharValue(b)}, &schema};
+  };
+
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(50, disk_manager);
+  auto *lock_manager = new LockManager();
+  auto *log_manager = new LogManager(disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, log_manager, transaction);
+
+  const int tuple_cnt = 500;
+  std::vector<RID> rids;
+  for (int i = 0; i < tuple_cnt; ++i) {
+    RID rid;
+    ASSERT_TRUE(table->InsertTuple(make_tuple(i, "a"), &rid, transaction));
+    rids.push_back(rid);
+  }
+
+  // Every tuple grows beyond the free space of its page, is moved, then moved again, and keeps its RID.
+  const std::string long_value(200, 'x');
+  const std::string longer_value(250, 'y');
+  for (const auto &value : {long_value, std::string("b"), longer_value}) {
+    for (int i = 0; i < tuple_cnt; ++i) {
+      ASSERT_TRUE(table->UpdateTuple(make_tuple(i, value), rids[i], transaction));
+    }
+    for (int i = 0; i < tuple_cnt; ++i) {
+      Tuple tuple;
+      ASSERT_TRUE(table->GetTuple(rids[i], &tuple, transaction));
+      EXPECT_EQ(i, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+      EXPECT_EQ(value, tuple.GetValue(&schema, 1).ToString());
+      EXPECT_EQ(rids[i], tuple.GetRid());
+    }
+    // A scan returns every tuple once, under its original RID.
+    std::vector<int> values;
+    for (auto itr = table->Begin(transaction); itr != table->End(); ++itr) {
+      values.push_back(itr->GetValue(&schema, 0).GetAs<int32_t>());
+      EXPECT_EQ(rids[values.back()], itr->GetRid());
+    }
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(tuple_cnt, values.size());
+    for (int i = 0; i < tuple_cnt; ++i) {
+      EXPECT_EQ(i, values[i]);
+    }
+  }
+
+  // Deleting a moved tuple deletes it at its new location too.
+  for (int i = 0; i < tuple_cnt; i += 2) {
+    ASSERT_TRUE(table->MarkDelete(rids[i], transaction));
+    table->ApplyDelete(rids[i], transaction);
+  }
+  size_t cnt = 0;
+  for (auto itr = table->Begin(transaction); itr != table->End(); ++itr) {
+    EXPECT_EQ(1, itr->GetValue(&schema, 0).GetAs<int32_t>() % 2);
+    cnt++;
+  }
+  EXPECT_EQ(tuple_cnt / 2, cnt);
+
+  disk_manager->ShutDown();
+  remove("test.db");  // remove db file
+  remove("test.log");
+  delete table;
+  delete buffer_pool_manager;
+  delete log_manager;
+  delete lock_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
 }  // namespace bustub
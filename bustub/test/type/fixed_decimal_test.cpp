@@ -0,0 +1,300 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// fixed_decimal_test.cpp
+//
+// Identification: test/type/fixed_decimal_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "gtest/gtest.h"
+#include "storage/table/tuple.h"
+#include "type/fixed_decimal_type.h"
+#include "type/type_kernel.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+static auto Decimal(const std::string &str) -> Value { return ValueFactory::GetFixedDecimalValue(str); }
+
+// NOLINTNEXTLINE
+TEST(FixedDecimalTest, ParseTest) {
+  std::vector<std::pair<std::string, std::string>> cases = {
+      {"0", "0"},
+      {"0.00", "0.00"},
+      {"-12.50", "-12.50"},
+      {"+7", "7"},
+      {"0.001", "0.001"},
+      {"-0.001", "-0.001"},
+      {"1.5e3", "1500"},
+      {"15e-3", "0.015"},
+      {"123456789012345678901234567890.12345678", "123456789012345678901234567890.12345678"},
+      {"99999999999999999999999999999999999999", "99999999999999999999999999999999999999"},
+  };
+  for (const auto &[str, expected] : cases) {
+    EXPECT_EQ(expected, Decimal(str).ToString()) << str;
+  }
+  for (const auto *str : {"", "-", "abc", "1.2.3", "1e", "999999999999999999999999999999999999999"}) {
+    EXPECT_THROW(Decimal(str), Exception) << str;
+  }
+}
+
+/** Check the arithmetic against the same computation on the scaled integers */
+// NOLINTNEXTLINE
+TEST(FixedDecimalTest, ArithmeticTest) {
+  std::mt19937_64 gen(15445);
+  std::uniform_int_distribution<int64_t> dis(-1000000000, 1000000000);
+  for (int i = 0; i < 1000; i++) {
+    // a has a scale of 2 and b a scale of 3
+    int64_t a = dis(gen);
+    int64_t b = dis(gen);
+    auto left = ValueFactory::GetFixedDecimalValue(a, 12, 2);
+    auto right = ValueFactory::GetFixedDecimalValue(b, 13, 3);
+
+    auto sum = left.Add(right);
+    EXPECT_EQ(3, FixedDecimalType::GetScale(sum));
+    EXPECT_TRUE(FixedDecimalType::GetScaled(sum) == static_cast<int128_t>(a) * 10 + b);
+
+    auto difference = left.Subtract(right);
+    EXPECT_TRUE(FixedDecimalType::GetScaled(difference) == static_cast<int128_t>(a) * 10 - b);
+
+    auto product = left.Multiply(right);
+    EXPECT_EQ(5, FixedDecimalType::GetScale(product));
+    EXPECT_TRUE(FixedDecimalType::GetScaled(product) == static_cast<int128_t>(a) * b);
+
+    EXPECT_EQ(CmpBool::CmpTrue, sum.Subtract(right).CompareEquals(left));
+    EXPECT_EQ(a * 10 < b ? CmpBool::CmpTrue : CmpBool::CmpFalse, left.CompareLessThan(right));
+    if (b != 0) {
+      // the quotient keeps at least 6 digits after the decimal point, rounded half away from zero
+      auto quotient = left.Divide(right);
+      EXPECT_EQ(6, FixedDecimalType::GetScale(quotient));
+      int128_t numerator = static_cast<int128_t>(a) * 10 * 1000000;
+      int128_t expected = numerator / b;
+      int128_t remainder = numerator % b;
+      if (remainder != 0 && 2 * (remainder < 0 ? -remainder : remainder) >= (b < 0 ? -b : b)) {
+        expected += (numerator < 0) == (b < 0) ? 1 : -1;
+      }
+      EXPECT_TRUE(FixedDecimalType::GetScaled(quotient) == expected) << left.ToString() << " / " << right.ToString();
+    }
+  }
+
+  // results beyond 38 digits throw instead of losing digits
+  auto big = Decimal("99999999999999999999999999999999999999");
+  EXPECT_THROW(big.Add(Decimal("1")), Exception);
+  EXPECT_THROW(big.Multiply(Decimal("10")), Exception);
+  EXPECT_THROW(Decimal("1").Divide(Decimal("0")), Exception);
+  EXPECT_EQ("0.3", Decimal("0.1").Add(Decimal("0.2")).ToString());
+  EXPECT_EQ("1.1", Decimal("10.1").Modulo(Decimal("3")).ToString());
+
+  // NULL on either side gives NULL
+  auto null = ValueFactory::GetNullValueByType(TypeId::FIXED_DECIMAL);
+  EXPECT_TRUE(null.Add(Decimal("1")).IsNull());
+  EXPECT_TRUE(Decimal("1").Multiply(null).IsNull());
+  EXPECT_EQ(CmpBool::CmpNull, null.CompareEquals(Decimal("1")));
+}
+
+// NOLINTNEXTLINE
+TEST(FixedDecimalTest, RescaleTest) {
+  EXPECT_EQ("1.01", FixedDecimalType::Rescale(Decimal("1.005"), 10, 2).ToString());
+  EXPECT_EQ("-1.01", FixedDecimalType::Rescale(Decimal("-1.005"), 10, 2).ToString());
+  EXPECT_EQ("1.00", FixedDecimalType::Rescale(Decimal("1.004"), 10, 2).ToString());
+  EXPECT_EQ("12.3000", FixedDecimalType::Rescale(Decimal("12.3"), 10, 4).ToString());
+  EXPECT_EQ("999.99", FixedDecimalType::Rescale(Decimal("999.99"), 5, 2).ToString());
+  EXPECT_THROW(FixedDecimalType::Rescale(Decimal("999.995"), 5, 2), Exception);
+  EXPECT_THROW(FixedDecimalType::Rescale(Decimal("12345.6"), 5, 2), Exception);
+}
+
+// NOLINTNEXTLINE
+TEST(FixedDecimalTest, CastTest) {
+  EXPECT_EQ(3, Decimal("2.5").CastAs(TypeId::INTEGER).GetAs<int32_t>());
+  EXPECT_EQ(-3, Decimal("-2.5").CastAs(TypeId::INTEGER).GetAs<int32_t>());
+  EXPECT_EQ(2, Decimal("2.49").CastAs(TypeId::BIGINT).GetAs<int64_t>());
+  EXPECT_THROW(Decimal("128").CastAs(TypeId::TINYINT), Exception);
+  EXPECT_DOUBLE_EQ(2.5, Decimal("2.5").CastAs(TypeId::DECIMAL).GetAs<double>());
+  EXPECT_EQ("-12.50", Decimal("-12.50").CastAs(TypeId::VARCHAR).ToString());
+
+  EXPECT_EQ("7", ValueFactory::GetIntegerValue(7).CastAs(TypeId::FIXED_DECIMAL).ToString());
+  EXPECT_EQ("0.1", ValueFactory::GetDecimalValue(0.1).CastAs(TypeId::FIXED_DECIMAL).ToString());
+  EXPECT_EQ("3.25", ValueFactory::GetVarcharValue("3.25").CastAs(TypeId::FIXED_DECIMAL).ToString());
+  EXPECT_EQ("2.50", ValueFactory::CastAsFixedDecimal(ValueFactory::GetDecimalValue(2.5), 10, 2).ToString());
+}
+
+// NOLINTNEXTLINE
+TEST(FixedDecimalTest, CompareTest) {
+  // the same number at different scales is equal and hashes the same
+  EXPECT_EQ(CmpBool::CmpTrue, Decimal("1.50").CompareEquals(Decimal("1.5")));
+  EXPECT_TRUE(FixedDecimalType::Normalize(Decimal("1.50")) == FixedDecimalType::Normalize(Decimal("1.5")));
+  EXPECT_EQ(CmpBool::CmpTrue, Decimal("-0.01").CompareLessThan(Decimal("0")));
+
+  // with the other numeric types, on either side
+  EXPECT_EQ(CmpBool::CmpTrue, Decimal("1.5").CompareLessThan(ValueFactory::GetIntegerValue(2)));
+  EXPECT_EQ(CmpBool::CmpTrue, ValueFactory::GetIntegerValue(2).CompareGreaterThan(Decimal("1.5")));
+  EXPECT_EQ(CmpBool::CmpTrue, ValueFactory::GetBigIntValue(3).CompareEquals(Decimal("3.000")));
+  EXPECT_EQ(CmpBool::CmpTrue, Decimal("1.25").CompareEquals(ValueFactory::GetDecimalValue(1.25)));
+  EXPECT_EQ(CmpBool::CmpTrue, ValueFactory::GetDecimalValue(1.24).CompareLessThan(Decimal("1.25")));
+}
+
+// NOLINTNEXTLINE
+TEST(FixedDecimalTest, SerializeTest) {
+  // decimal(10, 2) takes 9 bytes, decimal(30, 5) takes 17
+  Schema schema({Column("a", TypeId::FIXED_DECIMAL, 10, 2), Column("b", TypeId::FIXED_DECIMAL, 30, 5),
+                 Column("c", TypeId::INTEGER)});
+  EXPECT_EQ(9 + 17 + 4, schema.GetLength());
+
+  std::vector<std::vector<Value>> rows = {
+      {Decimal("12345678.99"), Decimal("1234567890123456789012345.12345"), ValueFactory::GetIntegerValue(1)},
+      {Decimal("-0.5"), Decimal("7"), ValueFactory::GetIntegerValue(2)},
+      {ValueFactory::GetNullValueByType(TypeId::FIXED_DECIMAL), ValueFactory::GetNullValueByType(TypeId::FIXED_DECIMAL),
+       ValueFactory::GetIntegerValue(3)},
+  };
+  std::vector<std::vector<std::string>> expected = {
+      {"12345678.99", "1234567890123456789012345.12345", "1"},
+      {"-0.50", "7.00000", "2"},
+      {"FIXED_DECIMAL_NULL", "FIXED_DECIMAL_NULL", "3"},
+  };
+  for (size_t i = 0; i < rows.size(); i++) {
+    Tuple tuple(rows[i], &schema);
+    for (uint32_t j = 0; j < schema.GetColumnCount(); j++) {
+      auto value = tuple.GetValue(&schema, j);
+      if (expected[i][j] == "FIXED_DECIMAL_NULL") {
+        EXPECT_TRUE(value.IsNull());
+      } else {
+        EXPECT_EQ(expected[i][j], value.ToString());
+      }
+    }
+  }
+
+  // a value that does not fit the column is rejected
+  EXPECT_THROW(Tuple({Decimal("123456789.5"), Decimal("0"), ValueFactory::GetIntegerValue(0)}, &schema), Exception);
+}
+
+/** The scaled values of a decimal(18, 2) column, with some NULLs */
+static auto RandomColumn(size_t count, uint64_t seed) -> std::vector<int64_t> {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<int64_t> dis(-999999999999999999, 999999999999999999);
+  std::vector<int64_t> values(count);
+  for (auto &value : values) {
+    value = gen() % 10 == 0 ? BUSTUB_INT64_NULL : dis(gen);
+  }
+  return values;
+}
+
+// NOLINTNEXTLINE
+TEST(FixedDecimalTest, BatchKernelTest) {
+  for (size_t count : {0, 1, 7, 8, 9, 100, 1021}) {
+    auto values = RandomColumn(count, count);
+    int128_t sum = 0;
+    int64_t min = BUSTUB_INT64_MAX;
+    int64_t max = BUSTUB_INT64_NULL;
+    size_t non_null = 0;
+    std::vector<uint32_t> expected_selection;
+    for (size_t i = 0; i < count; i++) {
+      if (values[i] == BUSTUB_INT64_NULL) {
+        continue;
+      }
+      sum += values[i];
+      min = std::min(min, values[i]);
+      max = std::max(max, values[i]);
+      non_null++;
+      if (values[i] < 0) {
+        expected_selection.push_back(i);
+      }
+    }
+    EXPECT_TRUE(sum == TypeKernels::SumFixedDecimals(values.data(), count));
+    EXPECT_EQ(min, TypeKernels::MinFixedDecimals(values.data(), count));
+    EXPECT_EQ(max, TypeKernels::MaxFixedDecimals(values.data(), count));
+    EXPECT_EQ(non_null, TypeKernels::CountFixedDecimals(values.data(), count));
+
+    std::vector<uint32_t> selection(count);
+    size_t selected = TypeKernels::SelectFixedDecimals(values.data(), count, CompareOp::LessThan, 0, selection.data());
+    selection.resize(selected);
+    EXPECT_EQ(expected_selection, selection);
+  }
+}
+
+/**
+ * Report the cost of summing and taking the minimum of a column of decimals three ways: the batch kernels over the
+ * scaled int64_t values, Value over FIXED_DECIMAL, and Value over DECIMAL, the double it replaces.
+ */
+// NOLINTNEXTLINE
+TEST(FixedDecimalTest, BatchBenchmark) {
+  const size_t count = 1 << 18;
+  const size_t rounds = 4;
+  auto values = RandomColumn(count, 15445);
+  std::vector<Value> fixed;
+  std::vector<Value> doubles;
+  for (auto value : values) {
+    if (value == BUSTUB_INT64_NULL) {
+      fixed.push_back(ValueFactory::GetNullValueByType(TypeId::FIXED_DECIMAL));
+      doubles.push_back(ValueFactory::GetNullValueByType(TypeId::DECIMAL));
+    } else {
+      // keep the sums well within the 38 digits
+      fixed.push_back(ValueFactory::GetFixedDecimalValue(value / 1000000, 18, 2));
+      doubles.push_back(ValueFactory::GetDecimalValue(static_cast<double>(value / 1000000) / 100));
+    }
+  }
+
+  auto time = [&](const auto &fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+      fn();
+    }
+    return static_cast<double>((std::chrono::steady_clock::now() - start).count()) / (rounds * count);
+  };
+  auto sum_values = [](const std::vector<Value> &column) {
+    Value sum = column[0];
+    for (size_t i = 1; i < column.size(); i++) {
+      if (!column[i].IsNull()) {
+        sum = sum.IsNull() ? column[i] : sum.Add(column[i]);
+      }
+    }
+    return sum;
+  };
+  auto min_values = [](const std::vector<Value> &column) {
+    Value min = column[0];
+    for (size_t i = 1; i < column.size(); i++) {
+      if (!column[i].IsNull()) {
+        min = min.IsNull() ? column[i] : min.Min(column[i]);
+      }
+    }
+    return min;
+  };
+
+  int128_t batch_sum = 0;
+  int64_t batch_min = 0;
+  Value fixed_sum;
+  double kernel_sum_ns = time([&] { batch_sum = TypeKernels::SumFixedDecimals(values.data(), count); });
+  double kernel_min_ns = time([&] { batch_min = TypeKernels::MinFixedDecimals(values.data(), count); });
+  double fixed_sum_ns = time([&] { fixed_sum = sum_values(fixed); });
+  double fixed_min_ns = time([&] { min_values(fixed); });
+  double double_sum_ns = time([&] { sum_values(doubles); });
+  double double_min_ns = time([&] { min_values(doubles); });
+  EXPECT_FALSE(fixed_sum.IsNull());
+  EXPECT_NE(0, batch_min);
+  EXPECT_FALSE(batch_sum == 0);
+
+  auto report = [](const std::string &name, double ns) {
+    std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(2) << std::setw(8)
+              << ns << " ns/value" << std::endl;
+  };
+  report("sum, batch kernel", kernel_sum_ns);
+  report("sum, Value over FIXED_DECIMAL", fixed_sum_ns);
+  report("sum, Value over DECIMAL", double_sum_ns);
+  report("min, batch kernel", kernel_min_ns);
+  report("min, Value over FIXED_DECIMAL", fixed_min_ns);
+  report("min, Value over DECIMAL", double_min_ns);
+}
+
+}  // namespace bustub
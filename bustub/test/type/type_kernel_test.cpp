@@ -0,0 +1,247 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// type_kernel_test.cpp
+//
+// Identification: test/type/type_kernel_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "gtest/gtest.h"
+#include "storage/index/generic_key.h"
+#include "storage/table/tuple.h"
+#include "type/type_kernel.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** The types covered by type_test.cpp, and VARCHAR */
+const std::vector<TypeId> KERNEL_TEST_TYPES = {
+    TypeId::BOOLEAN, TypeId::TINYINT, TypeId::SMALLINT, TypeId::INTEGER, TypeId::BIGINT, TypeId::DECIMAL, TypeId::VARCHAR,
+};
+
+const std::vector<CompareOp> COMPARE_OPS = {CompareOp::Equal,           CompareOp::NotEqual,    CompareOp::LessThan,
+                                            CompareOp::LessThanOrEqual, CompareOp::GreaterThan, CompareOp::GreaterThanOrEqual};
+
+const std::vector<ArithmeticOp> ARITHMETIC_OPS = {ArithmeticOp::Add, ArithmeticOp::Subtract, ArithmeticOp::Min,
+                                                  ArithmeticOp::Max};
+
+/** @return values of the type around zero, at the limits of the type, and NULL */
+static auto SampleValues(TypeId type) -> std::vector<Value> {
+  std::vector<Value> values{ValueFactory::GetNullValueByType(type)};
+  switch (type) {
+    case TypeId::BOOLEAN:
+      values.push_back(ValueFactory::GetBooleanValue(true));
+      values.push_back(ValueFactory::GetBooleanValue(false));
+      break;
+    case TypeId::VARCHAR:
+      for (const auto *str : {"", "a", "ab", "b", "a string that does not fit inline"}) {
+        values.push_back(ValueFactory::GetVarcharValue(str));
+      }
+      break;
+    default:
+      for (int32_t i : {-3, -1, 0, 1, 2, 100}) {
+        values.push_back(ValueFactory::GetIntegerValue(i).CastAs(type));
+      }
+      values.push_back(Type::GetMinValue(type));
+      values.push_back(Type::GetMaxValue(type));
+  }
+  return values;
+}
+
+static auto CompareWithValue(const Value &left, const Value &right, CompareOp op) -> CmpBool {
+  switch (op) {
+    case CompareOp::Equal:
+      return left.CompareEquals(right);
+    case CompareOp::NotEqual:
+      return left.CompareNotEquals(right);
+    case CompareOp::LessThan:
+      return left.CompareLessThan(right);
+    case CompareOp::LessThanOrEqual:
+      return left.CompareLessThanEquals(right);
+    case CompareOp::GreaterThan:
+      return left.CompareGreaterThan(right);
+    case CompareOp::GreaterThanOrEqual:
+      return left.CompareGreaterThanEquals(right);
+  }
+  return CmpBool::CmpNull;
+}
+
+static auto ArithmeticWithValue(const Value &left, const Value &right, ArithmeticOp op) -> Value {
+  switch (op) {
+    case ArithmeticOp::Add:
+      return left.Add(right);
+    case ArithmeticOp::Subtract:
+      return left.Subtract(right);
+    case ArithmeticOp::Min:
+      return left.Min(right);
+    case ArithmeticOp::Max:
+      return left.Max(right);
+  }
+  return {};
+}
+
+// NOLINTNEXTLINE
+TEST(TypeKernelTest, CompareKernelTest) {
+  size_t kernel_cnt = 0;
+  for (auto left_type : KERNEL_TEST_TYPES) {
+    for (auto right_type : KERNEL_TEST_TYPES) {
+      for (auto op : COMPARE_OPS) {
+        auto kernel = TypeKernels::GetCompareKernel(left_type, right_type, op);
+        if (kernel == nullptr) {
+          continue;
+        }
+        kernel_cnt++;
+        for (const auto &left : SampleValues(left_type)) {
+          for (const auto &right : SampleValues(right_type)) {
+            EXPECT_EQ(CompareWithValue(left, right, op), kernel(left, right))
+                << left.ToString() << " " << static_cast<int>(op) << " " << right.ToString();
+          }
+        }
+      }
+    }
+  }
+  // 5 x 5 numeric pairs, and BOOLEAN and VARCHAR with themselves
+  EXPECT_EQ((5 * 5 + 2) * COMPARE_OPS.size(), kernel_cnt);
+}
+
+// NOLINTNEXTLINE
+TEST(TypeKernelTest, ArithmeticKernelTest) {
+  for (auto type : KERNEL_TEST_TYPES) {
+    for (auto op : ARITHMETIC_OPS) {
+      auto kernel = TypeKernels::GetArithmeticKernel(type, op);
+      if (kernel == nullptr) {
+        continue;
+      }
+      for (const auto &left : SampleValues(type)) {
+        for (const auto &right : SampleValues(type)) {
+          // an overflow must throw on both paths
+          Value expected;
+          bool expected_throw = false;
+          try {
+            expected = ArithmeticWithValue(left, right, op);
+          } catch (const Exception &e) {
+            expected_throw = true;
+          }
+          if (expected_throw) {
+            EXPECT_THROW(kernel(left, right), Exception);
+            continue;
+          }
+          auto result = kernel(left, right);
+          EXPECT_EQ(expected.GetTypeId(), result.GetTypeId());
+          EXPECT_EQ(expected.IsNull(), result.IsNull());
+          if (!expected.IsNull()) {
+            EXPECT_EQ(CmpBool::CmpTrue, expected.CompareEquals(result)) << expected.ToString() << result.ToString();
+          }
+        }
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TypeKernelTest, KeyCompareKernelTest) {
+  for (auto type : KERNEL_TEST_TYPES) {
+    Schema schema({type == TypeId::VARCHAR ? Column("a", type, 64) : Column("a", type)});
+    auto kernel = TypeKernels::GetKeyCompareKernel(type);
+    ASSERT_NE(nullptr, kernel);
+    GenericComparator<64> comparator(&schema);
+    for (const auto &left : SampleValues(type)) {
+      for (const auto &right : SampleValues(type)) {
+        GenericKey<64> left_key;
+        GenericKey<64> right_key;
+        left_key.SetFromKey(Tuple({left}, &schema));
+        right_key.SetFromKey(Tuple({right}, &schema));
+
+        int expected = 0;
+        if (left.CompareLessThan(right) == CmpBool::CmpTrue) {
+          expected = -1;
+        } else if (left.CompareGreaterThan(right) == CmpBool::CmpTrue) {
+          expected = 1;
+        }
+        EXPECT_EQ(expected, comparator(left_key, right_key)) << left.ToString() << " " << right.ToString();
+      }
+    }
+  }
+}
+
+/**
+ * Report the cost of each operator through Value and through its kernel. The loop runs over the sample values of the
+ * type so that the branches of the kernels see changing inputs.
+ */
+// NOLINTNEXTLINE
+TEST(TypeKernelTest, KernelBenchmark) {
+  const size_t rounds = 20000;
+  auto report = [](const std::string &name, size_t ops, std::chrono::nanoseconds value_ns,
+                   std::chrono::nanoseconds kernel_ns) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+              << static_cast<double>(value_ns.count()) / ops << " ns/op (Value) " << std::setw(8)
+              << static_cast<double>(kernel_ns.count()) / ops << " ns/op (kernel)" << std::endl;
+  };
+
+  for (auto type : {TypeId::INTEGER, TypeId::BIGINT, TypeId::DECIMAL, TypeId::VARCHAR}) {
+    auto values = SampleValues(type);
+    values.erase(values.begin());  // the NULL returns before any work
+    size_t ops = rounds * values.size() * values.size();
+
+    for (auto op : {CompareOp::Equal, CompareOp::LessThan}) {
+      auto kernel = TypeKernels::GetCompareKernel(type, type, op);
+      size_t value_true = 0;
+      size_t kernel_true = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t r = 0; r < rounds; r++) {
+        for (const auto &left : values) {
+          for (const auto &right : values) {
+            value_true += static_cast<size_t>(CompareWithValue(left, right, op) == CmpBool::CmpTrue);
+          }
+        }
+      }
+      auto middle = std::chrono::steady_clock::now();
+      for (size_t r = 0; r < rounds; r++) {
+        for (const auto &left : values) {
+          for (const auto &right : values) {
+            kernel_true += static_cast<size_t>(kernel(left, right) == CmpBool::CmpTrue);
+          }
+        }
+      }
+      auto end = std::chrono::steady_clock::now();
+      EXPECT_EQ(value_true, kernel_true);
+      report(Type::TypeIdToString(type) + (op == CompareOp::Equal ? " =" : " <"), ops, middle - start, end - middle);
+    }
+
+    if (type == TypeId::VARCHAR) {
+      continue;
+    }
+    // Min never overflows, so it runs over every pair of values
+    auto kernel = TypeKernels::GetArithmeticKernel(type, ArithmeticOp::Min);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+      for (const auto &left : values) {
+        for (const auto &right : values) {
+          ArithmeticWithValue(left, right, ArithmeticOp::Min);
+        }
+      }
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+      for (const auto &left : values) {
+        for (const auto &right : values) {
+          kernel(left, right);
+        }
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    report(Type::TypeIdToString(type) + " min", ops, middle - start, end - middle);
+  }
+}
+
+}  // namespace bustub
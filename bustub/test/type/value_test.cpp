@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// value_test.cpp
+//
+// Identification: test/type/value_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/bustub_instance.h"
+#include "gtest/gtest.h"
+#include "type/value.h"
+#include "type/value_factory.h"
+
+namespace {
+/** The number of heap allocations made by the test while counting is enabled */
+std::atomic<size_t> allocation_cnt{0};
+std::atomic<bool> count_allocations{false};
+}  // namespace
+
+// Count the allocations of the whole test binary, the counter is only bumped while `count_allocations` is set.
+auto operator new(std::size_t size) -> void * {
+  if (count_allocations) {
+    allocation_cnt++;
+  }
+  if (void *ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+auto operator new[](std::size_t size) -> void * { return operator new(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t size) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t size) noexcept { std::free(ptr); }
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ValueTest, VarcharCopyMoveTest) {
+  for (const std::string str : {"", "short", "exactly 15 char", "a string that does not fit inline"}) {
+    auto value = ValueFactory::GetVarcharValue(str);
+    auto copy = value;
+    EXPECT_EQ(str, copy.ToString());
+    EXPECT_EQ(str.size() + 1, copy.GetLength());
+    EXPECT_EQ(CmpBool::CmpTrue, copy.CompareEquals(value));
+
+    auto moved = std::move(copy);
+    EXPECT_EQ(str, moved.ToString());
+    EXPECT_EQ(CmpBool::CmpTrue, moved.CompareEquals(value));
+
+    Value assigned;
+    assigned = moved;
+    EXPECT_EQ(str, assigned.ToString());
+    assigned = ValueFactory::GetIntegerValue(1);
+    EXPECT_EQ(1, assigned.GetAs<int32_t>());
+
+    // A copy of a value made from a buffer stays valid after the buffer is gone.
+    std::vector<char> buffer(str.begin(), str.end());
+    buffer.push_back('\0');
+    auto from_buffer = Value(TypeId::VARCHAR, buffer.data(), buffer.size(), true);
+    buffer.assign(buffer.size(), 'x');
+    EXPECT_EQ(str, from_buffer.ToString());
+
+    std::vector<char> storage(sizeof(uint32_t) + value.GetLength());
+    value.SerializeTo(storage.data());
+    EXPECT_EQ(str, Value::DeserializeFrom(storage.data(), TypeId::VARCHAR).ToString());
+  }
+
+  auto null_value = ValueFactory::GetNullValueByType(TypeId::VARCHAR);
+  auto null_copy = null_value;
+  EXPECT_TRUE(null_copy.IsNull());
+  auto null_moved = std::move(null_copy);
+  EXPECT_TRUE(null_moved.IsNull());
+}
+
+/** Count the heap allocations made by a query, after a first run to warm up the plan cache and the catalog */
+static auto CountAllocations(BustubInstance *bustub, const std::string &sql) -> size_t {
+  NoopWriter writer;
+  bustub->ExecuteSql(sql, writer);
+  allocation_cnt = 0;
+  count_allocations = true;
+  bustub->ExecuteSql(sql, writer);
+  count_allocations = false;
+  return allocation_cnt;
+}
+
+// NOLINTNEXTLINE
+TEST(ValueTest, GroupByVarcharAllocationTest) {
+  auto bustub = std::make_unique<BustubInstance>("value_test.db");
+  bustub->GenerateMockTable();
+
+  // 10,000 rows (1,000 in the small table), v6 holds 1 to 16 (1 to 8) four-byte characters.
+  const std::vector<std::string> queries{
+      "select v6, count(*), min(v1), max(v2) from __mock_agg_input_big group by v6",
+      "select v6, v2 from __mock_agg_input_small order by v6, v2 limit 10",
+      "select v1, count(v6) from __mock_agg_input_big group by v1",
+  };
+  for (const auto &sql : queries) {
+    std::cout << CountAllocations(bustub.get(), sql) << " allocations: " << sql << std::endl;
+  }
+
+  bustub.reset();
+  remove("value_test.db");
+  remove("value_test.log");
+}
+
+}  // namespace bustub
@@ -0,0 +1,674 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bustub_bench.cpp
+//
+// Identification: tools/bustub_bench/bustub_bench.cpp
+//
+//===----------------------------------------------------------------------===//
+
+// Throughput and latency benchmarks for BusTub.
+//
+//   bustub-bench ycsb --workloads a,b,c,d,e,f --records 10000 --operations 100000 --threads 4 --zipf 0.99
+//   bustub-bench tpcc --warehouses 1 --transactions 1000 --threads 4
+//
+// `ycsb` runs the YCSB core workloads directly against a TableHeap and its BPlusTreeIndex, without SQL, locks or
+// the planner. `tpcc` runs a simplified TPC-C (NewOrder and Payment only) through BustubInstance::ExecuteSqlTxn, so
+// it covers the whole stack including the lock manager.
+//
+// Every run appends one JSON object per line to `--output` (stdout if not given; the lock manager logs to stdout
+// as well, so prefer a file for the TPC-C driver). Latencies are reported in microseconds.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/catalog.h"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "common/util/string_util.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "fmt/format.h"
+#include "storage/index/b_plus_tree_index.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace {
+
+using bustub::BustubInstance;
+using bustub::RID;
+using bustub::Tuple;
+using bustub::Value;
+using bustub::ValueFactory;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Zipfian distribution over [0, n), as in YCSB (Gray et al., "Quickly Generating Billion-Record Synthetic
+ * Databases"). Rank 0 is the most popular item. theta = 0 falls back to a uniform distribution.
+ */
+class ZipfianGenerator {
+ public:
+  ZipfianGenerator(uint64_t n, double theta) : n_(std::max<uint64_t>(n, 1)), theta_(theta) {
+    if (theta_ <= 0) {
+      return;
+    }
+    zetan_ = Zeta(n_, theta_);
+    auto zeta2 = Zeta(2, theta_);
+    alpha_ = 1.0 / (1.0 - theta_);
+    eta_ = (1.0 - std::pow(2.0 / static_cast<double>(n_), 1.0 - theta_)) / (1.0 - zeta2 / zetan_);
+  }
+
+  /** @return the rank of the next item */
+  auto Next(std::mt19937_64 *rng) const -> uint64_t {
+    if (theta_ <= 0) {
+      return std::uniform_int_distribution<uint64_t>(0, n_ - 1)(*rng);
+    }
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(*rng);
+    double uz = u * zetan_;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, theta_)) {
+      return 1;
+    }
+    auto rank = static_cast<uint64_t>(static_cast<double>(n_) * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+    return std::min(rank, n_ - 1);
+  }
+
+  /** @return the next item, with the popular ranks scattered over the key space instead of clustered at 0 */
+  auto NextScrambled(std::mt19937_64 *rng) const -> uint64_t { return Fnv64(Next(rng)) % n_; }
+
+ private:
+  static auto Zeta(uint64_t n, double theta) -> double {
+    double sum = 0;
+    for (uint64_t i = 1; i <= n; i++) {
+      sum += 1.0 / std::pow(static_cast<double>(i), theta);
+    }
+    return sum;
+  }
+
+  static auto Fnv64(uint64_t val) -> uint64_t {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < 8; i++) {
+      h = (h ^ (val & 0xff)) * 0x100000001b3ULL;
+      val >>= 8;
+    }
+    return h;
+  }
+
+  uint64_t n_;
+  double theta_;
+  double zetan_{0};
+  double alpha_{0};
+  double eta_{0};
+};
+
+/** Latencies of one kind of operation, in nanoseconds */
+struct LatencyRecorder {
+  std::map<std::string, std::vector<uint64_t>> samples_;
+
+  void Record(const std::string &op, Clock::time_point start) {
+    samples_[op].push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+  }
+
+  void Merge(LatencyRecorder &&other) {
+    for (auto &[op, samples] : other.samples_) {
+      auto &dst = samples_[op];
+      dst.insert(dst.end(), samples.begin(), samples.end());
+    }
+  }
+
+  /** @return `"op": {"count": .., "p50": .., "p99": .., "p999": ..}` for every operation, and for all of them */
+  auto ToJson() -> std::string {
+    std::vector<uint64_t> all;
+    std::vector<std::string> parts;
+    for (auto &[op, samples] : samples_) {
+      all.insert(all.end(), samples.begin(), samples.end());
+      parts.push_back(fmt::format("\"{}\": {}", op, Summarize(&samples)));
+    }
+    parts.insert(parts.begin(), fmt::format("\"all\": {}", Summarize(&all)));
+    return fmt::format("{{{}}}", fmt::join(parts, ", "));
+  }
+
+ private:
+  static auto Summarize(std::vector<uint64_t> *samples) -> std::string {
+    std::sort(samples->begin(), samples->end());
+    auto percentile = [&](double q) -> double {
+      if (samples->empty()) {
+        return 0;
+      }
+      auto idx = std::min(samples->size() - 1, static_cast<size_t>(q * static_cast<double>(samples->size())));
+      return static_cast<double>((*samples)[idx]) / 1000.0;
+    };
+    return fmt::format("{{\"count\": {}, \"p50\": {:.1f}, \"p99\": {:.1f}, \"p999\": {:.1f}}}", samples->size(),
+                       percentile(0.5), percentile(0.99), percentile(0.999));
+  }
+};
+
+/** Run `body(thread_id)` on `threads` threads, @return the wall time in seconds */
+template <typename F>
+auto RunThreads(size_t threads, F &&body) -> double {
+  auto start = Clock::now();
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < threads; i++) {
+    workers.emplace_back(body, i);
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void WriteResult(const std::string &output, const std::string &line) {
+  if (output.empty()) {
+    std::cout << line << std::endl;
+    return;
+  }
+  std::ofstream file(output, std::ios::app);
+  file << line << std::endl;
+}
+
+/** A ResultWriter keeping the cells of the result, to read the values selected by the TPC-C transactions */
+class CellWriter : public bustub::ResultWriter {
+ public:
+  void WriteCell(const std::string &cell) override { cells_.push_back(cell); }
+  void WriteHeaderCell(const std::string &cell) override {}
+  void BeginHeader() override {}
+  void EndHeader() override {}
+  void BeginRow() override {}
+  void EndRow() override {}
+  void BeginTable(bool simplified_output) override {}
+  void EndTable() override {}
+
+  std::vector<std::string> cells_;
+};
+
+//===--------------------------------------------------------------------===//
+// YCSB
+//===--------------------------------------------------------------------===//
+
+/** The operation mix of a YCSB core workload */
+struct YcsbWorkload {
+  double read_;
+  double update_;
+  double insert_;
+  double scan_;
+  double read_modify_write_;
+  /** Requests go to the most recently inserted keys (workload D) instead of a scrambled zipfian */
+  bool latest_;
+};
+
+auto GetYcsbWorkload(char name) -> YcsbWorkload {
+  switch (name) {
+    case 'a':
+      return {0.5, 0.5, 0, 0, 0, false};
+    case 'b':
+      return {0.95, 0.05, 0, 0, 0, false};
+    case 'c':
+      return {1.0, 0, 0, 0, 0, false};
+    case 'd':
+      return {0.95, 0, 0.05, 0, 0, true};
+    case 'e':
+      return {0, 0, 0.05, 0.95, 0, false};
+    case 'f':
+      return {0.5, 0, 0, 0, 0.5, false};
+    default:
+      throw bustub::Exception(fmt::format("unknown YCSB workload: {}", name));
+  }
+}
+
+struct YcsbOptions {
+  size_t records_;
+  size_t operations_;
+  size_t threads_;
+  size_t pool_size_;
+  size_t value_size_;
+  size_t scan_length_;
+  double zipf_;
+  std::string output_;
+};
+
+/** The usertable of YCSB: an integer key with its B+ tree index, and one VARCHAR field */
+class YcsbTable {
+ public:
+  YcsbTable(BustubInstance *bustub, size_t value_size) : value_size_(value_size) {
+    auto *txn = bustub->txn_manager_->Begin();
+    auto &catalog = *bustub->catalog_;
+    bustub::Schema schema({bustub::Column("ycsb_key", bustub::TypeId::INTEGER),
+                           bustub::Column("field0", bustub::TypeId::VARCHAR, static_cast<uint32_t>(value_size))});
+    table_info_ = catalog.CreateTable(txn, "usertable", schema);
+    auto key_schema = bustub::Schema::CopySchema(&schema, {0});
+    index_info_ = catalog.CreateIndex<bustub::IntegerKeyType, bustub::IntegerValueType, bustub::IntegerComparatorType>(
+        txn, "usertable_pk", "usertable", table_info_->schema_, key_schema, {0}, bustub::INTEGER_SIZE,
+        bustub::HashFunction<bustub::IntegerKeyType>());
+    bustub->txn_manager_->Commit(txn);
+    delete txn;
+    tree_ = dynamic_cast<bustub::BPlusTreeIndexForOneIntegerColumn *>(index_info_->index_.get());
+  }
+
+  auto Insert(int32_t key, std::mt19937_64 *rng, bustub::Transaction *txn) -> bool {
+    RID rid;
+    if (!table_info_->table_->InsertTuple(MakeRecord(key, rng), &rid, txn)) {
+      return false;
+    }
+    index_info_->index_->InsertEntry(MakeKey(key), rid, txn);
+    return true;
+  }
+
+  auto Read(int32_t key, Tuple *tuple, RID *rid, bustub::Transaction *txn) -> bool {
+    std::vector<RID> rids;
+    index_info_->index_->ScanKey(MakeKey(key), &rids, txn);
+    if (rids.empty()) {
+      return false;
+    }
+    *rid = rids[0];
+    return table_info_->table_->GetTuple(*rid, tuple, txn);
+  }
+
+  auto Update(int32_t key, std::mt19937_64 *rng, bustub::Transaction *txn) -> bool {
+    Tuple tuple;
+    RID rid;
+    if (!Read(key, &tuple, &rid, txn)) {
+      return false;
+    }
+    return table_info_->table_->UpdateTuple(MakeRecord(key, rng), rid, txn);
+  }
+
+  /** Read up to `length` records in key order, starting from `key` */
+  auto Scan(int32_t key, size_t length, bustub::Transaction *txn) -> size_t {
+    bustub::IntegerKeyType start;
+    start.SetFromKey(MakeKey(key));
+    size_t count = 0;
+    Tuple tuple;
+    for (auto iter = tree_->GetBeginIterator(start); !iter.IsEnd() && count < length; ++iter) {
+      table_info_->table_->GetTuple((*iter).second, &tuple, txn);
+      count++;
+    }
+    return count;
+  }
+
+ private:
+  auto MakeKey(int32_t key) -> Tuple {
+    return Tuple({ValueFactory::GetIntegerValue(key)}, &index_info_->key_schema_);
+  }
+
+  auto MakeRecord(int32_t key, std::mt19937_64 *rng) -> Tuple {
+    std::string field(value_size_, 'a');
+    for (auto &c : field) {
+      c = static_cast<char>('a' + (*rng)() % 26);
+    }
+    return Tuple({ValueFactory::GetIntegerValue(key), ValueFactory::GetVarcharValue(field)}, &table_info_->schema_);
+  }
+
+  size_t value_size_;
+  bustub::TableInfo *table_info_;
+  bustub::IndexInfo *index_info_;
+  bustub::BPlusTreeIndexForOneIntegerColumn *tree_;
+};
+
+void RunYcsb(const YcsbOptions &opts, const std::string &workloads) {
+  std::remove("bench.db");
+  std::remove("bench.log");
+  auto bustub = std::make_unique<BustubInstance>("bench.db", opts.pool_size_);
+  YcsbTable table(bustub.get(), opts.value_size_);
+
+  // Load phase: the keys 0 .. records - 1, split between the threads.
+  auto load_time = RunThreads(opts.threads_, [&](size_t thread_id) {
+    bustub::Transaction txn(static_cast<bustub::txn_id_t>(thread_id));
+    std::mt19937_64 rng(thread_id);
+    for (size_t key = thread_id; key < opts.records_; key += opts.threads_) {
+      table.Insert(static_cast<int32_t>(key), &rng, &txn);
+      txn.GetWriteSet()->clear();
+    }
+  });
+  WriteResult(opts.output_, fmt::format("{{\"benchmark\": \"ycsb\", \"phase\": \"load\", \"records\": {}, "
+                                        "\"threads\": {}, \"pool_size\": {}, \"seconds\": {:.3f}, "
+                                        "\"throughput\": {:.1f}}}",
+                                        opts.records_, opts.threads_, opts.pool_size_, load_time,
+                                        static_cast<double>(opts.records_) / load_time));
+
+  // Keys handed out to inserts, and keys whose insert is done; `latest` reads only go up to the latter.
+  std::atomic<int64_t> next_key{static_cast<int64_t>(opts.records_)};
+  std::atomic<int64_t> inserted_keys{static_cast<int64_t>(opts.records_)};
+  ZipfianGenerator zipf(opts.records_, opts.zipf_);
+  for (auto name : workloads) {
+    if (name == ',') {
+      continue;
+    }
+    auto workload = GetYcsbWorkload(name);
+    std::vector<LatencyRecorder> recorders(opts.threads_);
+    std::atomic<size_t> failed{0};
+
+    auto seconds = RunThreads(opts.threads_, [&](size_t thread_id) {
+      bustub::Transaction txn(static_cast<bustub::txn_id_t>(thread_id));
+      std::mt19937_64 rng(thread_id * 7919 + name);
+      std::uniform_real_distribution<double> coin(0.0, 1.0);
+      auto &recorder = recorders[thread_id];
+      auto pick_key = [&]() -> int32_t {
+        if (workload.latest_) {
+          auto newest = inserted_keys.load() - 1;
+          return static_cast<int32_t>(std::max<int64_t>(0, newest - static_cast<int64_t>(zipf.Next(&rng))));
+        }
+        return static_cast<int32_t>(zipf.NextScrambled(&rng));
+      };
+
+      Tuple tuple;
+      RID rid;
+      for (size_t i = thread_id; i < opts.operations_; i += opts.threads_) {
+        double dice = coin(rng);
+        auto start = Clock::now();
+        bool ok = true;
+        if ((dice -= workload.read_) < 0) {
+          ok = table.Read(pick_key(), &tuple, &rid, &txn);
+          recorder.Record("read", start);
+        } else if ((dice -= workload.update_) < 0) {
+          ok = table.Update(pick_key(), &rng, &txn);
+          recorder.Record("update", start);
+        } else if ((dice -= workload.insert_) < 0) {
+          ok = table.Insert(static_cast<int32_t>(next_key.fetch_add(1)), &rng, &txn);
+          inserted_keys++;
+          recorder.Record("insert", start);
+        } else if ((dice -= workload.scan_) < 0) {
+          auto length = std::uniform_int_distribution<size_t>(1, opts.scan_length_)(rng);
+          table.Scan(pick_key(), length, &txn);
+          recorder.Record("scan", start);
+        } else {
+          auto key = pick_key();
+          ok = table.Read(key, &tuple, &rid, &txn) && table.Update(key, &rng, &txn);
+          recorder.Record("read_modify_write", start);
+        }
+        if (!ok) {
+          failed++;
+        }
+        txn.GetWriteSet()->clear();
+      }
+    });
+
+    LatencyRecorder latencies;
+    for (auto &recorder : recorders) {
+      latencies.Merge(std::move(recorder));
+    }
+    WriteResult(opts.output_,
+                fmt::format("{{\"benchmark\": \"ycsb\", \"workload\": \"{}\", \"records\": {}, \"operations\": {}, "
+                            "\"threads\": {}, \"pool_size\": {}, \"zipf\": {}, \"seconds\": {:.3f}, "
+                            "\"throughput\": {:.1f}, \"failed\": {}, \"latency_us\": {}}}",
+                            name, opts.records_, opts.operations_, opts.threads_, opts.pool_size_, opts.zipf_, seconds,
+                            static_cast<double>(opts.operations_) / seconds, failed.load(), latencies.ToJson()));
+  }
+
+  bustub.reset();
+  std::remove("bench.db");
+  std::remove("bench.log");
+}
+
+//===--------------------------------------------------------------------===//
+// TPC-C
+//===--------------------------------------------------------------------===//
+
+struct TpccOptions {
+  size_t warehouses_;
+  size_t items_;
+  size_t customers_;
+  size_t transactions_;
+  size_t threads_;
+  size_t pool_size_;
+  double zipf_;
+  double new_order_ratio_;
+  std::string output_;
+};
+
+/** Districts per warehouse, as in TPC-C */
+constexpr size_t DISTRICTS = 10;
+
+/**
+ * A simplified TPC-C schema. Composite keys are folded into one integer column so that every lookup can use a single
+ * column B+ tree index: district key = w * 10 + d, customer key = district key * customers + c, and stock key =
+ * w * items + i.
+ */
+void LoadTpcc(BustubInstance *bustub, const TpccOptions &opts) {
+  bustub::NoopWriter writer;
+  bustub->ExecuteSql("CREATE TABLE warehouse (w_id INT, w_ytd INT);", writer);
+  bustub->ExecuteSql("CREATE TABLE district (d_key INT, d_ytd INT, d_next_o_id INT);", writer);
+  bustub->ExecuteSql("CREATE TABLE customer (c_key INT, c_balance INT, c_payment_cnt INT);", writer);
+  bustub->ExecuteSql("CREATE TABLE item (i_id INT, i_price INT);", writer);
+  bustub->ExecuteSql("CREATE TABLE stock (s_key INT, s_quantity INT, s_order_cnt INT);", writer);
+  bustub->ExecuteSql("CREATE TABLE orders (o_key INT, o_id INT, o_c_key INT, o_ol_cnt INT);", writer);
+  bustub->ExecuteSql("CREATE TABLE order_line (ol_o_key INT, ol_o_id INT, ol_number INT, ol_i_id INT, "
+                     "ol_quantity INT, ol_amount INT);",
+                     writer);
+
+  // Insert in batches of rows, a single statement per table would hold too many locks in one transaction.
+  auto insert_rows = [&](const std::string &table, size_t count, auto &&make_row) {
+    std::vector<std::string> rows;
+    for (size_t i = 0; i < count; i++) {
+      rows.push_back(make_row(i));
+      if (rows.size() == 100 || i + 1 == count) {
+        bustub->ExecuteSql(fmt::format("INSERT INTO {} VALUES {};", table, fmt::join(rows, ", ")), writer);
+        rows.clear();
+      }
+    }
+  };
+  std::mt19937_64 rng(42);
+  insert_rows("warehouse", opts.warehouses_, [](size_t w) { return fmt::format("({}, 0)", w); });
+  insert_rows("district", opts.warehouses_ * DISTRICTS, [](size_t d) { return fmt::format("({}, 0, 1)", d); });
+  insert_rows("customer", opts.warehouses_ * DISTRICTS * opts.customers_,
+              [](size_t c) { return fmt::format("({}, 0, 0)", c); });
+  insert_rows("item", opts.items_, [&](size_t i) { return fmt::format("({}, {})", i, 1 + rng() % 100); });
+  insert_rows("stock", opts.warehouses_ * opts.items_,
+              [&](size_t s) { return fmt::format("({}, {}, 0)", s, 10 + rng() % 91); });
+
+  bustub->ExecuteSql("CREATE INDEX warehouse_pk ON warehouse (w_id);", writer);
+  bustub->ExecuteSql("CREATE INDEX district_pk ON district (d_key);", writer);
+  bustub->ExecuteSql("CREATE INDEX customer_pk ON customer (c_key);", writer);
+  bustub->ExecuteSql("CREATE INDEX item_pk ON item (i_id);", writer);
+  bustub->ExecuteSql("CREATE INDEX stock_pk ON stock (s_key);", writer);
+}
+
+/** @return the first cell of the result of a query run in the transaction */
+auto QueryInt(BustubInstance *bustub, const std::string &sql, bustub::Transaction *txn) -> int64_t {
+  CellWriter writer;
+  bustub->ExecuteSqlTxn(sql, writer, txn);
+  if (writer.cells_.empty()) {
+    throw bustub::Exception(fmt::format("no result for: {}", sql));
+  }
+  return std::stoll(writer.cells_[0]);
+}
+
+/** NewOrder: take the next order id of a district, then order 5 to 15 items and decrement their stock */
+void NewOrder(BustubInstance *bustub, const TpccOptions &opts, const ZipfianGenerator &items,
+              const ZipfianGenerator &customers, std::mt19937_64 *rng, bustub::Transaction *txn) {
+  bustub::NoopWriter writer;
+  auto w = (*rng)() % opts.warehouses_;
+  auto d_key = w * DISTRICTS + (*rng)() % DISTRICTS;
+  auto c_key = d_key * opts.customers_ + customers.NextScrambled(rng);
+
+  auto o_id = QueryInt(bustub, fmt::format("SELECT d_next_o_id FROM district WHERE d_key = {};", d_key), txn);
+  bustub->ExecuteSqlTxn(
+      fmt::format("UPDATE district SET d_next_o_id = d_next_o_id + 1 WHERE d_key = {};", d_key), writer, txn);
+  auto ol_cnt = 5 + (*rng)() % 11;
+  bustub->ExecuteSqlTxn(
+      fmt::format("INSERT INTO orders VALUES ({}, {}, {}, {});", d_key, o_id, c_key, ol_cnt), writer, txn);
+
+  for (size_t number = 1; number <= ol_cnt; number++) {
+    auto i_id = items.NextScrambled(rng);
+    auto s_key = w * opts.items_ + i_id;
+    auto quantity = 1 + static_cast<int64_t>((*rng)() % 10);
+    auto price = QueryInt(bustub, fmt::format("SELECT i_price FROM item WHERE i_id = {};", i_id), txn);
+    auto s_quantity = QueryInt(bustub, fmt::format("SELECT s_quantity FROM stock WHERE s_key = {};", s_key), txn);
+    s_quantity = s_quantity >= quantity + 10 ? s_quantity - quantity : s_quantity - quantity + 91;
+    bustub->ExecuteSqlTxn(fmt::format("UPDATE stock SET s_quantity = {}, s_order_cnt = s_order_cnt + 1 "
+                                      "WHERE s_key = {};",
+                                      s_quantity, s_key),
+                          writer, txn);
+    bustub->ExecuteSqlTxn(fmt::format("INSERT INTO order_line VALUES ({}, {}, {}, {}, {}, {});", d_key, o_id, number,
+                                      i_id, quantity, quantity * price),
+                          writer, txn);
+  }
+}
+
+/** Payment: add the amount to the year-to-date totals of a warehouse and a district, and to a customer */
+void Payment(BustubInstance *bustub, const TpccOptions &opts, const ZipfianGenerator &customers,
+             std::mt19937_64 *rng, bustub::Transaction *txn) {
+  bustub::NoopWriter writer;
+  auto w = (*rng)() % opts.warehouses_;
+  auto d_key = w * DISTRICTS + (*rng)() % DISTRICTS;
+  auto c_key = d_key * opts.customers_ + customers.NextScrambled(rng);
+  auto amount = 1 + (*rng)() % 5000;
+
+  bustub->ExecuteSqlTxn(fmt::format("UPDATE warehouse SET w_ytd = w_ytd + {} WHERE w_id = {};", amount, w), writer,
+                        txn);
+  bustub->ExecuteSqlTxn(fmt::format("UPDATE district SET d_ytd = d_ytd + {} WHERE d_key = {};", amount, d_key),
+                        writer, txn);
+  bustub->ExecuteSqlTxn(fmt::format("UPDATE customer SET c_balance = c_balance - {}, c_payment_cnt = c_payment_cnt + 1 "
+                                    "WHERE c_key = {};",
+                                    amount, c_key),
+                        writer, txn);
+}
+
+void RunTpcc(const TpccOptions &opts) {
+  std::remove("bench.db");
+  std::remove("bench.log");
+  auto bustub = std::make_unique<BustubInstance>("bench.db", opts.pool_size_);
+  auto load_start = Clock::now();
+  LoadTpcc(bustub.get(), opts);
+  auto load_time = std::chrono::duration<double>(Clock::now() - load_start).count();
+
+  ZipfianGenerator items(opts.items_, opts.zipf_);
+  ZipfianGenerator customers(opts.customers_, opts.zipf_);
+  std::vector<LatencyRecorder> recorders(opts.threads_);
+  std::atomic<size_t> aborted{0};
+
+  auto seconds = RunThreads(opts.threads_, [&](size_t thread_id) {
+    std::mt19937_64 rng(thread_id * 7919 + 1);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    for (size_t i = thread_id; i < opts.transactions_; i += opts.threads_) {
+      bool new_order = coin(rng) < opts.new_order_ratio_;
+      auto start = Clock::now();
+      auto *txn = bustub->txn_manager_->Begin();
+      try {
+        if (new_order) {
+          NewOrder(bustub.get(), opts, items, customers, &rng, txn);
+        } else {
+          Payment(bustub.get(), opts, customers, &rng, txn);
+        }
+        if (txn->GetState() == bustub::TransactionState::ABORTED) {
+          throw bustub::Exception("transaction aborted");
+        }
+        bustub->txn_manager_->Commit(txn);
+        recorders[thread_id].Record(new_order ? "new_order" : "payment", start);
+      } catch (const std::exception &e) {
+        // Deadlock victims and lock conflicts abort, they are counted but not retried.
+        bustub->txn_manager_->Abort(txn);
+        aborted++;
+      }
+      delete txn;
+    }
+  });
+
+  LatencyRecorder latencies;
+  for (auto &recorder : recorders) {
+    latencies.Merge(std::move(recorder));
+  }
+  auto committed = opts.transactions_ - aborted.load();
+  WriteResult(opts.output_,
+              fmt::format("{{\"benchmark\": \"tpcc\", \"warehouses\": {}, \"items\": {}, \"customers\": {}, "
+                          "\"transactions\": {}, \"threads\": {}, \"pool_size\": {}, \"zipf\": {}, "
+                          "\"load_seconds\": {:.3f}, \"seconds\": {:.3f}, \"throughput\": {:.1f}, \"committed\": {}, "
+                          "\"aborted\": {}, \"latency_us\": {}}}",
+                          opts.warehouses_, opts.items_, opts.customers_, opts.transactions_, opts.threads_,
+                          opts.pool_size_, opts.zipf_, load_time, seconds, static_cast<double>(committed) / seconds,
+                          committed, aborted.load(), latencies.ToJson()));
+
+  bustub.reset();
+  std::remove("bench.db");
+  std::remove("bench.log");
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int {  // NOLINT
+  argparse::ArgumentParser program("bustub-bench");
+  program.add_argument("benchmark").help("ycsb or tpcc");
+  program.add_argument("--threads").help("number of client threads").default_value(1).scan<'i', int>();
+  program.add_argument("--pool-size").help("buffer pool frames").default_value(1024).scan<'i', int>();
+  program.add_argument("--zipf").help("zipfian skew in [0, 1), 0 is uniform").default_value(0.99).scan<'g', double>();
+  program.add_argument("--output").help("append the results to this file, as JSON lines").default_value(std::string());
+  program.add_argument("--workloads").help("ycsb: workloads to run in order").default_value(std::string("a,b,c,d,e,f"));
+  program.add_argument("--records").help("ycsb: records loaded").default_value(10000).scan<'i', int>();
+  program.add_argument("--operations").help("ycsb: operations per workload").default_value(100000).scan<'i', int>();
+  program.add_argument("--value-size").help("ycsb: bytes of the value field").default_value(100).scan<'i', int>();
+  program.add_argument("--scan-length").help("ycsb: longest scan").default_value(100).scan<'i', int>();
+  program.add_argument("--warehouses").help("tpcc: warehouses").default_value(1).scan<'i', int>();
+  program.add_argument("--items").help("tpcc: items").default_value(1000).scan<'i', int>();
+  program.add_argument("--customers").help("tpcc: customers per district").default_value(30).scan<'i', int>();
+  program.add_argument("--transactions").help("tpcc: transactions").default_value(1000).scan<'i', int>();
+  program.add_argument("--new-order-ratio").help("tpcc: NewOrder share").default_value(0.5).scan<'g', double>();
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  auto benchmark = bustub::StringUtil::Lower(program.get<std::string>("benchmark"));
+  auto threads = static_cast<size_t>(std::max(1, program.get<int>("threads")));
+  auto pool_size = static_cast<size_t>(program.get<int>("pool-size"));
+  auto zipf = program.get<double>("zipf");
+  if (zipf < 0 || zipf >= 1) {
+    std::cerr << "--zipf must be in [0, 1)" << std::endl;
+    return 1;
+  }
+  auto output = program.get<std::string>("output");
+
+  try {
+    if (benchmark == "ycsb") {
+      YcsbOptions opts{static_cast<size_t>(program.get<int>("records")),
+                       static_cast<size_t>(program.get<int>("operations")),
+                       threads,
+                       pool_size,
+                       static_cast<size_t>(program.get<int>("value-size")),
+                       static_cast<size_t>(std::max(1, program.get<int>("scan-length"))),
+                       zipf,
+                       output};
+      RunYcsb(opts, bustub::StringUtil::Lower(program.get<std::string>("workloads")));
+    } else if (benchmark == "tpcc") {
+      TpccOptions opts{static_cast<size_t>(std::max(1, program.get<int>("warehouses"))),
+                       static_cast<size_t>(std::max(1, program.get<int>("items"))),
+                       static_cast<size_t>(std::max(1, program.get<int>("customers"))),
+                       static_cast<size_t>(program.get<int>("transactions")),
+                       threads,
+                       pool_size,
+                       zipf,
+                       program.get<double>("new-order-ratio"),
+                       output};
+      RunTpcc(opts);
+    } else {
+      std::cerr << "unknown benchmark: " << benchmark << std::endl;
+      return 1;
+    }
+  } catch (const bustub::Exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
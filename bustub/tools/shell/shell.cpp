@@ -1,8 +1,11 @@
+#include <algorithm>
+#include <chrono>  // NOLINT
 #include <iostream>
 #include <string>
 #include "binder/binder.h"
 #include "common/bustub_instance.h"
 #include "common/exception.h"
+#include "common/metrics.h"
 #include "common/util/string_util.h"
 #include "libfort/lib/fort.hpp"
 #include "linenoise/linenoise.h"
@@ -33,16 +36,32 @@ auto main(int argc, char **argv) -> int {
   auto emoji_prompt = "\U0001f6c1> ";  // the bathtub emoji
   bool use_emoji_prompt = false;
   bool disable_tty = false;
+  std::string metrics_file;
+  int metrics_interval_ms = 10000;
 
   for (int i = 1; i < argc; i++) {
     if (strcmp(argv[i], "--emoji-prompt") == 0) {
       use_emoji_prompt = true;
-      break;
+      continue;
     }
     if (strcmp(argv[i], "--disable-tty") == 0) {
       disable_tty = true;
-      break;
+      continue;
     }
+    // Append a JSON snapshot of the metrics to a file periodically, see SHOW METRICS for the current values.
+    if (strcmp(argv[i], "--metrics-file") == 0 && i + 1 < argc) {
+      metrics_file = argv[++i];
+      continue;
+    }
+    if (strcmp(argv[i], "--metrics-interval-ms") == 0 && i + 1 < argc) {
+      metrics_interval_ms = std::max(1, std::stoi(argv[++i]));
+      continue;
+    }
+  }
+
+  if (!metrics_file.empty()) {
+    bustub::MetricsRegistry::Instance().StartSnapshotThread(metrics_file,
+                                                            std::chrono::milliseconds(metrics_interval_ms));
   }
 
   bustub->GenerateMockTable();
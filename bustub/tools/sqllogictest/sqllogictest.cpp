@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <fstream>
 #include <ios>
 #include <iostream>
@@ -87,6 +88,42 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           fmt::print("NestedIndexJoin not found\n");
           return false;
         }
+      } else if (opt == "ensure:merge_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "MergeJoin")) {
+          fmt::print("MergeJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:hash_semi_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "HashJoin { type=Semi")) {
+          fmt::print("semi HashJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:hash_anti_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "HashJoin { type=Anti")) {
+          fmt::print("anti HashJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:runtime_filter") {
+        if (!bustub::StringUtil::Contains(result.str(), "runtime_filters=[")) {
+          fmt::print("runtime filter not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:sorted_agg") {
+        if (!bustub::StringUtil::Contains(result.str(), "sorted_input=true")) {
+          fmt::print("sorted aggregation not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:limit_pushdown") {
+        if (!bustub::StringUtil::Contains(result.str(), "IndexScan") ||
+            !bustub::StringUtil::Contains(result.str(), ", limit=")) {
+          fmt::print("limit not pushed into the index scan\n");
+          return false;
+        }
+      } else if (opt == "ensure:distinct") {
+        if (!bustub::StringUtil::Contains(result.str(), "Distinct")) {
+          fmt::print("Distinct not found\n");
+          return false;
+        }
       } else {
         throw bustub::NotImplementedException(fmt::format("unsupported extra option: {}", opt));
       }
@@ -169,6 +206,9 @@ auto main(int argc, char **argv) -> int {  // NOLINT
 
   auto result = bustub::SQLLogicTestParser::Parse(script);
 
+  // Every script starts with an empty database, the catalog would otherwise be loaded from the previous run.
+  std::remove("test.db");
+  std::remove("test.log");
   auto bustub = std::make_unique<bustub::BustubInstance>("test.db");
   bustub->GenerateMockTable();
 